@@ -5,6 +5,7 @@
 #include <nctl/StackAllocator.h>
 #include <nctl/PoolAllocator.h>
 #include <nctl/FreeListAllocator.h>
+#include <nctl/SlabAllocator.h>
 
 const unsigned int BufferSize = (65536 + 4) * 1024;
 uint8_t buffer[BufferSize];
@@ -232,4 +233,40 @@ BENCHMARK(BM_FixedAllocations_FreeListAllocator_Reverse_NoDefrag)->Args({ Repeti
                                                                  ->Args({ Repetitions / 4, 4096 })->Args({ Repetitions / 2, 4096 })->Args({ Repetitions, 4096 })
                                                                  ->Args({ Repetitions / 4, 65536 })->Args({ Repetitions / 2, 65536 })->Args({ Repetitions, 65536 });
 
+static void BM_FixedAllocations_SlabAllocator(benchmark::State &state)
+{
+	nctl::MallocAllocator malloc;
+	nctl::SlabAllocator slab("Slab", state.range(1), nctl::IAllocator::DefaultAlignment, Repetitions, malloc);
+	void *ptrs[Repetitions];
+
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < state.range(0); i++)
+			ptrs[i] = slab.allocate(state.range(1));
+		for (unsigned int i = 0; i < state.range(0); i++)
+			slab.deallocate(ptrs[i]);
+	}
+}
+BENCHMARK(BM_FixedAllocations_SlabAllocator)->Args({ Repetitions / 4, 1024 })->Args({ Repetitions / 2, 1024 })->Args({ Repetitions, 1024 })
+                                            ->Args({ Repetitions / 4, 4096 })->Args({ Repetitions / 2, 4096 })->Args({ Repetitions, 4096 })
+                                            ->Args({ Repetitions / 4, 65536 })->Args({ Repetitions / 2, 65536 })->Args({ Repetitions, 65536 });
+
+static void BM_FixedAllocations_SlabAllocator_Reverse(benchmark::State &state)
+{
+	nctl::MallocAllocator malloc;
+	nctl::SlabAllocator slab("Slab", state.range(1), nctl::IAllocator::DefaultAlignment, Repetitions, malloc);
+	void *ptrs[Repetitions];
+
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < state.range(0); i++)
+			ptrs[i] = slab.allocate(state.range(1));
+		for (unsigned int i = 0; i < state.range(0); i++)
+			slab.deallocate(ptrs[state.range(0) - i - 1]);
+	}
+}
+BENCHMARK(BM_FixedAllocations_SlabAllocator_Reverse)->Args({ Repetitions / 4, 1024 })->Args({ Repetitions / 2, 1024 })->Args({ Repetitions, 1024 })
+                                                    ->Args({ Repetitions / 4, 4096 })->Args({ Repetitions / 2, 4096 })->Args({ Repetitions, 4096 })
+                                                    ->Args({ Repetitions / 4, 65536 })->Args({ Repetitions / 2, 65536 })->Args({ Repetitions, 65536 });
+
 BENCHMARK_MAIN();
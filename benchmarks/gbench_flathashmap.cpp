@@ -0,0 +1,150 @@
+#include "benchmark/benchmark.h"
+#include <nctl/FlatHashMap.h>
+
+const unsigned int Capacity = 1024;
+const int KeyValueDifference = 10;
+
+using SaxFlatHashMap = nctl::FlatHashMap<unsigned int, unsigned int, nctl::SaxHashFunc<unsigned int>>;
+using JenkinsFlatHashMap = nctl::FlatHashMap<unsigned int, unsigned int, nctl::JenkinsHashFunc<unsigned int>>;
+using FNV1aFlatHashMap = nctl::FlatHashMap<unsigned int, unsigned int, nctl::FNV1aHashFunc<unsigned int>>;
+using FlatHashMapTestType = FNV1aFlatHashMap;
+
+static void BM_FlatHashMapCreation(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	for (auto _ : state)
+	{
+		FlatHashMapTestType map(Capacity);
+		benchmark::DoNotOptimize(map);
+	}
+}
+BENCHMARK(BM_FlatHashMapCreation);
+
+static void BM_FlatHashMapCopy(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashMapTestType initMap(Capacity);
+	for (unsigned int i = 0; i < state.range(0); i++)
+		initMap[i] = i * 2;
+	FlatHashMapTestType map(Capacity);
+
+	for (auto _ : state)
+	{
+		map = initMap;
+		benchmark::DoNotOptimize(map);
+
+		state.PauseTiming();
+		map.clear();
+		state.ResumeTiming();
+	}
+}
+BENCHMARK(BM_FlatHashMapCopy)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_FlatHashMapInsert(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashMapTestType map(Capacity);
+
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < state.range(0); i++)
+			benchmark::DoNotOptimize(map[i] = i + KeyValueDifference);
+
+		state.PauseTiming();
+		map.clear();
+		state.ResumeTiming();
+	}
+}
+BENCHMARK(BM_FlatHashMapInsert)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_FlatHashMapRetrieve(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashMapTestType map(Capacity);
+	for (unsigned int i = 0; i < state.range(0); i++)
+		map[i] = i * 2;
+
+	unsigned int key = 0;
+	for (auto _ : state)
+	{
+		key = (key + 19) % state.range(0);
+		benchmark::DoNotOptimize(map[key]);
+	}
+}
+BENCHMARK(BM_FlatHashMapRetrieve)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_FlatHashMapClear(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashMapTestType initMap(Capacity);
+	for (unsigned int i = 0; i < state.range(0); i++)
+		initMap[i] = i * 2;
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		FlatHashMapTestType map(initMap);
+		state.ResumeTiming();
+
+		map.clear();
+	}
+}
+BENCHMARK(BM_FlatHashMapClear)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_FlatHashMapRemove(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashMapTestType initMap(Capacity);
+	for (unsigned int i = 0; i < state.range(0); i++)
+		initMap[i] = i * 2;
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		FlatHashMapTestType map(initMap);
+		state.ResumeTiming();
+
+		for (unsigned int i = 0; i < state.range(0); i++)
+			map.remove(i);
+	}
+}
+BENCHMARK(BM_FlatHashMapRemove)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_FlatHashMapReverseRemove(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashMapTestType initMap(Capacity);
+	for (unsigned int i = 0; i < state.range(0); i++)
+		initMap[i] = i * 2;
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		FlatHashMapTestType map(initMap);
+		state.ResumeTiming();
+
+		for (int i = state.range(0) - 1; i >= 0; i--)
+			map.remove(i);
+	}
+}
+BENCHMARK(BM_FlatHashMapReverseRemove)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_FlatHashMapRehashDoubleCapacity(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashMapTestType initMap(Capacity);
+	for (unsigned int i = 0; i < state.range(0); i++)
+		initMap[i] = i * 2;
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		FlatHashMapTestType map(initMap);
+		state.ResumeTiming();
+
+		map.rehash(Capacity * 2);
+	}
+}
+BENCHMARK(BM_FlatHashMapRehashDoubleCapacity)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,149 @@
+#include "benchmark/benchmark.h"
+#include <nctl/FlatHashSet.h>
+
+const unsigned int Capacity = 1024;
+
+using SaxFlatHashSet = nctl::FlatHashSet<unsigned int, nctl::SaxHashFunc<unsigned int>>;
+using JenkinsFlatHashSet = nctl::FlatHashSet<unsigned int, nctl::JenkinsHashFunc<unsigned int>>;
+using FNV1aFlatHashSet = nctl::FlatHashSet<unsigned int, nctl::FNV1aHashFunc<unsigned int>>;
+using FlatHashSetTestType = FNV1aFlatHashSet;
+
+static void BM_FlatHashSetCreation(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	for (auto _ : state)
+	{
+		FlatHashSetTestType set(Capacity);
+		benchmark::DoNotOptimize(set);
+	}
+}
+BENCHMARK(BM_FlatHashSetCreation);
+
+static void BM_FlatHashSetCopy(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashSetTestType initSet(Capacity);
+	for (unsigned int i = 0; i < state.range(0); i++)
+		initSet.insert(i);
+	FlatHashSetTestType set(Capacity);
+
+	for (auto _ : state)
+	{
+		set = initSet;
+		benchmark::DoNotOptimize(set);
+
+		state.PauseTiming();
+		set.clear();
+		state.ResumeTiming();
+	}
+}
+BENCHMARK(BM_FlatHashSetCopy)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_FlatHashSetInsert(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashSetTestType set(Capacity);
+
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < state.range(0); i++)
+			set.insert(i);
+
+		state.PauseTiming();
+		set.clear();
+		state.ResumeTiming();
+	}
+}
+BENCHMARK(BM_FlatHashSetInsert)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_FlatHashSetRetrieve(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashSetTestType set(Capacity);
+	for (unsigned int i = 0; i < state.range(0); i++)
+		set.insert(i);
+
+	unsigned int key = 0;
+	for (auto _ : state)
+	{
+		key = (key + 19) % state.range(0);
+		benchmark::DoNotOptimize(set.find(key));
+	}
+}
+BENCHMARK(BM_FlatHashSetRetrieve)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_FlatHashSetClear(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashSetTestType initSet(Capacity);
+	for (unsigned int i = 0; i < state.range(0); i++)
+		initSet.insert(i);
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		FlatHashSetTestType set(initSet);
+		state.ResumeTiming();
+
+		set.clear();
+	}
+}
+BENCHMARK(BM_FlatHashSetClear)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_FlatHashSetRemove(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashSetTestType initSet(Capacity);
+	for (unsigned int i = 0; i < state.range(0); i++)
+		initSet.insert(i);
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		FlatHashSetTestType set(initSet);
+		state.ResumeTiming();
+
+		for (unsigned int i = 0; i < state.range(0); i++)
+			set.remove(i);
+	}
+}
+BENCHMARK(BM_FlatHashSetRemove)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_FlatHashSetReverseRemove(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashSetTestType initSet(Capacity);
+	for (unsigned int i = 0; i < state.range(0); i++)
+		initSet.insert(i);
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		FlatHashSetTestType set(initSet);
+		state.ResumeTiming();
+
+		for (int i = state.range(0) - 1; i >= 0; i--)
+			set.remove(i);
+	}
+}
+BENCHMARK(BM_FlatHashSetReverseRemove)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_FlatHashSetRehashDoubleCapacity(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashSetTestType initSet(Capacity);
+	for (unsigned int i = 0; i < state.range(0); i++)
+		initSet.insert(i);
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		FlatHashSetTestType set(initSet);
+		state.ResumeTiming();
+
+		set.rehash(Capacity * 2);
+	}
+}
+BENCHMARK(BM_FlatHashSetRehashDoubleCapacity)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+BENCHMARK_MAIN();
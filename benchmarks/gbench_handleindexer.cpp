@@ -0,0 +1,92 @@
+#include "benchmark/benchmark.h"
+#include <ncine/HandleIndexer.h>
+#include <ncine/Object.h>
+#include <ncine/ServiceLocator.h>
+#include <nctl/UniquePtr.h>
+
+const unsigned int NumLiveObjects = 1024;
+const unsigned int NumChurnedObjects = 4 * 1024 * 1024;
+
+using ncine::Object;
+
+namespace {
+
+ncine::HandleIndexer *registerIndexer()
+{
+	nctl::UniquePtr<ncine::HandleIndexer> indexer = nctl::makeUnique<ncine::HandleIndexer>();
+	ncine::HandleIndexer *indexerPtr = indexer.get();
+	ncine::theServiceLocator().registerIndexer(nctl::move(indexer));
+	return indexerPtr;
+}
+
+}
+
+static void BM_IndexerCreateDestroy(benchmark::State &state)
+{
+	ncine::HandleIndexer *indexer = registerIndexer();
+	Object *objects[NumLiveObjects];
+
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < NumLiveObjects; i++)
+			objects[i] = new Object(Object::ObjectType::BASE);
+		for (unsigned int i = 0; i < NumLiveObjects; i++)
+			delete objects[i];
+	}
+
+	state.SetItemsProcessed(state.iterations() * NumLiveObjects);
+	state.counters["Slots"] = indexer->numSlots();
+	ncine::theServiceLocator().unregisterIndexer();
+}
+BENCHMARK(BM_IndexerCreateDestroy);
+
+static void BM_IndexerChurn(benchmark::State &state)
+{
+	ncine::HandleIndexer *indexer = registerIndexer();
+	Object *objects[NumLiveObjects];
+	for (unsigned int i = 0; i < NumLiveObjects; i++)
+		objects[i] = new Object(Object::ObjectType::BASE);
+
+	for (auto _ : state)
+	{
+		// A live object is replaced by a new one millions of times
+		for (unsigned int i = 0; i < NumChurnedObjects; i++)
+		{
+			const unsigned int index = i % NumLiveObjects;
+			delete objects[index];
+			objects[index] = new Object(Object::ObjectType::BASE);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * NumChurnedObjects);
+	// The number of slots stays bounded by the peak number of live objects
+	state.counters["Slots"] = indexer->numSlots();
+	state.counters["SlotsMemory"] = indexer->numSlots() * (sizeof(Object *) + 2 * sizeof(unsigned int));
+
+	for (unsigned int i = 0; i < NumLiveObjects; i++)
+		delete objects[i];
+	ncine::theServiceLocator().unregisterIndexer();
+}
+BENCHMARK(BM_IndexerChurn)->Unit(benchmark::kMillisecond);
+
+static void BM_IndexerLookup(benchmark::State &state)
+{
+	registerIndexer();
+	Object *objects[NumLiveObjects];
+	for (unsigned int i = 0; i < NumLiveObjects; i++)
+		objects[i] = new Object(Object::ObjectType::BASE);
+
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < NumLiveObjects; i++)
+			benchmark::DoNotOptimize(ncine::theServiceLocator().indexer().object(objects[i]->id()));
+	}
+
+	state.SetItemsProcessed(state.iterations() * NumLiveObjects);
+	for (unsigned int i = 0; i < NumLiveObjects; i++)
+		delete objects[i];
+	ncine::theServiceLocator().unregisterIndexer();
+}
+BENCHMARK(BM_IndexerLookup);
+
+BENCHMARK_MAIN();
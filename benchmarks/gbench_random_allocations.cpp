@@ -5,6 +5,7 @@
 #include <nctl/StackAllocator.h>
 #include <nctl/PoolAllocator.h>
 #include <nctl/FreeListAllocator.h>
+#include <nctl/ThreadCacheAllocator.h>
 
 const unsigned int BufferSize = 65536 * 1024 + 512;
 uint16_t buffer[BufferSize];
@@ -12,12 +13,28 @@ uint16_t buffer[BufferSize];
 const unsigned int Repetitions = 1024;
 uint16_t allocSizes[Repetitions];
 
+uint16_t smallAllocSizes[Repetitions];
+
 void setup()
 {
 	for (unsigned int i = 0; i < Repetitions; i++)
 		allocSizes[i] = static_cast<uint16_t>((i << 8) + 255);
 }
 
+void setupSmall()
+{
+	// Sizes typical of container allocations
+	for (unsigned int i = 0; i < Repetitions; i++)
+		smallAllocSizes[i] = static_cast<uint16_t>(16 + (i * 37) % 1008);
+}
+
+nctl::IAllocator &sharedThreadCacheAllocator()
+{
+	static nctl::MallocAllocator source;
+	static nctl::ThreadCacheAllocator threadCache(source);
+	return threadCache;
+}
+
 static void BM_RandomAllocations_new(benchmark::State &state)
 {
 	setup();
@@ -210,4 +227,104 @@ static void BM_RandomAllocations_FreeListAllocator_NoDefrag_Reverse(benchmark::S
 }
 BENCHMARK(BM_RandomAllocations_FreeListAllocator_NoDefrag_Reverse)->Arg(Repetitions / 4)->Arg(Repetitions / 2)->Arg(Repetitions);
 
+static void BM_RandomAllocations_ThreadCacheAllocator(benchmark::State &state)
+{
+	setup();
+	nctl::MallocAllocator source;
+	nctl::ThreadCacheAllocator threadCache(source);
+	void *ptrs[Repetitions];
+
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < state.range(0); i++)
+			ptrs[i] = threadCache.allocate(allocSizes[i]);
+		for (unsigned int i = 0; i < state.range(0); i++)
+			threadCache.deallocate(ptrs[i]);
+	}
+}
+BENCHMARK(BM_RandomAllocations_ThreadCacheAllocator)->Arg(Repetitions / 4)->Arg(Repetitions / 2)->Arg(Repetitions);
+
+static void BM_RandomAllocations_ThreadCacheAllocator_Reverse(benchmark::State &state)
+{
+	setup();
+	nctl::MallocAllocator source;
+	nctl::ThreadCacheAllocator threadCache(source);
+	void *ptrs[Repetitions];
+
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < state.range(0); i++)
+			ptrs[i] = threadCache.allocate(allocSizes[i]);
+		for (unsigned int i = 0; i < state.range(0); i++)
+			threadCache.deallocate(ptrs[state.range(0) - i - 1]);
+	}
+}
+BENCHMARK(BM_RandomAllocations_ThreadCacheAllocator_Reverse)->Arg(Repetitions / 4)->Arg(Repetitions / 2)->Arg(Repetitions);
+
+static void BM_RandomAllocations_malloc_Threaded(benchmark::State &state)
+{
+	static const bool initialized = (setup(), true);
+	(void)initialized;
+	void *ptrs[Repetitions];
+
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < state.range(0); i++)
+			ptrs[i] = malloc(allocSizes[i]);
+		for (unsigned int i = 0; i < state.range(0); i++)
+			free(ptrs[i]);
+	}
+}
+BENCHMARK(BM_RandomAllocations_malloc_Threaded)->Arg(Repetitions)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_RandomAllocations_ThreadCacheAllocator_Threaded(benchmark::State &state)
+{
+	static const bool initialized = (setup(), true);
+	(void)initialized;
+	nctl::IAllocator &threadCache = sharedThreadCacheAllocator();
+	void *ptrs[Repetitions];
+
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < state.range(0); i++)
+			ptrs[i] = threadCache.allocate(allocSizes[i]);
+		for (unsigned int i = 0; i < state.range(0); i++)
+			threadCache.deallocate(ptrs[i]);
+	}
+}
+BENCHMARK(BM_RandomAllocations_ThreadCacheAllocator_Threaded)->Arg(Repetitions)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_RandomAllocations_malloc_SmallThreaded(benchmark::State &state)
+{
+	static const bool initialized = (setupSmall(), true);
+	(void)initialized;
+	void *ptrs[Repetitions];
+
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < state.range(0); i++)
+			ptrs[i] = malloc(smallAllocSizes[i]);
+		for (unsigned int i = 0; i < state.range(0); i++)
+			free(ptrs[i]);
+	}
+}
+BENCHMARK(BM_RandomAllocations_malloc_SmallThreaded)->Arg(Repetitions)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_RandomAllocations_ThreadCacheAllocator_SmallThreaded(benchmark::State &state)
+{
+	static const bool initialized = (setupSmall(), true);
+	(void)initialized;
+	nctl::IAllocator &threadCache = sharedThreadCacheAllocator();
+	void *ptrs[Repetitions];
+
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < state.range(0); i++)
+			ptrs[i] = threadCache.allocate(smallAllocSizes[i]);
+		for (unsigned int i = 0; i < state.range(0); i++)
+			threadCache.deallocate(ptrs[i]);
+	}
+}
+BENCHMARK(BM_RandomAllocations_ThreadCacheAllocator_SmallThreaded)->Arg(Repetitions)->ThreadRange(1, 8)->UseRealTime();
+
 BENCHMARK_MAIN();
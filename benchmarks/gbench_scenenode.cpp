@@ -0,0 +1,89 @@
+#include "benchmark/benchmark.h"
+#include <ncine/SceneNode.h>
+
+const unsigned int NumNodes = 1024;
+const unsigned int ChildrenPerNode = 8;
+
+using ncine::SceneNode;
+
+namespace {
+
+void buildFlatScene(SceneNode &root, unsigned int numNodes)
+{
+	for (unsigned int i = 0; i < numNodes; i++)
+		new SceneNode(&root, static_cast<float>(i), static_cast<float>(i));
+}
+
+void buildDeepScene(SceneNode &root, unsigned int numNodes)
+{
+	SceneNode *parent = &root;
+	unsigned int numChildren = 0;
+	for (unsigned int i = 0; i < numNodes; i++)
+	{
+		SceneNode *node = new SceneNode(parent, static_cast<float>(i), static_cast<float>(i));
+		numChildren++;
+		if (numChildren == ChildrenPerNode)
+		{
+			parent = node;
+			numChildren = 0;
+		}
+	}
+}
+
+}
+
+static void BM_SceneBuildFlat(benchmark::State &state)
+{
+	for (auto _ : state)
+	{
+		SceneNode *root = new SceneNode();
+		buildFlatScene(*root, state.range(0));
+
+		state.PauseTiming();
+		delete root;
+		state.ResumeTiming();
+	}
+}
+BENCHMARK(BM_SceneBuildFlat)->Arg(NumNodes)->Arg(NumNodes * 10)->Arg(NumNodes * 100);
+
+static void BM_SceneTeardownFlat(benchmark::State &state)
+{
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		SceneNode *root = new SceneNode();
+		buildFlatScene(*root, state.range(0));
+		state.ResumeTiming();
+
+		delete root;
+	}
+}
+BENCHMARK(BM_SceneTeardownFlat)->Arg(NumNodes)->Arg(NumNodes * 10)->Arg(NumNodes * 100);
+
+static void BM_SceneBuildTeardownDeep(benchmark::State &state)
+{
+	for (auto _ : state)
+	{
+		SceneNode *root = new SceneNode();
+		buildDeepScene(*root, state.range(0));
+		delete root;
+	}
+}
+BENCHMARK(BM_SceneBuildTeardownDeep)->Arg(NumNodes)->Arg(NumNodes * 10)->Arg(NumNodes * 100);
+
+static void BM_SceneRebuildFlat(benchmark::State &state)
+{
+	SceneNode root;
+	buildFlatScene(root, state.range(0));
+
+	for (auto _ : state)
+	{
+		// Churning half of the nodes reuses the memory freed by the previous ones
+		for (unsigned int i = 0; i < state.range(0) / 2; i++)
+			delete root.children().back();
+		buildFlatScene(root, state.range(0) / 2);
+	}
+}
+BENCHMARK(BM_SceneRebuildFlat)->Arg(NumNodes)->Arg(NumNodes * 10)->Arg(NumNodes * 100);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,169 @@
+#include "benchmark/benchmark.h"
+#include <ncine/Font.h>
+#include <ncine/TextNode.h>
+#include <ncine/Random.h>
+#include <nctl/String.h>
+#include <nctl/Array.h>
+#include <nctl/Utf8.h>
+
+const unsigned int NumKernings = 2000;
+const unsigned int TextLength = 64 * 1024;
+const unsigned int LineLength = 80;
+
+namespace nc = ncine;
+
+namespace {
+
+/// Codepoint ranges of the glyphs in the font: ASCII, Latin-1, Greek and Cyrillic
+const unsigned int GlyphRanges[][2] = { { 32, 126 }, { 160, 255 }, { 0x391, 0x3C9 }, { 0x410, 0x44F } };
+const unsigned int NumGlyphRanges = sizeof(GlyphRanges) / sizeof(*GlyphRanges);
+
+unsigned int randomCodepoint(unsigned int range)
+{
+	// Skipping the space at the beginning of the ASCII range
+	const unsigned int first = (range == 0) ? GlyphRanges[0][0] + 1 : GlyphRanges[range][0];
+	return nc::random().integer(first, GlyphRanges[range][1] + 1);
+}
+
+/// Creates an AngelCode's `FNT` memory buffer with glyphs of four scripts and kerning pairs between them
+nctl::String createFntBuffer()
+{
+	unsigned int numGlyphs = 0;
+	for (unsigned int i = 0; i < NumGlyphRanges; i++)
+		numGlyphs += GlyphRanges[i][1] - GlyphRanges[i][0] + 1;
+
+	nctl::String fnt(128 * 1024);
+	fnt.append("info face=\"Benchmark\" size=32 bold=0 italic=0 charset=\"\" unicode=1 stretchH=100 smooth=1 aa=1 padding=0,0,0,0 spacing=1,1 outline=0\n");
+	fnt.append("common lineHeight=38 base=30 scaleW=512 scaleH=512 pages=1 packed=0 alphaChnl=0 redChnl=4 greenChnl=4 blueChnl=4\n");
+	fnt.append("page id=0 file=\"benchmark.png\"\n");
+	fnt.formatAppend("chars count=%u\n", numGlyphs);
+	for (unsigned int i = 0; i < NumGlyphRanges; i++)
+	{
+		for (unsigned int codepoint = GlyphRanges[i][0]; codepoint <= GlyphRanges[i][1]; codepoint++)
+		{
+			const unsigned int width = 10 + codepoint % 12;
+			fnt.formatAppend("char id=%u x=%u y=%u width=%u height=24 xoffset=1 yoffset=6 xadvance=%u page=0 chnl=15\n",
+			                 codepoint, (codepoint * 24) % 512, ((codepoint * 24) / 512) * 24 % 512, width, width + 2);
+		}
+	}
+
+	fnt.formatAppend("kernings count=%u\n", NumKernings);
+	for (unsigned int i = 0; i < NumKernings; i++)
+	{
+		const unsigned int range = i % NumGlyphRanges;
+		fnt.formatAppend("kerning first=%u second=%u amount=%d\n", randomCodepoint(range), randomCodepoint(range), -1 - static_cast<int>(i % 3));
+	}
+
+	return fnt;
+}
+
+/// Creates a long multi-line text made of words written in the scripts of the font
+nctl::String createText()
+{
+	nctl::String text(TextLength * 2);
+	char utf8[5];
+	unsigned int numCodepoints = 0;
+	unsigned int lineLength = 0;
+	while (numCodepoints < TextLength)
+	{
+		const unsigned int range = nc::random().integer(0, NumGlyphRanges);
+		const unsigned int wordLength = nc::random().integer(2, 10);
+		for (unsigned int i = 0; i < wordLength; i++)
+		{
+			nctl::Utf8::codePointToUtf8(randomCodepoint(range), utf8, nullptr);
+			text.append(utf8);
+		}
+		numCodepoints += wordLength + 1;
+		lineLength += wordLength + 1;
+
+		if (lineLength >= LineLength)
+		{
+			text.append("\n");
+			lineLength = 0;
+		}
+		else
+			text.append(" ");
+	}
+
+	return text;
+}
+
+struct TextLayoutData
+{
+	nc::Font font;
+	nctl::String text;
+	nctl::Array<unsigned int> codepoints;
+
+	TextLayoutData()
+	    : text(TextLength * 2), codepoints(TextLength)
+	{
+		// Text and kerning pairs are the same for every run
+		nc::random().init(0x853c49e6748fea9bULL, 0xda3e39cb94b95bdbULL);
+
+		const nctl::String fnt = createFntBuffer();
+		font.loadMetricsFromMemory("Benchmark", reinterpret_cast<const unsigned char *>(fnt.data()), fnt.length());
+		text = createText();
+
+		const char *current = text.data();
+		const char *end = current + text.length();
+		while (current < end)
+		{
+			unsigned int codepoint = nctl::Utf8::InvalidUnicode;
+			current = nctl::Utf8::utf8ToCodePoint(current, codepoint);
+			codepoints.pushBack(codepoint);
+		}
+	}
+};
+
+TextLayoutData &textLayoutData()
+{
+	static TextLayoutData data;
+	return data;
+}
+
+}
+
+static void BM_CalculateBoundaries(benchmark::State &state)
+{
+	TextLayoutData &data = textLayoutData();
+	const bool withKerning = (state.range(0) != 0);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(nc::TextNode::calculateBoundaries(data.font, withKerning, data.text));
+
+	state.SetItemsProcessed(state.iterations() * data.codepoints.size());
+	state.SetBytesProcessed(state.iterations() * data.text.length());
+}
+BENCHMARK(BM_CalculateBoundaries)->Arg(0)->Arg(1);
+
+static void BM_GlyphLookup(benchmark::State &state)
+{
+	TextLayoutData &data = textLayoutData();
+
+	for (auto _ : state)
+	{
+		for (unsigned int codepoint : data.codepoints)
+			benchmark::DoNotOptimize(data.font.glyph(codepoint));
+	}
+
+	state.SetItemsProcessed(state.iterations() * data.codepoints.size());
+}
+BENCHMARK(BM_GlyphLookup);
+
+static void BM_KerningLookup(benchmark::State &state)
+{
+	TextLayoutData &data = textLayoutData();
+
+	for (auto _ : state)
+	{
+		int sum = 0;
+		for (unsigned int i = 0; i < data.codepoints.size() - 1; i++)
+			sum += data.font.kerning(data.codepoints[i], data.codepoints[i + 1]);
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * (data.codepoints.size() - 1));
+}
+BENCHMARK(BM_KerningLookup);
+
+BENCHMARK_MAIN();
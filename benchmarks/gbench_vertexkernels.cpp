@@ -0,0 +1,141 @@
+#include "benchmark/benchmark.h"
+#include <ncine/VertexKernels.h>
+#include <nctl/UniquePtr.h>
+
+const unsigned int NumFloats = 4;
+const unsigned int NumVertices = 4 * 1024;
+const unsigned int NumIndices = 6 * 1024;
+const unsigned int NumQuads = 1024;
+const int MeshIndex = 7;
+const unsigned short Offset = 1000;
+
+using ncine::VertexKernels;
+
+namespace {
+
+nctl::UniquePtr<float[]> createVertices()
+{
+	nctl::UniquePtr<float[]> vertices = nctl::makeUnique<float[]>(NumVertices * NumFloats);
+	for (unsigned int i = 0; i < NumVertices * NumFloats; i++)
+		vertices[i] = static_cast<float>(i);
+	return vertices;
+}
+
+nctl::UniquePtr<unsigned short[]> createIndices()
+{
+	nctl::UniquePtr<unsigned short[]> indices = nctl::makeUnique<unsigned short[]>(NumIndices);
+	for (unsigned int i = 0; i < NumIndices; i++)
+		indices[i] = static_cast<unsigned short>(i % 4);
+	return indices;
+}
+
+nctl::UniquePtr<VertexKernels::Quad[]> createQuads()
+{
+	nctl::UniquePtr<VertexKernels::Quad[]> quads = nctl::makeUnique<VertexKernels::Quad[]>(NumQuads);
+	for (unsigned int i = 0; i < NumQuads; i++)
+	{
+		for (unsigned int j = 0; j < 4; j++)
+		{
+			quads[i].positions[j] = static_cast<float>(i + j);
+			quads[i].texCoords[j] = static_cast<float>(j) * 0.25f;
+		}
+	}
+	return quads;
+}
+
+}
+
+static void BM_CopyWithIndexScalar(benchmark::State &state)
+{
+	nctl::UniquePtr<float[]> src = createVertices();
+	nctl::UniquePtr<float[]> dest = nctl::makeUnique<float[]>(NumVertices * (NumFloats + 1));
+
+	for (auto _ : state)
+	{
+		VertexKernels::copyWithIndexScalar(dest.get(), src.get(), NumVertices, NumFloats, MeshIndex);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * NumVertices);
+}
+BENCHMARK(BM_CopyWithIndexScalar);
+
+static void BM_CopyWithIndex(benchmark::State &state)
+{
+	nctl::UniquePtr<float[]> src = createVertices();
+	nctl::UniquePtr<float[]> dest = nctl::makeUnique<float[]>(NumVertices * (NumFloats + 1));
+
+	for (auto _ : state)
+	{
+		VertexKernels::copyWithIndex(dest.get(), src.get(), NumVertices, NumFloats, MeshIndex);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * NumVertices);
+	state.SetLabel(VertexKernels::instructionSet());
+}
+BENCHMARK(BM_CopyWithIndex);
+
+static void BM_AddOffsetScalar(benchmark::State &state)
+{
+	nctl::UniquePtr<unsigned short[]> src = createIndices();
+	nctl::UniquePtr<unsigned short[]> dest = nctl::makeUnique<unsigned short[]>(NumIndices);
+
+	for (auto _ : state)
+	{
+		VertexKernels::addOffsetScalar(dest.get(), src.get(), NumIndices, Offset);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * NumIndices);
+}
+BENCHMARK(BM_AddOffsetScalar);
+
+static void BM_AddOffset(benchmark::State &state)
+{
+	nctl::UniquePtr<unsigned short[]> src = createIndices();
+	nctl::UniquePtr<unsigned short[]> dest = nctl::makeUnique<unsigned short[]>(NumIndices);
+
+	for (auto _ : state)
+	{
+		VertexKernels::addOffset(dest.get(), src.get(), NumIndices, Offset);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * NumIndices);
+	state.SetLabel(VertexKernels::instructionSet());
+}
+BENCHMARK(BM_AddOffset);
+
+static void BM_QuadsToStripScalar(benchmark::State &state)
+{
+	nctl::UniquePtr<VertexKernels::Quad[]> quads = createQuads();
+	nctl::UniquePtr<float[]> dest = nctl::makeUnique<float[]>(NumQuads * 16);
+
+	for (auto _ : state)
+	{
+		VertexKernels::quadsToStripScalar(dest.get(), quads.get(), NumQuads);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * NumQuads);
+}
+BENCHMARK(BM_QuadsToStripScalar);
+
+static void BM_QuadsToStrip(benchmark::State &state)
+{
+	nctl::UniquePtr<VertexKernels::Quad[]> quads = createQuads();
+	nctl::UniquePtr<float[]> dest = nctl::makeUnique<float[]>(NumQuads * 16);
+
+	for (auto _ : state)
+	{
+		VertexKernels::quadsToStrip(dest.get(), quads.get(), NumQuads);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * NumQuads);
+	state.SetLabel(VertexKernels::instructionSet());
+}
+BENCHMARK(BM_QuadsToStrip);
+
+BENCHMARK_MAIN();
@@ -76,6 +76,10 @@ if(MSVC)
 		target_compile_options(ncine PRIVATE $<$<CONFIG:Release>:/Qvec-report:2 /Qpar-report:2>)
 	endif()
 
+	if(NCINE_WITH_AVX2 AND CMAKE_SIZEOF_VOID_P EQUAL 8)
+		target_compile_options(ncine PRIVATE /arch:AVX2)
+	endif()
+
 	target_compile_definitions(ncine PRIVATE "_CRT_SECURE_NO_DEPRECATE")
 	# Suppress linker warning about templates
 	target_compile_options(ncine PUBLIC "/wd4251")
@@ -91,6 +95,10 @@ else() # GCC and LLVM
 	target_compile_options(ncine PRIVATE -fno-exceptions)
 	target_compile_options(ncine PRIVATE $<$<CONFIG:Release>:-ffast-math>)
 
+	if(NCINE_WITH_AVX2 AND NOT EMSCRIPTEN AND CMAKE_SYSTEM_PROCESSOR MATCHES "x86_64|AMD64|i.86")
+		target_compile_options(ncine PRIVATE -mavx2)
+	endif()
+
 	if(NCINE_DYNAMIC_LIBRARY)
 		target_compile_options(ncine PRIVATE -fvisibility=hidden -fvisibility-inlines-hidden)
 	endif()
@@ -1,6 +1,8 @@
 if(WIN32)
 	list(APPEND HEADERS ${NCINE_ROOT}/include/ncine/common_windefines.h)
 	list(APPEND SOURCES ${NCINE_ROOT}/src/FileLoggerWindows.cpp)
+	# For `timeBeginPeriod()` used by the frame pacer
+	target_link_libraries(ncine PRIVATE winmm)
 	if(NOT MINGW)
 		list(APPEND SOURCES ${NCINE_ROOT}/src/base/WindowsAtomic.cpp)
 	else()
@@ -195,6 +197,9 @@ if(LUA_FOUND)
 	list(APPEND HEADERS
 		${NCINE_ROOT}/include/ncine/LuaTypes.h
 		${NCINE_ROOT}/include/ncine/LuaStateManager.h
+		${NCINE_ROOT}/include/ncine/LuaHandleTable.h
+		${NCINE_ROOT}/include/ncine/LuaProfiler.h
+		${NCINE_ROOT}/include/ncine/LuaBytecodeCache.h
 		${NCINE_ROOT}/include/ncine/LuaUtils.h
 		${NCINE_ROOT}/include/ncine/LuaDebug.h
 		${NCINE_ROOT}/include/ncine/LuaRectUtils.h
@@ -207,13 +212,18 @@ if(LUA_FOUND)
 	list(APPEND PRIVATE_HEADERS
 		${NCINE_ROOT}/src/include/LuaNames.h
 		${NCINE_ROOT}/src/include/LuaStatistics.h
+		${NCINE_ROOT}/src/include/LuaCallbacks.h
 	)
 
 	list(APPEND SOURCES
 		${NCINE_ROOT}/src/scripting/LuaStateManager.cpp
+		${NCINE_ROOT}/src/scripting/LuaHandleTable.cpp
+		${NCINE_ROOT}/src/scripting/LuaProfiler.cpp
 		${NCINE_ROOT}/src/scripting/LuaUtils.cpp
 		${NCINE_ROOT}/src/scripting/LuaDebug.cpp
 		${NCINE_ROOT}/src/scripting/LuaStatistics.cpp
+		${NCINE_ROOT}/src/scripting/LuaCallbacks.cpp
+		${NCINE_ROOT}/src/scripting/LuaBytecodeCache.cpp
 		${NCINE_ROOT}/src/scripting/LuaColorUtils.cpp
 	)
 
@@ -332,6 +342,10 @@ if(NCINE_WITH_ALLOCATORS)
 		${NCINE_ROOT}/include/nctl/PoolAllocator.h
 		${NCINE_ROOT}/include/nctl/FreeListAllocator.h
 		${NCINE_ROOT}/include/nctl/ProxyAllocator.h
+		${NCINE_ROOT}/include/nctl/SpinLock.h
+		${NCINE_ROOT}/include/nctl/SlabAllocator.h
+		${NCINE_ROOT}/include/nctl/ThreadCacheAllocator.h
+		${NCINE_ROOT}/include/nctl/FrameArenaAllocator.h
 	)
 
 	list(APPEND SOURCES
@@ -343,6 +357,10 @@ if(NCINE_WITH_ALLOCATORS)
 		${NCINE_ROOT}/src/base/PoolAllocator.cpp
 		${NCINE_ROOT}/src/base/FreeListAllocator.cpp
 		${NCINE_ROOT}/src/base/ProxyAllocator.cpp
+		${NCINE_ROOT}/src/base/SpinLock.cpp
+		${NCINE_ROOT}/src/base/SlabAllocator.cpp
+		${NCINE_ROOT}/src/base/ThreadCacheAllocator.cpp
+		${NCINE_ROOT}/src/base/FrameArenaAllocator.cpp
 	)
 endif()
 
@@ -359,6 +377,9 @@ if(NCINE_WITH_IMGUI)
 		${IMGUI_INCLUDE_ONLY_DIR}/ncine/imconfig.h
 	)
 
+	# The dynamic font atlas rasterises TrueType glyphs with the library vendored with Dear ImGui
+	target_include_directories(ncine PRIVATE ${IMGUI_SOURCE_DIR})
+
 	list(APPEND PRIVATE_HEADERS
 		${IMGUI_SOURCE_DIR}/imgui_internal.h
 		${IMGUI_SOURCE_DIR}/imstb_rectpack.h
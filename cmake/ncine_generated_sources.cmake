@@ -212,6 +212,9 @@ if(NCINE_WITH_ALLOCATORS)
 		file(APPEND ${CFGALLOC_H_FILE} "#define USE_FREELIST\n")
 		file(APPEND ${CFGALLOC_H_FILE} "#define FREELIST_BUFFER (${NCINE_FREELIST_BUFFER})\n")
 	endif()
+	if(NCINE_USE_THREADCACHE)
+		file(APPEND ${CFGALLOC_H_FILE} "#define USE_THREADCACHE\n")
+	endif()
 endif()
 
 if(EXISTS ${CMAKE_SOURCE_DIR}/config.h.in)
@@ -20,6 +20,7 @@ set(HEADERS
 	${NCINE_ROOT}/include/ncine/Matrix4x4.h
 	${NCINE_ROOT}/include/ncine/Quaternion.h
 	${NCINE_ROOT}/include/ncine/IIndexer.h
+	${NCINE_ROOT}/include/ncine/HandleIndexer.h
 	${NCINE_ROOT}/include/ncine/ILogger.h
 	${NCINE_ROOT}/include/ncine/IAudioDevice.h
 	${NCINE_ROOT}/include/ncine/IThreadPool.h
@@ -29,6 +30,9 @@ set(HEADERS
 	${NCINE_ROOT}/include/ncine/DisplayMode.h
 	${NCINE_ROOT}/include/ncine/TimeStamp.h
 	${NCINE_ROOT}/include/ncine/Timer.h
+	${NCINE_ROOT}/include/ncine/FramePacer.h
+	${NCINE_ROOT}/include/ncine/FrameStatistics.h
+	${NCINE_ROOT}/include/ncine/Profiler.h
 	${NCINE_ROOT}/include/ncine/Font.h
 	${NCINE_ROOT}/include/ncine/FileSystem.h
 	${NCINE_ROOT}/include/ncine/IFile.h
@@ -37,6 +41,7 @@ set(HEADERS
 	${NCINE_ROOT}/include/ncine/ITextureSaver.h
 	${NCINE_ROOT}/include/ncine/Shader.h
 	${NCINE_ROOT}/include/ncine/ShaderState.h
+	${NCINE_ROOT}/include/ncine/ShaderProgramStatus.h
 	${NCINE_ROOT}/include/ncine/SceneNode.h
 	${NCINE_ROOT}/include/ncine/BaseSprite.h
 	${NCINE_ROOT}/include/ncine/Sprite.h
@@ -49,6 +54,7 @@ set(HEADERS
 	${NCINE_ROOT}/include/ncine/ParticleSystem.h
 	${NCINE_ROOT}/include/ncine/ParticleInitializer.h
 	${NCINE_ROOT}/include/ncine/TextNode.h
+	${NCINE_ROOT}/include/ncine/VertexKernels.h
 	${NCINE_ROOT}/include/ncine/RectAnimation.h
 	${NCINE_ROOT}/include/ncine/AnimatedSprite.h
 	${NCINE_ROOT}/include/ncine/Viewport.h
@@ -84,6 +90,11 @@ set(NCTL_HEADERS
 	${NCINE_ROOT}/include/nctl/StaticHashSetIterator.h
 	${NCINE_ROOT}/include/nctl/HashSetList.h
 	${NCINE_ROOT}/include/nctl/HashSetListIterator.h
+	${NCINE_ROOT}/include/nctl/FlatHashGroup.h
+	${NCINE_ROOT}/include/nctl/FlatHashMap.h
+	${NCINE_ROOT}/include/nctl/FlatHashMapIterator.h
+	${NCINE_ROOT}/include/nctl/FlatHashSet.h
+	${NCINE_ROOT}/include/nctl/FlatHashSetIterator.h
 	${NCINE_ROOT}/include/nctl/SparseSet.h
 	${NCINE_ROOT}/include/nctl/SparseSetIterator.h
 	${NCINE_ROOT}/include/nctl/ReverseIterator.h
@@ -4,6 +4,7 @@ option(NCINE_BUILD_BENCHMARKS "Build the engine micro benchmarks" OFF)
 option(NCINE_INSTALL_DEV_SUPPORT "Install files to support development" ON)
 option(NCINE_LINKTIME_OPTIMIZATION "Compile the engine with link time optimization when in release" OFF)
 option(NCINE_AUTOVECTORIZATION_REPORT "Enable report generation from compiler auto-vectorization" OFF)
+option(NCINE_WITH_AVX2 "Compile the engine with AVX2 instructions for the vectorised kernels" OFF)
 option(NCINE_DYNAMIC_LIBRARY "Compile the engine as a dynamic library" ON)
 option(NCINE_BUILD_DOCUMENTATION "Create and install the HTML based API documentation (requires Doxygen)" OFF)
 option(NCINE_IMPLEMENTATION_DOCUMENTATION "Include implementation classes in the documentation" OFF)
@@ -61,6 +62,7 @@ if(NCINE_WITH_ALLOCATORS)
 	option(NCINE_OVERRIDE_NEW "Override global new and delete operators to use custom allocators" OFF)
 	option(NCINE_USE_FREELIST "Use the free list custom allocator instead of malloc()/free()" OFF)
 	set(NCINE_FREELIST_BUFFER "33554432" CACHE STRING "Size in bytes of the free list allocator buffer")
+	option(NCINE_USE_THREADCACHE "Use the thread-safe thread caching allocator on top of malloc()/free()" OFF)
 endif()
 
 if(NCINE_WITH_RENDERDOC)
@@ -1,8 +1,8 @@
 set(PRIVATE_HEADERS
 	${NCINE_ROOT}/src/include/common_headers.h
 	${NCINE_ROOT}/src/include/return_macros.h
+	${NCINE_ROOT}/src/include/ring_copy.h
 	${NCINE_ROOT}/src/include/Clock.h
-	${NCINE_ROOT}/src/include/ArrayIndexer.h
 	${NCINE_ROOT}/src/include/FrameTimer.h
 	${NCINE_ROOT}/src/include/MemoryFile.h
 	${NCINE_ROOT}/src/include/StandardFile.h
@@ -11,8 +11,11 @@ set(PRIVATE_HEADERS
 	${NCINE_ROOT}/src/input/JoyMappingDb.h
 	${NCINE_ROOT}/src/include/FntParser.h
 	${NCINE_ROOT}/src/include/FontGlyph.h
+	${NCINE_ROOT}/src/include/DynamicFontAtlas.h
+	${NCINE_ROOT}/src/include/GlyphRunCache.h
 	${NCINE_ROOT}/src/include/GfxCapabilities.h
 	${NCINE_ROOT}/src/include/RenderResources.h
+	${NCINE_ROOT}/src/include/ReadbackQueue.h
 	${NCINE_ROOT}/src/include/RenderCommand.h
 	${NCINE_ROOT}/src/include/RenderQueue.h
 	${NCINE_ROOT}/src/include/Material.h
@@ -31,6 +34,8 @@ set(PRIVATE_HEADERS
 	${NCINE_ROOT}/src/include/GLRenderbuffer.h
 	${NCINE_ROOT}/src/include/GLShader.h
 	${NCINE_ROOT}/src/include/GLShaderProgram.h
+	${NCINE_ROOT}/src/include/GLShaderProgramQueue.h
+	${NCINE_ROOT}/src/include/BinaryShaderCache.h
 	${NCINE_ROOT}/src/include/GLShaderUniforms.h
 	${NCINE_ROOT}/src/include/GLUniform.h
 	${NCINE_ROOT}/src/include/GLUniformCache.h
@@ -8,13 +8,18 @@ set(SOURCES
 	${NCINE_ROOT}/src/base/Clock.cpp
 	${NCINE_ROOT}/src/ServiceLocator.cpp
 	${NCINE_ROOT}/src/FileLogger.cpp
-	${NCINE_ROOT}/src/ArrayIndexer.cpp
+	${NCINE_ROOT}/src/HandleIndexer.cpp
 	${NCINE_ROOT}/src/TimeStamp.cpp
 	${NCINE_ROOT}/src/Timer.cpp
 	${NCINE_ROOT}/src/FrameTimer.cpp
+	${NCINE_ROOT}/src/FramePacer.cpp
+	${NCINE_ROOT}/src/FrameStatistics.cpp
+	${NCINE_ROOT}/src/Profiler.cpp
 	${NCINE_ROOT}/src/Font.cpp
 	${NCINE_ROOT}/src/FntParser.cpp
 	${NCINE_ROOT}/src/FontGlyph.cpp
+	${NCINE_ROOT}/src/graphics/DynamicFontAtlas.cpp
+	${NCINE_ROOT}/src/graphics/GlyphRunCache.cpp
 	${NCINE_ROOT}/src/FileSystem.cpp
 	${NCINE_ROOT}/src/IFile.cpp
 	${NCINE_ROOT}/src/MemoryFile.cpp
@@ -27,6 +32,7 @@ set(SOURCES
 	${NCINE_ROOT}/src/graphics/IGfxDevice.cpp
 	${NCINE_ROOT}/src/graphics/GfxCapabilities.cpp
 	${NCINE_ROOT}/src/graphics/RenderResources.cpp
+	${NCINE_ROOT}/src/graphics/ReadbackQueue.cpp
 	${NCINE_ROOT}/src/graphics/RenderCommand.cpp
 	${NCINE_ROOT}/src/graphics/RenderQueue.cpp
 	${NCINE_ROOT}/src/graphics/Material.cpp
@@ -60,6 +66,9 @@ set(SOURCES
 	${NCINE_ROOT}/src/graphics/opengl/GLRenderbuffer.cpp
 	${NCINE_ROOT}/src/graphics/opengl/GLShader.cpp
 	${NCINE_ROOT}/src/graphics/opengl/GLShaderProgram.cpp
+	${NCINE_ROOT}/src/graphics/opengl/GLShaderProgramQueue.cpp
+	${NCINE_ROOT}/src/graphics/ShaderProgramStatus.cpp
+	${NCINE_ROOT}/src/graphics/opengl/BinaryShaderCache.cpp
 	${NCINE_ROOT}/src/graphics/opengl/GLShaderUniforms.cpp
 	${NCINE_ROOT}/src/graphics/opengl/GLUniform.cpp
 	${NCINE_ROOT}/src/graphics/opengl/GLUniformCache.cpp
@@ -77,6 +86,7 @@ set(SOURCES
 	${NCINE_ROOT}/src/graphics/opengl/GLViewport.cpp
 	${NCINE_ROOT}/src/graphics/RenderBuffersManager.cpp
 	${NCINE_ROOT}/src/graphics/RenderBatcher.cpp
+	${NCINE_ROOT}/src/graphics/VertexKernels.cpp
 	${NCINE_ROOT}/src/graphics/opengl/GLDebug.cpp
 	${NCINE_ROOT}/src/graphics/RenderStatistics.cpp
 	${NCINE_ROOT}/src/graphics/opengl/GLVertexFormat.cpp
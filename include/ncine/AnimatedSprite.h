@@ -71,6 +71,10 @@ class DLL_PUBLIC AnimatedSprite : public Sprite
 
 	inline static ObjectType sType() { return ObjectType::ANIMATED_SPRITE; }
 
+#if NCINE_WITH_ALLOCATORS
+	NCTL_DECLARE_SLAB_ALLOCATED()
+#endif
+
   protected:
 	/// Protected copy constructor used to clone objects
 	AnimatedSprite(const AnimatedSprite &other);
@@ -24,6 +24,13 @@ class DLL_PUBLIC AppConfiguration
 	ILogger::LogLevel fileLogLevel;
 	/// The interval for frame timer accumulation average and log
 	float frameTimerLogInterval;
+	/// The number of most recent frames recorded by the frame statistics, or 0 to disable recording
+	unsigned int frameStatisticsSize;
+	/// The name of the file in the save path where frame statistics are saved on shutdown, or empty to not save them
+	/*! \note The summary of every stage is saved if the extension is ".json", otherwise every recorded frame is saved as CSV */
+	nctl::String frameStatisticsFile;
+	/// The name of the file in the save path where the zones recorded by the profiler are saved on shutdown, or empty to not save them
+	nctl::String profilerTraceFile;
 
 	/// The screen resolution
 	/*! \note If either `x` or `y` are zero then the screen resolution will not be changed. */
@@ -34,6 +41,13 @@ class DLL_PUBLIC AppConfiguration
 	bool isResizable;
 	/// The maximum number of frames to render per second or 0 for no limit
 	unsigned int frameLimit;
+	/// The time step in seconds of the scenegraph updates or 0 to update once per frame
+	/*! \note When set, nodes are updated as many times as needed to catch up with the elapsed time and
+	 *  their rendered transformation is interpolated between the last two updates. */
+	float fixedTimeStep;
+	/// The maximum number of fixed time step updates in a single frame
+	/*! \note The time that cannot be simulated with this number of updates is dropped */
+	unsigned int maxFixedUpdates;
 
 	/// The window title
 	nctl::String windowTitle;
@@ -43,8 +57,12 @@ class DLL_PUBLIC AppConfiguration
 	/// The flag is `true` if mapping is used to update OpenGL buffers
 	bool useBufferMapping;
 	/// The flag is `true` when error checking and introspection of shader programs are deferred to first use
-	/*! \note The value is only taken into account when the scenegraph is being used */
+	/*! \note When deferred, programs are compiled and linked in parallel if the driver supports `GL_KHR_parallel_shader_compile`.
+	The loading functions of the `Shader` class cannot report compilation and linking errors, which are logged on first use. */
 	bool deferShaderQueries;
+	/// The flag is `true` if linked shader program binaries are saved in the save path and loaded on the next run
+	/*! \note The cache is not used if the driver does not support any program binary format */
+	bool useBinaryShaderCache;
 	/// Fixed size of render commands to be collected for batching on Emscripten and ANGLE
 	/*! \note Increasing this value too much might negatively affect batching shaders compilation time.
 	A value of zero restores the default behavior of non fixed size for batches. */
@@ -57,9 +75,15 @@ class DLL_PUBLIC AppConfiguration
 	unsigned int vaoPoolSize;
 	/// The initial size for the pool of render commands
 	unsigned int renderCommandPoolSize;
+	/// The size in bytes of each of the two buffers of the frame arena allocator
+	/*! \note The value is only taken into account when the custom memory allocators are enabled */
+	unsigned long frameArenaSize;
 
 	/// The flag is `true` if the debug overlay is enabled
 	bool withDebugOverlay;
+	/// The flag is `true` if the built-in profiler records zones from the start
+	/*! \note The profiler is not available when the Tracy integration is enabled */
+	bool withProfiler;
 	/// The flag is `true` if the audio subsystem is enabled
 	bool withAudio;
 	/// The flag is `true` if the threading subsystem is enabled
@@ -5,11 +5,19 @@
 #include "AppConfiguration.h"
 #include "IDebugOverlay.h"
 #include "TimeStamp.h"
+#include "Texture.h"
 #include <nctl/UniquePtr.h>
 
+namespace nctl {
+class IAllocator;
+class FrameArenaAllocator;
+}
+
 namespace ncine {
 
 class FrameTimer;
+class FramePacer;
+class FrameStatistics;
 class SceneNode;
 class Viewport;
 class ScreenViewport;
@@ -26,13 +34,15 @@ class DLL_PUBLIC Application
 	struct RenderingSettings
 	{
 		RenderingSettings()
-		    : batchingEnabled(true), batchingWithIndices(false),
+		    : batchingEnabled(true), batchingWithIndices(false), parallelBatching(true),
 		      cullingEnabled(true), minBatchSize(4), maxBatchSize(500) {}
 
 		/// True if batching is enabled
 		bool batchingEnabled;
 		/// True if using indices for vertex batching
 		bool batchingWithIndices;
+		/// True if batches are filled in parallel by the thread pool, when there are enough of them
+		bool parallelBatching;
 		/// True if node culling is enabled
 		bool cullingEnabled;
 		/// Minimum size for a batch to be collected
@@ -93,6 +103,10 @@ class DLL_PUBLIC Application
 
 	/// Returns all timings
 	inline const float *timings() const { return timings_; }
+	/// Returns the frame pacer that limits the frame rate when `AppConfiguration::frameLimit` is set
+	inline FramePacer &framePacer() { return *framePacer_; }
+	/// Returns the frame statistics that record the duration of the stages of the most recent frames
+	inline FrameStatistics &frameStatistics() { return *frameStatistics_; }
 
 	/// Returns the graphics device instance
 	inline IGfxDevice &gfxDevice() { return *gfxDevice_; }
@@ -100,13 +114,30 @@ class DLL_PUBLIC Application
 	inline SceneNode &rootNode() { return *rootNode_; }
 	/// Returns the screen viewport
 	Viewport &screenViewport();
+	/// Reads back the pixels of the screen without stalling, the callback is invoked a few frames later
+	/*! \note To capture a complete frame it should be called from `IAppEventHandler::onFrameEnd()` */
+	bool readScreenAsync(Texture::ReadbackCallback callback, void *userData);
+	/// Reads back the pixels of the screen without stalling and saves them to a PNG or WebP file on a worker thread
+	/*! \note To capture a complete frame it should be called from `IAppEventHandler::onFrameEnd()` */
+	bool saveScreenToFileAsync(const char *filename);
 	/// Returns the input manager instance
 	inline IInputManager &inputManager() { return *inputManager_; }
+#if NCINE_WITH_ALLOCATORS
+	/// Returns the allocator for temporary data that only needs to live until the end of the next frame
+	/*! \note It falls back to the default allocator if the frame arena size is zero */
+	nctl::IAllocator &frameAllocator();
+#endif
 
 	/// Returns the total number of frames already rendered
 	unsigned long int numFrames() const;
 	/// Returns the elapsed time since the end of the previous frame in seconds
 	float interval() const;
+	/// Returns true if the scenegraph is updated with the fixed time step of `AppConfiguration::fixedTimeStep`
+	inline bool hasFixedTimeStep() const { return appCfg_.fixedTimeStep > 0.0f; }
+	/// Returns the total number of fixed time step updates already performed
+	inline unsigned long int numFixedUpdates() const { return numFixedUpdates_; }
+	/// Returns the fraction of a fixed time step elapsed since the last update, used to interpolate the rendered transformations
+	inline float interpolationFactor() const { return interpolationFactor_; }
 
 	/// Returns the screen width as a float number
 	inline float width() const { return static_cast<float>(gfxDevice_->width()); }
@@ -157,7 +188,13 @@ class DLL_PUBLIC Application
 	IDebugOverlay::DisplaySettings debugOverlayNullSettings_;
 
 	TimeStamp profileStartTime_;
+	/// The elapsed time not yet simulated by fixed time step updates
+	float fixedUpdateTime_;
+	unsigned long int numFixedUpdates_;
+	float interpolationFactor_;
 	nctl::UniquePtr<FrameTimer> frameTimer_;
+	nctl::UniquePtr<FramePacer> framePacer_;
+	nctl::UniquePtr<FrameStatistics> frameStatistics_;
 	nctl::UniquePtr<IGfxDevice> gfxDevice_;
 	nctl::UniquePtr<SceneNode> rootNode_;
 	nctl::UniquePtr<ScreenViewport> screenViewport_;
@@ -170,6 +207,9 @@ class DLL_PUBLIC Application
 #ifdef WITH_NUKLEAR
 	nctl::UniquePtr<NuklearDrawing> nuklearDrawing_;
 #endif
+#if NCINE_WITH_ALLOCATORS
+	nctl::UniquePtr<nctl::FrameArenaAllocator> frameArena_;
+#endif
 
 	Application();
 	~Application();
@@ -196,6 +236,10 @@ class DLL_PUBLIC Application
 	Application &operator=(const Application &) = delete;
 
 	bool shouldSuspend();
+	/// Updates the scenegraph as many times as needed to catch up with the elapsed time
+	void fixedUpdate();
+	/// Records the timings of the last frame in the frame statistics
+	void addFrameStatistics();
 
 	friend class PCApplication;
 	friend class AndroidApplication;
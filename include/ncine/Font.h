@@ -3,13 +3,15 @@
 
 #include "Object.h"
 #include "Vector2.h"
-#include <nctl/HashMap.h>
+#include <nctl/Array.h>
+#include <nctl/FlatHashMap.h>
 
 namespace ncine {
 
 class FntParser;
 class FontGlyph;
 class Texture;
+class DynamicFontAtlas;
 
 /// A class holding every information needed to correctly render text
 class DLL_PUBLIC Font : public Object
@@ -55,11 +57,30 @@ class DLL_PUBLIC Font : public Object
 	bool loadFromFile(const char *fntFilename, const char *texFilename);
 	bool loadFromFile(const char *fntFilename, Texture *texture);
 
+	/// Loads only the glyph metrics and the kerning pairs from an AngelCode's `FNT` memory buffer
+	/*! \note The font has no texture, it can measure text with `TextNode::calculateBoundaries()` but it cannot render it */
+	bool loadMetricsFromMemory(const char *fntBufferName, const unsigned char *fntBufferPtr, unsigned long int fntBufferSize);
+
+	/// Default side in pixels of the square texture atlas of a TrueType font
+	static const unsigned int DefaultTtfAtlasSize = 1024;
+	/// Loads a TrueType font from a memory buffer, its glyphs will be rasterised at the specified height when first needed
+	bool loadFromTtfMemory(const char *ttfBufferName, const unsigned char *ttfBufferPtr, unsigned long int ttfBufferSize, unsigned int pixelHeight);
+	/// Loads a TrueType font from a memory buffer, specifying the side of its texture atlas
+	bool loadFromTtfMemory(const char *ttfBufferName, const unsigned char *ttfBufferPtr, unsigned long int ttfBufferSize, unsigned int pixelHeight, unsigned int atlasSize);
+	/// Loads a TrueType font from a file, its glyphs will be rasterised at the specified height when first needed
+	bool loadFromTtfFile(const char *ttfFilename, unsigned int pixelHeight);
+	/// Loads a TrueType font from a file, specifying the side of its texture atlas
+	bool loadFromTtfFile(const char *ttfFilename, unsigned int pixelHeight, unsigned int atlasSize);
+
+	/// Returns true if the glyphs are rasterised at run-time in a texture atlas of fixed size
+	inline bool isDynamic() const { return dynamicAtlas_ != nullptr; }
+
 	/// Returns the constant texture object in use by the font
 	inline const Texture *texture() const { return (texture_ != nullptr) ? texture_.get() : texturePtr_; }
 	/// Returns the texture object in use by the font
 	inline Texture *texture() { return (texture_ != nullptr) ? texture_.get() : texturePtr_; }
 	/// Sets a new shared texture object without modifying any glyphs or kerning data
+	/*! \note It fails for a dynamic font, as its glyphs are stored in the texture atlas */
 	bool setTexture(Texture *texture);
 
 	/// Returns font line height
@@ -73,7 +94,10 @@ class DLL_PUBLIC Font : public Object
 	/// Returns number of kerning pairs
 	inline unsigned int numKernings() const { return numKernings_; }
 	/// Returns a constant pointer to a glyph
+	/*! \note The glyph of a dynamic font is rasterised if it is not in the atlas, the pointer is valid until the next request */
 	const FontGlyph *glyph(unsigned int glyphId) const;
+	/// Returns the kerning amount between two glyphs
+	int kerning(unsigned int firstGlyphId, unsigned int secondGlyphId) const;
 
 	inline RenderMode renderMode() const { return renderMode_; }
 
@@ -97,17 +121,28 @@ class DLL_PUBLIC Font : public Object
 	/// Number of kernings for this font
 	unsigned int numKernings_;
 
-	/// Maximum number of font glyphs stored in the array (single byte UTF-8 characters)
-	static const unsigned int GlyphArraySize = 256;
-	/// Array of font glyphs encoded in a single UTF-8 code unit
-	nctl::UniquePtr<FontGlyph[]> glyphArray_;
-	/// Maximum number of font glyphs stored in the hashmap (multi-byte UTF-8 characters)
-	static const unsigned int GlyphHashmapSize = 1024;
-	/// Hashmap of font glyphs encoded in more than one UTF-8 code unit
-	nctl::HashMap<unsigned short int, FontGlyph> glyphHashMap_;
+	/// Number of consecutive codepoints mapped by a page of the glyph table
+	static const unsigned int GlyphPageSize = 256;
+	/// The value of an empty entry in the glyph table
+	static const unsigned short int InvalidGlyphIndex = 0xFFFF;
+	/// Initial capacity of the kerning pairs hashmap
+	static const unsigned int KerningHashmapSize = 16;
+	/// Font glyphs stored contiguously, in the order they are loaded
+	nctl::Array<FontGlyph> glyphs_;
+	/// First level of the glyph table, it maps the high bits of a codepoint to a page of the second level
+	nctl::Array<unsigned short int> glyphPages_;
+	/// Second level of the glyph table, its pages map the low bits of a codepoint to the index of a glyph
+	nctl::Array<unsigned short int> glyphIndices_;
+	/// Kerning amounts of glyph pairs, keyed by the first codepoint in the high 32 bits and the second one in the low 32 bits
+	nctl::FlatHashMap<uint64_t, int> kernings_;
 
 	RenderMode renderMode_;
 
+	/// The texture atlas of a dynamic font, it is updated when glyphs are requested
+	mutable nctl::UniquePtr<DynamicFontAtlas> dynamicAtlas_;
+	/// Incremented every time the font loads new glyph data, it invalidates the glyph runs laid out before
+	unsigned int generation_;
+
 	/// Deleted copy constructor
 	Font(const Font &) = delete;
 	/// Deleted assignment operator
@@ -123,6 +158,14 @@ class DLL_PUBLIC Font : public Object
 	void determineRenderMode(const FntParser &fntParser);
 	/// Retrieves font information from the FNT parser
 	void retrieveInfoFromFnt(const FntParser &fntParser);
+	/// Destroys the texture atlas when a font with prebaked glyphs is loaded
+	void releaseDynamicAtlas();
+	/// Retrieves font information from the dynamic atlas
+	void retrieveInfoFromAtlas();
+
+	/// Glyph runs lay out glyphs and keep the atlas shelves they use from being evicted
+	friend class GlyphRun;
+	friend class GlyphRunCache;
 };
 
 }
@@ -0,0 +1,109 @@
+#ifndef CLASS_NCINE_FRAMEPACER
+#define CLASS_NCINE_FRAMEPACER
+
+#include <cstdint>
+#include "common_defines.h"
+
+namespace ncine {
+
+/// A class to limit the frame rate without busy waiting
+/*! The pacer sleeps until shortly before the frame deadline and only yields the thread for the remaining time.
+ *  Deadlines are advanced by a fixed period, so that the long-run frame rate is exact even if single frames are late.
+ *  If allowed, the pacer slips to a fraction of the target rate when deadlines are missed for a sustained time. */
+class DLL_PUBLIC FramePacer
+{
+  public:
+	/// Number of consecutive frames missing the deadline before slipping, or fitting in a shorter period before recovering
+	static const unsigned int SlipFrames = 60;
+	/// Maximum divisor of the target frame rate when slipping
+	static const unsigned int MaxSlipDivisor = 4;
+
+	/// The interface used by the pacer to read the time and to sleep
+	/*! The default source uses the system clock, a custom one allows to test the pacer deterministically. */
+	class TimeSource
+	{
+	  public:
+		virtual ~TimeSource() {}
+
+		/// Returns the current value of the counter, in ticks
+		virtual uint64_t counter() const = 0;
+		/// Returns the number of ticks per second
+		virtual uint32_t frequency() const = 0;
+		/// Puts the current thread to sleep for the specified number of seconds, zero only yields it
+		virtual void sleep(float seconds) = 0;
+	};
+
+	/// Creates a disabled pacer
+	FramePacer();
+	/// Creates a pacer with the specified target frame rate
+	explicit FramePacer(unsigned int frameRate);
+	/// Creates a pacer with the specified target frame rate that reads the time from a custom source
+	/*! \note The source must outlive the pacer */
+	FramePacer(unsigned int frameRate, TimeSource &timeSource);
+	~FramePacer();
+
+	/// Returns the target frame rate, or zero if pacing is disabled
+	inline unsigned int frameRate() const { return frameRate_; }
+	/// Sets the target frame rate, zero disables pacing
+	void setFrameRate(unsigned int frameRate);
+
+	/// Returns true if the pacer can slip to a lower rate under sustained overload
+	inline bool canSlip() const { return canSlip_; }
+	/// Sets the flag that allows the pacer to slip to a lower rate under sustained overload
+	void setCanSlip(bool canSlip);
+	/// Returns the divisor applied to the target frame rate, greater than one when slipping
+	inline unsigned int slipDivisor() const { return slipDivisor_; }
+	/// Returns the frame rate that is currently being paced
+	inline float pacedFrameRate() const { return static_cast<float>(frameRate_) / static_cast<float>(slipDivisor_); }
+
+	/// Returns the interval in seconds before the deadline in which the thread is yielded instead of put to sleep
+	/*! \note The interval adapts to the measured oversleep of the system */
+	float spinInterval() const;
+	/// Returns the total number of frames that have missed their deadline
+	inline unsigned long int numMissedFrames() const { return numMissedFrames_; }
+
+	/// Waits until the deadline of the current frame and schedules the next one
+	/*! \return The number of seconds spent waiting */
+	float wait();
+	/// Restarts pacing from now, discarding accumulated drift, as after a suspension
+	void reset();
+
+  private:
+	TimeSource &timeSource_;
+	unsigned int frameRate_;
+	bool canSlip_;
+	unsigned int slipDivisor_;
+
+	/// Duration of a frame at the target rate, in clock ticks
+	uint64_t periodTicks_;
+	/// Clock counter of the next deadline, zero when pacing has to be restarted
+	uint64_t nextDeadline_;
+	/// Clock counter at the end of the last wait
+	uint64_t lastWakeUp_;
+	/// Ticks before the deadline in which the thread only yields
+	uint64_t spinTicks_;
+
+	/// Consecutive frames that have missed the deadline
+	unsigned int numLateFrames_;
+	/// Consecutive frames that would have fitted in a shorter slipped period
+	unsigned int numEarlyFrames_;
+	unsigned long int numMissedFrames_;
+	/// True if the resolution of the system timer has been raised while pacing is active
+	bool hasRaisedTimerResolution_;
+
+	/// Deleted copy constructor
+	FramePacer(const FramePacer &) = delete;
+	/// Deleted assignment operator
+	FramePacer &operator=(const FramePacer &) = delete;
+
+	/// Converts a duration in seconds to ticks of the time source
+	uint64_t secondsToTicks(float seconds) const;
+	void updateSlip(uint64_t now);
+	void sleepUntilDeadline();
+	/// Raises the resolution of the system timer when pacing is enabled and restores it when disabled
+	void updateTimerResolution();
+};
+
+}
+
+#endif
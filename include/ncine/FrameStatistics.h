@@ -0,0 +1,120 @@
+#ifndef CLASS_NCINE_FRAMESTATISTICS
+#define CLASS_NCINE_FRAMESTATISTICS
+
+#include "common_defines.h"
+#include <nctl/Atomic.h>
+#include <nctl/UniquePtr.h>
+
+namespace ncine {
+
+/// A class that records the duration of every frame and of its stages to compute statistics
+/*! Frames are written in a ring that keeps the most recent ones. There is a single writer, the main thread,
+ *  while readers can compute statistics or save the recorded frames at any time without locking. */
+class DLL_PUBLIC FrameStatistics
+{
+  public:
+	/// The frame stages that are recorded
+	struct Stages
+	{
+		enum
+		{
+			FRAME,
+			FRAME_START,
+			UPDATE,
+			POST_UPDATE,
+			VISIT,
+			DRAW,
+			IMGUI,
+			NUKLEAR,
+			FRAME_END,
+
+			COUNT
+		};
+	};
+
+	/// The statistics of a single stage over the recorded frames, in seconds
+	struct StageSummary
+	{
+		float mean = 0.0f;
+		float p50 = 0.0f;
+		float p95 = 0.0f;
+		float p99 = 0.0f;
+		float max = 0.0f;
+	};
+
+	/// The statistics of all stages over the recorded frames
+	struct Summary
+	{
+		/// Number of frames the statistics have been computed on
+		unsigned int numFrames = 0;
+		/// Number of frames longer than the hitch factor times the median frame duration
+		unsigned int numHitches = 0;
+		StageSummary stages[Stages::COUNT];
+	};
+
+	/// The file formats for saving statistics
+	enum class Format
+	{
+		/// One line per recorded frame with the duration of every stage
+		CSV,
+		/// The summary of every stage
+		JSON
+	};
+
+	/// The default factor of the median frame duration over which a frame is considered a hitch
+	static const float DefaultHitchFactor;
+
+	/// Creates a ring that can record the specified number of frames, zero disables recording
+	explicit FrameStatistics(unsigned int capacity);
+
+	/// Returns the maximum number of recorded frames
+	inline unsigned int capacity() const { return capacity_; }
+	/// Returns the total number of frames added since the creation or the last reset
+	unsigned long int numFrames() const;
+	/// Returns the number of frames currently in the ring
+	unsigned int numRecordedFrames() const;
+
+	/// Returns the factor of the median frame duration over which a frame is considered a hitch
+	inline float hitchFactor() const { return hitchFactor_; }
+	/// Sets the factor of the median frame duration over which a frame is considered a hitch
+	inline void setHitchFactor(float hitchFactor) { hitchFactor_ = hitchFactor; }
+
+	/// Records the durations in seconds of the stages of a frame
+	void addFrame(const float stageTimes[Stages::COUNT]);
+	/// Discards all recorded frames
+	void reset();
+
+	/// Computes the statistics of every stage over the recorded frames
+	void computeSummary(Summary &summary) const;
+	/// Saves the recorded frames or their summary in a file in the save path
+	bool save(const char *filename, Format format) const;
+
+	/// Returns the name of a stage, as used in the saved files
+	static const char *stageName(unsigned int stage);
+	/// Returns the format associated to the extension of the filename, JSON for ".json" and CSV otherwise
+	static Format formatFromExtension(const char *filename);
+
+  private:
+	struct Sample
+	{
+		float stageTimes[Stages::COUNT];
+	};
+
+	unsigned int capacity_;
+	float hitchFactor_;
+	nctl::UniquePtr<Sample[]> samples_;
+	/// The total number of added frames, the next sample is written at this index modulo the capacity
+	mutable nctl::Atomic64 writeIndex_;
+
+	/// Copies the most recent samples that have not been overwritten while copying, returns their number
+	unsigned int copySamples(Sample *dest, unsigned long int &firstFrame) const;
+
+	/// Deleted copy constructor
+	FrameStatistics(const FrameStatistics &) = delete;
+	/// Deleted assignment operator
+	FrameStatistics &operator=(const FrameStatistics &) = delete;
+};
+
+}
+
+#endif
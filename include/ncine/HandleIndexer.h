@@ -0,0 +1,74 @@
+#ifndef CLASS_NCINE_HANDLEINDEXER
+#define CLASS_NCINE_HANDLEINDEXER
+
+#include "IIndexer.h"
+#include <nctl/Array.h>
+
+namespace ncine {
+
+/// Keeps track of allocated objects in a slot map with generation-checked handles
+/*! An object id packs a slot index in the lower bits and the slot generation in the upper ones.
+ *  Slots of removed objects are recycled through a free list and their generation is incremented,
+ *  so that the memory is bounded by the peak number of objects and stale ids are rejected. */
+class DLL_PUBLIC HandleIndexer : public IIndexer
+{
+  public:
+	/// Number of bits of an id used for the slot index
+	static const unsigned int IndexBits = 22;
+	/// Number of bits of an id used for the slot generation
+	static const unsigned int GenerationBits = 32 - IndexBits;
+	/// Maximum number of objects that can be indexed at the same time
+	static const unsigned int MaxObjects = (1U << IndexBits) - 1;
+
+	HandleIndexer();
+	~HandleIndexer() override;
+
+	unsigned int addObject(Object *object) override;
+	bool removeObject(unsigned int id) override;
+
+	Object *object(unsigned int id) const override;
+	bool setObject(unsigned int id, Object *object) override;
+
+	bool isEmpty() const override { return numObjects_ == 0; }
+	unsigned int size() const override { return numObjects_; }
+
+	/// Returns the number of allocated slots, including the free ones
+	inline unsigned int numSlots() const { return slots_.size(); }
+	/// Returns the number of slots that are available for reuse
+	inline unsigned int numFreeSlots() const { return numFreeSlots_; }
+
+	/// Returns the slot index part of an id
+	static inline unsigned int index(unsigned int id) { return id & MaxObjects; }
+	/// Returns the generation part of an id
+	static inline unsigned int generation(unsigned int id) { return id >> IndexBits; }
+
+	void logReport() const override;
+
+  private:
+	/// A slot of the map, the next free slot index is only meaningful when the object is `nullptr`
+	struct Slot
+	{
+		Object *object;
+		unsigned int generation;
+		unsigned int nextFree;
+	};
+
+	unsigned int numObjects_;
+	unsigned int numFreeSlots_;
+	/// The free list is a FIFO queue to spread generation increments among slots
+	unsigned int freeListHead_;
+	unsigned int freeListTail_;
+	nctl::Array<Slot> slots_;
+
+	/// Deleted copy constructor
+	HandleIndexer(const HandleIndexer &) = delete;
+	/// Deleted assignment operator
+	HandleIndexer &operator=(const HandleIndexer &) = delete;
+
+	/// Returns the slot pointed by a valid id or `nullptr`
+	const Slot *validSlot(unsigned int id) const;
+};
+
+}
+
+#endif
@@ -23,6 +23,9 @@ class DLL_PUBLIC IAppEventHandler
 	virtual void onInit() {}
 	/// Called at the start of each frame
 	virtual void onFrameStart() {}
+	/// Called before every scenegraph update when `AppConfiguration::fixedTimeStep` is set
+	/*! \note It can be called multiple times per frame, or not at all, depending on the elapsed time */
+	virtual void onFixedUpdate(float timeStep) {}
 	/// Called every time the scenegraph has been traversed and all nodes have been transformed
 	virtual void onPostUpdate() {}
 	/// Called every time a viewport is going to be drawn
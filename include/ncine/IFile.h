@@ -57,6 +57,9 @@ class DLL_PUBLIC IFile
 	/// Writes a certain amount of bytes from a buffer to the file
 	/*! \return Number of bytes written */
 	virtual unsigned long int write(void *buffer, unsigned long int bytes) = 0;
+	/// Writes the characters of a string, without the terminating one
+	/*! \return True if all the characters have been written */
+	bool writeString(const nctl::String &string);
 
 	/// Sets the close on destruction flag
 	/*! If the flag is true the file is closed upon object destruction. */
@@ -15,6 +15,8 @@ class DLL_PUBLIC IThreadPool
 
 	/// Enqueues a command request for a worker thread
 	virtual void enqueueCommand(nctl::UniquePtr<IThreadCommand> threadCommand) = 0;
+	/// Returns the number of worker threads, zero if enqueued commands are never executed
+	virtual unsigned int numThreads() const = 0;
 };
 
 inline IThreadPool::~IThreadPool() {}
@@ -24,6 +26,7 @@ class DLL_PUBLIC NullThreadPool : public IThreadPool
 {
   public:
 	void enqueueCommand(nctl::UniquePtr<IThreadCommand> threadCommand) override {}
+	unsigned int numThreads() const override { return 0; }
 };
 
 }
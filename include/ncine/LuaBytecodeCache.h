@@ -0,0 +1,77 @@
+#ifndef CLASS_NCINE_LUABYTECODECACHE
+#define CLASS_NCINE_LUABYTECODECACHE
+
+#include <cstdint> // for uint64_t
+#include "common_defines.h"
+#include <nctl/String.h>
+
+struct lua_State;
+
+namespace ncine {
+
+/// A class that stores compiled Lua chunks on disk to avoid parsing their source again
+/*! Chunks are retrieved with `lua_dump()` and stored in the save path, in a file named after the chunk name.
+ *  The file header stores a hash of the chunk name, of the source and of the Lua release, so that a changed
+ *  script overwrites its own file. A cached chunk is ignored and deleted if Lua rejects it, the source is then
+ *  compiled as usual. */
+class DLL_PUBLIC LuaBytecodeCache
+{
+  public:
+	/// Cache usage statistics since the cache has been created
+	struct Statistics
+	{
+		/// Number of chunks loaded from the cache
+		unsigned int loaded = 0;
+		/// Number of chunks that were not found in the cache
+		unsigned int missed = 0;
+		/// Number of cached chunks rejected by Lua or by the header checks
+		unsigned int rejected = 0;
+		/// Number of chunks saved in the cache
+		unsigned int saved = 0;
+	};
+
+	LuaBytecodeCache();
+
+	/// Returns true if the cache directory is available
+	inline bool isAvailable() const { return isAvailable_; }
+	/// Returns the directory where the compiled chunks are stored
+	inline const nctl::String &directory() const { return directory_; }
+	/// Returns the cache usage statistics
+	inline const Statistics &statistics() const { return statistics_; }
+
+	/// Hashes the name and the source of a chunk together with the Lua release
+	static uint64_t hash(const char *chunkName, const char *source, unsigned long int length);
+
+	/// Tries to load the compiled chunk on top of the stack, returns true if it is cached with the same hash
+	bool loadFromCache(lua_State *L, uint64_t hash, const char *chunkName);
+	/// Dumps the compiled chunk on top of the stack and saves it in the cache, replacing a previous version
+	bool saveToCache(lua_State *L, uint64_t hash, const char *chunkName);
+	/// Deletes all compiled chunks from the cache, returns the number of deleted files
+	unsigned int clear();
+
+  private:
+	/// The header written at the beginning of every cached chunk file
+	struct Header
+	{
+		uint32_t signature;
+		uint32_t version;
+		uint64_t hash;
+		uint32_t length;
+		uint32_t padding;
+	};
+
+	bool isAvailable_;
+	nctl::String directory_;
+	Statistics statistics_;
+
+	nctl::String filename(const char *chunkName) const;
+
+	/// Deleted copy constructor
+	LuaBytecodeCache(const LuaBytecodeCache &) = delete;
+	/// Deleted assignment operator
+	LuaBytecodeCache &operator=(const LuaBytecodeCache &) = delete;
+};
+
+}
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef CLASS_NCINE_LUAHANDLETABLE
+#define CLASS_NCINE_LUAHANDLETABLE
+
+#include <cstdint>
+#include "common_defines.h"
+#include <nctl/Array.h>
+#include <nctl/HashMap.h>
+#include "LuaTypes.h"
+
+namespace ncine {
+
+/// Keeps track of the C++ objects exposed to Lua in a slot map with type-checked handles
+/*! A handle packs a slot index in the lower bits, the type of the object in the middle ones and the slot generation in the upper ones.
+ *  Scripts receive handles instead of raw pointers, so that validating one only requires a bounds check and a comparison.
+ *  The number of objects of every type tracked by Lua is kept up to date when objects are added and removed. */
+class DLL_PUBLIC LuaHandleTable
+{
+  public:
+	using Handle = uint32_t;
+
+	/// Number of bits of a handle used for the slot index
+	static const unsigned int IndexBits = 20;
+	/// Number of bits of a handle used for the object type
+	static const unsigned int TypeBits = 5;
+	/// Number of bits of a handle used for the slot generation
+	static const unsigned int GenerationBits = 32 - IndexBits - TypeBits;
+	/// Maximum number of objects that can be exposed to Lua at the same time
+	static const unsigned int MaxObjects = (1U << IndexBits) - 1;
+	/// A handle that is never valid
+	static const Handle InvalidHandle = 0;
+
+	/// Whether an object is owned by Lua or by the engine
+	enum class Tracking
+	{
+		/// The object has been created by a script and will be destroyed with the Lua state if not deleted before
+		TRACKED,
+		/// The object is owned by the engine and is only referenced by scripts
+		UNTRACKED
+	};
+
+	explicit LuaHandleTable(unsigned int capacity);
+
+	/// Returns the handle of an object, adding the object to the table if it is not already there
+	Handle add(void *object, LuaTypes::UserDataType type, Tracking tracking);
+	/// Invalidates a handle and removes its object from the table
+	bool remove(Handle handle);
+	/// Removes all the untracked objects, invalidating their handles
+	void removeUntracked();
+
+	/// Returns the object of a valid handle and its type, or `nullptr`
+	inline void *object(Handle handle, LuaTypes::UserDataType &type) const
+	{
+		const unsigned int slotIndex = index(handle);
+		if (slotIndex < slots_.size() && slots_[slotIndex].handle == handle && handle != InvalidHandle)
+		{
+			type = LuaTypes::UserDataType(handle >> IndexBits & ((1U << TypeBits) - 1));
+			return slots_[slotIndex].object;
+		}
+
+		type = LuaTypes::UNKNOWN;
+		return nullptr;
+	}
+	/// Returns true if the handle is valid and its object is tracked
+	inline bool isTracked(Handle handle) const { return isValid(handle) && slots_[index(handle)].tracking == Tracking::TRACKED; }
+	/// Returns true if the handle points to an object in the table
+	inline bool isValid(Handle handle) const { return (handle != InvalidHandle && index(handle) < slots_.size() && slots_[index(handle)].handle == handle); }
+
+	/// Returns the number of allocated slots, including the free ones
+	inline unsigned int numSlots() const { return slots_.size(); }
+	/// Returns the handle of the object in a slot, or an invalid one if the slot is free
+	inline Handle handleAt(unsigned int slotIndex) const { return (slotIndex < slots_.size()) ? slots_[slotIndex].handle : InvalidHandle; }
+
+	/// Returns the number of objects in the table
+	inline unsigned int size() const { return objectHandles_.size(); }
+	/// Returns the number of tracked objects in the table
+	inline unsigned int numTracked() const { return numTracked_; }
+	/// Returns the number of tracked objects of the specified type in the table
+	inline unsigned int numTracked(LuaTypes::UserDataType type) const { return numTypedTracked_[type]; }
+
+	/// Returns the slot index part of a handle
+	static inline unsigned int index(Handle handle) { return handle & MaxObjects; }
+	/// Converts a handle to the light userdata value pushed on the Lua stack
+	static inline void *toUserData(Handle handle) { return reinterpret_cast<void *>(static_cast<uintptr_t>(handle)); }
+	/// Converts a light userdata value retrieved from the Lua stack to a handle
+	static inline Handle toHandle(void *userData)
+	{
+		const uintptr_t value = reinterpret_cast<uintptr_t>(userData);
+		return (value <= UINT32_MAX) ? static_cast<Handle>(value) : InvalidHandle;
+	}
+
+  private:
+	/// A slot of the map, the next free slot index is only meaningful when the handle is not valid
+	struct Slot
+	{
+		void *object;
+		Handle handle;
+		unsigned int generation;
+		unsigned int nextFree;
+		Tracking tracking;
+	};
+
+	static_assert(LuaTypes::UNKNOWN < (1 << TypeBits), "Not enough handle bits for the userdata type");
+
+	unsigned int numTracked_;
+	unsigned int numTypedTracked_[LuaTypes::UNKNOWN + 1];
+	/// The free list is a FIFO queue to spread generation increments among slots
+	unsigned int freeListHead_;
+	unsigned int freeListTail_;
+	nctl::Array<Slot> slots_;
+	/// Used to always push the same handle for the same object
+	nctl::HashMap<void *, Handle> objectHandles_;
+
+	/// Deleted copy constructor
+	LuaHandleTable(const LuaHandleTable &) = delete;
+	/// Deleted assignment operator
+	LuaHandleTable &operator=(const LuaHandleTable &) = delete;
+};
+
+}
+
+#endif
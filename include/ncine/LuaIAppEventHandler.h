@@ -17,6 +17,7 @@ class DLL_PUBLIC LuaIAppEventHandler
 	static void onPreInit(lua_State *L, AppConfiguration &config);
 	static void onInit(lua_State *L);
 	static void onFrameStart(lua_State *L);
+	static void onFixedUpdate(lua_State *L, float timeStep);
 	static void onPostUpdate(lua_State *L);
 	static void onDrawViewport(lua_State *L, Viewport &viewport);
 	static void onFrameEnd(lua_State *L);
@@ -0,0 +1,147 @@
+#ifndef CLASS_NCINE_LUAPROFILER
+#define CLASS_NCINE_LUAPROFILER
+
+#include <cstdint>
+#include "common_defines.h"
+#include <nctl/Array.h>
+#include <nctl/HashMap.h>
+#include <nctl/String.h>
+#include <nctl/UniquePtr.h>
+#include <nctl/Atomic.h>
+
+struct lua_State;
+struct lua_Debug;
+
+namespace ncine {
+
+class Thread;
+
+/// A sampling profiler for the scripts running in a Lua state
+/*! A sparse instruction count hook takes a sample when the interval has elapsed. When threads are available a timer thread
+ *  flags when a sample is due, so the hook only reads the flag, otherwise the hook checks the clock.
+ *  Every sample records the function and line stack of the script in a ring buffer, which can be reported
+ *  as self and total time per function or saved as collapsed stacks for flame graph tools.
+ *  \note Lua hooks belong to a single thread, only code running in the main one is sampled and coroutines are not */
+class DLL_PUBLIC LuaProfiler
+{
+  public:
+	/// Number of most recent samples kept by the ring buffer
+	static const unsigned int MaxSamples = 8192;
+	/// Maximum number of stack frames recorded by a sample, the outermost ones are discarded
+	static const unsigned int MaxStackDepth = 32;
+	/// Default time between two samples in seconds
+	static const float DefaultInterval;
+
+	/// The time spent in a function, estimated from the samples in the buffer
+	struct FunctionStats
+	{
+		/// The function name, with the script and the line where it is defined
+		const char *name;
+		/// Number of samples where the function was running
+		unsigned int selfSamples;
+		/// Number of samples where the function was on the stack
+		unsigned int totalSamples;
+		/// Time spent in the function itself in seconds
+		float selfTime;
+		/// Time spent in the function and in the ones it called in seconds
+		float totalTime;
+	};
+
+	explicit LuaProfiler(lua_State *L);
+	~LuaProfiler();
+
+	/// Returns true if samples are being taken
+	inline bool isRunning() const { return running_; }
+	/// Returns the time between two samples in seconds
+	inline float interval() const { return interval_; }
+	/// Starts taking a sample every specified number of seconds
+	void start(float interval);
+	/// Starts taking samples at the default interval
+	inline void start() { start(DefaultInterval); }
+	/// Stops taking samples, the ones in the buffer are kept
+	void stop();
+	/// Discards all samples in the buffer
+	void clear();
+
+	/// Returns the number of samples in the buffer
+	unsigned int numSamples() const;
+	/// Returns the estimated time spent running scripts since the profiler has been created, in seconds
+	inline double sampledTime() const { return sampledTime_; }
+
+	/// Fills the array with the time spent in every sampled function, sorted by decreasing self time
+	/*! \note The names are valid until the profiler is destroyed */
+	void report(nctl::Array<FunctionStats> &stats) const;
+	/// Logs the functions with the highest self time
+	void logReport(unsigned int maxFunctions) const;
+	/// Saves the samples as collapsed stacks in the save path, optionally with the line being run in every frame
+	/*! Each line of the file has the frames separated by semicolons, from the outermost, followed by a number of samples. */
+	bool saveCollapsedStacks(const char *filename, bool withLines) const;
+
+  private:
+	/// Number of Lua instructions between two checks of the timer flag or of the clock
+	static const int CountHookPeriod = 1000;
+
+	struct Frame
+	{
+		uint32_t function;
+		int32_t line;
+	};
+
+	struct Sample
+	{
+		unsigned int depth;
+		/// The innermost frame comes first
+		Frame frames[MaxStackDepth];
+	};
+
+	struct FunctionInfo
+	{
+		nctl::String name;
+		nctl::String source;
+		int lineDefined;
+	};
+
+	lua_State *L_;
+	bool running_;
+	float interval_;
+	uint64_t intervalTicks_;
+	/// The clock counter at which the next sample is due when there is no timer thread
+	uint64_t nextSampleTicks_;
+	double sampledTime_;
+
+	/// The ring buffer is only allocated when the profiler is started for the first time
+	nctl::UniquePtr<Sample[]> samples_;
+	/// The total number of taken samples, the next one is written at this index modulo the capacity
+	unsigned long int writeIndex_;
+	/// The samples before this index have been discarded
+	unsigned long int clearIndex_;
+
+	nctl::Array<FunctionInfo> functions_;
+	/// Maps a key derived from a function definition to its index in the functions array
+	nctl::HashMap<uint64_t, uint32_t> functionIndices_;
+
+	nctl::UniquePtr<Thread> timerThread_;
+	/// The clock counter at which the timer thread has flagged the last sample as due
+	nctl::Atomic64 dueTicks_;
+	/// Set by the timer thread and cleared by the hook, on the thread running the scripts
+	nctl::Atomic32 sampleDue_;
+	nctl::Atomic32 timerRunning_;
+
+	static void timerFunction(void *arg);
+	static void sampleHook(lua_State *L, lua_Debug *ar);
+	static LuaProfiler *profiler(lua_State *L);
+
+	void takeSample(lua_State *L);
+	uint32_t functionIndex(const lua_Debug &ar);
+	/// Returns the index of the oldest sample in the buffer
+	unsigned long int firstIndex() const;
+
+	/// Deleted copy constructor
+	LuaProfiler(const LuaProfiler &) = delete;
+	/// Deleted assignment operator
+	LuaProfiler &operator=(const LuaProfiler &) = delete;
+};
+
+}
+
+#endif
@@ -20,6 +20,8 @@ class LuaRectUtils
 {
   public:
 	static void push(lua_State *L, const Rect<T> &rect);
+	static void push(lua_State *L, const Rect<T> &rect, int outIndex);
+	static int pushValues(lua_State *L, const Rect<T> &rect);
 	static void pushField(lua_State *L, const char *name, const Rect<T> &rect);
 	static Rect<T> retrieve(lua_State *L, int index, int &newIndex);
 	static Rect<T> retrieveTable(lua_State *L, int index);
@@ -42,6 +44,34 @@ void LuaRectUtils<T>::push(lua_State *L, const Rect<T> &rect)
 	LuaUtils::pushField(L, LuaNames::Rect::h, rect.h);
 }
 
+/*! \note The table at `outIndex` is filled and pushed again, a new table is only created if there is none */
+template <class T>
+void LuaRectUtils<T>::push(lua_State *L, const Rect<T> &rect, int outIndex)
+{
+	if (LuaUtils::isTable(L, outIndex) == false)
+	{
+		push(L, rect);
+		return;
+	}
+
+	LuaUtils::pushValue(L, outIndex);
+	LuaUtils::pushField(L, LuaNames::Rect::x, rect.x);
+	LuaUtils::pushField(L, LuaNames::Rect::y, rect.y);
+	LuaUtils::pushField(L, LuaNames::Rect::w, rect.w);
+	LuaUtils::pushField(L, LuaNames::Rect::h, rect.h);
+}
+
+/*! \return The number of values pushed on the stack, one per component */
+template <class T>
+int LuaRectUtils<T>::pushValues(lua_State *L, const Rect<T> &rect)
+{
+	LuaUtils::push(L, rect.x);
+	LuaUtils::push(L, rect.y);
+	LuaUtils::push(L, rect.w);
+	LuaUtils::push(L, rect.h);
+	return 4;
+}
+
 template <class T>
 void LuaRectUtils<T>::pushField(lua_State *L, const char *name, const Rect<T> &rect)
 {
@@ -2,11 +2,10 @@
 #define CLASS_NCINE_LUAMANAGER
 
 #include "common_defines.h"
-#include <nctl/HashMap.h>
-#include "LuaTypes.h"
+#include <nctl/UniquePtr.h>
+#include "LuaHandleTable.h"
 
 struct lua_State;
-struct lua_Debug;
 
 namespace nctl {
 class String;
@@ -18,6 +17,10 @@ namespace LuaUtils {
 	class RunInfo;
 }
 
+class LuaCallbacks;
+class LuaProfiler;
+class LuaBytecodeCache;
+
 /// The Lua scripting state manager
 class DLL_PUBLIC LuaStateManager
 {
@@ -35,7 +38,7 @@ class DLL_PUBLIC LuaStateManager
 		NONE
 	};
 
-	/// To enable or not memory and instruction count statistics
+	/// To enable or not memory usage statistics
 	enum class StatisticsTracking
 	{
 		ENABLED,
@@ -102,10 +105,25 @@ class DLL_PUBLIC LuaStateManager
 	inline StatisticsTracking statisticsTracking() const { return statsTracking_; }
 	inline StandardLibraries standardLibraries() const { return stdLibraries_; }
 
-	LuaTypes::UserDataType trackedType(void *pointer) const;
-	inline nctl::HashMap<void *, LuaTypes::UserDataType> &trackedUserDatas() { return trackedUserDatas_; }
-	LuaTypes::UserDataType untrackedType(void *pointer) const;
-	inline nctl::HashMap<void *, LuaTypes::UserDataType> &untrackedUserDatas() { return untrackedUserDatas_; }
+	/// Returns the table of handles of the objects exposed to Lua
+	inline LuaHandleTable &handles() { return handles_; }
+	/// Returns the table of handles of the objects exposed to Lua (read-only)
+	inline const LuaHandleTable &handles() const { return handles_; }
+	/// Returns the cached references to the script callbacks
+	inline LuaCallbacks &callbacks() { return *callbacks_; }
+	/// Returns the sampling profiler of the scripts running in the state
+	inline LuaProfiler &profiler() { return *profiler_; }
+	/// Returns the sampling profiler of the scripts running in the state (read-only)
+	inline const LuaProfiler &profiler() const { return *profiler_; }
+
+	/// Enables or disables the cache of compiled chunks in the save path, disabled by default
+	void setBytecodeCacheEnabled(bool enabled);
+	/// Returns true if compiled chunks are cached in the save path
+	inline bool isBytecodeCacheEnabled() const { return bytecodeCache_ != nullptr; }
+	/// Returns the cache of compiled chunks, to clear it or to query its statistics, or `nullptr` if it is disabled
+	inline LuaBytecodeCache *bytecodeCache() { return bytecodeCache_.get(); }
+	/// Returns the cache of compiled chunks, or `nullptr` if it is disabled (read-only)
+	inline const LuaBytecodeCache *bytecodeCache() const { return bytecodeCache_.get(); }
 
 	static LuaStateManager *manager(lua_State *L);
 
@@ -116,14 +134,17 @@ class DLL_PUBLIC LuaStateManager
 	ApiType apiType_;
 	StatisticsTracking statsTracking_;
 	StandardLibraries stdLibraries_;
-	nctl::HashMap<void *, LuaTypes::UserDataType> trackedUserDatas_;
-	nctl::HashMap<void *, LuaTypes::UserDataType> untrackedUserDatas_;
+	LuaHandleTable handles_;
+	nctl::UniquePtr<LuaCallbacks> callbacks_;
+	/// Recreated together with the Lua state
+	nctl::UniquePtr<LuaProfiler> profiler_;
+	/// Kept when the state is reopened
+	nctl::UniquePtr<LuaBytecodeCache> bytecodeCache_;
 	/// True if the Lua state should be closed upon destruction
 	bool closeOnDestruction_;
 
 	static void *luaAllocator(void *ud, void *ptr, size_t osize, size_t nsize);
 	static void *luaAllocatorWithStatistics(void *ud, void *ptr, size_t osize, size_t nsize);
-	static void luaCountHook(lua_State *L, lua_Debug *ar);
 
 	void init(ApiType apiType, StatisticsTracking statsTracking, StandardLibraries stdLibraries);
 	void shutdown();
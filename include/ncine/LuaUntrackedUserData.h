@@ -15,6 +15,8 @@ class LuaUntrackedUserData
   public:
 	static T *retrieve(lua_State *L, int index) { return retrieve(L, index, RetrieveNull::TRACE); }
 	static T *retrieveOrNil(lua_State *L, int index) { return retrieve(L, index, RetrieveNull::ACCEPT); }
+	/// Retrieves the object at a position of the array table at the specified index, for bulk functions
+	static T *retrieveArrayElement(lua_State *L, int index, int64_t position);
 
 	static void push(lua_State *L, T *object);
 	static void push(lua_State *L, const T *object);
@@ -30,7 +32,7 @@ class LuaUntrackedUserData
 	};
 
 	static T *retrieve(lua_State *L, int index, RetrieveNull unwrapType);
-	static T *store(lua_State *L, T *object);
+	static LuaHandleTable::Handle store(lua_State *L, T *object);
 };
 
 template <class T>
@@ -44,15 +46,12 @@ T *LuaUntrackedUserData<T>::retrieve(lua_State *L, int index, RetrieveNull unwra
 		return nullptr;
 	}
 
-	void *pointer = LuaUtils::retrieveUserData<void *>(L, index);
+	const LuaHandleTable::Handle handle = LuaHandleTable::toHandle(LuaUtils::retrieveUserData<void>(L, index));
 
-	LuaStateManager *stateManager = LuaStateManager::manager(L);
-	LuaTypes::UserDataType type = stateManager->trackedType(pointer);
+	LuaTypes::UserDataType type = LuaTypes::UNKNOWN;
+	void *pointer = LuaStateManager::manager(L)->handles().object(handle, type);
 
-	if (type == LuaTypes::UNKNOWN)
-		type = stateManager->untrackedType(pointer);
-
-	if (type == LuaTypes::UNKNOWN)
+	if (pointer == nullptr)
 		return nullptr; // TODO: Caller should check return value and abort the call
 
 	T *object = reinterpret_cast<T *>(pointer);
@@ -128,14 +127,21 @@ T *LuaUntrackedUserData<T>::retrieve(lua_State *L, int index, RetrieveNull unwra
 	return object;
 }
 
+template <class T>
+T *LuaUntrackedUserData<T>::retrieveArrayElement(lua_State *L, int index, int64_t position)
+{
+	LuaUtils::rawGeti(L, index, position);
+	T *object = retrieve(L, -1, RetrieveNull::TRACE);
+	LuaUtils::pop(L);
+
+	return object;
+}
+
 template <class T>
 void LuaUntrackedUserData<T>::push(lua_State *L, T *object)
 {
 	if (object != nullptr)
-	{
-		store(L, object);
-		LuaUtils::push(L, reinterpret_cast<void *>(object));
-	}
+		LuaUtils::push(L, LuaHandleTable::toUserData(store(L, object)));
 	else
 		LuaUtils::pushNil(L);
 }
@@ -150,10 +156,7 @@ template <class T>
 void LuaUntrackedUserData<T>::pushField(lua_State *L, const char *name, T *object)
 {
 	if (object != nullptr)
-	{
-		store(L, object);
-		LuaUtils::pushField(L, name, reinterpret_cast<void *>(object));
-	}
+		LuaUtils::pushField(L, name, LuaHandleTable::toUserData(store(L, object)));
 	else
 		LuaUtils::pushFieldNil(L, name);
 }
@@ -164,19 +167,14 @@ void LuaUntrackedUserData<T>::pushField(lua_State *L, const char *name, const T
 	pushField(L, name, const_cast<T *>(object));
 }
 
+/*! \note An object created by a script keeps the handle it was given when tracked */
 template <class T>
-T *LuaUntrackedUserData<T>::store(lua_State *L, T *object)
+LuaHandleTable::Handle LuaUntrackedUserData<T>::store(lua_State *L, T *object)
 {
 	FATAL_ASSERT(object != nullptr);
 
-	LuaStateManager *stateManager = LuaStateManager::manager(L);
-
-	nctl::HashMap<void *, LuaTypes::UserDataType> &hashMap = stateManager->untrackedUserDatas();
-	if (hashMap.loadFactor() >= 0.8f)
-		hashMap.rehash(hashMap.capacity() * 2);
-	hashMap.insert(object, LuaTypes::classToUserDataType(object));
-
-	return object;
+	LuaHandleTable &handles = LuaStateManager::manager(L)->handles();
+	return handles.add(object, LuaTypes::classToUserDataType(object), LuaHandleTable::Tracking::UNTRACKED);
 }
 
 }
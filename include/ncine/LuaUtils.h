@@ -274,6 +274,7 @@ namespace LuaUtils {
 	}
 
 	DLL_PUBLIC void pushNil(lua_State *L);
+	DLL_PUBLIC void pushValue(lua_State *L, int index);
 	DLL_PUBLIC void push(lua_State *L, double number);
 	DLL_PUBLIC void push(lua_State *L, float number);
 	DLL_PUBLIC void push(lua_State *L, int64_t integer);
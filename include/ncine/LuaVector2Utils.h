@@ -18,6 +18,8 @@ class LuaVector2Utils
 {
   public:
 	static void push(lua_State *L, const Vector2<T> &v);
+	static void push(lua_State *L, const Vector2<T> &v, int outIndex);
+	static int pushValues(lua_State *L, const Vector2<T> &v);
 	static void pushField(lua_State *L, const char *name, const Vector2<T> &v);
 	static Vector2<T> retrieve(lua_State *L, int index, int &newIndex);
 	static Vector2<T> retrieveTable(lua_State *L, int index);
@@ -38,6 +40,30 @@ void LuaVector2Utils<T>::push(lua_State *L, const Vector2<T> &v)
 	LuaUtils::pushField(L, LuaNames::Vector2::y, v.y);
 }
 
+/*! \note The table at `outIndex` is filled and pushed again, a new table is only created if there is none */
+template <class T>
+void LuaVector2Utils<T>::push(lua_State *L, const Vector2<T> &v, int outIndex)
+{
+	if (LuaUtils::isTable(L, outIndex) == false)
+	{
+		push(L, v);
+		return;
+	}
+
+	LuaUtils::pushValue(L, outIndex);
+	LuaUtils::pushField(L, LuaNames::Vector2::x, v.x);
+	LuaUtils::pushField(L, LuaNames::Vector2::y, v.y);
+}
+
+/*! \return The number of values pushed on the stack, one per component */
+template <class T>
+int LuaVector2Utils<T>::pushValues(lua_State *L, const Vector2<T> &v)
+{
+	LuaUtils::push(L, v.x);
+	LuaUtils::push(L, v.y);
+	return 2;
+}
+
 template <class T>
 void LuaVector2Utils<T>::pushField(lua_State *L, const char *name, const Vector2<T> &v)
 {
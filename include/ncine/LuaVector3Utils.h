@@ -19,6 +19,8 @@ class LuaVector3Utils
 {
   public:
 	static void push(lua_State *L, const Vector3<T> &v);
+	static void push(lua_State *L, const Vector3<T> &v, int outIndex);
+	static int pushValues(lua_State *L, const Vector3<T> &v);
 	static void pushField(lua_State *L, const char *name, const Vector3<T> &v);
 	static Vector3<T> retrieve(lua_State *L, int index, int &newIndex);
 	static Vector3<T> retrieveTable(lua_State *L, int index);
@@ -40,6 +42,32 @@ void LuaVector3Utils<T>::push(lua_State *L, const Vector3<T> &v)
 	LuaUtils::pushField(L, LuaNames::Vector3::z, v.z);
 }
 
+/*! \note The table at `outIndex` is filled and pushed again, a new table is only created if there is none */
+template <class T>
+void LuaVector3Utils<T>::push(lua_State *L, const Vector3<T> &v, int outIndex)
+{
+	if (LuaUtils::isTable(L, outIndex) == false)
+	{
+		push(L, v);
+		return;
+	}
+
+	LuaUtils::pushValue(L, outIndex);
+	LuaUtils::pushField(L, LuaNames::Vector3::x, v.x);
+	LuaUtils::pushField(L, LuaNames::Vector3::y, v.y);
+	LuaUtils::pushField(L, LuaNames::Vector3::z, v.z);
+}
+
+/*! \return The number of values pushed on the stack, one per component */
+template <class T>
+int LuaVector3Utils<T>::pushValues(lua_State *L, const Vector3<T> &v)
+{
+	LuaUtils::push(L, v.x);
+	LuaUtils::push(L, v.y);
+	LuaUtils::push(L, v.z);
+	return 3;
+}
+
 template <class T>
 void LuaVector3Utils<T>::pushField(lua_State *L, const char *name, const Vector3<T> &v)
 {
@@ -20,6 +20,8 @@ class LuaVector4Utils
 {
   public:
 	static void push(lua_State *L, const Vector4<T> &v);
+	static void push(lua_State *L, const Vector4<T> &v, int outIndex);
+	static int pushValues(lua_State *L, const Vector4<T> &v);
 	static void pushField(lua_State *L, const char *name, const Vector4<T> &v);
 	static Vector4<T> retrieve(lua_State *L, int index, int &newIndex);
 	static Vector4<T> retrieveTable(lua_State *L, int index);
@@ -42,6 +44,34 @@ void LuaVector4Utils<T>::push(lua_State *L, const Vector4<T> &v)
 	LuaUtils::pushField(L, LuaNames::Vector4::w, v.w);
 }
 
+/*! \note The table at `outIndex` is filled and pushed again, a new table is only created if there is none */
+template <class T>
+void LuaVector4Utils<T>::push(lua_State *L, const Vector4<T> &v, int outIndex)
+{
+	if (LuaUtils::isTable(L, outIndex) == false)
+	{
+		push(L, v);
+		return;
+	}
+
+	LuaUtils::pushValue(L, outIndex);
+	LuaUtils::pushField(L, LuaNames::Vector4::x, v.x);
+	LuaUtils::pushField(L, LuaNames::Vector4::y, v.y);
+	LuaUtils::pushField(L, LuaNames::Vector4::z, v.z);
+	LuaUtils::pushField(L, LuaNames::Vector4::w, v.w);
+}
+
+/*! \return The number of values pushed on the stack, one per component */
+template <class T>
+int LuaVector4Utils<T>::pushValues(lua_State *L, const Vector4<T> &v)
+{
+	LuaUtils::push(L, v.x);
+	LuaUtils::push(L, v.y);
+	LuaUtils::push(L, v.z);
+	LuaUtils::push(L, v.w);
+	return 4;
+}
+
 template <class T>
 void LuaVector4Utils<T>::pushField(lua_State *L, const char *name, const Vector4<T> &v)
 {
@@ -125,6 +125,10 @@ class DLL_PUBLIC MeshSprite : public BaseSprite
 
 	inline static ObjectType sType() { return ObjectType::MESH_SPRITE; }
 
+#if NCINE_WITH_ALLOCATORS
+	NCTL_DECLARE_SLAB_ALLOCATED()
+#endif
+
   protected:
 	/// Protected copy constructor used to clone objects
 	MeshSprite(const MeshSprite &other);
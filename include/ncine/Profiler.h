@@ -0,0 +1,75 @@
+#ifndef CLASS_NCINE_PROFILER
+#define CLASS_NCINE_PROFILER
+
+#include <cstdint>
+#include "common_defines.h"
+#include <nctl/Atomic.h>
+
+namespace ncine {
+
+/// A low overhead CPU profiler that records zones in per-thread ring buffers
+/*! Every thread recording a zone gets its own fixed size buffer, so recording never locks and never allocates
+ *  after the first zone of a thread. A zone costs a single branch when the profiler is disabled at runtime.
+ *  The recorded zones can be saved in the Chrome trace event format, to be inspected with `chrome://tracing` or Perfetto. */
+class DLL_PUBLIC Profiler
+{
+  public:
+	/// Maximum number of threads that can record zones during the whole application lifetime
+	static const unsigned int MaxThreads = 64;
+	/// Number of most recent zones kept by the buffer of every thread
+	static const unsigned int ZonesPerThread = 8192;
+	/// Maximum length of a thread name, including the terminating character
+	static const unsigned int MaxThreadNameLength = 32;
+
+	/// A zone recording the time between its construction and its destruction in the buffer of the current thread
+	/*! \note The name is not copied and should be a string literal */
+	class Zone
+	{
+	  public:
+		explicit Zone(const char *name)
+		    : name_(name), start_(isEnabled() ? ticks() : 0) {}
+		~Zone()
+		{
+			if (start_ != 0)
+				recordZone(name_, start_, ticks());
+		}
+
+	  private:
+		const char *name_;
+		uint64_t start_;
+
+		/// Deleted copy constructor
+		Zone(const Zone &) = delete;
+		/// Deleted assignment operator
+		Zone &operator=(const Zone &) = delete;
+	};
+
+	/// Returns true if zones are being recorded
+	static inline bool isEnabled() { return enabled_.load(nctl::Atomic32::MemoryModel::RELAXED) != 0; }
+	/// Enables or disables the recording of zones
+	static void setEnabled(bool enabled);
+
+	/// Sets the name of the calling thread in the saved traces
+	/*! \note The buffer of the thread is only created when it records its first zone */
+	static void setThreadName(const char *name);
+	/// Returns the number of threads that have a buffer
+	static unsigned int numThreads();
+	/// Returns the number of zones currently in the buffers of all threads
+	static unsigned long int numZones();
+	/// Discards all recorded zones
+	static void clear();
+
+	/// Saves the recorded zones in a Chrome trace event JSON file in the save path
+	static bool saveChromeTrace(const char *filename);
+
+  private:
+	/// Written by the main thread and read by every thread starting a zone
+	static nctl::Atomic32 enabled_;
+
+	static uint64_t ticks();
+	static void recordZone(const char *name, uint64_t start, uint64_t end);
+};
+
+}
+
+#endif
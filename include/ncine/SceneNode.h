@@ -9,6 +9,11 @@
 #include "Color.h"
 #include "Colorf.h"
 
+#include <ncine/config.h>
+#if NCINE_WITH_ALLOCATORS
+	#include <nctl/SlabAllocator.h>
+#endif
+
 namespace ncine {
 
 class RenderQueue;
@@ -49,6 +54,10 @@ class DLL_PUBLIC SceneNode : public Object
 
 	inline static ObjectType sType() { return ObjectType::SCENENODE; }
 
+#if NCINE_WITH_ALLOCATORS
+	NCTL_DECLARE_SLAB_ALLOCATED()
+#endif
+
 	/// Returns the parent as a constant node, if there is any
 	inline const SceneNode *parent() const { return parent_; }
 	/// Returns the parent node, if there is any
@@ -201,6 +210,8 @@ class DLL_PUBLIC SceneNode : public Object
 
 	/// Returns the last frame in which any of the viewports have updated this node
 	inline unsigned long int lastFrameUpdated() const { return lastFrameUpdated_; }
+	/// Returns the last fixed time step update in which this node has been transformed
+	inline unsigned long int lastFixedUpdate() const { return lastFixedUpdate_; }
 
   protected:
 	/// Bit positions inside the dirty bitset
@@ -210,7 +221,11 @@ class DLL_PUBLIC SceneNode : public Object
 		ColorBit = 1,
 		SizeBit = 2,
 		TextureBit = 3,
-		AabbBit = 4
+		AabbBit = 4,
+		/// The rendered transformation is interpolated between the last two fixed time step updates
+		InterpolationBit = 5,
+		/// The previous world matrix is stale and cannot be used for interpolation
+		StaleInterpolationBit = 6
 	};
 
 	bool updateEnabled_;
@@ -269,6 +284,8 @@ class DLL_PUBLIC SceneNode : public Object
 	Matrix4x4f worldMatrix_;
 	/// Local transformation matrix
 	Matrix4x4f localMatrix_;
+	/// World transformation matrix of the previous fixed time step update
+	Matrix4x4f previousWorldMatrix_;
 
 	/// A flag indicating whether the destructor should also delete all children
 	bool shouldDeleteChildrenOnDestruction_;
@@ -278,6 +295,8 @@ class DLL_PUBLIC SceneNode : public Object
 
 	/// The last frame any viewport updated this node
 	unsigned long int lastFrameUpdated_;
+	/// The last fixed time step update in which this node has been transformed, zero if it never has
+	unsigned long int lastFixedUpdate_;
 
 	/// Deleted assignment operator
 	SceneNode &operator=(const SceneNode &) = delete;
@@ -289,6 +308,8 @@ class DLL_PUBLIC SceneNode : public Object
 	void swapChildPointer(SceneNode *first, SceneNode *second);
 
 	virtual void transform();
+	/// Returns the world matrix to render, interpolated between the last two fixed time step updates if needed
+	Matrix4x4f interpolatedWorldMatrix();
 };
 
 inline const nctl::Array<const SceneNode *> &SceneNode::children() const
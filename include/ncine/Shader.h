@@ -93,6 +93,7 @@ class DLL_PUBLIC Shader : public Object
 	bool setAttribute(const char *name, int stride, unsigned long int pointer);
 
 	/// Returns true if the shader is linked and can therefore be used
+	/*! \note When shader queries are deferred, a program whose errors have not been checked yet is considered linked */
 	bool isLinked() const;
 
 	/// Returns the length of the information log including the null termination character
@@ -0,0 +1,57 @@
+#ifndef CLASS_NCINE_SHADERPROGRAMSTATUS
+#define CLASS_NCINE_SHADERPROGRAMSTATUS
+
+#include "common_defines.h"
+
+namespace ncine {
+
+/// The status of a shader program and the transitions between its values
+/*! The class does not call OpenGL, it only validates the transitions requested by the program.
+ *  A link with immediate queries goes from `NOT_LINKED` to `LINKED` and then to `LINKED_WITH_INTROSPECTION`.
+ *  A deferred link goes through `LINKING`, when the driver can be polled, and `LINKED_WITH_DEFERRED_QUERIES` first.
+ *  \note Every transition returns false and leaves the status unchanged if it is not valid from the current one */
+class DLL_PUBLIC ShaderProgramStatus
+{
+  public:
+	enum class Status
+	{
+		NOT_LINKED,
+		COMPILATION_FAILED,
+		LINKING_FAILED,
+		/// The link has been submitted and the driver is compiling and linking in parallel
+		LINKING,
+		LINKED,
+		LINKED_WITH_DEFERRED_QUERIES,
+		LINKED_WITH_INTROSPECTION
+	};
+
+	ShaderProgramStatus()
+	    : value_(Status::NOT_LINKED) {}
+
+	/// Returns the current status
+	inline Status value() const { return value_; }
+	/// Returns true if the program is linked or could still be, as its queries have been deferred
+	bool isLinked() const;
+	/// Returns true if compilation and link errors have not been checked yet
+	bool hasDeferredQueries() const;
+
+	/// A shader has failed to compile, either at attach time or when checking deferred queries
+	bool failCompilation();
+	/// The link has been submitted without checking its result, the status is `LINKING` if the driver can be polled
+	bool deferLink(bool canPollCompletion);
+	/// The driver has completed the compilation and the link of a program in the `LINKING` status
+	bool completeLink();
+	/// The link status has been retrieved, either right after linking or when checking deferred queries
+	bool checkLink(bool hasLinked);
+	/// Uniforms, uniform blocks and attributes of a linked program have been discovered
+	bool completeIntrospection();
+	/// The program has been deleted so that new shaders can be attached
+	void reset();
+
+  private:
+	Status value_;
+};
+
+}
+
+#endif
@@ -34,6 +34,10 @@ class DLL_PUBLIC Sprite : public BaseSprite
 
 	inline static ObjectType sType() { return ObjectType::SPRITE; }
 
+#if NCINE_WITH_ALLOCATORS
+	NCTL_DECLARE_SLAB_ALLOCATED()
+#endif
+
   protected:
 	/// Protected copy constructor used to clone objects
 	Sprite(const Sprite &other);
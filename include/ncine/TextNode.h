@@ -10,7 +10,7 @@
 namespace ncine {
 
 class GLUniformBlockCache;
-class FontGlyph;
+class GlyphRun;
 
 /// A scene node to draw a text label
 class DLL_PUBLIC TextNode : public DrawableNode
@@ -35,10 +35,12 @@ class DLL_PUBLIC TextNode : public DrawableNode
 	TextNode(SceneNode *parent, Font *font);
 	TextNode(SceneNode *parent, Font *font, unsigned int maxStringLength);
 
+	~TextNode() override;
+
 	/// Default move constructor
-	TextNode(TextNode &&) = default;
+	TextNode(TextNode &&);
 	/// Default move assignment operator
-	TextNode &operator=(TextNode &&) = default;
+	TextNode &operator=(TextNode &&);
 
 	/// Returns a copy of this object
 	inline TextNode clone() const { return TextNode(*this); }
@@ -90,6 +92,10 @@ class DLL_PUBLIC TextNode : public DrawableNode
 
 	inline static ObjectType sType() { return ObjectType::TEXTNODE; }
 
+#if NCINE_WITH_ALLOCATORS
+	NCTL_DECLARE_SLAB_ALLOCATED()
+#endif
+
   protected:
 	/// Protected copy constructor used to clone objects
 	TextNode(const TextNode &other);
@@ -106,13 +112,23 @@ class DLL_PUBLIC TextNode : public DrawableNode
 		    : x(xx), y(yy), u(uu), v(vv) {}
 	};
 
-	/// Position of degenerate vertices in glyph quad
-	enum class Degenerate
+	/// A line of text and the shared glyph run that lays it out
+	struct Line
 	{
-		NONE,
-		START,
-		START_END,
-		END
+		/// The run acquired from the glyph run cache, `nullptr` for empty lines
+		GlyphRun *run;
+		/// The version of the run when the vertices were last generated
+		unsigned int version;
+
+		Line()
+		    : run(nullptr), version(0) {}
+		explicit Line(GlyphRun *glyphRun)
+		    : run(glyphRun), version(0) {}
+		/// Releases the run
+		~Line();
+
+		Line(Line &&other);
+		Line &operator=(Line &&other);
 	};
 
 	/// The string to be rendered
@@ -128,12 +144,8 @@ class DLL_PUBLIC TextNode : public DrawableNode
 	/// The array of vertex positions interleaved with texture coordinates for every glyph in the node
 	nctl::Array<Vertex> interleavedVertices_;
 
-	/// Advance on the X-axis for the next processed glyph
-	mutable float xAdvance_;
-	/// Advance on the Y-axis for the next processed glyph
-	mutable float yAdvance_;
-	/// Text width for each line of text
-	mutable nctl::Array<float> lineLengths_;
+	/// The lines of the string, only the ones that change are laid out again
+	mutable nctl::Array<Line> lines_;
 	/// Horizontal text alignment of multiple lines
 	Alignment alignment_;
 	/// The line height for the text node
@@ -151,8 +163,8 @@ class DLL_PUBLIC TextNode : public DrawableNode
 	void calculateBoundaries() const;
 	/// Calculates align offset for a particular line
 	float calculateAlignment(unsigned int lineIndex) const;
-	/// Fills the batch draw command with data from a glyph
-	void processGlyph(const FontGlyph *glyph, Degenerate degen);
+	/// Regenerates the vertices of every line from their glyph runs
+	void processLines();
 
 	void shaderHasChanged() override;
 
@@ -44,6 +44,22 @@ class DLL_PUBLIC Texture : public Object
 		REPEAT
 	};
 
+	/// Texels read back asynchronously from a texture or from the screen
+	struct Readback
+	{
+		Readback()
+		    : pixels(nullptr), width(0), height(0), format(Format::RGBA8) {}
+
+		/// Tightly packed rows of texels, from bottom to top, only valid for the duration of the callback
+		const unsigned char *pixels;
+		int width;
+		int height;
+		Format format;
+	};
+
+	/// The function invoked on the main thread when an asynchronous readback completes
+	using ReadbackCallback = void (*)(const Readback &readback, void *userData);
+
 	/// Creates an OpenGL texture name
 	Texture();
 
@@ -96,6 +112,13 @@ class DLL_PUBLIC Texture : public Object
 	/// Saves all texture texels in the specified texture mip level in raw format to a memory buffer
 	bool saveToMemory(unsigned char *bufferPtr, unsigned int level);
 
+	/// Reads back all texture texels in the first mip level without stalling, the callback is invoked a few frames later
+	bool readTexelsAsync(ReadbackCallback callback, void *userData);
+	/// Reads back all texture texels in the specified mip level without stalling, the callback is invoked a few frames later
+	bool readTexelsAsync(unsigned int level, ReadbackCallback callback, void *userData);
+	/// Reads back all texture texels in the first mip level without stalling and saves them to a PNG or WebP file on a worker thread
+	bool saveToFileAsync(const char *filename, bool verticalFlip);
+
 	/// Returns texture width
 	inline int width() const { return width_; }
 	/// Returns texture height
@@ -0,0 +1,45 @@
+#ifndef CLASS_NCINE_VERTEXKERNELS
+#define CLASS_NCINE_VERTEXKERNELS
+
+#include "common_defines.h"
+
+namespace ncine {
+
+/// Vectorised kernels to expand vertex and index data
+/*! The instruction set is chosen at build time between AVX2, SSE2 and NEON,
+ *  every kernel has a scalar version that is used as a fallback and as a reference. */
+class DLL_PUBLIC VertexKernels
+{
+  public:
+	/// A quad to be expanded into the four vertices of a triangle strip
+	struct Quad
+	{
+		/// Positions as left, bottom, right and top
+		float positions[4];
+		/// Texture coordinates as left, bottom, right and top
+		float texCoords[4];
+	};
+
+	/// Returns the name of the instruction set the kernels have been compiled for
+	static const char *instructionSet();
+
+	/// Copies vertices of `numFloats` elements appending the same integer index to each one of them
+	/*! \note The destination stride is `numFloats + 1`, the index has the same size as a `float` */
+	static void copyWithIndex(float *dest, const float *src, unsigned int numVertices, unsigned int numFloats, int index);
+	/// Copies indices adding the same offset to each one of them
+	static void addOffset(unsigned short *dest, const unsigned short *src, unsigned int numIndices, unsigned short offset);
+	/// Expands quads into the four vertices of a triangle strip, made of a position and a texture coordinate
+	/*! \note Every quad writes 16 floats, vertices are bottom left, top left, bottom right and top right */
+	static void quadsToStrip(float *dest, const Quad *quads, unsigned int numQuads);
+
+	/// Scalar version of `copyWithIndex()`
+	static void copyWithIndexScalar(float *dest, const float *src, unsigned int numVertices, unsigned int numFloats, int index);
+	/// Scalar version of `addOffset()`
+	static void addOffsetScalar(unsigned short *dest, const unsigned short *src, unsigned int numIndices, unsigned short offset);
+	/// Scalar version of `quadsToStrip()`
+	static void quadsToStripScalar(float *dest, const Quad *quads, unsigned int numQuads);
+};
+
+}
+
+#endif
@@ -211,6 +211,7 @@ class DLL_PUBLIC Viewport
 
 	void calculateCullingRect();
 
+	void fixedUpdate(float timeStep);
 	void update();
 	void visit();
 	void sortAndCommitQueue();
@@ -5,19 +5,22 @@
 
 #else
 
+	// Zones are recorded by the built-in profiler when Tracy is not available
+	#include "Profiler.h"
+
 	// From Tracy.hpp
-	#define ZoneNamed(x, y)
-	#define ZoneNamedN(x, y, z)
-	#define ZoneNamedC(x, y, z)
-	#define ZoneNamedNC(x, y, z, w)
+	#define ZoneNamed(x, y) ncine::Profiler::Zone x(__FUNCTION__)
+	#define ZoneNamedN(x, y, z) ncine::Profiler::Zone x(y)
+	#define ZoneNamedC(x, y, z) ncine::Profiler::Zone x(__FUNCTION__)
+	#define ZoneNamedNC(x, y, z, w) ncine::Profiler::Zone x(y)
 
 	#define ZoneTransient(x, y)
 	#define ZoneTransientN(x, y, z)
 
-	#define ZoneScoped
-	#define ZoneScopedN(x)
-	#define ZoneScopedC(x)
-	#define ZoneScopedNC(x, y)
+	#define ZoneScoped ZoneNamed(ncineProfilerZone, true)
+	#define ZoneScopedN(x) ZoneNamedN(ncineProfilerZone, x, true)
+	#define ZoneScopedC(x) ZoneNamedC(ncineProfilerZone, x, true)
+	#define ZoneScopedNC(x, y) ZoneNamedNC(ncineProfilerZone, x, y, true)
 
 	#define ZoneText(x, y)
 	#define ZoneTextV(x, y, z)
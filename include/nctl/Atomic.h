@@ -2,7 +2,7 @@
 #define NCTL_ATOMIC
 
 #include <cstdint>
-#include <ncine/common_macros.h>
+#include <ncine/common_defines.h>
 
 #if defined(__APPLE__)
 	#include <atomic>
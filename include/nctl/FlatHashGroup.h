@@ -0,0 +1,188 @@
+#ifndef CLASS_NCTL_FLATHASHGROUP
+#define CLASS_NCTL_FLATHASHGROUP
+
+#include <cstdint>
+#include "HashFunctions.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define NCTL_FLATHASH_SSE2 (1)
+	#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	#define NCTL_FLATHASH_NEON (1)
+	#include <arm_neon.h>
+#endif
+
+#ifdef _MSC_VER
+	#include <intrin.h>
+#endif
+
+namespace nctl {
+
+namespace detail {
+
+	/// A group of control bytes of a flat hash container, probed with a single vector comparison
+	/*! Every control byte is either empty, deleted or full. A full byte stores
+	 *  seven bits of the hash of the element in the corresponding bucket. */
+	class FlatHashGroup
+	{
+	  public:
+#if NCTL_FLATHASH_NEON
+		/// Every matching byte sets a nibble of the mask
+		using Mask = uint64_t;
+#else
+		/// Every matching byte sets a bit of the mask
+		using Mask = uint32_t;
+#endif
+
+		/// Number of control bytes in a group
+		static const unsigned int Size = 16;
+		/// Control byte of an empty bucket
+		static const int8_t Empty = -128;
+		/// Control byte of a bucket whose element has been removed
+		static const int8_t Deleted = -2;
+
+		explicit FlatHashGroup(const int8_t *ctrl);
+
+		/// Returns a mask of the full buckets with the specified hash fragment
+		inline Mask match(int8_t fragment) const;
+		/// Returns a mask of the empty buckets
+		inline Mask matchEmpty() const;
+		/// Returns a mask of the empty or deleted buckets
+		inline Mask matchEmptyOrDeleted() const;
+
+		/// Returns the bucket index in the group of the first bit set in the mask
+		static inline unsigned int firstIndex(Mask mask);
+		/// Returns the mask without its first bit set
+		static inline Mask clearFirst(Mask mask) { return mask & (mask - 1); }
+
+		/// Returns true if the control byte belongs to a bucket with an element
+		static inline bool isFull(int8_t ctrl) { return ctrl >= 0; }
+
+		/// Spreads the bits of a hash so that both the group index and the fragment are well distributed
+		static inline hash_t mix(hash_t hash)
+		{
+			hash ^= hash >> 16;
+			hash *= 0x85EBCA6B;
+			hash ^= hash >> 13;
+			hash *= 0xC2B2AE35;
+			hash ^= hash >> 16;
+			return hash;
+		}
+		/// Returns the hash part used to choose the first probed group
+		static inline hash_t groupHash(hash_t mixedHash) { return mixedHash >> 7; }
+		/// Returns the seven bits hash fragment stored in the control byte
+		static inline int8_t fragment(hash_t mixedHash) { return static_cast<int8_t>(mixedHash & 0x7F); }
+
+	  private:
+#if NCTL_FLATHASH_SSE2
+		__m128i ctrl_;
+#elif NCTL_FLATHASH_NEON
+		int8x16_t ctrl_;
+
+		static inline Mask toMask(uint8x16_t cmp)
+		{
+			// Narrowing by four bits leaves a nibble per byte, the top bit of each nibble is kept
+			const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+			return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & 0x8888888888888888ULL;
+		}
+#else
+		const int8_t *ctrl_;
+#endif
+	};
+
+#if NCTL_FLATHASH_SSE2
+
+	inline FlatHashGroup::FlatHashGroup(const int8_t *ctrl)
+	    : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl))) {}
+
+	inline FlatHashGroup::Mask FlatHashGroup::match(int8_t fragment) const
+	{
+		return static_cast<Mask>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(fragment), ctrl_)));
+	}
+
+	inline FlatHashGroup::Mask FlatHashGroup::matchEmpty() const
+	{
+		return static_cast<Mask>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(Empty), ctrl_)));
+	}
+
+	inline FlatHashGroup::Mask FlatHashGroup::matchEmptyOrDeleted() const
+	{
+		// Only empty and deleted control bytes have the sign bit set
+		return static_cast<Mask>(_mm_movemask_epi8(ctrl_));
+	}
+
+#elif NCTL_FLATHASH_NEON
+
+	inline FlatHashGroup::FlatHashGroup(const int8_t *ctrl)
+	    : ctrl_(vld1q_s8(ctrl)) {}
+
+	inline FlatHashGroup::Mask FlatHashGroup::match(int8_t fragment) const
+	{
+		return toMask(vceqq_s8(vdupq_n_s8(fragment), ctrl_));
+	}
+
+	inline FlatHashGroup::Mask FlatHashGroup::matchEmpty() const
+	{
+		return toMask(vceqq_s8(vdupq_n_s8(Empty), ctrl_));
+	}
+
+	inline FlatHashGroup::Mask FlatHashGroup::matchEmptyOrDeleted() const
+	{
+		// Only empty and deleted control bytes have the sign bit set
+		return toMask(vcltq_s8(ctrl_, vdupq_n_s8(0)));
+	}
+
+#else
+
+	inline FlatHashGroup::FlatHashGroup(const int8_t *ctrl)
+	    : ctrl_(ctrl) {}
+
+	inline FlatHashGroup::Mask FlatHashGroup::match(int8_t fragment) const
+	{
+		Mask mask = 0;
+		for (unsigned int i = 0; i < Size; i++)
+			mask |= static_cast<Mask>(ctrl_[i] == fragment) << i;
+		return mask;
+	}
+
+	inline FlatHashGroup::Mask FlatHashGroup::matchEmpty() const
+	{
+		return match(Empty);
+	}
+
+	inline FlatHashGroup::Mask FlatHashGroup::matchEmptyOrDeleted() const
+	{
+		Mask mask = 0;
+		for (unsigned int i = 0; i < Size; i++)
+			mask |= static_cast<Mask>(ctrl_[i] < 0) << i;
+		return mask;
+	}
+
+#endif
+
+	inline unsigned int FlatHashGroup::firstIndex(Mask mask)
+	{
+#if NCTL_FLATHASH_NEON
+	#ifdef _MSC_VER
+		unsigned long index = 0;
+		_BitScanForward64(&index, mask);
+		return static_cast<unsigned int>(index) >> 2;
+	#else
+		return static_cast<unsigned int>(__builtin_ctzll(mask)) >> 2;
+	#endif
+#else
+	#ifdef _MSC_VER
+		unsigned long index = 0;
+		_BitScanForward(&index, mask);
+		return static_cast<unsigned int>(index);
+	#else
+		return static_cast<unsigned int>(__builtin_ctz(mask));
+	#endif
+#endif
+	}
+
+}
+
+}
+
+#endif
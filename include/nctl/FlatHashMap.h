@@ -0,0 +1,658 @@
+#ifndef CLASS_NCTL_FLATHASHMAP
+#define CLASS_NCTL_FLATHASHMAP
+
+#include <ncine/common_macros.h>
+#include "HashFunctions.h"
+#include "FlatHashGroup.h"
+#include "ReverseIterator.h"
+#include <cstring> // for memcpy()
+
+#include <ncine/config.h>
+#if NCINE_WITH_ALLOCATORS
+	#include "AllocManager.h"
+	#include "IAllocator.h"
+#endif
+
+namespace nctl {
+
+template <class K, class T, class HashFunc, bool IsConst> class FlatHashMapIterator;
+template <class K, class T, class HashFunc, bool IsConst> struct FlatHashMapHelperTraits;
+class String;
+
+/// A template based hashmap implementation with open addressing and SIMD probing of groups of control bytes
+/*! The buckets are divided in groups of sixteen, each one with a control byte storing
+ *  seven bits of the element hash. A lookup compares all the control bytes of a group at once
+ *  and only checks the keys of matching buckets.
+ *  \note The capacity is rounded up to a power of two that is not smaller than a group */
+template <class K, class T, class HashFunc = FNV1aHashFunc<K>>
+class FlatHashMap
+{
+  public:
+	/// Iterator type
+	using Iterator = FlatHashMapIterator<K, T, HashFunc, false>;
+	/// Constant iterator type
+	using ConstIterator = FlatHashMapIterator<K, T, HashFunc, true>;
+	/// Reverse iterator type
+	using ReverseIterator = nctl::ReverseIterator<Iterator>;
+	/// Reverse constant iterator type
+	using ConstReverseIterator = nctl::ReverseIterator<ConstIterator>;
+
+	explicit FlatHashMap(unsigned int capacity);
+#if NCINE_WITH_ALLOCATORS
+	FlatHashMap(unsigned int capacity, IAllocator &alloc);
+#endif
+	~FlatHashMap();
+
+	/// Copy constructor
+	FlatHashMap(const FlatHashMap &other);
+	/// Move constructor
+	FlatHashMap(FlatHashMap &&other);
+	/// Assignment operator
+	FlatHashMap &operator=(const FlatHashMap &other);
+	/// Move assignment operator
+	FlatHashMap &operator=(FlatHashMap &&other);
+
+	/// Swaps two hashmaps without copying their data
+	inline void swap(FlatHashMap &first, FlatHashMap &second)
+	{
+#if NCINE_WITH_ALLOCATORS
+		nctl::swap(first.alloc_, second.alloc_);
+#endif
+		nctl::swap(first.size_, second.size_);
+		nctl::swap(first.numDeleted_, second.numDeleted_);
+		nctl::swap(first.capacity_, second.capacity_);
+		nctl::swap(first.ctrl_, second.ctrl_);
+		nctl::swap(first.nodes_, second.nodes_);
+	}
+
+	/// Returns an iterator to the first element
+	Iterator begin();
+	/// Returns a reverse iterator to the last element
+	ReverseIterator rBegin();
+	/// Returns an iterator to past the last element
+	Iterator end();
+	/// Returns a reverse iterator to prior the first element
+	ReverseIterator rEnd();
+
+	/// Returns a constant iterator to the first element
+	ConstIterator begin() const;
+	/// Returns a constant reverse iterator to the last element
+	ConstReverseIterator rBegin() const;
+	/// Returns a constant iterator to past the last lement
+	ConstIterator end() const;
+	/// Returns a constant reverse iterator to prior the first element
+	ConstReverseIterator rEnd() const;
+
+	/// Returns a constant iterator to the first element
+	inline ConstIterator cBegin() const { return begin(); }
+	/// Returns a constant reverse iterator to the last element
+	inline ConstReverseIterator crBegin() const { return rBegin(); }
+	/// Returns a constant iterator to past the last lement
+	inline ConstIterator cEnd() const { return end(); }
+	/// Returns a constant reverse iterator to prior the first element
+	inline ConstReverseIterator crEnd() const { return rEnd(); }
+
+	/// Subscript operator
+	T &operator[](const K &key);
+	/// Inserts an element if no other has the same key
+	bool insert(const K &key, const T &value);
+	/// Moves an element if no other has the same key
+	bool insert(const K &key, T &&value);
+	/// Constructs an element if no other has the same key
+	template <typename... Args> bool emplace(const K &key, Args &&... args);
+
+	/// Returns the capacity of the hashmap
+	inline unsigned int capacity() const { return capacity_; }
+	/// Returns true if the hashmap is empty
+	inline bool isEmpty() const { return size_ == 0; }
+	/// Returns the number of elements in the hashmap
+	inline unsigned int size() const { return size_; }
+	/// Returns the ratio between used and total buckets
+	inline float loadFactor() const { return size_ / static_cast<float>(capacity_); }
+	/// Returns the hash of a given key
+	inline hash_t hash(const K &key) const { return hashFunc_(key); }
+
+	/// Clears the hashmap
+	void clear();
+	/// Checks whether an element is in the hashmap or not
+	bool contains(const K &key, T &returnedValue) const;
+	/// Checks whether an element is in the hashmap or not
+	T *find(const K &key);
+	/// Checks whether an element is in the hashmap or not (read-only)
+	const T *find(const K &key) const;
+	/// Removes a key from the hashmap, if it exists
+	bool remove(const K &key);
+
+	/// Sets the number of buckets to the new specified size and rehashes the container
+	/*! \note Rehashing with the current capacity clears the buckets marked as deleted */
+	void rehash(unsigned int count);
+
+  private:
+	using Group = detail::FlatHashGroup;
+
+	/// The template class for the node stored inside the hashmap
+	class Node
+	{
+	  public:
+		K key;
+		T value;
+
+		Node() {}
+		explicit Node(K kk)
+		    : key(kk) {}
+		Node(K kk, const T &vv)
+		    : key(kk), value(vv) {}
+		Node(K kk, T &&vv)
+		    : key(kk), value(nctl::move(vv)) {}
+		template <typename... Args>
+		Node(K kk, Args &&... args)
+		    : key(kk), value(nctl::forward<Args>(args)...) {}
+	};
+
+#if NCINE_WITH_ALLOCATORS
+	/// The custom memory allocator for the hashmap
+	IAllocator &alloc_;
+#endif
+	unsigned int size_;
+	/// Number of buckets marked as deleted, they do not stop a probe sequence
+	unsigned int numDeleted_;
+	unsigned int capacity_;
+	/// One control byte per bucket
+	int8_t *ctrl_;
+	Node *nodes_;
+	HashFunc hashFunc_;
+
+	static unsigned int calcCapacity(unsigned int capacity);
+	void allocate();
+	void initValues();
+	void destructNodes();
+	void deallocate();
+	bool findBucketIndex(const K &key, unsigned int &foundIndex) const;
+	bool findOrPrepareInsert(const K &key, unsigned int &bucketIndex, int8_t &fragment) const;
+	void markFull(unsigned int index, int8_t fragment);
+
+	friend class FlatHashMapIterator<K, T, HashFunc, false>;
+	friend class FlatHashMapIterator<K, T, HashFunc, true>;
+	friend struct FlatHashMapHelperTraits<K, T, HashFunc, false>;
+	friend struct FlatHashMapHelperTraits<K, T, HashFunc, true>;
+};
+
+template <class K, class T, class HashFunc>
+inline typename FlatHashMap<K, T, HashFunc>::Iterator FlatHashMap<K, T, HashFunc>::begin()
+{
+	Iterator iterator(this, Iterator::SentinelTagInit::BEGINNING);
+	return ++iterator;
+}
+
+template <class K, class T, class HashFunc>
+typename FlatHashMap<K, T, HashFunc>::ReverseIterator FlatHashMap<K, T, HashFunc>::rBegin()
+{
+	Iterator iterator(this, Iterator::SentinelTagInit::END);
+	return ReverseIterator(--iterator);
+}
+
+template <class K, class T, class HashFunc>
+typename FlatHashMap<K, T, HashFunc>::Iterator FlatHashMap<K, T, HashFunc>::end()
+{
+	return Iterator(this, Iterator::SentinelTagInit::END);
+}
+
+template <class K, class T, class HashFunc>
+typename FlatHashMap<K, T, HashFunc>::ReverseIterator FlatHashMap<K, T, HashFunc>::rEnd()
+{
+	Iterator iterator(this, Iterator::SentinelTagInit::BEGINNING);
+	return ReverseIterator(iterator);
+}
+
+template <class K, class T, class HashFunc>
+typename FlatHashMap<K, T, HashFunc>::ConstIterator FlatHashMap<K, T, HashFunc>::begin() const
+{
+	ConstIterator iterator(this, ConstIterator::SentinelTagInit::BEGINNING);
+	return ++iterator;
+}
+
+template <class K, class T, class HashFunc>
+typename FlatHashMap<K, T, HashFunc>::ConstReverseIterator FlatHashMap<K, T, HashFunc>::rBegin() const
+{
+	ConstIterator iterator(this, ConstIterator::SentinelTagInit::END);
+	return ConstReverseIterator(--iterator);
+}
+
+template <class K, class T, class HashFunc>
+typename FlatHashMap<K, T, HashFunc>::ConstIterator FlatHashMap<K, T, HashFunc>::end() const
+{
+	return ConstIterator(this, ConstIterator::SentinelTagInit::END);
+}
+
+template <class K, class T, class HashFunc>
+typename FlatHashMap<K, T, HashFunc>::ConstReverseIterator FlatHashMap<K, T, HashFunc>::rEnd() const
+{
+	ConstIterator iterator(this, ConstIterator::SentinelTagInit::BEGINNING);
+	return ConstReverseIterator(iterator);
+}
+
+template <class K, class T, class HashFunc>
+FlatHashMap<K, T, HashFunc>::FlatHashMap(unsigned int capacity)
+    :
+#if NCINE_WITH_ALLOCATORS
+      alloc_(theDefaultAllocator()),
+#endif
+      size_(0), numDeleted_(0), capacity_(0), ctrl_(nullptr), nodes_(nullptr)
+{
+	FATAL_ASSERT_MSG(capacity > 0, "Zero is not a valid capacity");
+
+	capacity_ = calcCapacity(capacity);
+	allocate();
+	initValues();
+}
+
+#if NCINE_WITH_ALLOCATORS
+template <class K, class T, class HashFunc>
+FlatHashMap<K, T, HashFunc>::FlatHashMap(unsigned int capacity, IAllocator &alloc)
+    : alloc_(alloc), size_(0), numDeleted_(0), capacity_(0), ctrl_(nullptr), nodes_(nullptr)
+{
+	FATAL_ASSERT_MSG(capacity > 0, "Zero is not a valid capacity");
+
+	capacity_ = calcCapacity(capacity);
+	allocate();
+	initValues();
+}
+#endif
+
+template <class K, class T, class HashFunc>
+FlatHashMap<K, T, HashFunc>::~FlatHashMap()
+{
+	destructNodes();
+	deallocate();
+}
+
+template <class K, class T, class HashFunc>
+FlatHashMap<K, T, HashFunc>::FlatHashMap(const FlatHashMap<K, T, HashFunc> &other)
+    :
+#if NCINE_WITH_ALLOCATORS
+      alloc_(other.alloc_),
+#endif
+      size_(other.size_), numDeleted_(other.numDeleted_), capacity_(other.capacity_), ctrl_(nullptr), nodes_(nullptr)
+{
+	allocate();
+	memcpy(ctrl_, other.ctrl_, capacity_);
+
+	for (unsigned int i = 0; i < capacity_; i++)
+	{
+		if (Group::isFull(ctrl_[i]))
+			new (nodes_ + i) Node(other.nodes_[i]);
+	}
+}
+
+template <class K, class T, class HashFunc>
+FlatHashMap<K, T, HashFunc>::FlatHashMap(FlatHashMap<K, T, HashFunc> &&other)
+    :
+#if NCINE_WITH_ALLOCATORS
+      alloc_(other.alloc_),
+#endif
+      size_(other.size_), numDeleted_(other.numDeleted_), capacity_(other.capacity_), ctrl_(other.ctrl_), nodes_(other.nodes_)
+{
+	other.size_ = 0;
+	other.numDeleted_ = 0;
+	other.capacity_ = 0;
+	other.ctrl_ = nullptr;
+	other.nodes_ = nullptr;
+}
+
+template <class K, class T, class HashFunc>
+FlatHashMap<K, T, HashFunc> &FlatHashMap<K, T, HashFunc>::operator=(const FlatHashMap<K, T, HashFunc> &other)
+{
+	if (this == &other)
+		return *this;
+
+	// Elements are copied bucket by bucket, the two layouts need to be the same
+	if (other.capacity_ != capacity_)
+	{
+		destructNodes();
+		deallocate();
+
+		capacity_ = other.capacity_;
+		allocate();
+		initValues();
+	}
+
+	for (unsigned int i = 0; i < capacity_; i++)
+	{
+		if (Group::isFull(other.ctrl_[i]))
+		{
+			if (Group::isFull(ctrl_[i]))
+				nodes_[i] = other.nodes_[i];
+			else
+				new (nodes_ + i) Node(other.nodes_[i]);
+		}
+		else if (Group::isFull(ctrl_[i]))
+			destructObject(nodes_ + i);
+
+		ctrl_[i] = other.ctrl_[i];
+	}
+	size_ = other.size_;
+	numDeleted_ = other.numDeleted_;
+
+	return *this;
+}
+
+template <class K, class T, class HashFunc>
+FlatHashMap<K, T, HashFunc> &FlatHashMap<K, T, HashFunc>::operator=(FlatHashMap<K, T, HashFunc> &&other)
+{
+	if (this != &other)
+	{
+		swap(*this, other);
+		other.clear();
+	}
+	return *this;
+}
+
+template <class K, class T, class HashFunc>
+T &FlatHashMap<K, T, HashFunc>::operator[](const K &key)
+{
+	unsigned int bucketIndex = 0;
+	int8_t fragment = 0;
+	if (findOrPrepareInsert(key, bucketIndex, fragment))
+		return nodes_[bucketIndex].value;
+
+	new (nodes_ + bucketIndex) Node(key);
+	markFull(bucketIndex, fragment);
+	return nodes_[bucketIndex].value;
+}
+
+/*! \return True if the element has been inserted */
+template <class K, class T, class HashFunc>
+bool FlatHashMap<K, T, HashFunc>::insert(const K &key, const T &value)
+{
+	unsigned int bucketIndex = 0;
+	int8_t fragment = 0;
+	if (findOrPrepareInsert(key, bucketIndex, fragment))
+		return false;
+
+	new (nodes_ + bucketIndex) Node(key, value);
+	markFull(bucketIndex, fragment);
+	return true;
+}
+
+/*! \return True if the element has been inserted */
+template <class K, class T, class HashFunc>
+bool FlatHashMap<K, T, HashFunc>::insert(const K &key, T &&value)
+{
+	unsigned int bucketIndex = 0;
+	int8_t fragment = 0;
+	if (findOrPrepareInsert(key, bucketIndex, fragment))
+		return false;
+
+	new (nodes_ + bucketIndex) Node(key, nctl::move(value));
+	markFull(bucketIndex, fragment);
+	return true;
+}
+
+/*! \return True if the element has been emplaced */
+template <class K, class T, class HashFunc>
+template <typename... Args>
+bool FlatHashMap<K, T, HashFunc>::emplace(const K &key, Args &&... args)
+{
+	unsigned int bucketIndex = 0;
+	int8_t fragment = 0;
+	if (findOrPrepareInsert(key, bucketIndex, fragment))
+		return false;
+
+	new (nodes_ + bucketIndex) Node(key, nctl::forward<Args>(args)...);
+	markFull(bucketIndex, fragment);
+	return true;
+}
+
+template <class K, class T, class HashFunc>
+void FlatHashMap<K, T, HashFunc>::clear()
+{
+	destructNodes();
+	initValues();
+}
+
+template <class K, class T, class HashFunc>
+bool FlatHashMap<K, T, HashFunc>::contains(const K &key, T &returnedValue) const
+{
+	unsigned int bucketIndex = 0;
+	const bool found = findBucketIndex(key, bucketIndex);
+
+	if (found)
+		returnedValue = nodes_[bucketIndex].value;
+
+	return found;
+}
+
+/*! \note Prefer this method if copying `T` is expensive, but always check the validity of returned pointer. */
+template <class K, class T, class HashFunc>
+T *FlatHashMap<K, T, HashFunc>::find(const K &key)
+{
+	unsigned int bucketIndex = 0;
+	const bool found = findBucketIndex(key, bucketIndex);
+
+	T *returnedPtr = nullptr;
+	if (found)
+		returnedPtr = &nodes_[bucketIndex].value;
+
+	return returnedPtr;
+}
+
+/*! \note Prefer this method if copying `T` is expensive, but always check the validity of returned pointer. */
+template <class K, class T, class HashFunc>
+const T *FlatHashMap<K, T, HashFunc>::find(const K &key) const
+{
+	unsigned int bucketIndex = 0;
+	const bool found = findBucketIndex(key, bucketIndex);
+
+	const T *returnedPtr = nullptr;
+	if (found)
+		returnedPtr = &nodes_[bucketIndex].value;
+
+	return returnedPtr;
+}
+
+/*! \return True if the element has been found and removed
+ *  \note Other elements are never moved by a removal */
+template <class K, class T, class HashFunc>
+bool FlatHashMap<K, T, HashFunc>::remove(const K &key)
+{
+	unsigned int bucketIndex = 0;
+	const bool found = findBucketIndex(key, bucketIndex);
+
+	if (found)
+	{
+		destructObject(nodes_ + bucketIndex);
+		size_--;
+
+		if (size_ == 0)
+			initValues();
+		else
+		{
+			// A probe sequence never goes past a group with an empty bucket, no need to mark it as deleted
+			const Group group(ctrl_ + (bucketIndex & ~(Group::Size - 1)));
+			if (group.matchEmpty())
+				ctrl_[bucketIndex] = Group::Empty;
+			else
+			{
+				ctrl_[bucketIndex] = Group::Deleted;
+				numDeleted_++;
+			}
+		}
+	}
+
+	return found;
+}
+
+template <class K, class T, class HashFunc>
+void FlatHashMap<K, T, HashFunc>::rehash(unsigned int count)
+{
+	if (size_ == 0 || count < size_)
+		return;
+
+#if !NCINE_WITH_ALLOCATORS
+	FlatHashMap<K, T, HashFunc> hashMap(count);
+#else
+	FlatHashMap<K, T, HashFunc> hashMap(count, alloc_);
+#endif
+
+	unsigned int rehashedNodes = 0;
+	for (unsigned int i = 0; i < capacity_; i++)
+	{
+		if (Group::isFull(ctrl_[i]))
+		{
+			Node &node = nodes_[i];
+			hashMap.insert(node.key, nctl::move(node.value));
+
+			rehashedNodes++;
+			if (rehashedNodes == size_)
+				break;
+		}
+	}
+
+	*this = nctl::move(hashMap);
+}
+
+template <class K, class T, class HashFunc>
+unsigned int FlatHashMap<K, T, HashFunc>::calcCapacity(unsigned int capacity)
+{
+	unsigned int roundedCapacity = Group::Size;
+	while (roundedCapacity < capacity)
+		roundedCapacity *= 2;
+	return roundedCapacity;
+}
+
+template <class K, class T, class HashFunc>
+void FlatHashMap<K, T, HashFunc>::allocate()
+{
+#if !NCINE_WITH_ALLOCATORS
+	ctrl_ = static_cast<int8_t *>(::operator new(capacity_));
+	nodes_ = static_cast<Node *>(::operator new(sizeof(Node) * capacity_));
+#else
+	ctrl_ = static_cast<int8_t *>(alloc_.allocate(capacity_, Group::Size));
+	nodes_ = static_cast<Node *>(alloc_.allocate(sizeof(Node) * capacity_));
+#endif
+}
+
+template <class K, class T, class HashFunc>
+void FlatHashMap<K, T, HashFunc>::initValues()
+{
+	memset(ctrl_, Group::Empty, capacity_);
+	numDeleted_ = 0;
+}
+
+template <class K, class T, class HashFunc>
+void FlatHashMap<K, T, HashFunc>::destructNodes()
+{
+	for (unsigned int i = 0; i < capacity_; i++)
+	{
+		if (Group::isFull(ctrl_[i]))
+		{
+			destructObject(nodes_ + i);
+			ctrl_[i] = Group::Empty;
+		}
+	}
+	size_ = 0;
+}
+
+template <class K, class T, class HashFunc>
+void FlatHashMap<K, T, HashFunc>::deallocate()
+{
+#if !NCINE_WITH_ALLOCATORS
+	::operator delete(ctrl_);
+	::operator delete(nodes_);
+#else
+	alloc_.deallocate(ctrl_);
+	alloc_.deallocate(nodes_);
+#endif
+}
+
+template <class K, class T, class HashFunc>
+bool FlatHashMap<K, T, HashFunc>::findBucketIndex(const K &key, unsigned int &foundIndex) const
+{
+	if (size_ == 0)
+		return false;
+
+	const hash_t mixedHash = Group::mix(hashFunc_(key));
+	const int8_t fragment = Group::fragment(mixedHash);
+	const unsigned int groupMask = capacity_ / Group::Size - 1;
+	unsigned int groupIndex = Group::groupHash(mixedHash) & groupMask;
+
+	// Triangular probing visits every group once when their number is a power of two
+	for (unsigned int i = 0; i <= groupMask; i++)
+	{
+		const unsigned int firstBucket = groupIndex * Group::Size;
+		const Group group(ctrl_ + firstBucket);
+		for (Group::Mask mask = group.match(fragment); mask != 0; mask = Group::clearFirst(mask))
+		{
+			const unsigned int index = firstBucket + Group::firstIndex(mask);
+			if (equalTo(nodes_[index].key, key))
+			{
+				foundIndex = index;
+				return true;
+			}
+		}
+
+		if (group.matchEmpty())
+			return false;
+		groupIndex = (groupIndex + i + 1) & groupMask;
+	}
+
+	return false;
+}
+
+/*! \return True if the key has been found, otherwise the bucket index is where it should be inserted */
+template <class K, class T, class HashFunc>
+bool FlatHashMap<K, T, HashFunc>::findOrPrepareInsert(const K &key, unsigned int &bucketIndex, int8_t &fragment) const
+{
+	const hash_t mixedHash = Group::mix(hashFunc_(key));
+	fragment = Group::fragment(mixedHash);
+	const unsigned int groupMask = capacity_ / Group::Size - 1;
+	unsigned int groupIndex = Group::groupHash(mixedHash) & groupMask;
+
+	bool insertFound = false;
+	for (unsigned int i = 0; i <= groupMask; i++)
+	{
+		const unsigned int firstBucket = groupIndex * Group::Size;
+		const Group group(ctrl_ + firstBucket);
+		for (Group::Mask mask = group.match(fragment); mask != 0; mask = Group::clearFirst(mask))
+		{
+			const unsigned int index = firstBucket + Group::firstIndex(mask);
+			if (equalTo(nodes_[index].key, key))
+			{
+				bucketIndex = index;
+				return true;
+			}
+		}
+
+		// The first empty or deleted bucket of the sequence is reused, but the search continues up to an empty one
+		if (insertFound == false)
+		{
+			const Group::Mask mask = group.matchEmptyOrDeleted();
+			if (mask != 0)
+			{
+				bucketIndex = firstBucket + Group::firstIndex(mask);
+				insertFound = true;
+			}
+		}
+
+		if (group.matchEmpty())
+			break;
+		groupIndex = (groupIndex + i + 1) & groupMask;
+	}
+
+	FATAL_ASSERT(size_ < capacity_);
+	FATAL_ASSERT(insertFound);
+	return false;
+}
+
+template <class K, class T, class HashFunc>
+void FlatHashMap<K, T, HashFunc>::markFull(unsigned int index, int8_t fragment)
+{
+	if (ctrl_[index] == Group::Deleted)
+		numDeleted_--;
+	ctrl_[index] = fragment;
+	size_++;
+}
+
+}
+
+#endif
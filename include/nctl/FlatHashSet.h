@@ -0,0 +1,600 @@
+#ifndef CLASS_NCTL_FLATHASHSET
+#define CLASS_NCTL_FLATHASHSET
+
+#include <ncine/common_macros.h>
+#include "HashFunctions.h"
+#include "FlatHashGroup.h"
+#include "ReverseIterator.h"
+#include <cstring> // for memcpy()
+
+#include <ncine/config.h>
+#if NCINE_WITH_ALLOCATORS
+	#include "AllocManager.h"
+	#include "IAllocator.h"
+#endif
+
+namespace nctl {
+
+template <class K, class HashFunc> class FlatHashSetIterator;
+template <class K, class HashFunc> struct FlatHashSetHelperTraits;
+class String;
+
+/// A template based hashset implementation with open addressing and SIMD probing of groups of control bytes
+/*! The buckets are divided in groups of sixteen, each one with a control byte storing
+ *  seven bits of the element hash. A lookup compares all the control bytes of a group at once
+ *  and only checks the keys of matching buckets.
+ *  \note The capacity is rounded up to a power of two that is not smaller than a group */
+template <class K, class HashFunc = FNV1aHashFunc<K>>
+class FlatHashSet
+{
+  public:
+	/// Iterator type
+	/*! Elements in the hashset can never be changed */
+	using Iterator = FlatHashSetIterator<K, HashFunc>;
+	/// Constant iterator type
+	using ConstIterator = FlatHashSetIterator<K, HashFunc>;
+	/// Reverse iterator type
+	using ReverseIterator = nctl::ReverseIterator<Iterator>;
+	/// Reverse constant iterator type
+	using ConstReverseIterator = nctl::ReverseIterator<ConstIterator>;
+
+	explicit FlatHashSet(unsigned int capacity);
+#if NCINE_WITH_ALLOCATORS
+	FlatHashSet(unsigned int capacity, IAllocator &alloc);
+#endif
+	~FlatHashSet();
+
+	/// Copy constructor
+	FlatHashSet(const FlatHashSet &other);
+	/// Move constructor
+	FlatHashSet(FlatHashSet &&other);
+	/// Assignment operator
+	FlatHashSet &operator=(const FlatHashSet &other);
+	/// Move assignment operator
+	FlatHashSet &operator=(FlatHashSet &&other);
+
+	/// Swaps two hashsets without copying their data
+	inline void swap(FlatHashSet &first, FlatHashSet &second)
+	{
+#if NCINE_WITH_ALLOCATORS
+		nctl::swap(first.alloc_, second.alloc_);
+#endif
+		nctl::swap(first.size_, second.size_);
+		nctl::swap(first.numDeleted_, second.numDeleted_);
+		nctl::swap(first.capacity_, second.capacity_);
+		nctl::swap(first.ctrl_, second.ctrl_);
+		nctl::swap(first.keys_, second.keys_);
+	}
+
+	/// Returns a constant iterator to the first element
+	ConstIterator begin();
+	/// Returns a reverse constant iterator to the last element
+	ConstReverseIterator rBegin();
+	/// Returns a constant iterator to past the last element
+	ConstIterator end();
+	/// Returns a reverse constant iterator to prior the first element
+	ConstReverseIterator rEnd();
+
+	/// Returns a constant iterator to the first element
+	ConstIterator begin() const;
+	/// Returns a constant reverse iterator to the last element
+	ConstReverseIterator rBegin() const;
+	/// Returns a constant iterator to past the last lement
+	ConstIterator end() const;
+	/// Returns a constant reverse iterator to prior the first element
+	ConstReverseIterator rEnd() const;
+
+	/// Returns a constant iterator to the first element
+	inline ConstIterator cBegin() const { return begin(); }
+	/// Returns a constant reverse iterator to the last element
+	inline ConstReverseIterator crBegin() const { return rBegin(); }
+	/// Returns a constant iterator to past the last lement
+	inline ConstIterator cEnd() const { return end(); }
+	/// Returns a constant reverse iterator to prior the first element
+	inline ConstReverseIterator crEnd() const { return rEnd(); }
+
+	/// Inserts an element if not already in
+	bool insert(const K &key);
+	/// Moves an element if not already in
+	bool insert(K &&key);
+
+	/// Returns the capacity of the hashset
+	inline unsigned int capacity() const { return capacity_; }
+	/// Returns true if the hashset is empty
+	inline bool isEmpty() const { return size_ == 0; }
+	/// Returns the number of elements in the hashset
+	inline unsigned int size() const { return size_; }
+	/// Returns the ratio between used and total buckets
+	inline float loadFactor() const { return size_ / static_cast<float>(capacity_); }
+	/// Returns the hash of a given key
+	inline hash_t hash(const K &key) const { return hashFunc_(key); }
+
+	/// Clears the hashset
+	void clear();
+	/// Checks whether an element is in the hashset or not
+	bool contains(const K &key) const;
+	/// Checks whether an element is in the hashset or not
+	K *find(const K &key);
+	/// Checks whether an element is in the hashset or not (read-only)
+	const K *find(const K &key) const;
+	/// Removes a key from the hashset, if it exists
+	bool remove(const K &key);
+
+	/// Sets the number of buckets to the new specified size and rehashes the container
+	/*! \note Rehashing with the current capacity clears the buckets marked as deleted */
+	void rehash(unsigned int count);
+
+  private:
+	using Group = detail::FlatHashGroup;
+
+#if NCINE_WITH_ALLOCATORS
+	/// The custom memory allocator for the hashset
+	IAllocator &alloc_;
+#endif
+	unsigned int size_;
+	/// Number of buckets marked as deleted, they do not stop a probe sequence
+	unsigned int numDeleted_;
+	unsigned int capacity_;
+	/// One control byte per bucket
+	int8_t *ctrl_;
+	K *keys_;
+	HashFunc hashFunc_;
+
+	static unsigned int calcCapacity(unsigned int capacity);
+	void allocate();
+	void initValues();
+	void destructKeys();
+	void deallocate();
+	bool findBucketIndex(const K &key, unsigned int &foundIndex) const;
+	bool findOrPrepareInsert(const K &key, unsigned int &bucketIndex, int8_t &fragment) const;
+	void markFull(unsigned int index, int8_t fragment);
+
+	friend class FlatHashSetIterator<K, HashFunc>;
+	friend struct FlatHashSetHelperTraits<K, HashFunc>;
+};
+
+template <class K, class HashFunc>
+inline typename FlatHashSet<K, HashFunc>::ConstIterator FlatHashSet<K, HashFunc>::begin()
+{
+	ConstIterator iterator(this, ConstIterator::SentinelTagInit::BEGINNING);
+	return ++iterator;
+}
+
+template <class K, class HashFunc>
+typename FlatHashSet<K, HashFunc>::ConstReverseIterator FlatHashSet<K, HashFunc>::rBegin()
+{
+	ConstIterator iterator(this, ConstIterator::SentinelTagInit::END);
+	return ConstReverseIterator(--iterator);
+}
+
+template <class K, class HashFunc>
+typename FlatHashSet<K, HashFunc>::ConstIterator FlatHashSet<K, HashFunc>::end()
+{
+	return ConstIterator(this, ConstIterator::SentinelTagInit::END);
+}
+
+template <class K, class HashFunc>
+typename FlatHashSet<K, HashFunc>::ConstReverseIterator FlatHashSet<K, HashFunc>::rEnd()
+{
+	ConstIterator iterator(this, ConstIterator::SentinelTagInit::BEGINNING);
+	return ConstReverseIterator(iterator);
+}
+
+template <class K, class HashFunc>
+typename FlatHashSet<K, HashFunc>::ConstIterator FlatHashSet<K, HashFunc>::begin() const
+{
+	ConstIterator iterator(this, ConstIterator::SentinelTagInit::BEGINNING);
+	return ++iterator;
+}
+
+template <class K, class HashFunc>
+typename FlatHashSet<K, HashFunc>::ConstReverseIterator FlatHashSet<K, HashFunc>::rBegin() const
+{
+	ConstIterator iterator(this, ConstIterator::SentinelTagInit::END);
+	return ConstReverseIterator(--iterator);
+}
+
+template <class K, class HashFunc>
+typename FlatHashSet<K, HashFunc>::ConstIterator FlatHashSet<K, HashFunc>::end() const
+{
+	return ConstIterator(this, ConstIterator::SentinelTagInit::END);
+}
+
+template <class K, class HashFunc>
+typename FlatHashSet<K, HashFunc>::ConstReverseIterator FlatHashSet<K, HashFunc>::rEnd() const
+{
+	ConstIterator iterator(this, ConstIterator::SentinelTagInit::BEGINNING);
+	return ConstReverseIterator(iterator);
+}
+
+template <class K, class HashFunc>
+FlatHashSet<K, HashFunc>::FlatHashSet(unsigned int capacity)
+    :
+#if NCINE_WITH_ALLOCATORS
+      alloc_(theDefaultAllocator()),
+#endif
+      size_(0), numDeleted_(0), capacity_(0), ctrl_(nullptr), keys_(nullptr)
+{
+	FATAL_ASSERT_MSG(capacity > 0, "Zero is not a valid capacity");
+
+	capacity_ = calcCapacity(capacity);
+	allocate();
+	initValues();
+}
+
+#if NCINE_WITH_ALLOCATORS
+template <class K, class HashFunc>
+FlatHashSet<K, HashFunc>::FlatHashSet(unsigned int capacity, IAllocator &alloc)
+    : alloc_(alloc), size_(0), numDeleted_(0), capacity_(0), ctrl_(nullptr), keys_(nullptr)
+{
+	FATAL_ASSERT_MSG(capacity > 0, "Zero is not a valid capacity");
+
+	capacity_ = calcCapacity(capacity);
+	allocate();
+	initValues();
+}
+#endif
+
+template <class K, class HashFunc>
+FlatHashSet<K, HashFunc>::~FlatHashSet()
+{
+	destructKeys();
+	deallocate();
+}
+
+template <class K, class HashFunc>
+FlatHashSet<K, HashFunc>::FlatHashSet(const FlatHashSet<K, HashFunc> &other)
+    :
+#if NCINE_WITH_ALLOCATORS
+      alloc_(other.alloc_),
+#endif
+      size_(other.size_), numDeleted_(other.numDeleted_), capacity_(other.capacity_), ctrl_(nullptr), keys_(nullptr)
+{
+	allocate();
+	memcpy(ctrl_, other.ctrl_, capacity_);
+
+	for (unsigned int i = 0; i < capacity_; i++)
+	{
+		if (Group::isFull(ctrl_[i]))
+			new (keys_ + i) K(other.keys_[i]);
+	}
+}
+
+template <class K, class HashFunc>
+FlatHashSet<K, HashFunc>::FlatHashSet(FlatHashSet<K, HashFunc> &&other)
+    :
+#if NCINE_WITH_ALLOCATORS
+      alloc_(other.alloc_),
+#endif
+      size_(other.size_), numDeleted_(other.numDeleted_), capacity_(other.capacity_), ctrl_(other.ctrl_), keys_(other.keys_)
+{
+	other.size_ = 0;
+	other.numDeleted_ = 0;
+	other.capacity_ = 0;
+	other.ctrl_ = nullptr;
+	other.keys_ = nullptr;
+}
+
+template <class K, class HashFunc>
+FlatHashSet<K, HashFunc> &FlatHashSet<K, HashFunc>::operator=(const FlatHashSet<K, HashFunc> &other)
+{
+	if (this == &other)
+		return *this;
+
+	// Elements are copied bucket by bucket, the two layouts need to be the same
+	if (other.capacity_ != capacity_)
+	{
+		destructKeys();
+		deallocate();
+
+		capacity_ = other.capacity_;
+		allocate();
+		initValues();
+	}
+
+	for (unsigned int i = 0; i < capacity_; i++)
+	{
+		if (Group::isFull(other.ctrl_[i]))
+		{
+			if (Group::isFull(ctrl_[i]))
+				keys_[i] = other.keys_[i];
+			else
+				new (keys_ + i) K(other.keys_[i]);
+		}
+		else if (Group::isFull(ctrl_[i]))
+			destructObject(keys_ + i);
+
+		ctrl_[i] = other.ctrl_[i];
+	}
+	size_ = other.size_;
+	numDeleted_ = other.numDeleted_;
+
+	return *this;
+}
+
+template <class K, class HashFunc>
+FlatHashSet<K, HashFunc> &FlatHashSet<K, HashFunc>::operator=(FlatHashSet<K, HashFunc> &&other)
+{
+	if (this != &other)
+	{
+		swap(*this, other);
+		other.clear();
+	}
+	return *this;
+}
+
+/*! \return True if the element has been inserted */
+template <class K, class HashFunc>
+bool FlatHashSet<K, HashFunc>::insert(const K &key)
+{
+	unsigned int bucketIndex = 0;
+	int8_t fragment = 0;
+	if (findOrPrepareInsert(key, bucketIndex, fragment))
+		return false;
+
+	new (keys_ + bucketIndex) K(key);
+	markFull(bucketIndex, fragment);
+	return true;
+}
+
+/*! \return True if the element has been inserted */
+template <class K, class HashFunc>
+bool FlatHashSet<K, HashFunc>::insert(K &&key)
+{
+	unsigned int bucketIndex = 0;
+	int8_t fragment = 0;
+	if (findOrPrepareInsert(key, bucketIndex, fragment))
+		return false;
+
+	new (keys_ + bucketIndex) K(nctl::move(key));
+	markFull(bucketIndex, fragment);
+	return true;
+}
+
+template <class K, class HashFunc>
+void FlatHashSet<K, HashFunc>::clear()
+{
+	destructKeys();
+	initValues();
+}
+
+template <class K, class HashFunc>
+bool FlatHashSet<K, HashFunc>::contains(const K &key) const
+{
+	unsigned int bucketIndex = 0;
+	return findBucketIndex(key, bucketIndex);
+}
+
+/*! \note Prefer this method if copying `K` is expensive, but always check the validity of returned pointer. */
+template <class K, class HashFunc>
+K *FlatHashSet<K, HashFunc>::find(const K &key)
+{
+	unsigned int bucketIndex = 0;
+	const bool found = findBucketIndex(key, bucketIndex);
+
+	K *returnedPtr = nullptr;
+	if (found)
+		returnedPtr = &keys_[bucketIndex];
+
+	return returnedPtr;
+}
+
+/*! \note Prefer this method if copying `K` is expensive, but always check the validity of returned pointer. */
+template <class K, class HashFunc>
+const K *FlatHashSet<K, HashFunc>::find(const K &key) const
+{
+	unsigned int bucketIndex = 0;
+	const bool found = findBucketIndex(key, bucketIndex);
+
+	const K *returnedPtr = nullptr;
+	if (found)
+		returnedPtr = &keys_[bucketIndex];
+
+	return returnedPtr;
+}
+
+/*! \return True if the element has been found and removed
+ *  \note Other elements are never moved by a removal */
+template <class K, class HashFunc>
+bool FlatHashSet<K, HashFunc>::remove(const K &key)
+{
+	unsigned int bucketIndex = 0;
+	const bool found = findBucketIndex(key, bucketIndex);
+
+	if (found)
+	{
+		destructObject(keys_ + bucketIndex);
+		size_--;
+
+		if (size_ == 0)
+			initValues();
+		else
+		{
+			// A probe sequence never goes past a group with an empty bucket, no need to mark it as deleted
+			const Group group(ctrl_ + (bucketIndex & ~(Group::Size - 1)));
+			if (group.matchEmpty())
+				ctrl_[bucketIndex] = Group::Empty;
+			else
+			{
+				ctrl_[bucketIndex] = Group::Deleted;
+				numDeleted_++;
+			}
+		}
+	}
+
+	return found;
+}
+
+template <class K, class HashFunc>
+void FlatHashSet<K, HashFunc>::rehash(unsigned int count)
+{
+	if (size_ == 0 || count < size_)
+		return;
+
+#if !NCINE_WITH_ALLOCATORS
+	FlatHashSet<K, HashFunc> hashSet(count);
+#else
+	FlatHashSet<K, HashFunc> hashSet(count, alloc_);
+#endif
+
+	unsigned int rehashedNodes = 0;
+	for (unsigned int i = 0; i < capacity_; i++)
+	{
+		if (Group::isFull(ctrl_[i]))
+		{
+			hashSet.insert(nctl::move(keys_[i]));
+
+			rehashedNodes++;
+			if (rehashedNodes == size_)
+				break;
+		}
+	}
+
+	*this = nctl::move(hashSet);
+}
+
+template <class K, class HashFunc>
+unsigned int FlatHashSet<K, HashFunc>::calcCapacity(unsigned int capacity)
+{
+	unsigned int roundedCapacity = Group::Size;
+	while (roundedCapacity < capacity)
+		roundedCapacity *= 2;
+	return roundedCapacity;
+}
+
+template <class K, class HashFunc>
+void FlatHashSet<K, HashFunc>::allocate()
+{
+#if !NCINE_WITH_ALLOCATORS
+	ctrl_ = static_cast<int8_t *>(::operator new(capacity_));
+	keys_ = static_cast<K *>(::operator new(sizeof(K) * capacity_));
+#else
+	ctrl_ = static_cast<int8_t *>(alloc_.allocate(capacity_, Group::Size));
+	keys_ = static_cast<K *>(alloc_.allocate(sizeof(K) * capacity_));
+#endif
+}
+
+template <class K, class HashFunc>
+void FlatHashSet<K, HashFunc>::initValues()
+{
+	memset(ctrl_, Group::Empty, capacity_);
+	numDeleted_ = 0;
+}
+
+template <class K, class HashFunc>
+void FlatHashSet<K, HashFunc>::destructKeys()
+{
+	for (unsigned int i = 0; i < capacity_; i++)
+	{
+		if (Group::isFull(ctrl_[i]))
+		{
+			destructObject(keys_ + i);
+			ctrl_[i] = Group::Empty;
+		}
+	}
+	size_ = 0;
+}
+
+template <class K, class HashFunc>
+void FlatHashSet<K, HashFunc>::deallocate()
+{
+#if !NCINE_WITH_ALLOCATORS
+	::operator delete(ctrl_);
+	::operator delete(keys_);
+#else
+	alloc_.deallocate(ctrl_);
+	alloc_.deallocate(keys_);
+#endif
+}
+
+template <class K, class HashFunc>
+bool FlatHashSet<K, HashFunc>::findBucketIndex(const K &key, unsigned int &foundIndex) const
+{
+	if (size_ == 0)
+		return false;
+
+	const hash_t mixedHash = Group::mix(hashFunc_(key));
+	const int8_t fragment = Group::fragment(mixedHash);
+	const unsigned int groupMask = capacity_ / Group::Size - 1;
+	unsigned int groupIndex = Group::groupHash(mixedHash) & groupMask;
+
+	// Triangular probing visits every group once when their number is a power of two
+	for (unsigned int i = 0; i <= groupMask; i++)
+	{
+		const unsigned int firstBucket = groupIndex * Group::Size;
+		const Group group(ctrl_ + firstBucket);
+		for (Group::Mask mask = group.match(fragment); mask != 0; mask = Group::clearFirst(mask))
+		{
+			const unsigned int index = firstBucket + Group::firstIndex(mask);
+			if (equalTo(keys_[index], key))
+			{
+				foundIndex = index;
+				return true;
+			}
+		}
+
+		if (group.matchEmpty())
+			return false;
+		groupIndex = (groupIndex + i + 1) & groupMask;
+	}
+
+	return false;
+}
+
+/*! \return True if the key has been found, otherwise the bucket index is where it should be inserted */
+template <class K, class HashFunc>
+bool FlatHashSet<K, HashFunc>::findOrPrepareInsert(const K &key, unsigned int &bucketIndex, int8_t &fragment) const
+{
+	const hash_t mixedHash = Group::mix(hashFunc_(key));
+	fragment = Group::fragment(mixedHash);
+	const unsigned int groupMask = capacity_ / Group::Size - 1;
+	unsigned int groupIndex = Group::groupHash(mixedHash) & groupMask;
+
+	bool insertFound = false;
+	for (unsigned int i = 0; i <= groupMask; i++)
+	{
+		const unsigned int firstBucket = groupIndex * Group::Size;
+		const Group group(ctrl_ + firstBucket);
+		for (Group::Mask mask = group.match(fragment); mask != 0; mask = Group::clearFirst(mask))
+		{
+			const unsigned int index = firstBucket + Group::firstIndex(mask);
+			if (equalTo(keys_[index], key))
+			{
+				bucketIndex = index;
+				return true;
+			}
+		}
+
+		// The first empty or deleted bucket of the sequence is reused, but the search continues up to an empty one
+		if (insertFound == false)
+		{
+			const Group::Mask mask = group.matchEmptyOrDeleted();
+			if (mask != 0)
+			{
+				bucketIndex = firstBucket + Group::firstIndex(mask);
+				insertFound = true;
+			}
+		}
+
+		if (group.matchEmpty())
+			break;
+		groupIndex = (groupIndex + i + 1) & groupMask;
+	}
+
+	FATAL_ASSERT(size_ < capacity_);
+	FATAL_ASSERT(insertFound);
+	return false;
+}
+
+template <class K, class HashFunc>
+void FlatHashSet<K, HashFunc>::markFull(unsigned int index, int8_t fragment)
+{
+	if (ctrl_[index] == Group::Deleted)
+		numDeleted_--;
+	ctrl_[index] = fragment;
+	size_++;
+}
+
+}
+
+#endif
@@ -0,0 +1,232 @@
+#ifndef CLASS_NCTL_FLATHASHSETITERATOR
+#define CLASS_NCTL_FLATHASHSETITERATOR
+
+#include "FlatHashSet.h"
+#include "iterator.h"
+
+namespace nctl {
+
+/// Base helper structure for type traits used in the flat hashset iterator
+template <class K, class HashFunc>
+struct FlatHashSetHelperTraits
+{
+	using FlatHashSetPtr = const FlatHashSet<K, HashFunc> *;
+};
+
+/// A flat hashset iterator
+template <class K, class HashFunc>
+class FlatHashSetIterator
+{
+  public:
+	/// Reference type which respects iterator constness
+	using Reference = typename IteratorTraits<FlatHashSetIterator>::Reference;
+
+	/// Sentinel tags to initialize the iterator at the beginning and end
+	enum class SentinelTagInit
+	{
+		/// Iterator at the beginning, next element is the first one
+		BEGINNING,
+		/// Iterator at the end, previous element is the last one
+		END
+	};
+
+	FlatHashSetIterator(typename FlatHashSetHelperTraits<K, HashFunc>::FlatHashSetPtr hashSet, unsigned int bucketIndex)
+	    : hashSet_(hashSet), bucketIndex_(bucketIndex), tag_(SentinelTag::REGULAR) {}
+
+	FlatHashSetIterator(typename FlatHashSetHelperTraits<K, HashFunc>::FlatHashSetPtr hashSet, SentinelTagInit tag);
+
+	/// Deferencing operator
+	Reference operator*() const;
+
+	/// Iterates to the next element (prefix)
+	FlatHashSetIterator &operator++();
+	/// Iterates to the next element (postfix)
+	FlatHashSetIterator operator++(int);
+
+	/// Iterates to the previous element (prefix)
+	FlatHashSetIterator &operator--();
+	/// Iterates to the previous element (postfix)
+	FlatHashSetIterator operator--(int);
+
+	/// Equality operator
+	friend inline bool operator==(const FlatHashSetIterator &lhs, const FlatHashSetIterator &rhs)
+	{
+		if (lhs.tag_ == SentinelTag::REGULAR && rhs.tag_ == SentinelTag::REGULAR)
+			return (lhs.hashSet_ == rhs.hashSet_ && lhs.bucketIndex_ == rhs.bucketIndex_);
+		else
+			return (lhs.tag_ == rhs.tag_);
+	}
+
+	/// Inequality operator
+	friend inline bool operator!=(const FlatHashSetIterator &lhs, const FlatHashSetIterator &rhs)
+	{
+		if (lhs.tag_ == SentinelTag::REGULAR && rhs.tag_ == SentinelTag::REGULAR)
+			return (lhs.hashSet_ != rhs.hashSet_ || lhs.bucketIndex_ != rhs.bucketIndex_);
+		else
+			return (lhs.tag_ != rhs.tag_);
+	}
+
+	/// Returns the key associated to the currently pointed element
+	const K &key() const;
+	/// Returns the hash associated to the currently pointed element
+	/*! \note The hash is not stored in the hashset and is calculated again */
+	hash_t hash() const;
+
+  private:
+	/// Sentinel tags to detect begin and end conditions
+	enum SentinelTag
+	{
+		/// Iterator poiting to a real element
+		REGULAR,
+		/// Iterator at the beginning, next element is the first one
+		BEGINNING,
+		/// Iterator at the end, previous element is the last one
+		END
+	};
+
+	typename FlatHashSetHelperTraits<K, HashFunc>::FlatHashSetPtr hashSet_;
+	unsigned int bucketIndex_;
+	SentinelTag tag_;
+
+	/// Makes the iterator point to the next element in the hashSet
+	void next();
+	/// Makes the iterator point to the previous element in the hashset
+	void previous();
+};
+
+/// Iterator traits structure specialization for `FlatHashSetIterator` class
+template <class K, class HashFunc>
+struct IteratorTraits<FlatHashSetIterator<K, HashFunc>>
+{
+	/// Type of the values deferenced by the iterator (never const)
+	using ValueType = K;
+	/// Pointer to the type of the values deferenced by the iterator
+	using Pointer = const K *;
+	/// Reference to the type of the values deferenced by the iterator
+	using Reference = const K &;
+	/// Type trait for iterator category
+	static inline BidirectionalIteratorTag IteratorCategory() { return BidirectionalIteratorTag(); }
+};
+
+template <class K, class HashFunc>
+FlatHashSetIterator<K, HashFunc>::FlatHashSetIterator(typename FlatHashSetHelperTraits<K, HashFunc>::FlatHashSetPtr hashSet, SentinelTagInit tag)
+    : hashSet_(hashSet), bucketIndex_(0)
+{
+	switch (tag)
+	{
+		case SentinelTagInit::BEGINNING: tag_ = SentinelTag::BEGINNING; break;
+		case SentinelTagInit::END: tag_ = SentinelTag::END; break;
+	}
+}
+
+template <class K, class HashFunc>
+typename FlatHashSetIterator<K, HashFunc>::Reference FlatHashSetIterator<K, HashFunc>::operator*() const
+{
+	return hashSet_->keys_[bucketIndex_];
+}
+
+template <class K, class HashFunc>
+FlatHashSetIterator<K, HashFunc> &FlatHashSetIterator<K, HashFunc>::operator++()
+{
+	next();
+	return *this;
+}
+
+template <class K, class HashFunc>
+FlatHashSetIterator<K, HashFunc> FlatHashSetIterator<K, HashFunc>::operator++(int)
+{
+	// Create an unmodified copy to return
+	FlatHashSetIterator<K, HashFunc> iterator = *this;
+	next();
+	return iterator;
+}
+
+template <class K, class HashFunc>
+FlatHashSetIterator<K, HashFunc> &FlatHashSetIterator<K, HashFunc>::operator--()
+{
+	previous();
+	return *this;
+}
+
+template <class K, class HashFunc>
+FlatHashSetIterator<K, HashFunc> FlatHashSetIterator<K, HashFunc>::operator--(int)
+{
+	// Create an unmodified copy to return
+	FlatHashSetIterator<K, HashFunc> iterator = *this;
+	previous();
+	return iterator;
+}
+
+template <class K, class HashFunc>
+const K &FlatHashSetIterator<K, HashFunc>::key() const
+{
+	return hashSet_->keys_[bucketIndex_];
+}
+
+template <class K, class HashFunc>
+hash_t FlatHashSetIterator<K, HashFunc>::hash() const
+{
+	return hashSet_->hashFunc_(hashSet_->keys_[bucketIndex_]);
+}
+
+template <class K, class HashFunc>
+void FlatHashSetIterator<K, HashFunc>::next()
+{
+	if (tag_ == SentinelTag::REGULAR)
+	{
+		if (bucketIndex_ >= hashSet_->capacity() - 1)
+		{
+			tag_ = SentinelTag::END;
+			return;
+		}
+		else
+			bucketIndex_++;
+	}
+	else if (tag_ == SentinelTag::BEGINNING)
+	{
+		tag_ = SentinelTag::REGULAR;
+		bucketIndex_ = 0;
+	}
+	else if (tag_ == SentinelTag::END)
+		return;
+
+	// Search the first non empty index starting from the current one
+	while (bucketIndex_ < hashSet_->capacity() - 1 && detail::FlatHashGroup::isFull(hashSet_->ctrl_[bucketIndex_]) == false)
+		bucketIndex_++;
+
+	if (detail::FlatHashGroup::isFull(hashSet_->ctrl_[bucketIndex_]) == false)
+		tag_ = SentinelTag::END;
+}
+
+template <class K, class HashFunc>
+void FlatHashSetIterator<K, HashFunc>::previous()
+{
+	if (tag_ == SentinelTag::REGULAR)
+	{
+		if (bucketIndex_ == 0)
+		{
+			tag_ = SentinelTag::BEGINNING;
+			return;
+		}
+		else
+			bucketIndex_--;
+	}
+	else if (tag_ == SentinelTag::END)
+	{
+		tag_ = SentinelTag::REGULAR;
+		bucketIndex_ = hashSet_->capacity() - 1;
+	}
+	else if (tag_ == SentinelTag::BEGINNING)
+		return;
+
+	// Search the first non empty index starting from the current one
+	while (bucketIndex_ > 0 && detail::FlatHashGroup::isFull(hashSet_->ctrl_[bucketIndex_]) == false)
+		bucketIndex_--;
+
+	if (detail::FlatHashGroup::isFull(hashSet_->ctrl_[bucketIndex_]) == false)
+		tag_ = SentinelTag::BEGINNING;
+}
+
+}
+
+#endif
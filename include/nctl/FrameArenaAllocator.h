@@ -0,0 +1,83 @@
+#ifndef CLASS_NCTL_FRAMEARENAALLOCATOR
+#define CLASS_NCTL_FRAMEARENAALLOCATOR
+
+#include <nctl/LinearAllocator.h>
+
+namespace nctl {
+
+/// A double-buffered linear allocator for data that only lives for a frame
+/*! Allocations are served by the linear buffer of the current frame and stay valid until the end of the next one.
+ *  Deallocating is not needed, the memory is reclaimed in constant time when the buffer is reused.
+ *  Allocations that do not fit in the current buffer are served by the source allocator and should be deallocated.
+ *  Every allocation served by a buffer is preceded by a small header that stores its size for reallocations.
+ *  \note The allocator is not thread-safe */
+class DLL_PUBLIC FrameArenaAllocator : public IAllocator
+{
+  public:
+	/// The default size in bytes of each of the two buffers
+	static const size_t DefaultBufferSize = 1024 * 1024;
+
+	FrameArenaAllocator()
+	    : FrameArenaAllocator("FrameArena", DefaultBufferSize) {}
+	explicit FrameArenaAllocator(size_t bufferSize)
+	    : FrameArenaAllocator("FrameArena", bufferSize) {}
+	FrameArenaAllocator(const char *name, size_t bufferSize);
+	FrameArenaAllocator(const char *name, size_t bufferSize, IAllocator &source);
+	~FrameArenaAllocator();
+
+	/// Ends the current frame, the buffer used two frames ago is cleared and becomes the current one
+	void swapBuffers();
+
+	/// Returns the size in bytes of each of the two buffers
+	inline size_t bufferSize() const { return bufferSize_; }
+	/// Returns the index of the buffer used by the current frame
+	inline unsigned int currentBuffer() const { return currentBuffer_; }
+
+	/// Returns the memory allocated from the buffer during the current frame
+	inline size_t frameUsedMemory() const { return linearAllocators_[currentBuffer_].usedMemory(); }
+	/// Returns the memory allocated from the buffer during the last completed frame
+	inline size_t lastFrameUsedMemory() const { return lastFrameUsedMemory_; }
+	/// Returns the highest memory allocated from the buffer in a single frame (the high-water mark)
+	inline size_t peakUsedMemory() const { return peakUsedMemory_; }
+	/// Returns the number of allocations of the last completed frame that were served by the source allocator
+	inline unsigned int lastFrameNumOverflows() const { return lastFrameNumOverflows_; }
+	/// Returns the total number of allocations that were served by the source allocator
+	inline unsigned long int numOverflows() const { return numOverflows_; }
+
+	/// Returns true if the pointer belongs to one of the two buffers
+	bool owns(const void *ptr) const;
+
+  private:
+	/// The header stored before every allocation served by the buffers
+	struct Header
+	{
+		size_t size;
+	};
+
+	IAllocator &source_;
+	size_t bufferSize_;
+	void *buffers_[2];
+	LinearAllocator linearAllocators_[2];
+	unsigned int currentBuffer_;
+
+	size_t lastFrameUsedMemory_;
+	size_t peakUsedMemory_;
+	unsigned int frameNumOverflows_;
+	unsigned int lastFrameNumOverflows_;
+	unsigned long int numOverflows_;
+	/// Number of allocations served by the source allocator that have not been deallocated yet
+	unsigned int numActiveOverflows_;
+
+	FrameArenaAllocator(const FrameArenaAllocator &) = delete;
+	FrameArenaAllocator &operator=(const FrameArenaAllocator &) = delete;
+
+	void updateStatistics();
+
+	static void *allocateImpl(IAllocator *allocator, size_t bytes, uint8_t alignment);
+	static void *reallocateImpl(IAllocator *allocator, void *ptr, size_t bytes, uint8_t alignment, size_t &oldSize);
+	static void deallocateImpl(IAllocator *allocator, void *ptr);
+};
+
+}
+
+#endif
@@ -9,6 +9,7 @@
 
 #ifdef RECORD_ALLOCATIONS
 	#include <ncine/TimeStamp.h>
+	#include <nctl/Atomic.h>
 #endif
 
 namespace nctl {
@@ -115,9 +116,17 @@ class DLL_PUBLIC IAllocator
 
 #ifdef RECORD_ALLOCATIONS
 	bool recordAllocations_;
+	/// Spinlock protecting the entries of thread-safe allocators
+	Atomic32 recordLock_;
 	static const unsigned int MaxEntries = 100 * 1000;
 	Entry entries_[MaxEntries];
 	size_t numEntries_;
+
+	inline void acquireRecordLock()
+	{
+		while (recordLock_.cmpExchange(1, 0, Atomic32::MemoryModel::ACQUIRE) == false) {}
+	}
+	inline void releaseRecordLock() { recordLock_.store(0, Atomic32::MemoryModel::RELEASE); }
 #endif
 
 	friend class ProxyAllocator;
@@ -0,0 +1,144 @@
+#ifndef CLASS_NCTL_SLABALLOCATOR
+#define CLASS_NCTL_SLABALLOCATOR
+
+#include <ncine/common_macros.h>
+#include <nctl/IAllocator.h>
+#include <nctl/SpinLock.h>
+
+namespace nctl {
+
+/// A pool allocator that grows by requesting new slabs of memory from a source allocator
+/*! Every new slab can hold twice the elements of the previous one.
+ *  Freed elements go back to a single free list shared by all the slabs, like in a `PoolAllocator`.
+ *  \note The allocator is not thread-safe */
+class DLL_PUBLIC SlabAllocator : public IAllocator
+{
+  public:
+	/// The maximum number of slabs that can be requested to the source allocator
+	static const unsigned int MaxSlabs = 32;
+	/// The default number of elements in the first slab
+	static const unsigned int DefaultElementsPerSlab = 64;
+
+	explicit SlabAllocator(size_t elementSize)
+	    : SlabAllocator("Slab", elementSize, DefaultAlignment, DefaultElementsPerSlab) {}
+	SlabAllocator(const char *name, size_t elementSize)
+	    : SlabAllocator(name, elementSize, DefaultAlignment, DefaultElementsPerSlab) {}
+	SlabAllocator(const char *name, size_t elementSize, uint8_t elementAlignment, unsigned int elementsPerSlab);
+	SlabAllocator(const char *name, size_t elementSize, uint8_t elementAlignment, unsigned int elementsPerSlab, IAllocator &source);
+	~SlabAllocator();
+
+	inline size_t elementSize() const { return elementSize_; }
+	inline uint8_t elementAlignment() const { return elementAlignment_; }
+	/// Returns the distance in bytes between two consecutive elements in a slab
+	inline size_t elementStride() const { return elementStride_; }
+	/// Returns the number of slabs requested to the source allocator
+	inline unsigned int numSlabs() const { return numSlabs_; }
+	/// Returns the total number of elements that can be allocated before requesting a new slab
+	inline size_t capacity() const { return capacity_; }
+	void **freeList() const { return freeList_; }
+
+	/// Returns true if the pointer belongs to one of the slabs
+	bool owns(const void *ptr) const;
+	/// Requests enough slabs to hold the specified number of elements without growing
+	bool reserve(size_t numElements);
+	/// Gives all slabs back to the source allocator if there are no active allocations
+	bool releaseSlabs();
+
+  private:
+	struct Slab
+	{
+		void *memory;
+		size_t bytes;
+		size_t numElements;
+	};
+
+	IAllocator &source_;
+	size_t elementSize_;
+	uint8_t elementAlignment_;
+	size_t elementStride_;
+	unsigned int elementsPerSlab_;
+	unsigned int numSlabs_;
+	size_t capacity_;
+	void **freeList_;
+	Slab slabs_[MaxSlabs];
+
+	SlabAllocator(const SlabAllocator &) = delete;
+	SlabAllocator &operator=(const SlabAllocator &) = delete;
+
+	bool addSlab();
+
+	static void *allocateImpl(IAllocator *allocator, size_t size, uint8_t alignment);
+	static void *reallocateImpl(IAllocator *allocator, void *ptr, size_t size, uint8_t alignment, size_t &oldSize);
+	static void deallocateImpl(IAllocator *allocator, void *ptr);
+};
+
+/// A slab allocator with the element size and alignment of a specific type
+template <class T>
+class TypedSlabAllocator : public SlabAllocator
+{
+  public:
+	TypedSlabAllocator()
+	    : TypedSlabAllocator("TypedSlab", DefaultElementsPerSlab) {}
+	TypedSlabAllocator(const char *name, unsigned int elementsPerSlab)
+	    : SlabAllocator(name, sizeof(T), alignment(), elementsPerSlab) {}
+
+	/// Allocates and constructs a new object of the allocator type
+	template <typename... Args> inline T *create(Args &&... args) { return newObject<T>(nctl::forward<Args>(args)...); }
+	/// Destructs and deallocates an object of the allocator type
+	inline void destroy(T *ptr) { deleteObject(ptr); }
+
+  private:
+	static constexpr uint8_t alignment() { return (alignof(T) > DefaultAlignment) ? alignof(T) : DefaultAlignment; }
+};
+
+}
+
+/// Declares class specific allocation functions that use a typed slab allocator
+/*! \note Derived classes with a different size are allocated with the global allocation functions */
+#define NCTL_DECLARE_SLAB_ALLOCATED() \
+	static void *operator new(size_t bytes); \
+	static void operator delete(void *ptr, size_t bytes); \
+	inline static void *operator new(size_t, void *ptr) { return ptr; } \
+	inline static void operator delete(void *, void *) {}
+
+/// Defines the class specific allocation functions declared with `NCTL_DECLARE_SLAB_ALLOCATED()`
+/*! Objects can be created and destroyed from any thread, the allocator is protected by a spin lock.
+ *  The allocator is never destroyed, so that static objects can still be deleted after it would have been. */
+#define NCTL_DEFINE_SLAB_ALLOCATED(CLASS_NAME, ELEMENTS_PER_SLAB) \
+	static nctl::TypedSlabAllocator<CLASS_NAME> &CLASS_NAME##SlabAllocator() \
+	{ \
+		static nctl::TypedSlabAllocator<CLASS_NAME> *allocator = new nctl::TypedSlabAllocator<CLASS_NAME>(#CLASS_NAME, ELEMENTS_PER_SLAB); \
+		return *allocator; \
+	} \
+	static nctl::SpinLock &CLASS_NAME##SlabLock() \
+	{ \
+		static nctl::SpinLock lock; \
+		return lock; \
+	} \
+	void *CLASS_NAME::operator new(size_t bytes) \
+	{ \
+		if (bytes != sizeof(CLASS_NAME)) \
+			return ::operator new(bytes); \
+		nctl::TypedSlabAllocator<CLASS_NAME> &allocator = CLASS_NAME##SlabAllocator(); \
+		nctl::SpinLock &lock = CLASS_NAME##SlabLock(); \
+		lock.lock(); \
+		void *ptr = allocator.allocate(bytes); \
+		lock.unlock(); \
+		FATAL_ASSERT(ptr != nullptr); \
+		return ptr; \
+	} \
+	void CLASS_NAME::operator delete(void *ptr, size_t bytes) \
+	{ \
+		if (bytes != sizeof(CLASS_NAME)) \
+			::operator delete(ptr); \
+		else \
+		{ \
+			nctl::TypedSlabAllocator<CLASS_NAME> &allocator = CLASS_NAME##SlabAllocator(); \
+			nctl::SpinLock &lock = CLASS_NAME##SlabLock(); \
+			lock.lock(); \
+			allocator.deallocate(ptr); \
+			lock.unlock(); \
+		} \
+	}
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef CLASS_NCTL_SPINLOCK
+#define CLASS_NCTL_SPINLOCK
+
+#include <nctl/Atomic.h>
+
+namespace nctl {
+
+/// A lock that busy waits in user space, for critical sections of a few instructions
+/*! The waiting thread yields every few spins, in case the lock holder has been preempted. */
+class DLL_PUBLIC SpinLock
+{
+  public:
+	SpinLock()
+	    : lock_(0) {}
+
+	/// Acquires the lock, spinning until it is available
+	void lock();
+	/// Tries to acquire the lock without waiting
+	inline bool tryLock() { return lock_.cmpExchange(1, 0, Atomic32::MemoryModel::ACQUIRE); }
+	/// Releases the lock
+	inline void unlock() { lock_.store(0, Atomic32::MemoryModel::RELEASE); }
+
+  private:
+	Atomic32 lock_;
+
+	/// Deleted copy constructor
+	SpinLock(const SpinLock &) = delete;
+	/// Deleted assignment operator
+	SpinLock &operator=(const SpinLock &) = delete;
+};
+
+}
+
+#endif
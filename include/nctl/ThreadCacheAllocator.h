@@ -0,0 +1,102 @@
+#ifndef CLASS_NCTL_THREADCACHEALLOCATOR
+#define CLASS_NCTL_THREADCACHEALLOCATOR
+
+#include <ncine/common_macros.h>
+#include <nctl/IAllocator.h>
+#include <nctl/Atomic.h>
+#include <nctl/SpinLock.h>
+
+namespace nctl {
+
+/// A thread-safe general purpose allocator with per-thread caches of size classes
+/*! Small allocations are rounded up to a size class and served from a cache owned by the calling thread,
+ *  without any synchronization. Caches are refilled from, and flushed to, a shared backend protected by a spinlock.
+ *  Blocks can be freed by a thread that is different from the one that allocated them.
+ *  Large or over-aligned allocations are requested directly to the source allocator. */
+class DLL_PUBLIC ThreadCacheAllocator : public IAllocator
+{
+  public:
+	/// The maximum number of threads that can have a cache at the same time
+	/*! \note Threads exceeding the limit allocate directly from the shared backend */
+	static const unsigned int MaxThreadCaches = 64;
+	/// The number of size classes served by the thread caches
+	static const unsigned int NumSizeClasses = 40;
+	/// The biggest allocation size served by the thread caches
+	static const size_t MaxSmallSize = 32768;
+	/// The size of a memory chunk requested to the source allocator to be split in blocks
+	static const size_t ChunkSize = 256 * 1024;
+
+	ThreadCacheAllocator();
+	explicit ThreadCacheAllocator(IAllocator &source)
+	    : ThreadCacheAllocator("ThreadCache", source) {}
+	ThreadCacheAllocator(const char *name, IAllocator &source);
+	~ThreadCacheAllocator();
+
+	/// Returns the size class used for an allocation of the specified size
+	static unsigned int sizeClass(size_t bytes);
+	/// Returns the allocation size of the specified size class
+	static size_t classSize(unsigned int sizeClass);
+
+	/// Returns the number of chunks requested to the source allocator
+	inline unsigned int numChunks() const { return numChunks_; }
+	/// Returns the number of free blocks of the specified size class cached by the calling thread
+	unsigned int numCachedBlocks(unsigned int sizeClass) const;
+
+	/// Gives all the blocks cached by the calling thread back to the shared backend
+	/*! \note It also folds the thread statistics into the allocator ones */
+	void flushThreadCache();
+
+  private:
+	struct Block
+	{
+		Block *next;
+	};
+
+	struct ThreadCache
+	{
+		Block *freeLists[NumSizeClasses];
+		unsigned int numFree[NumSizeClasses];
+		/// Memory and allocation counters not yet folded into the allocator ones
+		int64_t usedMemoryDelta;
+		int64_t numAllocationsDelta;
+	};
+
+	struct Chunk
+	{
+		Chunk *next;
+		size_t bytes;
+	};
+
+	IAllocator &source_;
+	/// Spinlock protecting the shared backend and the allocator statistics
+	SpinLock lock_;
+	Block *centralFreeLists_[NumSizeClasses];
+	Chunk *chunks_;
+	unsigned int numChunks_;
+	/// Remaining bytes of the last chunk not yet split in blocks
+	uint8_t *chunkCursor_;
+	uint8_t *chunkEnd_;
+	ThreadCache caches_[MaxThreadCaches];
+
+	ThreadCacheAllocator(const ThreadCacheAllocator &) = delete;
+	ThreadCacheAllocator &operator=(const ThreadCacheAllocator &) = delete;
+
+	void acquireLock();
+	void releaseLock();
+	ThreadCache *threadCache();
+
+	void *allocateLarge(size_t bytes, uint8_t alignment);
+	void deallocateLarge(void *ptr);
+	Block *carveBlock(unsigned int sizeClass);
+	void refillCache(ThreadCache &cache, unsigned int sizeClass);
+	void flushCache(ThreadCache &cache, unsigned int sizeClass, unsigned int numBlocks);
+	void foldStatistics(ThreadCache &cache);
+
+	static void *allocateImpl(IAllocator *allocator, size_t bytes, uint8_t alignment);
+	static void *reallocateImpl(IAllocator *allocator, void *ptr, size_t bytes, uint8_t alignment, size_t &oldSize);
+	static void deallocateImpl(IAllocator *allocator, void *ptr);
+};
+
+}
+
+#endif
@@ -0,0 +1,121 @@
+#!/usr/bin/env lua
+
+-- Compares updating sprites with one call per node against the bulk functions
+
+if ncine == nil then
+	ncine = require "libncine"
+	needs_start = true
+end
+
+nc = ncine
+
+num_sprites = 10000
+frames_per_mode = 300
+
+function ncine.on_pre_init(cfg)
+	cfg.resolution = {x = 1280, y = 720}
+	cfg.window_title = "nCine Lua bulk API benchmark"
+	cfg.vsync = false
+	return cfg
+end
+
+function ncine.on_init()
+	local texture_file = nc.ANDROID and "texture2_ETC2.ktx" or "texture2.png"
+	texture_ = nc.texture.new(nc.fs.get_datapath().."textures/"..texture_file)
+
+	local rootnode = nc.application.get_rootnode()
+	resolution_ = nc.application.get_resolution()
+
+	sprites_ = {}
+	positions_ = {}
+	rotations_ = {}
+	colors_ = {}
+	for i = 1, num_sprites do
+		sprites_[i] = nc.sprite.new(rootnode, texture_, 0, 0)
+		nc.sprite.set_scale(sprites_[i], 0.1)
+		positions_[i * 2 - 1] = 0
+		positions_[i * 2] = 0
+		rotations_[i] = 0
+		colors_[i * 4 - 3] = 1
+		colors_[i * 4 - 2] = 1
+		colors_[i * 4 - 1] = 1
+		colors_[i * 4] = 1
+	end
+
+	time_ = 0
+	bulk_ = false
+	frames_ = 0
+	elapsed_ = 0
+	results_ = {}
+end
+
+local function compute_values(time)
+	for i = 1, num_sprites do
+		local phase = time + i * 0.01
+		positions_[i * 2 - 1] = resolution_.x * (0.5 + 0.45 * math.sin(phase))
+		positions_[i * 2] = resolution_.y * (0.5 + 0.45 * math.cos(phase * 1.3))
+		rotations_[i] = phase * 50
+		colors_[i * 4 - 3] = 0.5 + 0.5 * math.sin(phase)
+	end
+end
+
+local function update_per_node()
+	for i = 1, num_sprites do
+		local sprite = sprites_[i]
+		nc.sprite.set_position(sprite, positions_[i * 2 - 1], positions_[i * 2])
+		nc.sprite.set_rotation(sprite, rotations_[i])
+		nc.sprite.set_color(sprite, colors_[i * 4 - 3], colors_[i * 4 - 2], colors_[i * 4 - 1], colors_[i * 4])
+	end
+end
+
+local function update_bulk()
+	nc.sprite.set_positions(sprites_, positions_)
+	nc.sprite.set_rotations(sprites_, rotations_)
+	nc.sprite.set_colors(sprites_, colors_)
+end
+
+function ncine.on_frame_start()
+	time_ = time_ + nc.application.get_interval()
+	compute_values(time_)
+
+	local start = nc.timestamp.now()
+	if bulk_ then
+		update_bulk()
+	else
+		update_per_node()
+	end
+	elapsed_ = elapsed_ + nc.timestamp.milliseconds_since(start)
+	frames_ = frames_ + 1
+
+	if frames_ == frames_per_mode then
+		local mode = bulk_ and "bulk" or "per-node"
+		results_[mode] = elapsed_ / frames_
+		nc.log.info(string.format("%s updates of %d sprites: %.3f ms per frame", mode, num_sprites, results_[mode]))
+
+		if results_["bulk"] and results_["per-node"] then
+			nc.log.info(string.format("Bulk updates are %.2fx faster", results_["per-node"] / results_["bulk"]))
+			results_ = {}
+		end
+
+		bulk_ = not bulk_
+		frames_ = 0
+		elapsed_ = 0
+	end
+end
+
+function ncine.on_shutdown()
+	for i = 1, num_sprites do
+		nc.sprite.delete(sprites_[i])
+	end
+	nc.texture.delete(texture_)
+end
+
+function ncine.on_key_released(event)
+	if event.sym == nc.keysym.ESCAPE then
+		nc.application.quit()
+	end
+end
+
+if needs_start then
+	ncine.start()
+end
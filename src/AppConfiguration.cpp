@@ -21,14 +21,20 @@ AppConfiguration::AppConfiguration()
 #endif
       fileLogLevel(ILogger::LogLevel::OFF),
       frameTimerLogInterval(5.0f),
+      frameStatisticsSize(4096),
+      frameStatisticsFile(128),
+      profilerTraceFile(128),
       resolution(1280, 720),
       inFullscreen(false),
       isResizable(false),
       frameLimit(0),
+      fixedTimeStep(0.0f),
+      maxFixedUpdates(5),
       windowTitle(128),
       windowIconFilename(128),
       useBufferMapping(false),
       deferShaderQueries(true),
+      useBinaryShaderCache(true),
       fixedBatchSize(10),
 #if defined(WITH_IMGUI) || defined(WITH_NUKLEAR)
       vboSize(512 * 1024),
@@ -39,7 +45,9 @@ AppConfiguration::AppConfiguration()
 #endif
       vaoPoolSize(16),
       renderCommandPoolSize(32),
+      frameArenaSize(1024 * 1024),
       withDebugOverlay(false),
+      withProfiler(false),
       withAudio(true),
       withThreads(false),
       withScenegraph(true),
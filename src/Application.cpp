@@ -1,16 +1,21 @@
-﻿#include "Application.h"
+﻿#include <cmath> // for fmodf()
+#include "Application.h"
 #include "Random.h"
 #include "IAppEventHandler.h"
 #include "FileSystem.h"
 #include "IFile.h"
-#include "ArrayIndexer.h"
+#include "HandleIndexer.h"
 #include "GfxCapabilities.h"
 #include "RenderResources.h"
+#include "BinaryShaderCache.h"
+#include "ReadbackQueue.h"
 #include "RenderQueue.h"
 #include "ScreenViewport.h"
 #include "GLDebug.h"
-#include "Timer.h" // for `sleep()`
 #include "FrameTimer.h"
+#include "FramePacer.h"
+#include "FrameStatistics.h"
+#include "Profiler.h"
 #include "SceneNode.h"
 #include <nctl/StaticString.h>
 #include "IInputManager.h"
@@ -28,6 +33,10 @@
 	#include "LuaStatistics.h"
 #endif
 
+#ifdef WITH_ALLOCATORS
+	#include <nctl/FrameArenaAllocator.h>
+#endif
+
 #ifdef WITH_IMGUI
 	#include "ImGuiDrawing.h"
 	#include "ImGuiDebugOverlay.h"
@@ -56,7 +65,8 @@ namespace {
 ///////////////////////////////////////////////////////////
 
 Application::Application()
-    : isSuspended_(false), autoSuspension_(true), hasFocus_(true), shouldQuit_(false)
+    : isSuspended_(false), autoSuspension_(true), hasFocus_(true), shouldQuit_(false),
+      timings_(), fixedUpdateTime_(0.0f), numFixedUpdates_(0), interpolationFactor_(0.0f)
 {
 }
 
@@ -78,6 +88,48 @@ Viewport &Application::screenViewport()
 	return *screenViewport_;
 }
 
+bool Application::readScreenAsync(Texture::ReadbackCallback callback, void *userData)
+{
+	ASSERT(callback);
+	ReadbackQueue::Request request;
+	request.width = gfxDevice_->width();
+	request.height = gfxDevice_->height();
+	request.format = Texture::Format::RGBA8;
+	request.callback = callback;
+	request.userData = userData;
+
+	return RenderResources::readbackQueue().readScreen(request);
+}
+
+bool Application::saveScreenToFileAsync(const char *filename)
+{
+	ASSERT(filename);
+	if (ReadbackQueue::isFileFormatSupported(filename) == false)
+	{
+		LOGE_X("Cannot save \"%s\", the image format is not supported", filename);
+		return false;
+	}
+
+	ReadbackQueue::Request request;
+	request.width = gfxDevice_->width();
+	request.height = gfxDevice_->height();
+	request.format = Texture::Format::RGBA8;
+	request.filename = filename;
+	// The framebuffer is read from bottom to top
+	request.verticalFlip = true;
+
+	return RenderResources::readbackQueue().readScreen(request);
+}
+
+#ifdef WITH_ALLOCATORS
+nctl::IAllocator &Application::frameAllocator()
+{
+	if (frameArena_ != nullptr)
+		return *frameArena_;
+	return nctl::theDefaultAllocator();
+}
+#endif
+
 unsigned long int Application::numFrames() const
 {
 	return frameTimer_->totalNumberFrames();
@@ -100,6 +152,10 @@ void Application::resizeScreenViewport(int width, int height)
 
 void Application::initCommon()
 {
+#ifndef WITH_TRACY
+	Profiler::setThreadName("MainThread");
+	Profiler::setEnabled(appCfg_.withProfiler);
+#endif
 	TracyGpuContext;
 	ZoneScoped;
 	profileStartTime_ = TimeStamp::now();
@@ -115,7 +171,7 @@ void Application::initCommon()
 	TracyAppInfo(appInfoString.data(), appInfoString.length());
 #endif
 
-	theServiceLocator().registerIndexer(nctl::makeUnique<ArrayIndexer>());
+	theServiceLocator().registerIndexer(nctl::makeUnique<HandleIndexer>());
 #ifdef WITH_AUDIO
 	if (appCfg_.withAudio)
 		theServiceLocator().registerAudioDevice(nctl::makeUnique<ALAudioDevice>());
@@ -126,6 +182,7 @@ void Application::initCommon()
 #endif
 	theServiceLocator().registerGfxCapabilities(nctl::makeUnique<GfxCapabilities>());
 	GLDebug::init(theServiceLocator().gfxCapabilities());
+	RenderResources::createBinaryShaderCache();
 
 	LOGI_X("Data path: \"%s\"", fs::dataPath().data());
 	LOGI_X("Save path: \"%s\"", fs::savePath().data());
@@ -140,6 +197,14 @@ void Application::initCommon()
 	TracyGpuCollect;
 
 	frameTimer_ = nctl::makeUnique<FrameTimer>(appCfg_.frameTimerLogInterval, appCfg_.profileTextUpdateTime());
+	framePacer_ = nctl::makeUnique<FramePacer>(appCfg_.frameLimit);
+	frameStatistics_ = nctl::makeUnique<FrameStatistics>(appCfg_.frameStatisticsSize);
+	if (hasFixedTimeStep())
+		LOGI_X("Scenegraph updated with a fixed time step of %.3f ms", appCfg_.fixedTimeStep * 1000.0f);
+#ifdef WITH_ALLOCATORS
+	if (appCfg_.frameArenaSize > 0)
+		frameArena_ = nctl::makeUnique<nctl::FrameArenaAllocator>("FrameArena", appCfg_.frameArenaSize);
+#endif
 
 #ifdef WITH_IMGUI
 	imguiDrawing_ = nctl::makeUnique<ImGuiDrawing>(appCfg_.withScenegraph);
@@ -171,6 +236,15 @@ void Application::initCommon()
 	LOGI("Application initialized");
 
 	timings_[Timings::INIT_COMMON] = profileStartTime_.secondsSince();
+	const BinaryShaderCache &binaryCache = *RenderResources::binaryShaderCache();
+	if (binaryCache.isAvailable())
+	{
+		const BinaryShaderCache::Statistics &stats = binaryCache.statistics();
+		LOGI_X("Init time: %.3f s (%s start, %u program binaries loaded, %u missed, %u rejected)", timings_[Timings::INIT_COMMON],
+		       binaryCache.isWarm() ? "warm" : "cold", stats.loaded, stats.missed, stats.rejected);
+	}
+	else
+		LOGI_X("Init time: %.3f s", timings_[Timings::INIT_COMMON]);
 
 	{
 		ZoneScopedN("onInit");
@@ -199,6 +273,13 @@ void Application::step()
 	ZoneScoped;
 	frameTimer_->addFrame();
 
+	// Programs that have been linked in parallel by the driver become ready to use as soon as they complete
+	if (RenderResources::shaderProgramQueue().isEmpty() == false)
+		RenderResources::shaderProgramQueue().poll();
+	// Pixel readbacks are handed over as soon as their copy has completed, without waiting for it
+	if (RenderResources::readbackQueue().isEmpty() == false)
+		RenderResources::readbackQueue().poll();
+
 #ifdef WITH_IMGUI
 	{
 		ZoneScopedN("ImGui newFrame");
@@ -237,6 +318,8 @@ void Application::step()
 		{
 			ZoneScopedN("Update");
 			profileStartTime_ = TimeStamp::now();
+			if (hasFixedTimeStep())
+				fixedUpdate();
 			screenViewport_->update();
 			timings_[Timings::UPDATE] = profileStartTime_.secondsSince();
 		}
@@ -322,16 +405,22 @@ void Application::step()
 
 	if (debugOverlay_)
 		debugOverlay_->updateFrameTimings();
+	addFrameStatistics();
 
 	gfxDevice_->update();
 	FrameMark;
 	TracyGpuCollect;
 
-	if (appCfg_.frameLimit > 0)
+#ifdef WITH_ALLOCATORS
+	// Temporary allocations of the previous frame are reclaimed
+	if (frameArena_ != nullptr)
+		frameArena_->swapBuffers();
+#endif
+
+	if (framePacer_->frameRate() > 0)
 	{
-		const float frameTimeDuration = 1.0f / static_cast<float>(appCfg_.frameLimit);
-		while (frameTimer_->frameInterval() < frameTimeDuration)
-			Timer::sleep(0.0f);
+		ZoneScopedN("Frame pacing");
+		framePacer_->wait();
 	}
 }
 
@@ -359,9 +448,20 @@ void Application::shutdownCommon()
 	debugOverlay_.reset(nullptr);
 	rootNode_.reset(nullptr);
 	RenderResources::dispose();
+	if (appCfg_.frameStatisticsFile.isEmpty() == false)
+		frameStatistics_->save(appCfg_.frameStatisticsFile.data(), FrameStatistics::formatFromExtension(appCfg_.frameStatisticsFile.data()));
+	frameStatistics_.reset(nullptr);
+#ifndef WITH_TRACY
+	if (appCfg_.profilerTraceFile.isEmpty() == false)
+		Profiler::saveChromeTrace(appCfg_.profilerTraceFile.data());
+#endif
+	framePacer_.reset(nullptr);
 	frameTimer_.reset(nullptr);
 	inputManager_.reset(nullptr);
 	gfxDevice_.reset(nullptr);
+#ifdef WITH_ALLOCATORS
+	frameArena_.reset(nullptr);
+#endif
 
 	if (theServiceLocator().indexer().isEmpty() == false)
 	{
@@ -398,6 +498,7 @@ void Application::resume()
 	if (appEventHandler_)
 		appEventHandler_->onResume();
 	const TimeStamp suspensionDuration = frameTimer_->resume();
+	framePacer_->reset();
 	LOGV_X("Suspended for %.3f seconds", suspensionDuration.seconds());
 	profileStartTime_ += suspensionDuration;
 	LOGI("IAppEventHandler::onResume() invoked");
@@ -412,4 +513,43 @@ bool Application::shouldSuspend()
 	return (!hasFocus_ && autoSuspension_) || isSuspended_;
 }
 
+void Application::addFrameStatistics()
+{
+	float stageTimes[FrameStatistics::Stages::COUNT];
+	stageTimes[FrameStatistics::Stages::FRAME] = frameTimer_->lastFrameInterval();
+	stageTimes[FrameStatistics::Stages::FRAME_START] = timings_[Timings::FRAME_START];
+	stageTimes[FrameStatistics::Stages::UPDATE] = timings_[Timings::UPDATE];
+	stageTimes[FrameStatistics::Stages::POST_UPDATE] = timings_[Timings::POST_UPDATE];
+	stageTimes[FrameStatistics::Stages::VISIT] = timings_[Timings::VISIT];
+	stageTimes[FrameStatistics::Stages::DRAW] = timings_[Timings::DRAW];
+	stageTimes[FrameStatistics::Stages::IMGUI] = timings_[Timings::IMGUI];
+	stageTimes[FrameStatistics::Stages::NUKLEAR] = timings_[Timings::NUKLEAR];
+	stageTimes[FrameStatistics::Stages::FRAME_END] = timings_[Timings::FRAME_END];
+	frameStatistics_->addFrame(stageTimes);
+}
+
+/*! \note The screen viewport update that follows only updates culling, as the nodes have already been updated here */
+void Application::fixedUpdate()
+{
+	const float timeStep = appCfg_.fixedTimeStep;
+	fixedUpdateTime_ += interval();
+
+	unsigned int numUpdates = 0;
+	while (fixedUpdateTime_ >= timeStep && numUpdates < appCfg_.maxFixedUpdates)
+	{
+		ZoneScopedN("Fixed update");
+		numFixedUpdates_++;
+		appEventHandler_->onFixedUpdate(timeStep);
+		screenViewport_->fixedUpdate(timeStep);
+
+		fixedUpdateTime_ -= timeStep;
+		numUpdates++;
+	}
+
+	// Dropping the time that could not be simulated keeps the cost of the following frames bounded
+	if (fixedUpdateTime_ >= timeStep)
+		fixedUpdateTime_ = fmodf(fixedUpdateTime_, timeStep);
+	interpolationFactor_ = fixedUpdateTime_ / timeStep;
+}
+
 }
@@ -3,6 +3,10 @@
 #include "FntParser.h"
 #include "IFile.h"
 
+#ifdef WITH_ALLOCATORS
+	#include "Application.h"
+#endif
+
 namespace ncine {
 
 ///////////////////////////////////////////////////////////
@@ -33,7 +37,12 @@ FntParser::FntParser(const char *fntFilename)
 		return;
 
 	const long int size = fileHandle->size();
+#ifdef WITH_ALLOCATORS
+	// The file content is only needed while parsing
+	nctl::UniquePtr<char[], nctl::AllocDelete<char[]>> fileBuffer = nctl::allocateUnique<char[]>(theApplication().frameAllocator(), size);
+#else
 	nctl::UniquePtr<char[]> fileBuffer = nctl::makeUnique<char[]>(size);
+#endif
 	fileHandle->read(fileBuffer.get(), size);
 
 	parseFntBuffer(fileBuffer.get(), size);
@@ -4,6 +4,7 @@
 #include "Font.h"
 #include "FntParser.h"
 #include "FontGlyph.h"
+#include "DynamicFontAtlas.h"
 #include "Texture.h"
 #include "FileSystem.h"
 #include "tracy.h"
@@ -14,6 +15,15 @@
 
 namespace ncine {
 
+///////////////////////////////////////////////////////////
+// STATIC DEFINITIONS
+///////////////////////////////////////////////////////////
+
+const unsigned int Font::DefaultTtfAtlasSize;
+const unsigned int Font::GlyphPageSize;
+const unsigned short int Font::InvalidGlyphIndex;
+const unsigned int Font::KerningHashmapSize;
+
 ///////////////////////////////////////////////////////////
 // CONSTRUCTORS and DESTRUCTOR
 ///////////////////////////////////////////////////////////
@@ -21,8 +31,8 @@ namespace ncine {
 Font::Font()
     : Object(ObjectType::FONT), texturePtr_(nullptr), lineHeight_(0),
       base_(0), width_(0), height_(0), numGlyphs_(0), numKernings_(0),
-      glyphArray_(nctl::makeUnique<FontGlyph[]>(GlyphArraySize)),
-      glyphHashMap_(GlyphHashmapSize), renderMode_(RenderMode::GLYPH_IN_RED)
+      glyphs_(0), glyphPages_(0), glyphIndices_(0),
+      kernings_(KerningHashmapSize), renderMode_(RenderMode::GLYPH_IN_RED), generation_(0)
 {
 }
 
@@ -161,6 +171,7 @@ bool Font::loadFromMemory(const char *fntBufferName, const unsigned char *fntBuf
 	if (fntParser.numCharTags() == 0)
 		return false;
 
+	releaseDynamicAtlas();
 	const bool textureValid = setTexture(texture);
 	if (textureValid == false)
 		return false;
@@ -245,6 +256,7 @@ bool Font::loadFromFile(const char *fntFilename, Texture *texture)
 	if (fntParser.numCharTags() == 0)
 		return false;
 
+	releaseDynamicAtlas();
 	const bool textureValid = setTexture(texture);
 	if (textureValid == false)
 		return false;
@@ -259,22 +271,126 @@ bool Font::loadFromFile(const char *fntFilename, Texture *texture)
 	return true;
 }
 
+bool Font::loadMetricsFromMemory(const char *fntBufferName, const unsigned char *fntBufferPtr, unsigned long int fntBufferSize)
+{
+	ZoneScoped;
+	if (fntBufferName)
+	{
+		// When Tracy is disabled the statement body is empty and braces are needed
+		ZoneText(fntBufferName, nctl::strnlen(fntBufferName, nctl::String::MaxCStringLength));
+	}
+
+	FntParser fntParser(reinterpret_cast<const char *>(fntBufferPtr), fntBufferSize);
+	if (fntParser.numCharTags() == 0)
+		return false;
+
+	releaseDynamicAtlas();
+	texture_.reset(nullptr);
+	texturePtr_ = nullptr;
+
+	const bool fntInfoValid = checkFntInformation(fntParser);
+	if (fntInfoValid == false)
+		return false;
+
+	setName(fntBufferName);
+	retrieveInfoFromFnt(fntParser);
+	return true;
+}
+
+bool Font::loadFromTtfMemory(const char *ttfBufferName, const unsigned char *ttfBufferPtr, unsigned long int ttfBufferSize, unsigned int pixelHeight)
+{
+	return loadFromTtfMemory(ttfBufferName, ttfBufferPtr, ttfBufferSize, pixelHeight, DefaultTtfAtlasSize);
+}
+
+bool Font::loadFromTtfMemory(const char *ttfBufferName, const unsigned char *ttfBufferPtr, unsigned long int ttfBufferSize, unsigned int pixelHeight, unsigned int atlasSize)
+{
+	ZoneScoped;
+	if (ttfBufferName)
+	{
+		// When Tracy is disabled the statement body is empty and braces are needed
+		ZoneText(ttfBufferName, nctl::strnlen(ttfBufferName, nctl::String::MaxCStringLength));
+	}
+
+	const bool wasDynamic = isDynamic();
+	if (wasDynamic == false)
+		dynamicAtlas_ = nctl::makeUnique<DynamicFontAtlas>();
+
+	const bool hasLoaded = dynamicAtlas_->loadFromMemory(ttfBufferName, ttfBufferPtr, ttfBufferSize, pixelHeight, atlasSize);
+	if (hasLoaded == false)
+	{
+		if (wasDynamic == false)
+			dynamicAtlas_.reset(nullptr);
+		return false;
+	}
+
+	setName(ttfBufferName);
+	retrieveInfoFromAtlas();
+	return true;
+}
+
+bool Font::loadFromTtfFile(const char *ttfFilename, unsigned int pixelHeight)
+{
+	return loadFromTtfFile(ttfFilename, pixelHeight, DefaultTtfAtlasSize);
+}
+
+bool Font::loadFromTtfFile(const char *ttfFilename, unsigned int pixelHeight, unsigned int atlasSize)
+{
+	ZoneScoped;
+	ZoneText(ttfFilename, nctl::strnlen(ttfFilename, nctl::String::MaxCStringLength));
+
+	const bool wasDynamic = isDynamic();
+	if (wasDynamic == false)
+		dynamicAtlas_ = nctl::makeUnique<DynamicFontAtlas>();
+
+	const bool hasLoaded = dynamicAtlas_->loadFromFile(ttfFilename, pixelHeight, atlasSize);
+	if (hasLoaded == false)
+	{
+		if (wasDynamic == false)
+			dynamicAtlas_.reset(nullptr);
+		return false;
+	}
+
+	setName(ttfFilename);
+	retrieveInfoFromAtlas();
+	return true;
+}
+
 bool Font::setTexture(Texture *texture)
 {
-	if (texture == nullptr || texture->dataSize() == 0)
+	if (texture == nullptr || texture->dataSize() == 0 || isDynamic())
 		return false;
 
 	texture_.reset(nullptr);
 	texturePtr_ = texture;
+	// Texture coordinates depend on the texture size
+	generation_++;
 	return true;
 }
 
 const FontGlyph *Font::glyph(unsigned int glyphId) const
 {
-	if (glyphId < GlyphArraySize)
-		return &glyphArray_[glyphId];
-	else
-		return glyphHashMap_.find(glyphId);
+	if (dynamicAtlas_ != nullptr)
+		return dynamicAtlas_->glyph(glyphId);
+
+	const unsigned int pageIndex = glyphId / GlyphPageSize;
+	if (pageIndex >= glyphPages_.size() || glyphPages_[pageIndex] == InvalidGlyphIndex)
+		return nullptr;
+
+	const unsigned short int glyphIndex = glyphIndices_[glyphPages_[pageIndex] * GlyphPageSize + glyphId % GlyphPageSize];
+	return (glyphIndex != InvalidGlyphIndex) ? &glyphs_[glyphIndex] : nullptr;
+}
+
+int Font::kerning(unsigned int firstGlyphId, unsigned int secondGlyphId) const
+{
+	if (dynamicAtlas_ != nullptr)
+		return dynamicAtlas_->kerning(firstGlyphId, secondGlyphId);
+
+	// Most fonts have no kerning pairs at all
+	if (kernings_.isEmpty())
+		return 0;
+
+	const int *amount = kernings_.find((static_cast<uint64_t>(firstGlyphId) << 32) | secondGlyphId);
+	return (amount != nullptr) ? *amount : 0;
 }
 
 ///////////////////////////////////////////////////////////
@@ -283,6 +399,7 @@ const FontGlyph *Font::glyph(unsigned int glyphId) const
 
 bool Font::loadTextureFromMemory(const char *texBufferName, const unsigned char *texBufferPtr, unsigned long int texBufferSize)
 {
+	releaseDynamicAtlas();
 	if (texture_ == nullptr)
 		texture_ = nctl::makeUnique<Texture>();
 	if (texturePtr_ != nullptr)
@@ -294,6 +411,7 @@ bool Font::loadTextureFromMemory(const char *texBufferName, const unsigned char
 
 bool Font::loadTextureFromFile(const char *texFilename)
 {
+	releaseDynamicAtlas();
 	if (texture_ == nullptr)
 		texture_ = nctl::makeUnique<Texture>();
 	if (texturePtr_ != nullptr)
@@ -373,28 +491,93 @@ void Font::retrieveInfoFromFnt(const FntParser &fntParser)
 	width_ = static_cast<unsigned int>(commonTag.scaleW);
 	height_ = static_cast<unsigned int>(commonTag.scaleH);
 
-	const unsigned int numChars = (fntParser.numCharTags() < GlyphArraySize + GlyphHashmapSize) ? fntParser.numCharTags() : GlyphArraySize + GlyphHashmapSize;
-	for (unsigned int i = 0; i < numChars; i++)
+	glyphs_.clear();
+	glyphPages_.clear();
+	glyphIndices_.clear();
+	kernings_.clear();
+
+	unsigned int maxCodepoint = 0;
+	for (unsigned int i = 0; i < fntParser.numCharTags(); i++)
+	{
+		const unsigned int codepoint = static_cast<unsigned int>(fntParser.charTag(i).id);
+		if (codepoint > maxCodepoint)
+			maxCodepoint = codepoint;
+	}
+	// The first level of the table only needs to reach the page of the highest codepoint
+	const unsigned int numPages = maxCodepoint / GlyphPageSize + 1;
+	glyphPages_.setCapacity(numPages);
+	for (unsigned int i = 0; i < numPages; i++)
+		glyphPages_.pushBack(InvalidGlyphIndex);
+
+	glyphs_.setCapacity(fntParser.numCharTags());
+	for (unsigned int i = 0; i < fntParser.numCharTags(); i++)
 	{
 		const FntParser::CharTag &charTag = fntParser.charTag(i);
-		if (charTag.id < static_cast<int>(GlyphArraySize))
-			glyphArray_[charTag.id].set(charTag.x, charTag.y, charTag.width, charTag.height, charTag.xoffset, charTag.yoffset, charTag.xadvance);
-		else
-			glyphHashMap_.emplace(charTag.id, charTag.x, charTag.y, charTag.width, charTag.height, charTag.xoffset, charTag.yoffset, charTag.xadvance);
-		numGlyphs_++;
+		const unsigned int pageIndex = static_cast<unsigned int>(charTag.id) / GlyphPageSize;
+		if (glyphPages_[pageIndex] == InvalidGlyphIndex)
+		{
+			// Adding a new page to the second level of the table
+			glyphPages_[pageIndex] = static_cast<unsigned short int>(glyphIndices_.size() / GlyphPageSize);
+			for (unsigned int j = 0; j < GlyphPageSize; j++)
+				glyphIndices_.pushBack(InvalidGlyphIndex);
+		}
+
+		unsigned short int &glyphIndex = glyphIndices_[glyphPages_[pageIndex] * GlyphPageSize + charTag.id % GlyphPageSize];
+		if (glyphIndex == InvalidGlyphIndex)
+		{
+			FATAL_ASSERT(glyphs_.size() < InvalidGlyphIndex);
+			glyphIndex = static_cast<unsigned short int>(glyphs_.size());
+			glyphs_.emplaceBack();
+		}
+		glyphs_[glyphIndex].set(charTag.x, charTag.y, charTag.width, charTag.height, charTag.xoffset, charTag.yoffset, charTag.xadvance);
 	}
+	numGlyphs_ = glyphs_.size();
 
+	// The hashmap does not grow by itself, and rehashing an empty one has no effect
+	const unsigned int kerningsCapacity = fntParser.numKerningTags() * 2;
+	if (kernings_.capacity() < kerningsCapacity)
+		kernings_ = nctl::FlatHashMap<uint64_t, int>(kerningsCapacity);
 	for (unsigned int i = 0; i < fntParser.numKerningTags(); i++)
 	{
 		const FntParser::KerningTag &kerningTag = fntParser.kerningTag(i);
-		if (kerningTag.first < static_cast<int>(GlyphArraySize))
-			glyphArray_[kerningTag.first].addKerning(kerningTag.second, kerningTag.amount);
-		else
-			glyphHashMap_[kerningTag.first].addKerning(kerningTag.second, kerningTag.amount);
-		numKernings_++;
+		const uint64_t key = (static_cast<uint64_t>(kerningTag.first) << 32) | static_cast<uint32_t>(kerningTag.second);
+		kernings_[key] = kerningTag.amount;
 	}
+	numKernings_ = kernings_.size();
 
+	generation_++;
 	LOGI_X("FNT file information retrieved: %u glyphs and %u kernings", numGlyphs_, numKernings_);
 }
 
+void Font::releaseDynamicAtlas()
+{
+	if (dynamicAtlas_ != nullptr)
+	{
+		// The shared texture pointer was pointing to the atlas texture
+		texturePtr_ = nullptr;
+		dynamicAtlas_.reset(nullptr);
+	}
+}
+
+void Font::retrieveInfoFromAtlas()
+{
+	texture_.reset(nullptr);
+	texturePtr_ = dynamicAtlas_->texture();
+
+	lineHeight_ = dynamicAtlas_->lineHeight();
+	base_ = dynamicAtlas_->base();
+	width_ = dynamicAtlas_->size();
+	height_ = dynamicAtlas_->size();
+	numGlyphs_ = dynamicAtlas_->numFontGlyphs();
+	numKernings_ = 0;
+	// Glyphs and kerning pairs are retrieved from the atlas
+	glyphs_.clear();
+	glyphPages_.clear();
+	glyphIndices_.clear();
+	kernings_.clear();
+	// The atlas texture has a single channel
+	renderMode_ = RenderMode::GLYPH_IN_RED;
+	generation_++;
+}
+
 }
@@ -0,0 +1,230 @@
+#include "common_macros.h"
+#include "FramePacer.h"
+#include "Clock.h"
+#include "Timer.h"
+
+#if defined(_WIN32)
+	#include "common_windefines.h"
+	#include <windows.h>
+	#include <mmsystem.h> // for timeBeginPeriod()
+#endif
+
+namespace ncine {
+
+namespace {
+	/// Initial interval before the deadline in which the thread only yields, in seconds
+	const float InitialSpinInterval = 0.001f;
+	/// Minimum interval before the deadline in which the thread only yields, in seconds
+	const float MinSpinInterval = 0.0001f;
+	/// Maximum interval before the deadline in which the thread only yields, in seconds
+	const float MaxSpinInterval = 0.004f;
+
+	/// The time source based on the system clock
+	class SystemTimeSource : public FramePacer::TimeSource
+	{
+	  public:
+		uint64_t counter() const override { return clock().counter(); }
+		uint32_t frequency() const override { return clock().frequency(); }
+		void sleep(float seconds) override { Timer::sleep(seconds); }
+	};
+
+	SystemTimeSource systemTimeSource;
+}
+
+///////////////////////////////////////////////////////////
+// STATIC DEFINITIONS
+///////////////////////////////////////////////////////////
+
+const unsigned int FramePacer::SlipFrames;
+const unsigned int FramePacer::MaxSlipDivisor;
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+FramePacer::FramePacer()
+    : FramePacer(0)
+{
+}
+
+FramePacer::FramePacer(unsigned int frameRate)
+    : FramePacer(frameRate, systemTimeSource)
+{
+}
+
+FramePacer::FramePacer(unsigned int frameRate, TimeSource &timeSource)
+    : timeSource_(timeSource), frameRate_(0), canSlip_(false), slipDivisor_(1), periodTicks_(0), nextDeadline_(0), lastWakeUp_(0),
+      spinTicks_(secondsToTicks(InitialSpinInterval)), numLateFrames_(0), numEarlyFrames_(0), numMissedFrames_(0),
+      hasRaisedTimerResolution_(false)
+{
+	setFrameRate(frameRate);
+}
+
+FramePacer::~FramePacer()
+{
+	frameRate_ = 0;
+	updateTimerResolution();
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void FramePacer::setFrameRate(unsigned int frameRate)
+{
+	frameRate_ = frameRate;
+	periodTicks_ = (frameRate > 0) ? timeSource_.frequency() / frameRate : 0;
+	slipDivisor_ = 1;
+	reset();
+	updateTimerResolution();
+}
+
+void FramePacer::setCanSlip(bool canSlip)
+{
+	canSlip_ = canSlip;
+	if (canSlip == false)
+		slipDivisor_ = 1;
+}
+
+float FramePacer::spinInterval() const
+{
+	return static_cast<float>(spinTicks_) / static_cast<float>(timeSource_.frequency());
+}
+
+float FramePacer::wait()
+{
+	if (frameRate_ == 0)
+		return 0.0f;
+
+	const uint64_t waitStart = timeSource_.counter();
+	if (nextDeadline_ == 0)
+	{
+		// The first frame after a reset is not paced
+		nextDeadline_ = waitStart;
+		lastWakeUp_ = waitStart;
+	}
+
+	updateSlip(waitStart);
+	const uint64_t period = periodTicks_ * slipDivisor_;
+
+	if (waitStart < nextDeadline_)
+		sleepUntilDeadline();
+	else if (waitStart - nextDeadline_ > period)
+	{
+		// Too late to catch up, restarting from now instead of rushing the next frames
+		nextDeadline_ = waitStart;
+	}
+
+	// Advancing the deadline by a fixed period compensates for late frames and keeps the long-run rate exact
+	nextDeadline_ += period;
+	lastWakeUp_ = timeSource_.counter();
+
+	return static_cast<float>(lastWakeUp_ - waitStart) / static_cast<float>(timeSource_.frequency());
+}
+
+void FramePacer::reset()
+{
+	nextDeadline_ = 0;
+	numLateFrames_ = 0;
+	numEarlyFrames_ = 0;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+uint64_t FramePacer::secondsToTicks(float seconds) const
+{
+	return static_cast<uint64_t>(seconds * static_cast<float>(timeSource_.frequency()));
+}
+
+void FramePacer::updateSlip(uint64_t now)
+{
+	if (now > nextDeadline_)
+	{
+		numMissedFrames_++;
+		numLateFrames_++;
+		numEarlyFrames_ = 0;
+
+		if (canSlip_ && numLateFrames_ >= SlipFrames && slipDivisor_ < MaxSlipDivisor)
+		{
+			slipDivisor_++;
+			numLateFrames_ = 0;
+			LOGI_X("Frame pacing slipped to %.2f FPS", pacedFrameRate());
+		}
+	}
+	else
+	{
+		numLateFrames_ = 0;
+
+		if (slipDivisor_ > 1)
+		{
+			// The frame work should fit in the shorter period with a safety margin to recover
+			const uint64_t workTicks = now - lastWakeUp_;
+			const uint64_t shorterPeriod = periodTicks_ * (slipDivisor_ - 1);
+			numEarlyFrames_ = (workTicks < shorterPeriod - shorterPeriod / 10) ? numEarlyFrames_ + 1 : 0;
+
+			if (numEarlyFrames_ >= SlipFrames)
+			{
+				slipDivisor_--;
+				numEarlyFrames_ = 0;
+				LOGI_X("Frame pacing recovered to %.2f FPS", pacedFrameRate());
+			}
+		}
+	}
+}
+
+void FramePacer::sleepUntilDeadline()
+{
+	const uint64_t minSpinTicks = secondsToTicks(MinSpinInterval);
+	const uint64_t maxSpinTicks = secondsToTicks(MaxSpinInterval);
+	const float frequency = static_cast<float>(timeSource_.frequency());
+
+	uint64_t now = timeSource_.counter();
+	while (now < nextDeadline_)
+	{
+		const uint64_t remainingTicks = nextDeadline_ - now;
+		if (remainingTicks > spinTicks_)
+		{
+			// Coarse sleep, waking up early enough to absorb the oversleep of the system
+			const uint64_t sleepTicks = remainingTicks - spinTicks_;
+			timeSource_.sleep(static_cast<float>(sleepTicks) / frequency);
+			const uint64_t wakeUp = timeSource_.counter();
+
+			// The spin interval grows quickly on oversleep and shrinks slowly when sleeping is accurate
+			const uint64_t sleptTicks = wakeUp - now;
+			const uint64_t overSleep = (sleptTicks > sleepTicks) ? sleptTicks - sleepTicks : 0;
+			const uint64_t targetSpinTicks = overSleep * 2;
+			spinTicks_ = (targetSpinTicks > spinTicks_) ? targetSpinTicks : (spinTicks_ * 7 + targetSpinTicks) / 8;
+			if (spinTicks_ < minSpinTicks)
+				spinTicks_ = minSpinTicks;
+			else if (spinTicks_ > maxSpinTicks)
+				spinTicks_ = maxSpinTicks;
+
+			now = wakeUp;
+		}
+		else
+		{
+			// Yielding the thread for the last fraction of a millisecond
+			timeSource_.sleep(0.0f);
+			now = timeSource_.counter();
+		}
+	}
+}
+
+void FramePacer::updateTimerResolution()
+{
+#if defined(_WIN32)
+	// The default granularity of the system timer is around 15.6 ms, too coarse for the spin interval to absorb the oversleep
+	const bool shouldRaise = (frameRate_ > 0);
+	if (shouldRaise && hasRaisedTimerResolution_ == false)
+		hasRaisedTimerResolution_ = (timeBeginPeriod(1) == TIMERR_NOERROR);
+	else if (shouldRaise == false && hasRaisedTimerResolution_)
+	{
+		timeEndPeriod(1);
+		hasRaisedTimerResolution_ = false;
+	}
+#endif
+}
+
+}
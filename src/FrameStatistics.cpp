@@ -0,0 +1,227 @@
+#include <cstdlib> // for qsort()
+#include <cmath> // for ceilf()
+#include "common_macros.h"
+#include "FrameStatistics.h"
+#include "FileSystem.h"
+#include "IFile.h"
+#include "ring_copy.h"
+
+namespace ncine {
+
+namespace {
+	const char *StageNames[FrameStatistics::Stages::COUNT] = {
+		"frame", "frame_start", "update", "post_update", "visit", "draw", "imgui", "nuklear", "frame_end"
+	};
+
+	int compareFloats(const void *a, const void *b)
+	{
+		const float first = *static_cast<const float *>(a);
+		const float second = *static_cast<const float *>(b);
+		return (first > second) - (first < second);
+	}
+
+	/// Nearest-rank percentile of an ascending sorted array
+	float percentile(const float *sortedValues, unsigned int numValues, float fraction)
+	{
+		// The rank is the smallest one that has at least the requested fraction of values at or below it
+		unsigned int rank = static_cast<unsigned int>(ceilf(fraction * numValues));
+		if (rank < 1)
+			rank = 1;
+		else if (rank > numValues)
+			rank = numValues;
+		return sortedValues[rank - 1];
+	}
+}
+
+///////////////////////////////////////////////////////////
+// STATIC DEFINITIONS
+///////////////////////////////////////////////////////////
+
+const float FrameStatistics::DefaultHitchFactor = 2.0f;
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+FrameStatistics::FrameStatistics(unsigned int capacity)
+    : capacity_(capacity), hitchFactor_(DefaultHitchFactor)
+{
+	if (capacity_ > 0)
+		samples_ = nctl::makeUnique<Sample[]>(capacity_);
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+unsigned long int FrameStatistics::numFrames() const
+{
+	return static_cast<unsigned long int>(writeIndex_.load(nctl::Atomic64::MemoryModel::ACQUIRE));
+}
+
+unsigned int FrameStatistics::numRecordedFrames() const
+{
+	const unsigned long int totalFrames = numFrames();
+	return (totalFrames < capacity_) ? static_cast<unsigned int>(totalFrames) : capacity_;
+}
+
+/*! \note The ordering of the stages follows the `Stages` enumeration */
+void FrameStatistics::addFrame(const float stageTimes[Stages::COUNT])
+{
+	if (capacity_ == 0)
+		return;
+
+	const int64_t index = writeIndex_.load(nctl::Atomic64::MemoryModel::RELAXED);
+	Sample &sample = samples_[static_cast<unsigned int>(index % capacity_)];
+	for (unsigned int i = 0; i < Stages::COUNT; i++)
+		sample.stageTimes[i] = stageTimes[i];
+
+	// Readers will only see the new index after the sample has been written
+	writeIndex_.store(index + 1, nctl::Atomic64::MemoryModel::RELEASE);
+}
+
+void FrameStatistics::reset()
+{
+	writeIndex_.store(0, nctl::Atomic64::MemoryModel::RELEASE);
+}
+
+void FrameStatistics::computeSummary(Summary &summary) const
+{
+	summary = Summary();
+	if (capacity_ == 0)
+		return;
+
+	nctl::UniquePtr<Sample[]> samples = nctl::makeUnique<Sample[]>(capacity_);
+	unsigned long int firstFrame = 0;
+	const unsigned int numSamples = copySamples(samples.get(), firstFrame);
+	if (numSamples == 0)
+		return;
+
+	nctl::UniquePtr<float[]> values = nctl::makeUnique<float[]>(numSamples);
+	for (unsigned int stage = 0; stage < Stages::COUNT; stage++)
+	{
+		float sum = 0.0f;
+		for (unsigned int i = 0; i < numSamples; i++)
+		{
+			values[i] = samples[i].stageTimes[stage];
+			sum += values[i];
+		}
+		qsort(values.get(), numSamples, sizeof(float), compareFloats);
+
+		StageSummary &stageSummary = summary.stages[stage];
+		stageSummary.mean = sum / static_cast<float>(numSamples);
+		stageSummary.p50 = percentile(values.get(), numSamples, 0.50f);
+		stageSummary.p95 = percentile(values.get(), numSamples, 0.95f);
+		stageSummary.p99 = percentile(values.get(), numSamples, 0.99f);
+		stageSummary.max = values[numSamples - 1];
+	}
+
+	const float hitchThreshold = summary.stages[Stages::FRAME].p50 * hitchFactor_;
+	for (unsigned int i = 0; i < numSamples; i++)
+	{
+		if (samples[i].stageTimes[Stages::FRAME] > hitchThreshold)
+			summary.numHitches++;
+	}
+	summary.numFrames = numSamples;
+}
+
+/*! \note Durations are saved in milliseconds */
+bool FrameStatistics::save(const char *filename, Format format) const
+{
+	ASSERT(filename);
+
+	const nctl::String path = fs::joinPath(fs::savePath(), filename);
+	nctl::UniquePtr<IFile> fileHandle = IFile::createFileHandle(path.data());
+	fileHandle->setExitOnFailToOpen(false);
+	fileHandle->open(IFile::OpenMode::WRITE | IFile::OpenMode::BINARY);
+	if (fileHandle->isOpened() == false)
+	{
+		LOGW_X("Cannot open the frame statistics file \"%s\"", path.data());
+		return false;
+	}
+
+	bool written = true;
+	nctl::String line(256);
+	if (format == Format::CSV)
+	{
+		nctl::UniquePtr<Sample[]> samples;
+		unsigned long int firstFrame = 0;
+		unsigned int numSamples = 0;
+		if (capacity_ > 0)
+		{
+			samples = nctl::makeUnique<Sample[]>(capacity_);
+			numSamples = copySamples(samples.get(), firstFrame);
+		}
+
+		line = "index";
+		for (unsigned int stage = 0; stage < Stages::COUNT; stage++)
+			line.formatAppend(",%s_ms", StageNames[stage]);
+		line += "\n";
+		written = fileHandle->writeString(line);
+
+		for (unsigned int i = 0; i < numSamples && written; i++)
+		{
+			line.format("%lu", firstFrame + i);
+			for (unsigned int stage = 0; stage < Stages::COUNT; stage++)
+				line.formatAppend(",%.3f", samples[i].stageTimes[stage] * 1000.0f);
+			line += "\n";
+			written = fileHandle->writeString(line);
+		}
+	}
+	else
+	{
+		Summary summary;
+		computeSummary(summary);
+
+		line.format("{\n\t\"frames\": %u,\n\t\"hitches\": %u,\n\t\"hitch_factor\": %.2f,\n\t\"stages\": {\n",
+		            summary.numFrames, summary.numHitches, hitchFactor_);
+		written = fileHandle->writeString(line);
+
+		for (unsigned int stage = 0; stage < Stages::COUNT && written; stage++)
+		{
+			const StageSummary &s = summary.stages[stage];
+			line.format("\t\t\"%s\": { \"mean_ms\": %.3f, \"p50_ms\": %.3f, \"p95_ms\": %.3f, \"p99_ms\": %.3f, \"max_ms\": %.3f }%s\n",
+			            StageNames[stage], s.mean * 1000.0f, s.p50 * 1000.0f, s.p95 * 1000.0f, s.p99 * 1000.0f, s.max * 1000.0f,
+			            (stage < Stages::COUNT - 1) ? "," : "");
+			written = fileHandle->writeString(line);
+		}
+
+		line = "\t}\n}\n";
+		written = written && fileHandle->writeString(line);
+	}
+	fileHandle->close();
+
+	if (written == false)
+	{
+		LOGW_X("Cannot write the frame statistics file \"%s\"", path.data());
+		return false;
+	}
+
+	LOGI_X("Frame statistics saved to \"%s\"", path.data());
+	return true;
+}
+
+const char *FrameStatistics::stageName(unsigned int stage)
+{
+	ASSERT(stage < Stages::COUNT);
+	return (stage < Stages::COUNT) ? StageNames[stage] : nullptr;
+}
+
+FrameStatistics::Format FrameStatistics::formatFromExtension(const char *filename)
+{
+	return fs::hasExtension(filename, "json") ? Format::JSON : Format::CSV;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+unsigned int FrameStatistics::copySamples(Sample *dest, unsigned long int &firstFrame) const
+{
+	int64_t firstIndex = 0;
+	const unsigned int numSamples = copyRingElements(samples_.get(), capacity_, writeIndex_, 0, dest, firstIndex);
+	firstFrame = static_cast<unsigned long int>(firstIndex);
+	return numSamples;
+}
+
+}
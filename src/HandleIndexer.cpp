@@ -0,0 +1,162 @@
+#include "common_macros.h"
+#include "HandleIndexer.h"
+#include "Object.h"
+
+namespace ncine {
+
+const char *objectTypeToString(Object::ObjectType type)
+{
+	// clang-format off
+	switch (type)
+	{
+		case Object::ObjectType::BASE:					return "Base";
+		case Object::ObjectType::TEXTURE:				return "Texture";
+		case Object::ObjectType::SHADER:				return "Shader";
+		case Object::ObjectType::SCENENODE:				return "SceneNode";
+		case Object::ObjectType::SPRITE:				return "Sprite";
+		case Object::ObjectType::MESH_SPRITE:			return "MeshSprite";
+		case Object::ObjectType::ANIMATED_SPRITE:		return "AnimatedSprite";
+		case Object::ObjectType::PARTICLE:				return "Particle";
+		case Object::ObjectType::PARTICLE_SYSTEM:		return "ParticleSystem";
+		case Object::ObjectType::FONT:					return "Font";
+		case Object::ObjectType::TEXTNODE:				return "TextNode";
+		case Object::ObjectType::AUDIOBUFFER:			return "AudioBuffer";
+		case Object::ObjectType::AUDIOBUFFER_PLAYER:	return "AudioBufferPlayer";
+		case Object::ObjectType::AUDIOSTREAM_PLAYER:	return "AudioStreamPlayer";
+		default:										return "Unknown";
+	}
+	// clang-format on
+}
+
+///////////////////////////////////////////////////////////
+// STATIC DEFINITIONS
+///////////////////////////////////////////////////////////
+
+const unsigned int HandleIndexer::IndexBits;
+const unsigned int HandleIndexer::GenerationBits;
+const unsigned int HandleIndexer::MaxObjects;
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+HandleIndexer::HandleIndexer()
+    : numObjects_(0), numFreeSlots_(0), freeListHead_(0), freeListTail_(0), slots_(16)
+{
+	// First element reserved, a zero id is never valid and a zero index terminates the free list
+	slots_.pushBack({ nullptr, 0, 0 });
+}
+
+HandleIndexer::~HandleIndexer()
+{
+	// Destroying an object removes it and might remove its children
+	for (unsigned int i = 0; i < slots_.size(); i++)
+		delete slots_[i].object;
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+unsigned int HandleIndexer::addObject(Object *object)
+{
+	if (object == nullptr)
+		return 0;
+
+	unsigned int slotIndex = freeListHead_;
+	if (slotIndex != 0)
+	{
+		freeListHead_ = slots_[slotIndex].nextFree;
+		if (freeListHead_ == 0)
+			freeListTail_ = 0;
+		numFreeSlots_--;
+	}
+	else
+	{
+		FATAL_ASSERT_MSG_X(slots_.size() <= MaxObjects, "Cannot index more than %u objects", MaxObjects);
+		slotIndex = slots_.size();
+		slots_.pushBack({ nullptr, 0, 0 });
+	}
+
+	Slot &slot = slots_[slotIndex];
+	slot.object = object;
+	slot.nextFree = 0;
+	numObjects_++;
+
+	return (slot.generation << IndexBits) | slotIndex;
+}
+
+bool HandleIndexer::removeObject(unsigned int id)
+{
+	if (validSlot(id) == nullptr)
+		return false;
+
+	const unsigned int slotIndex = index(id);
+	Slot &slot = slots_[slotIndex];
+	slot.object = nullptr;
+	// Every id pointing to the slot becomes stale
+	slot.generation = (slot.generation + 1) & ((1U << GenerationBits) - 1);
+	slot.nextFree = 0;
+
+	if (freeListTail_ != 0)
+		slots_[freeListTail_].nextFree = slotIndex;
+	else
+		freeListHead_ = slotIndex;
+	freeListTail_ = slotIndex;
+	numFreeSlots_++;
+	numObjects_--;
+
+	return true;
+}
+
+Object *HandleIndexer::object(unsigned int id) const
+{
+	const Slot *slot = validSlot(id);
+	return (slot != nullptr) ? slot->object : nullptr;
+}
+
+/*! \note Only the object of a valid id can be changed, use `removeObject()` to invalidate it */
+bool HandleIndexer::setObject(unsigned int id, Object *object)
+{
+	if (object == nullptr || validSlot(id) == nullptr)
+		return false;
+
+	slots_[index(id)].object = object;
+	return true;
+}
+
+void HandleIndexer::logReport() const
+{
+	for (unsigned int i = 0; i < slots_.size(); i++)
+	{
+		const Object *objPtr = slots_[i].object;
+		if (objPtr)
+		{
+			const char *objName = objPtr->name();
+
+			if (objName)
+				LOGI_X("%s object (id %u, 0x%x): \"%s\"", objectTypeToString(objPtr->type()), objPtr->id(), objPtr, objName);
+			else
+				LOGI_X("%s object (id %u, 0x%x)", objectTypeToString(objPtr->type()), objPtr->id(), objPtr);
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+const HandleIndexer::Slot *HandleIndexer::validSlot(unsigned int id) const
+{
+	const unsigned int slotIndex = index(id);
+	if (slotIndex == 0 || slotIndex >= slots_.size())
+		return nullptr;
+
+	const Slot &slot = slots_[slotIndex];
+	if (slot.object == nullptr || slot.generation != generation(id))
+		return nullptr;
+
+	return &slot;
+}
+
+}
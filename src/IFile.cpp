@@ -33,6 +33,12 @@ bool IFile::isOpened() const
 		return false;
 }
 
+bool IFile::writeString(const nctl::String &string)
+{
+	void *buffer = const_cast<char *>(string.data());
+	return (write(buffer, string.length()) == string.length());
+}
+
 nctl::UniquePtr<IFile> IFile::createFromMemory(const char *bufferName, unsigned char *bufferPtr, unsigned long int bufferSize)
 {
 	ASSERT(bufferName);
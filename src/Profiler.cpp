@@ -0,0 +1,296 @@
+#include <cstdio> // for snprintf()
+#include <cstring> // for strncpy() and memcpy()
+#include "common_macros.h"
+#include "Profiler.h"
+#include "Clock.h"
+#include "FileSystem.h"
+#include "IFile.h"
+#include "ring_copy.h"
+#include <nctl/Atomic.h>
+#include <nctl/String.h>
+#include <nctl/UniquePtr.h>
+
+namespace ncine {
+
+namespace {
+	struct ZoneEvent
+	{
+		const char *name;
+		uint64_t start;
+		uint64_t end;
+	};
+
+	/// The zones recorded by a thread, only the owning thread writes events in it
+	struct ThreadBuffer
+	{
+		ZoneEvent events[Profiler::ZonesPerThread];
+		/// The total number of recorded zones, the next one is written at this index modulo the capacity
+		nctl::Atomic64 writeIndex;
+		/// The zones before this index have been discarded
+		nctl::Atomic64 clearIndex;
+		char name[Profiler::MaxThreadNameLength];
+	};
+
+	/// Owns the buffers of all threads, they outlive their thread so that its zones can still be saved
+	struct ThreadBuffers
+	{
+		~ThreadBuffers()
+		{
+			for (unsigned int i = 0; i < Profiler::MaxThreads; i++)
+				delete buffers[i];
+		}
+
+		ThreadBuffer *buffers[Profiler::MaxThreads] = {};
+		/// The number of claimed slots, it can grow past the maximum number of threads
+		nctl::Atomic32 numSlots;
+		/// A bit is set when the buffer in the corresponding slot can be read
+		nctl::Atomic64 readyMask;
+	};
+
+	static_assert(Profiler::MaxThreads <= 64, "The ready buffers mask has 64 bits");
+
+	const int NoSlot = -1;
+	const int UnavailableSlot = -2;
+
+	thread_local int threadSlot = NoSlot;
+	/// The name set before the thread has a buffer, it is copied into the buffer when it is created
+	thread_local char pendingThreadName[Profiler::MaxThreadNameLength] = {};
+
+	ThreadBuffers &threadBuffers()
+	{
+		static ThreadBuffers buffers;
+		return buffers;
+	}
+
+	/// Returns the buffer of the calling thread, creating it the first time
+	ThreadBuffer *threadBuffer()
+	{
+		if (threadSlot >= 0)
+			return threadBuffers().buffers[threadSlot];
+		else if (threadSlot == UnavailableSlot)
+			return nullptr;
+
+		ThreadBuffers &buffers = threadBuffers();
+		const int32_t slot = buffers.numSlots.fetchAdd(1, nctl::Atomic32::MemoryModel::RELAXED);
+		if (slot >= static_cast<int32_t>(Profiler::MaxThreads))
+		{
+			LOGW_X("The profiler cannot record zones from more than %u threads", Profiler::MaxThreads);
+			threadSlot = UnavailableSlot;
+			return nullptr;
+		}
+
+		ThreadBuffer *buffer = new ThreadBuffer;
+		if (pendingThreadName[0] != '\0')
+			memcpy(buffer->name, pendingThreadName, Profiler::MaxThreadNameLength);
+		else
+			snprintf(buffer->name, Profiler::MaxThreadNameLength, "Thread#%02d", slot);
+		buffers.buffers[slot] = buffer;
+
+		// Readers will only access the buffer after it has been fully constructed
+		const int64_t bit = int64_t(uint64_t(1) << slot);
+		int64_t current = buffers.readyMask.load(nctl::Atomic64::MemoryModel::RELAXED);
+		while (buffers.readyMask.cmpExchange(current | bit, current, nctl::Atomic64::MemoryModel::RELEASE) == false)
+			current = buffers.readyMask.load(nctl::Atomic64::MemoryModel::RELAXED);
+
+		threadSlot = slot;
+		return buffer;
+	}
+
+	/// Returns the buffer in a slot if it can be read, or `nullptr`
+	ThreadBuffer *readyBuffer(int64_t readyMask, unsigned int slot)
+	{
+		return (uint64_t(readyMask) & (uint64_t(1) << slot)) ? threadBuffers().buffers[slot] : nullptr;
+	}
+
+	/// Copies a string escaping the characters that are not allowed inside a JSON string
+	void escapeJson(const char *src, char *dest, unsigned int destSize)
+	{
+		unsigned int length = 0;
+		for (; *src != '\0'; src++)
+		{
+			const unsigned char c = static_cast<unsigned char>(*src);
+			const unsigned int needed = (c == '"' || c == '\\') ? 2 : (c < 0x20 ? 6 : 1);
+			if (length + needed >= destSize)
+				break;
+
+			if (c == '"' || c == '\\')
+			{
+				dest[length++] = '\\';
+				dest[length++] = static_cast<char>(c);
+			}
+			else if (c < 0x20)
+				length += snprintf(dest + length, destSize - length, "\\u%04x", c);
+			else
+				dest[length++] = static_cast<char>(c);
+		}
+		dest[length] = '\0';
+	}
+}
+
+///////////////////////////////////////////////////////////
+// STATIC DEFINITIONS
+///////////////////////////////////////////////////////////
+
+const unsigned int Profiler::MaxThreads;
+const unsigned int Profiler::ZonesPerThread;
+const unsigned int Profiler::MaxThreadNameLength;
+
+nctl::Atomic32 Profiler::enabled_(0);
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+/*! \note Other threads will pick up the change when they start their next zone */
+void Profiler::setEnabled(bool enabled)
+{
+	enabled_.store(enabled ? 1 : 0, nctl::Atomic32::MemoryModel::RELAXED);
+}
+
+/*! \note Threads that never record a zone, like workers when the profiler is disabled, do not allocate a buffer */
+void Profiler::setThreadName(const char *name)
+{
+	ASSERT(name);
+	char *dest = (threadSlot >= 0) ? threadBuffers().buffers[threadSlot]->name : pendingThreadName;
+	strncpy(dest, name, MaxThreadNameLength - 1);
+	dest[MaxThreadNameLength - 1] = '\0';
+}
+
+unsigned int Profiler::numThreads()
+{
+	const int64_t readyMask = threadBuffers().readyMask.load(nctl::Atomic64::MemoryModel::ACQUIRE);
+	unsigned int count = 0;
+	for (unsigned int i = 0; i < MaxThreads; i++)
+	{
+		if (readyBuffer(readyMask, i) != nullptr)
+			count++;
+	}
+	return count;
+}
+
+unsigned long int Profiler::numZones()
+{
+	const int64_t readyMask = threadBuffers().readyMask.load(nctl::Atomic64::MemoryModel::ACQUIRE);
+	unsigned long int count = 0;
+	for (unsigned int i = 0; i < MaxThreads; i++)
+	{
+		ThreadBuffer *buffer = readyBuffer(readyMask, i);
+		if (buffer != nullptr)
+		{
+			const int64_t numRecorded = buffer->writeIndex.load(nctl::Atomic64::MemoryModel::ACQUIRE) -
+			                            buffer->clearIndex.load(nctl::Atomic64::MemoryModel::RELAXED);
+			count += static_cast<unsigned long int>((numRecorded < ZonesPerThread) ? numRecorded : ZonesPerThread);
+		}
+	}
+	return count;
+}
+
+void Profiler::clear()
+{
+	// The writers are not touched, the zones recorded until now are just skipped by the readers
+	const int64_t readyMask = threadBuffers().readyMask.load(nctl::Atomic64::MemoryModel::ACQUIRE);
+	for (unsigned int i = 0; i < MaxThreads; i++)
+	{
+		ThreadBuffer *buffer = readyBuffer(readyMask, i);
+		if (buffer != nullptr)
+			buffer->clearIndex.store(buffer->writeIndex.load(nctl::Atomic64::MemoryModel::ACQUIRE), nctl::Atomic64::MemoryModel::RELAXED);
+	}
+}
+
+/*! \note Zones are saved as complete events with timestamps and durations in microseconds */
+bool Profiler::saveChromeTrace(const char *filename)
+{
+	ASSERT(filename);
+
+	const nctl::String path = fs::joinPath(fs::savePath(), filename);
+	nctl::UniquePtr<IFile> fileHandle = IFile::createFileHandle(path.data());
+	fileHandle->setExitOnFailToOpen(false);
+	fileHandle->open(IFile::OpenMode::WRITE | IFile::OpenMode::BINARY);
+	if (fileHandle->isOpened() == false)
+	{
+		LOGW_X("Cannot open the profiler trace file \"%s\"", path.data());
+		return false;
+	}
+
+	const uint64_t baseCount = clock().baseCount();
+	const double ticksToMicroseconds = 1000000.0 / static_cast<double>(clock().frequency());
+	nctl::UniquePtr<ZoneEvent[]> events = nctl::makeUnique<ZoneEvent[]>(ZonesPerThread);
+
+	nctl::String line(256);
+	// Every character could be escaped as a six characters unicode sequence
+	char escapedName[MaxThreadNameLength * 6];
+	char escapedZoneName[256];
+	line = "{\"traceEvents\":[\n";
+	bool written = fileHandle->writeString(line);
+	bool firstEvent = true;
+	unsigned long int numSaved = 0;
+
+	const int64_t readyMask = threadBuffers().readyMask.load(nctl::Atomic64::MemoryModel::ACQUIRE);
+	for (unsigned int i = 0; i < MaxThreads && written; i++)
+	{
+		ThreadBuffer *buffer = readyBuffer(readyMask, i);
+		if (buffer == nullptr)
+			continue;
+
+		escapeJson(buffer->name, escapedName, sizeof(escapedName));
+		line.format("%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+		            firstEvent ? "" : ",\n", i, escapedName);
+		written = fileHandle->writeString(line);
+		firstEvent = false;
+
+		int64_t firstIndex = 0;
+		const int64_t clearIndex = buffer->clearIndex.load(nctl::Atomic64::MemoryModel::RELAXED);
+		const unsigned int numEvents = copyRingElements(buffer->events, ZonesPerThread, buffer->writeIndex, clearIndex, events.get(), firstIndex);
+		for (unsigned int j = 0; j < numEvents && written; j++)
+		{
+			const ZoneEvent &event = events[j];
+			const double start = static_cast<double>(event.start - baseCount) * ticksToMicroseconds;
+			const double duration = static_cast<double>(event.end - event.start) * ticksToMicroseconds;
+			escapeJson(event.name, escapedZoneName, sizeof(escapedZoneName));
+			line.format(",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+			            escapedZoneName, i, start, duration);
+			written = fileHandle->writeString(line);
+		}
+		numSaved += numEvents;
+	}
+
+	line = "\n]}\n";
+	written = written && fileHandle->writeString(line);
+	fileHandle->close();
+
+	if (written == false)
+	{
+		LOGW_X("Cannot write the profiler trace file \"%s\"", path.data());
+		return false;
+	}
+
+	LOGI_X("Profiler trace with %lu zones saved to \"%s\"", numSaved, path.data());
+	return true;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+uint64_t Profiler::ticks()
+{
+	return clock().counter();
+}
+
+void Profiler::recordZone(const char *name, uint64_t start, uint64_t end)
+{
+	ThreadBuffer *buffer = threadBuffer();
+	if (buffer == nullptr)
+		return;
+
+	const int64_t index = buffer->writeIndex.load(nctl::Atomic64::MemoryModel::RELAXED);
+	ZoneEvent &event = buffer->events[index % ZonesPerThread];
+	event.name = name;
+	event.start = start;
+	event.end = end;
+
+	// Readers will only see the new index after the event has been written
+	buffer->writeIndex.store(index + 1, nctl::Atomic64::MemoryModel::RELEASE);
+}
+
+}
@@ -3,6 +3,7 @@
 #include <nctl/AllocManager.h>
 #include <nctl/MallocAllocator.h>
 #include <nctl/FreeListAllocator.h>
+#include <nctl/ThreadCacheAllocator.h>
 #include <nctl/ProxyAllocator.h>
 
 #ifdef WITH_IMGUI
@@ -34,6 +35,10 @@ static FreeListAllocator &freelistAllocator = reinterpret_cast<FreeListAllocator
 #else
 alignas(IAllocator::DefaultAlignment) static uint8_t mallocAllocatorBuffer[sizeof(MallocAllocator)];
 static MallocAllocator &mallocAllocator = reinterpret_cast<MallocAllocator &>(mallocAllocatorBuffer);
+	#ifdef USE_THREADCACHE
+alignas(IAllocator::DefaultAlignment) static uint8_t threadCacheAllocatorBuffer[sizeof(ThreadCacheAllocator)];
+static ThreadCacheAllocator &threadCacheAllocator = reinterpret_cast<ThreadCacheAllocator &>(threadCacheAllocatorBuffer);
+	#endif
 #endif
 
 #ifdef WITH_IMGUI
@@ -121,7 +126,12 @@ AllocManager::AllocManager()
 	mainAllocator = &freelistAllocator;
 #else
 	new (&mallocAllocator) MallocAllocator();
+	#ifdef USE_THREADCACHE
+	new (&threadCacheAllocator) ThreadCacheAllocator("Default", mallocAllocator);
+	mainAllocator = &threadCacheAllocator;
+	#else
 	mainAllocator = &mallocAllocator;
+	#endif
 #endif
 
 	defaultAllocator_ = mainAllocator;
@@ -154,6 +164,9 @@ AllocManager::~AllocManager()
 #ifdef USE_FREELIST
 	(&freelistAllocator)->~FreeListAllocator();
 #else
+	#ifdef USE_THREADCACHE
+	(&threadCacheAllocator)->~ThreadCacheAllocator();
+	#endif
 	(&mallocAllocator)->~MallocAllocator();
 #endif
 }
@@ -0,0 +1,176 @@
+#include <cstring> // for memmove()
+#include <ncine/common_macros.h>
+#include <nctl/FrameArenaAllocator.h>
+#include <nctl/AllocManager.h>
+#include <nctl/PointerMath.h>
+
+namespace nctl {
+
+///////////////////////////////////////////////////////////
+// STATIC DEFINITIONS
+///////////////////////////////////////////////////////////
+
+const size_t FrameArenaAllocator::DefaultBufferSize;
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+FrameArenaAllocator::FrameArenaAllocator(const char *name, size_t bufferSize)
+    : FrameArenaAllocator(name, bufferSize, theDefaultAllocator())
+{
+}
+
+FrameArenaAllocator::FrameArenaAllocator(const char *name, size_t bufferSize, IAllocator &source)
+    : IAllocator(name, allocateImpl, reallocateImpl, deallocateImpl, 0, nullptr),
+      source_(source), bufferSize_(bufferSize), buffers_{ nullptr, nullptr }, currentBuffer_(0),
+      lastFrameUsedMemory_(0), peakUsedMemory_(0), frameNumOverflows_(0), lastFrameNumOverflows_(0), numOverflows_(0), numActiveOverflows_(0)
+{
+	FATAL_ASSERT(bufferSize_ > 0);
+
+	for (unsigned int i = 0; i < 2; i++)
+	{
+		buffers_[i] = source_.allocate(bufferSize_);
+		FATAL_ASSERT(buffers_[i] != nullptr);
+		linearAllocators_[i].init(bufferSize_, buffers_[i]);
+	}
+	size_ = bufferSize_ * 2;
+}
+
+/*! \note Allocations served by the source allocator are not deallocated */
+FrameArenaAllocator::~FrameArenaAllocator()
+{
+	for (unsigned int i = 0; i < 2; i++)
+	{
+		linearAllocators_[i].clear();
+		source_.deallocate(buffers_[i]);
+	}
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void FrameArenaAllocator::swapBuffers()
+{
+	LinearAllocator &current = linearAllocators_[currentBuffer_];
+	lastFrameUsedMemory_ = current.usedMemory();
+	if (peakUsedMemory_ < lastFrameUsedMemory_)
+		peakUsedMemory_ = lastFrameUsedMemory_;
+	lastFrameNumOverflows_ = frameNumOverflows_;
+	frameNumOverflows_ = 0;
+
+	// The allocations of the current frame are kept alive for the next one
+	currentBuffer_ = (currentBuffer_ + 1) % 2;
+	linearAllocators_[currentBuffer_].clear();
+	updateStatistics();
+}
+
+bool FrameArenaAllocator::owns(const void *ptr) const
+{
+	for (unsigned int i = 0; i < 2; i++)
+	{
+		if (ptr >= buffers_[i] && ptr < PointerMath::add(buffers_[i], bufferSize_))
+			return true;
+	}
+
+	return false;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+/*! \note The memory of allocations served by the source allocator is not accounted for */
+void FrameArenaAllocator::updateStatistics()
+{
+	usedMemory_ = linearAllocators_[0].usedMemory() + linearAllocators_[1].usedMemory();
+	numAllocations_ = linearAllocators_[0].numAllocations() + linearAllocators_[1].numAllocations() + numActiveOverflows_;
+}
+
+void *FrameArenaAllocator::allocateImpl(IAllocator *allocator, size_t bytes, uint8_t alignment)
+{
+	FATAL_ASSERT(bytes > 0);
+	FATAL_ASSERT_MSG((alignment & (alignment - 1)) == 0, "The alignment should be a power of two");
+	FATAL_ASSERT_MSG(alignment >= 1 && alignment <= 128, "The alignment must be between 1 and 128");
+
+	FATAL_ASSERT(allocator);
+	FrameArenaAllocator *allocatorImpl = static_cast<FrameArenaAllocator *>(allocator);
+
+	// The header is aligned and its offset is a multiple of the alignment, so that the allocation is aligned too
+	static_assert((sizeof(Header) & (sizeof(Header) - 1)) == 0, "The header size should be a power of two");
+	const uint8_t bufferAlignment = (alignment > alignof(Header)) ? alignment : alignof(Header);
+	const size_t headerOffset = (bufferAlignment > sizeof(Header)) ? bufferAlignment : sizeof(Header);
+
+	LinearAllocator &current = allocatorImpl->linearAllocators_[allocatorImpl->currentBuffer_];
+	void *ptr = current.allocate(bytes + headerOffset, bufferAlignment);
+
+	if (ptr != nullptr)
+	{
+		ptr = PointerMath::add(ptr, headerOffset);
+		Header *header = reinterpret_cast<Header *>(PointerMath::subtract(ptr, sizeof(Header)));
+		header->size = bytes;
+	}
+	else
+	{
+		// The buffer is full, the allocation falls back to the source allocator
+		ptr = allocatorImpl->source_.allocate(bytes, alignment);
+		if (ptr == nullptr)
+			return nullptr;
+
+		allocatorImpl->frameNumOverflows_++;
+		allocatorImpl->numOverflows_++;
+		allocatorImpl->numActiveOverflows_++;
+	}
+
+	allocatorImpl->updateStatistics();
+	return ptr;
+}
+
+void *FrameArenaAllocator::reallocateImpl(IAllocator *allocator, void *ptr, size_t bytes, uint8_t alignment, size_t &oldSize)
+{
+	FATAL_ASSERT(ptr != nullptr);
+	FATAL_ASSERT(bytes > 0);
+	FATAL_ASSERT_MSG((alignment & (alignment - 1)) == 0, "The alignment should be a power of two");
+	FATAL_ASSERT_MSG(alignment >= 1 && alignment <= 128, "The alignment must be between 1 and 128");
+
+	FATAL_ASSERT(allocator);
+	FrameArenaAllocator *allocatorImpl = static_cast<FrameArenaAllocator *>(allocator);
+
+	// The copy is performed here as the size of a linear allocation is unknown
+	allocatorImpl->copyOnReallocation_ = false;
+	oldSize = 0;
+
+	if (allocatorImpl->owns(ptr) == false)
+		return allocatorImpl->source_.reallocate(ptr, bytes, alignment);
+
+	// Access the header in the bytes before `ptr`
+	const Header *header = reinterpret_cast<const Header *>(PointerMath::subtract(ptr, sizeof(Header)));
+	const size_t allocationSize = header->size;
+
+	void *newPtr = allocateImpl(allocator, bytes, alignment);
+	if (newPtr != nullptr)
+		memmove(newPtr, ptr, (bytes < allocationSize) ? bytes : allocationSize);
+
+	return newPtr;
+}
+
+void FrameArenaAllocator::deallocateImpl(IAllocator *allocator, void *ptr)
+{
+	if (ptr == nullptr)
+		return;
+
+	FATAL_ASSERT(allocator);
+	FrameArenaAllocator *allocatorImpl = static_cast<FrameArenaAllocator *>(allocator);
+
+	// Memory from the buffers is only reclaimed when they are swapped
+	if (allocatorImpl->owns(ptr))
+		return;
+
+	allocatorImpl->source_.deallocate(ptr);
+	FATAL_ASSERT(allocatorImpl->numActiveOverflows_ > 0);
+	allocatorImpl->numActiveOverflows_--;
+	allocatorImpl->updateStatistics();
+}
+
+}
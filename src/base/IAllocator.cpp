@@ -26,7 +26,7 @@ IAllocator::IAllocator(const char *name, AllocateFunction allocFunc, ReallocateF
 #endif
 #if defined(RECORD_ALLOCATIONS)
       ,
-      recordAllocations_(true), numEntries_(0)
+      recordAllocations_(true), recordLock_(0), numEntries_(0)
 #endif
 {
 	nctl::strncpy(name_, MaxNameLength, name, MaxNameLength - 1);
@@ -198,16 +198,21 @@ void *IAllocator::wrapAllocate(IAllocator *allocator, size_t bytes, uint8_t alig
 	#endif
 
 	#ifdef RECORD_ALLOCATIONS
-	if (allocator->recordAllocations_ && allocator->numEntries_ < MaxEntries && ptr != nullptr && bytes > 0)
+	if (allocator->recordAllocations_ && ptr != nullptr && bytes > 0)
 	{
-		Entry &entry = allocator->entries_[allocator->numEntries_];
-		entry.timestamp = ncine::TimeStamp::now();
-		entry.ptr = ptr;
-		entry.bytes = bytes;
-		entry.alignment = alignment;
-		entry.usedMemory = allocator->usedMemory_;
-		entry.numAllocations = allocator->numAllocations_;
-		allocator->numEntries_++;
+		allocator->acquireRecordLock();
+		if (allocator->numEntries_ < MaxEntries)
+		{
+			Entry &entry = allocator->entries_[allocator->numEntries_];
+			entry.timestamp = ncine::TimeStamp::now();
+			entry.ptr = ptr;
+			entry.bytes = bytes;
+			entry.alignment = alignment;
+			entry.usedMemory = allocator->usedMemory_;
+			entry.numAllocations = allocator->numAllocations_;
+			allocator->numEntries_++;
+		}
+		allocator->releaseRecordLock();
 	}
 	#endif
 
@@ -228,6 +233,7 @@ void *IAllocator::wrapReallocate(IAllocator *allocator, void *ptr, size_t bytes,
 	#ifdef RECORD_ALLOCATIONS
 	if (allocator->recordAllocations_ && newPtr != nullptr)
 	{
+		allocator->acquireRecordLock();
 		for (size_t i = 0; i < allocator->numEntries_; i++)
 		{
 			if (allocator->entry(i).ptr == ptr)
@@ -242,6 +248,7 @@ void *IAllocator::wrapReallocate(IAllocator *allocator, void *ptr, size_t bytes,
 				break;
 			}
 		}
+		allocator->releaseRecordLock();
 	}
 	#endif
 
@@ -261,16 +268,21 @@ void IAllocator::wrapDeallocate(IAllocator *allocator, void *ptr)
 	#endif
 
 	#ifdef RECORD_ALLOCATIONS
-	if (allocator->recordAllocations_ && allocator->numEntries_ < MaxEntries && ptr != nullptr)
+	if (allocator->recordAllocations_ && ptr != nullptr)
 	{
-		Entry &entry = allocator->entries_[allocator->numEntries_];
-		entry.timestamp = ncine::TimeStamp::now();
-		entry.ptr = ptr;
-		entry.bytes = memoryUsedBefore - allocator->usedMemory_;
-		entry.alignment = 0;
-		entry.usedMemory = allocator->usedMemory_;
-		entry.numAllocations = allocator->numAllocations_;
-		allocator->numEntries_++;
+		allocator->acquireRecordLock();
+		if (allocator->numEntries_ < MaxEntries)
+		{
+			Entry &entry = allocator->entries_[allocator->numEntries_];
+			entry.timestamp = ncine::TimeStamp::now();
+			entry.ptr = ptr;
+			entry.bytes = memoryUsedBefore - allocator->usedMemory_;
+			entry.alignment = 0;
+			entry.usedMemory = allocator->usedMemory_;
+			entry.numAllocations = allocator->numAllocations_;
+			allocator->numEntries_++;
+		}
+		allocator->releaseRecordLock();
 	}
 	#endif
 }
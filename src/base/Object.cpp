@@ -37,6 +37,7 @@ Object &Object::operator=(Object &&other)
 	type_ = other.type_;
 	theServiceLocator().indexer().removeObject(id_);
 	id_ = other.id_;
+	theServiceLocator().indexer().setObject(id_, this);
 	name_ = other.name_;
 
 	other.id_ = 0;
@@ -0,0 +1,178 @@
+#include <ncine/common_macros.h>
+#include <nctl/SlabAllocator.h>
+#include <nctl/AllocManager.h>
+#include <nctl/PointerMath.h>
+
+namespace nctl {
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+SlabAllocator::SlabAllocator(const char *name, size_t elementSize, uint8_t elementAlignment, unsigned int elementsPerSlab)
+    : SlabAllocator(name, elementSize, elementAlignment, elementsPerSlab, theDefaultAllocator())
+{
+}
+
+SlabAllocator::SlabAllocator(const char *name, size_t elementSize, uint8_t elementAlignment, unsigned int elementsPerSlab, IAllocator &source)
+    : IAllocator(name, allocateImpl, reallocateImpl, deallocateImpl, 0, nullptr),
+      source_(source), elementSize_(elementSize), elementAlignment_(elementAlignment), elementStride_(0),
+      elementsPerSlab_(elementsPerSlab), numSlabs_(0), capacity_(0), freeList_(nullptr)
+{
+	FATAL_ASSERT(elementSize_ > 0);
+	FATAL_ASSERT(elementsPerSlab_ > 0);
+	FATAL_ASSERT_MSG((elementAlignment_ & (elementAlignment_ - 1)) == 0, "The alignment should be a power of two");
+	FATAL_ASSERT_MSG(elementAlignment_ >= 1 && elementAlignment_ <= 128, "The alignment must be between 1 and 128");
+
+	// The element should be big enough to store a pointer in the free list
+	elementStride_ = (elementSize_ > sizeof(void *)) ? elementSize_ : sizeof(void *);
+	// Every element in a slab should be aligned
+	elementStride_ = (elementStride_ + elementAlignment_ - 1) & ~size_t(elementAlignment_ - 1);
+}
+
+/*! \note Slabs with active allocations are not given back to the source allocator */
+SlabAllocator::~SlabAllocator()
+{
+	releaseSlabs();
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool SlabAllocator::owns(const void *ptr) const
+{
+	for (unsigned int i = 0; i < numSlabs_; i++)
+	{
+		const Slab &slab = slabs_[i];
+		if (ptr >= slab.memory && ptr < PointerMath::add(slab.memory, slab.bytes))
+			return true;
+	}
+
+	return false;
+}
+
+bool SlabAllocator::reserve(size_t numElements)
+{
+	while (capacity_ < numElements)
+	{
+		if (addSlab() == false)
+			return false;
+	}
+
+	return true;
+}
+
+bool SlabAllocator::releaseSlabs()
+{
+	if (numAllocations_ > 0)
+		return false;
+
+	for (unsigned int i = 0; i < numSlabs_; i++)
+	{
+		source_.deallocate(slabs_[i].memory);
+		slabs_[i].memory = nullptr;
+		slabs_[i].bytes = 0;
+		slabs_[i].numElements = 0;
+	}
+
+	numSlabs_ = 0;
+	capacity_ = 0;
+	size_ = 0;
+	freeList_ = nullptr;
+
+	return true;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool SlabAllocator::addSlab()
+{
+	if (numSlabs_ >= MaxSlabs)
+		return false;
+
+	// Every new slab doubles the capacity of the allocator
+	const size_t numElements = (numSlabs_ == 0) ? elementsPerSlab_ : capacity_;
+	const size_t bytes = numElements * elementStride_;
+	void *memory = source_.allocate(bytes, elementAlignment_);
+	if (memory == nullptr)
+		return false;
+
+	Slab &slab = slabs_[numSlabs_];
+	slab.memory = memory;
+	slab.bytes = bytes;
+	slab.numElements = numElements;
+	numSlabs_++;
+	capacity_ += numElements;
+	size_ += bytes;
+
+	// Link the elements of the new slab in front of the free list
+	void **ptr = reinterpret_cast<void **>(memory);
+	for (size_t i = 0; i < numElements - 1; i++)
+	{
+		*ptr = PointerMath::add(ptr, elementStride_);
+		ptr = reinterpret_cast<void **>(*ptr);
+	}
+	*ptr = freeList_;
+	freeList_ = reinterpret_cast<void **>(memory);
+
+	return true;
+}
+
+void *SlabAllocator::allocateImpl(IAllocator *allocator, size_t bytes, uint8_t alignment)
+{
+	FATAL_ASSERT(bytes > 0);
+	FATAL_ASSERT_MSG((alignment & (alignment - 1)) == 0, "The alignment should be a power of two");
+	FATAL_ASSERT_MSG(alignment >= 1 && alignment <= 128, "The alignment must be between 1 and 128");
+
+	FATAL_ASSERT(allocator);
+	SlabAllocator *allocatorImpl = static_cast<SlabAllocator *>(allocator);
+
+	FATAL_ASSERT(bytes <= allocatorImpl->elementSize_);
+	FATAL_ASSERT(alignment <= allocatorImpl->elementAlignment_);
+
+	if (allocatorImpl->freeList_ == nullptr && allocatorImpl->addSlab() == false)
+		return nullptr;
+
+	void *ptr = allocatorImpl->freeList_;
+	allocatorImpl->freeList_ = reinterpret_cast<void **>(*allocatorImpl->freeList_);
+
+	allocatorImpl->usedMemory_ += allocatorImpl->elementStride_;
+	allocatorImpl->numAllocations_++;
+	return ptr;
+}
+
+void *SlabAllocator::reallocateImpl(IAllocator *allocator, void *ptr, size_t bytes, uint8_t alignment, size_t &oldSize)
+{
+	ASSERT_MSG(false, "SlabAllocator cannot reallocate");
+
+	FATAL_ASSERT(allocator);
+	SlabAllocator *allocatorImpl = static_cast<SlabAllocator *>(allocator);
+
+	// Never try to allocte a new block and perform a copy of the data in `IAllocator`
+	allocatorImpl->copyOnReallocation_ = false;
+	oldSize = 0;
+
+	return nullptr;
+}
+
+void SlabAllocator::deallocateImpl(IAllocator *allocator, void *ptr)
+{
+	if (ptr == nullptr)
+		return;
+
+	FATAL_ASSERT(allocator);
+	SlabAllocator *allocatorImpl = static_cast<SlabAllocator *>(allocator);
+	ASSERT(allocatorImpl->owns(ptr));
+
+	*reinterpret_cast<void **>(ptr) = allocatorImpl->freeList_;
+	allocatorImpl->freeList_ = reinterpret_cast<void **>(ptr);
+	allocatorImpl->usedMemory_ -= allocatorImpl->elementStride_;
+
+	FATAL_ASSERT(allocatorImpl->numAllocations_ > 0);
+	allocatorImpl->numAllocations_--;
+}
+
+}
@@ -0,0 +1,43 @@
+#include <nctl/SpinLock.h>
+
+#if defined(_WIN32)
+	#include <ncine/common_windefines.h>
+	#include <synchapi.h>
+#else
+	#include <sched.h>
+#endif
+
+namespace nctl {
+
+namespace {
+
+	const unsigned int MaxSpinsBeforeYield = 64;
+
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void SpinLock::lock()
+{
+	unsigned int numSpins = 0;
+	while (tryLock() == false)
+	{
+		// Wait for the lock to look free before trying to acquire it again
+		while (lock_.load(Atomic32::MemoryModel::RELAXED) != 0)
+		{
+			// Give the lock holder a chance to run if it has been preempted
+			if (++numSpins % MaxSpinsBeforeYield == 0)
+			{
+#if defined(_WIN32)
+				Sleep(0);
+#else
+				sched_yield();
+#endif
+			}
+		}
+	}
+}
+
+}
@@ -0,0 +1,517 @@
+#include <ncine/common_macros.h>
+#include <nctl/ThreadCacheAllocator.h>
+#include <nctl/AllocManager.h>
+#include <nctl/PointerMath.h>
+
+namespace nctl {
+
+namespace {
+
+	/// The header stored before every block, it keeps the size class of the block
+	struct Header
+	{
+		uint32_t sizeClass;
+		/// Distance from the pointer returned by the source allocator, for large allocations only
+		uint32_t offset;
+		/// Number of bytes requested to the source allocator, for large allocations only
+		size_t bytes;
+	};
+
+	const size_t HeaderSize = 16;
+	static_assert(sizeof(Header) <= HeaderSize, "The block header should fit in 16 bytes");
+	const uint32_t LargeClass = 0xFFFFFFFF;
+
+	/// The number of blocks moved between a thread cache and the shared backend at once
+	unsigned int batchSize(unsigned int sizeClass)
+	{
+		const size_t numBlocks = 16384 / ThreadCacheAllocator::classSize(sizeClass);
+		return (numBlocks < 2) ? 2 : (numBlocks > 32 ? 32 : static_cast<unsigned int>(numBlocks));
+	}
+
+	/// The maximum number of free blocks of a size class that a thread cache can hold before flushing
+	unsigned int maxCachedBlocks(unsigned int sizeClass)
+	{
+		return batchSize(sizeClass) * 4;
+	}
+
+	inline Header *headerFromPointer(void *ptr)
+	{
+		return reinterpret_cast<Header *>(PointerMath::subtract(ptr, HeaderSize));
+	}
+
+	/// Thread cache slots are shared by all the allocators, every thread owns the same slot in each of them
+	/*! \note A function local static is used to avoid the mask being reinitialized after the first allocations */
+	Atomic64 &threadSlotsMask()
+	{
+		static Atomic64 mask;
+		return mask;
+	}
+
+	const int NoSlot = -1;
+	const int UnavailableSlot = -2;
+
+	void releaseThreadSlot(int index)
+	{
+		Atomic64 &mask = threadSlotsMask();
+		const uint64_t bit = uint64_t(1) << index;
+
+		int64_t current = mask.load(Atomic64::MemoryModel::RELAXED);
+		while (mask.cmpExchange(int64_t(uint64_t(current) & ~bit), current, Atomic64::MemoryModel::RELEASE) == false)
+			current = mask.load(Atomic64::MemoryModel::RELAXED);
+	}
+
+	/// A thread slot is given back when its thread exits, the cache is then reused by a new thread
+	struct ThreadSlot
+	{
+		constexpr ThreadSlot()
+		    : index(NoSlot) {}
+		~ThreadSlot()
+		{
+			if (index >= 0)
+				releaseThreadSlot(index);
+			// Allocations happening after the thread local destructors will use the shared backend
+			index = UnavailableSlot;
+		}
+
+		int index;
+	};
+
+	thread_local ThreadSlot threadSlot;
+
+	int acquireThreadSlot()
+	{
+		static_assert(ThreadCacheAllocator::MaxThreadCaches <= 64, "The thread slots mask has 64 bits");
+		Atomic64 &mask = threadSlotsMask();
+
+		int64_t current = mask.load(Atomic64::MemoryModel::RELAXED);
+		while (true)
+		{
+			const uint64_t currentBits = uint64_t(current);
+			int index = UnavailableSlot;
+			for (unsigned int i = 0; i < ThreadCacheAllocator::MaxThreadCaches; i++)
+			{
+				if ((currentBits & (uint64_t(1) << i)) == 0)
+				{
+					index = static_cast<int>(i);
+					break;
+				}
+			}
+
+			if (index == UnavailableSlot)
+				return UnavailableSlot;
+
+			if (mask.cmpExchange(int64_t(currentBits | (uint64_t(1) << index)), current, Atomic64::MemoryModel::ACQUIRE))
+				return index;
+			current = mask.load(Atomic64::MemoryModel::RELAXED);
+		}
+	}
+
+}
+
+///////////////////////////////////////////////////////////
+// STATIC DEFINITIONS
+///////////////////////////////////////////////////////////
+
+const unsigned int ThreadCacheAllocator::MaxThreadCaches;
+const unsigned int ThreadCacheAllocator::NumSizeClasses;
+const size_t ThreadCacheAllocator::MaxSmallSize;
+const size_t ThreadCacheAllocator::ChunkSize;
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+ThreadCacheAllocator::ThreadCacheAllocator()
+    : ThreadCacheAllocator("ThreadCache", theDefaultAllocator())
+{
+}
+
+ThreadCacheAllocator::ThreadCacheAllocator(const char *name, IAllocator &source)
+    : IAllocator(name, allocateImpl, reallocateImpl, deallocateImpl, 0, nullptr),
+      source_(source), chunks_(nullptr), numChunks_(0), chunkCursor_(nullptr), chunkEnd_(nullptr)
+{
+	for (unsigned int i = 0; i < NumSizeClasses; i++)
+		centralFreeLists_[i] = nullptr;
+
+	for (unsigned int i = 0; i < MaxThreadCaches; i++)
+	{
+		ThreadCache &cache = caches_[i];
+		for (unsigned int j = 0; j < NumSizeClasses; j++)
+		{
+			cache.freeLists[j] = nullptr;
+			cache.numFree[j] = 0;
+		}
+		cache.usedMemoryDelta = 0;
+		cache.numAllocationsDelta = 0;
+	}
+}
+
+/*! \note Chunks are not given back to the source allocator if there are active allocations */
+ThreadCacheAllocator::~ThreadCacheAllocator()
+{
+	for (unsigned int i = 0; i < MaxThreadCaches; i++)
+		foldStatistics(caches_[i]);
+
+	if (numAllocations_ > 0)
+		return;
+
+	Chunk *chunk = chunks_;
+	while (chunk != nullptr)
+	{
+		Chunk *next = chunk->next;
+		source_.deallocate(chunk);
+		chunk = next;
+	}
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+/*! Sizes up to 128 bytes use classes 16 bytes apart, bigger sizes use four classes for every power of two */
+unsigned int ThreadCacheAllocator::sizeClass(size_t bytes)
+{
+	FATAL_ASSERT(bytes > 0 && bytes <= MaxSmallSize);
+
+	if (bytes <= 128)
+		return static_cast<unsigned int>((bytes + 15) / 16 - 1);
+
+	unsigned int log2 = 7;
+	while ((bytes - 1) >> (log2 + 1))
+		log2++;
+
+	const unsigned int subClass = static_cast<unsigned int>(((bytes - 1) - (size_t(1) << log2)) >> (log2 - 2));
+	return 8 + (log2 - 7) * 4 + subClass;
+}
+
+size_t ThreadCacheAllocator::classSize(unsigned int sizeClass)
+{
+	FATAL_ASSERT(sizeClass < NumSizeClasses);
+
+	if (sizeClass < 8)
+		return (sizeClass + 1) * 16;
+
+	const unsigned int log2 = 7 + (sizeClass - 8) / 4;
+	const unsigned int subClass = (sizeClass - 8) % 4;
+	return (size_t(1) << log2) + (size_t(subClass + 1) << (log2 - 2));
+}
+
+unsigned int ThreadCacheAllocator::numCachedBlocks(unsigned int sizeClass) const
+{
+	FATAL_ASSERT(sizeClass < NumSizeClasses);
+
+	if (threadSlot.index < 0)
+		return 0;
+
+	return caches_[threadSlot.index].numFree[sizeClass];
+}
+
+void ThreadCacheAllocator::flushThreadCache()
+{
+	ThreadCache *cache = threadCache();
+	if (cache == nullptr)
+		return;
+
+	acquireLock();
+	for (unsigned int i = 0; i < NumSizeClasses; i++)
+	{
+		if (cache->numFree[i] > 0)
+			flushCache(*cache, i, cache->numFree[i]);
+	}
+	foldStatistics(*cache);
+	releaseLock();
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void ThreadCacheAllocator::acquireLock()
+{
+	lock_.lock();
+}
+
+void ThreadCacheAllocator::releaseLock()
+{
+	lock_.unlock();
+}
+
+ThreadCacheAllocator::ThreadCache *ThreadCacheAllocator::threadCache()
+{
+	if (threadSlot.index == NoSlot)
+		threadSlot.index = acquireThreadSlot();
+
+	return (threadSlot.index >= 0) ? &caches_[threadSlot.index] : nullptr;
+}
+
+void *ThreadCacheAllocator::allocateLarge(size_t bytes, uint8_t alignment)
+{
+	const size_t totalBytes = bytes + HeaderSize + alignment;
+
+	acquireLock();
+	void *memory = source_.allocate(totalBytes, DefaultAlignment);
+	if (memory != nullptr)
+	{
+		size_ += totalBytes;
+		usedMemory_ += totalBytes;
+		numAllocations_++;
+	}
+	releaseLock();
+
+	if (memory == nullptr)
+		return nullptr;
+
+	void *ptr = PointerMath::align(PointerMath::add(memory, HeaderSize), alignment);
+	Header *header = headerFromPointer(ptr);
+	header->sizeClass = LargeClass;
+	header->offset = static_cast<uint32_t>(PointerMath::subtract(ptr, memory));
+	header->bytes = totalBytes;
+
+	return ptr;
+}
+
+void ThreadCacheAllocator::deallocateLarge(void *ptr)
+{
+	const Header *header = headerFromPointer(ptr);
+	const size_t totalBytes = header->bytes;
+	void *memory = PointerMath::subtract(ptr, header->offset);
+
+	acquireLock();
+	source_.deallocate(memory);
+	size_ -= totalBytes;
+	usedMemory_ -= totalBytes;
+	numAllocations_--;
+	releaseLock();
+}
+
+/*! \note It should be called with the lock held */
+ThreadCacheAllocator::Block *ThreadCacheAllocator::carveBlock(unsigned int sizeClass)
+{
+	const size_t blockSize = HeaderSize + classSize(sizeClass);
+
+	if (chunkCursor_ == nullptr || chunkCursor_ + blockSize > chunkEnd_)
+	{
+		void *memory = source_.allocate(ChunkSize, DefaultAlignment);
+		if (memory == nullptr)
+			return nullptr;
+
+		Chunk *chunk = static_cast<Chunk *>(memory);
+		chunk->next = chunks_;
+		chunk->bytes = ChunkSize;
+		chunks_ = chunk;
+		numChunks_++;
+		size_ += ChunkSize;
+
+		// The remaining space of the previous chunk is wasted
+		chunkCursor_ = static_cast<uint8_t *>(memory) + HeaderSize;
+		chunkEnd_ = static_cast<uint8_t *>(memory) + ChunkSize;
+	}
+
+	Block *block = reinterpret_cast<Block *>(chunkCursor_);
+	chunkCursor_ += blockSize;
+	return block;
+}
+
+/*! \note It should be called with the lock held */
+void ThreadCacheAllocator::refillCache(ThreadCache &cache, unsigned int sizeClass)
+{
+	const unsigned int numBlocks = batchSize(sizeClass);
+	for (unsigned int i = 0; i < numBlocks; i++)
+	{
+		Block *block = centralFreeLists_[sizeClass];
+		if (block != nullptr)
+			centralFreeLists_[sizeClass] = block->next;
+		else
+		{
+			block = carveBlock(sizeClass);
+			if (block == nullptr)
+				break;
+		}
+
+		block->next = cache.freeLists[sizeClass];
+		cache.freeLists[sizeClass] = block;
+		cache.numFree[sizeClass]++;
+	}
+}
+
+/*! \note It should be called with the lock held */
+void ThreadCacheAllocator::flushCache(ThreadCache &cache, unsigned int sizeClass, unsigned int numBlocks)
+{
+	for (unsigned int i = 0; i < numBlocks && cache.freeLists[sizeClass] != nullptr; i++)
+	{
+		Block *block = cache.freeLists[sizeClass];
+		cache.freeLists[sizeClass] = block->next;
+		cache.numFree[sizeClass]--;
+
+		block->next = centralFreeLists_[sizeClass];
+		centralFreeLists_[sizeClass] = block;
+	}
+}
+
+/*! \note It should be called with the lock held, or by the thread owning the cache */
+void ThreadCacheAllocator::foldStatistics(ThreadCache &cache)
+{
+	usedMemory_ += cache.usedMemoryDelta;
+	numAllocations_ += cache.numAllocationsDelta;
+	cache.usedMemoryDelta = 0;
+	cache.numAllocationsDelta = 0;
+}
+
+void *ThreadCacheAllocator::allocateImpl(IAllocator *allocator, size_t bytes, uint8_t alignment)
+{
+	FATAL_ASSERT(bytes > 0);
+	FATAL_ASSERT_MSG((alignment & (alignment - 1)) == 0, "The alignment should be a power of two");
+	FATAL_ASSERT_MSG(alignment >= 1 && alignment <= 128, "The alignment must be between 1 and 128");
+
+	FATAL_ASSERT(allocator);
+	ThreadCacheAllocator *allocatorImpl = static_cast<ThreadCacheAllocator *>(allocator);
+
+	// Blocks are only aligned to the header size
+	if (bytes > MaxSmallSize || alignment > HeaderSize)
+		return allocatorImpl->allocateLarge(bytes, alignment);
+
+	const unsigned int sizeClass = ThreadCacheAllocator::sizeClass(bytes);
+	Block *block = nullptr;
+
+	ThreadCache *cache = allocatorImpl->threadCache();
+	if (cache != nullptr)
+	{
+		if (cache->freeLists[sizeClass] == nullptr)
+		{
+			allocatorImpl->acquireLock();
+			allocatorImpl->refillCache(*cache, sizeClass);
+			allocatorImpl->foldStatistics(*cache);
+			allocatorImpl->releaseLock();
+		}
+
+		block = cache->freeLists[sizeClass];
+		if (block == nullptr)
+			return nullptr;
+
+		cache->freeLists[sizeClass] = block->next;
+		cache->numFree[sizeClass]--;
+		cache->usedMemoryDelta += classSize(sizeClass);
+		cache->numAllocationsDelta++;
+
+#ifdef RECORD_ALLOCATIONS
+		// Recorded entries need up to date statistics
+		if (allocatorImpl->recordAllocations_)
+		{
+			allocatorImpl->acquireLock();
+			allocatorImpl->foldStatistics(*cache);
+			allocatorImpl->releaseLock();
+		}
+#endif
+	}
+	else
+	{
+		// Threads without a cache allocate directly from the shared backend
+		allocatorImpl->acquireLock();
+		block = allocatorImpl->centralFreeLists_[sizeClass];
+		if (block != nullptr)
+			allocatorImpl->centralFreeLists_[sizeClass] = block->next;
+		else
+			block = allocatorImpl->carveBlock(sizeClass);
+
+		if (block != nullptr)
+		{
+			allocatorImpl->usedMemory_ += classSize(sizeClass);
+			allocatorImpl->numAllocations_++;
+		}
+		allocatorImpl->releaseLock();
+
+		if (block == nullptr)
+			return nullptr;
+	}
+
+	Header *header = reinterpret_cast<Header *>(block);
+	header->sizeClass = sizeClass;
+	header->offset = 0;
+	header->bytes = 0;
+
+	return PointerMath::add(block, HeaderSize);
+}
+
+void *ThreadCacheAllocator::reallocateImpl(IAllocator *allocator, void *ptr, size_t bytes, uint8_t alignment, size_t &oldSize)
+{
+	FATAL_ASSERT(ptr != nullptr);
+	FATAL_ASSERT(bytes > 0);
+	FATAL_ASSERT_MSG((alignment & (alignment - 1)) == 0, "The alignment should be a power of two");
+	FATAL_ASSERT_MSG(alignment >= 1 && alignment <= 128, "The alignment must be between 1 and 128");
+
+	FATAL_ASSERT(allocator);
+	const Header *header = headerFromPointer(ptr);
+
+	if (header->sizeClass == LargeClass)
+	{
+		oldSize = header->bytes - header->offset;
+		return nullptr;
+	}
+
+	// The block can be reused if the new size still fits in the same size class
+	oldSize = classSize(header->sizeClass);
+	if (bytes <= oldSize && alignment <= HeaderSize && sizeClass(bytes) == header->sizeClass)
+		return ptr;
+
+	// A new block is allocated and the data is copied by `IAllocator`
+	return nullptr;
+}
+
+void ThreadCacheAllocator::deallocateImpl(IAllocator *allocator, void *ptr)
+{
+	if (ptr == nullptr)
+		return;
+
+	FATAL_ASSERT(allocator);
+	ThreadCacheAllocator *allocatorImpl = static_cast<ThreadCacheAllocator *>(allocator);
+
+	const Header *header = headerFromPointer(ptr);
+	if (header->sizeClass == LargeClass)
+	{
+		allocatorImpl->deallocateLarge(ptr);
+		return;
+	}
+
+	const unsigned int sizeClass = header->sizeClass;
+	FATAL_ASSERT(sizeClass < NumSizeClasses);
+	Block *block = reinterpret_cast<Block *>(headerFromPointer(ptr));
+
+	// A block freed by a thread different from the allocating one goes into the cache of the freeing thread
+	ThreadCache *cache = allocatorImpl->threadCache();
+	if (cache != nullptr)
+	{
+		block->next = cache->freeLists[sizeClass];
+		cache->freeLists[sizeClass] = block;
+		cache->numFree[sizeClass]++;
+		cache->usedMemoryDelta -= classSize(sizeClass);
+		cache->numAllocationsDelta--;
+
+		if (cache->numFree[sizeClass] > maxCachedBlocks(sizeClass))
+		{
+			allocatorImpl->acquireLock();
+			allocatorImpl->flushCache(*cache, sizeClass, cache->numFree[sizeClass] / 2);
+			allocatorImpl->foldStatistics(*cache);
+			allocatorImpl->releaseLock();
+		}
+#ifdef RECORD_ALLOCATIONS
+		else if (allocatorImpl->recordAllocations_)
+		{
+			allocatorImpl->acquireLock();
+			allocatorImpl->foldStatistics(*cache);
+			allocatorImpl->releaseLock();
+		}
+#endif
+	}
+	else
+	{
+		allocatorImpl->acquireLock();
+		block->next = allocatorImpl->centralFreeLists_[sizeClass];
+		allocatorImpl->centralFreeLists_[sizeClass] = block;
+		// Counters can temporarily wrap around until the other thread caches are folded
+		allocatorImpl->usedMemory_ -= classSize(sizeClass);
+		allocatorImpl->numAllocations_--;
+		allocatorImpl->releaseLock();
+	}
+}
+
+}
@@ -2,6 +2,14 @@
 
 namespace ncine {
 
+///////////////////////////////////////////////////////////
+// STATIC DEFINITIONS
+///////////////////////////////////////////////////////////
+
+#if NCINE_WITH_ALLOCATORS
+NCTL_DEFINE_SLAB_ALLOCATED(AnimatedSprite, 64)
+#endif
+
 ///////////////////////////////////////////////////////////
 // CONSTRUCTORS and DESTRUCTOR
 ///////////////////////////////////////////////////////////
@@ -130,9 +130,9 @@ void BaseSprite::updateRenderCommand()
 {
 	ZoneScoped;
 
-	if (dirtyBits_.test(DirtyBitPositions::TransformationBit))
+	if (dirtyBits_.test(DirtyBitPositions::TransformationBit) || dirtyBits_.test(DirtyBitPositions::InterpolationBit))
 	{
-		renderCommand_->setTransformation(worldMatrix_);
+		renderCommand_->setTransformation(interpolatedWorldMatrix());
 		dirtyBits_.reset(DirtyBitPositions::TransformationBit);
 	}
 	if (dirtyBits_.test(DirtyBitPositions::ColorBit))
@@ -202,7 +202,7 @@ void DrawableNode::setBlendingFactors(BlendingFactor srcBlendingFactor, Blending
 
 void DrawableNode::updateAabb()
 {
-	ZoneScoped;
+	RenderStatistics::addUpdatedAabb();
 
 	const float width = absWidth();
 	const float height = absHeight();
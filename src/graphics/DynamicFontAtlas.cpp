@@ -0,0 +1,394 @@
+#include <cstring> // for memcpy() and memset()
+#include <cmath> // for roundf()
+#include "common_macros.h"
+#include "DynamicFontAtlas.h"
+#include "Texture.h"
+#include "IFile.h"
+#include "Application.h"
+#include "RenderStatistics.h"
+#include "tracy.h"
+
+#ifdef WITH_IMGUI
+	#define STBTT_STATIC
+	#define STB_TRUETYPE_IMPLEMENTATION
+	#include "imstb_truetype.h"
+#endif
+
+namespace ncine {
+
+#ifdef WITH_IMGUI
+struct DynamicFontAtlas::TrueTypeInfo
+{
+	stbtt_fontinfo fontInfo;
+};
+#else
+struct DynamicFontAtlas::TrueTypeInfo
+{
+};
+#endif
+
+namespace {
+	inline int roundToInt(float value) { return static_cast<int>(roundf(value)); }
+}
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+DynamicFontAtlas::DynamicFontAtlas()
+    : texture_(nctl::makeUnique<Texture>()), size_(0), pixelHeight_(0), scale_(0.0f),
+      lineHeight_(0), base_(0), numFontGlyphs_(0), shelves_(16), nextShelfY_(0), nextEpoch_(0),
+      slots_(64), freeSlots_(16), glyphIndices_(256), bitmap_(1024), failedCodepoints_(16),
+      failedFrame_(0), numFailures_(0), nextWarningFrame_(0)
+{
+	RenderStatistics::addFontAtlas();
+}
+
+DynamicFontAtlas::~DynamicFontAtlas()
+{
+	RenderStatistics::addFontAtlasGlyphs(-static_cast<int>(glyphIndices_.size()));
+	RenderStatistics::removeFontAtlas();
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool DynamicFontAtlas::isAvailable()
+{
+#ifdef WITH_IMGUI
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool DynamicFontAtlas::loadFromMemory(const char *bufferName, const unsigned char *bufferPtr, unsigned long int bufferSize, unsigned int pixelHeight, unsigned int size)
+{
+#ifdef WITH_IMGUI
+	ZoneScoped;
+	ASSERT(bufferPtr);
+	ASSERT(pixelHeight > 0);
+	ASSERT(size > 0);
+
+	// The previous font is kept if the new one cannot be parsed
+	nctl::UniquePtr<unsigned char[]> fontData = nctl::makeUnique<unsigned char[]>(bufferSize);
+	memcpy(fontData.get(), bufferPtr, bufferSize);
+	nctl::UniquePtr<TrueTypeInfo> info = nctl::makeUnique<TrueTypeInfo>();
+
+	const int fontOffset = stbtt_GetFontOffsetForIndex(fontData.get(), 0);
+	if (fontOffset < 0 || stbtt_InitFont(&info->fontInfo, fontData.get(), fontOffset) == 0)
+	{
+		LOGE_X("Cannot parse the TrueType font \"%s\"", bufferName);
+		return false;
+	}
+
+	clear();
+	fontData_ = nctl::move(fontData);
+	info_ = nctl::move(info);
+
+	pixelHeight_ = pixelHeight;
+	scale_ = stbtt_ScaleForPixelHeight(&info_->fontInfo, static_cast<float>(pixelHeight));
+	int ascent = 0;
+	int descent = 0;
+	int lineGap = 0;
+	stbtt_GetFontVMetrics(&info_->fontInfo, &ascent, &descent, &lineGap);
+	base_ = static_cast<unsigned int>(roundToInt(ascent * scale_));
+	lineHeight_ = static_cast<unsigned int>(roundToInt((ascent - descent + lineGap) * scale_));
+	numFontGlyphs_ = static_cast<unsigned int>(info_->fontInfo.numGlyphs);
+
+	if (size != size_)
+	{
+		size_ = size;
+		texture_->init(bufferName, Texture::Format::R8, static_cast<int>(size_), static_cast<int>(size_));
+	}
+	else
+		texture_->setName(bufferName);
+
+	LOGI_X("TrueType font \"%s\" loaded: %u glyphs rasterised at %u pixels in a %ux%u atlas", bufferName, numFontGlyphs_, pixelHeight_, size_, size_);
+	return true;
+#else
+	LOGE_X("Cannot load the TrueType font \"%s\" as rasterisation is only available with Dear ImGui", bufferName);
+	return false;
+#endif
+}
+
+bool DynamicFontAtlas::loadFromFile(const char *filename, unsigned int pixelHeight, unsigned int size)
+{
+	nctl::UniquePtr<IFile> fileHandle = IFile::createFileHandle(filename);
+	fileHandle->setExitOnFailToOpen(false);
+	fileHandle->open(IFile::OpenMode::READ | IFile::OpenMode::BINARY);
+	if (fileHandle->isOpened() == false)
+		return false;
+
+	const unsigned long int bufferSize = static_cast<unsigned long int>(fileHandle->size());
+	nctl::UniquePtr<unsigned char[]> buffer = nctl::makeUnique<unsigned char[]>(bufferSize);
+	const unsigned long int bytesRead = fileHandle->read(buffer.get(), bufferSize);
+	fileHandle->close();
+	if (bytesRead != bufferSize)
+		return false;
+
+	return loadFromMemory(filename, buffer.get(), bufferSize, pixelHeight, size);
+}
+
+const FontGlyph *DynamicFontAtlas::glyph(unsigned int codepoint, uint64_t *shelfTag)
+{
+	unsigned int slotIndex = InvalidSlot;
+	const unsigned int *foundIndex = glyphIndices_.find(codepoint);
+	if (foundIndex != nullptr)
+		slotIndex = *foundIndex;
+	else
+	{
+		slotIndex = hasFailed(codepoint) ? InvalidSlot : rasterise(codepoint);
+		if (slotIndex == InvalidSlot)
+		{
+			// The glyph will be requested again when touching the tag fails in a later frame
+			if (shelfTag)
+				*shelfTag = hasFailed(codepoint) ? RetryShelfTag : NoShelfTag;
+			return nullptr;
+		}
+
+		if (glyphIndices_.loadFactor() >= 0.8f)
+			glyphIndices_.rehash(glyphIndices_.capacity() * 2);
+		glyphIndices_.insert(codepoint, slotIndex);
+		RenderStatistics::addFontAtlasGlyphs(1);
+	}
+	RenderStatistics::addFontAtlasLookup(foundIndex == nullptr);
+
+	const GlyphSlot &slot = slots_[slotIndex];
+	if (slot.shelf != NoShelf)
+	{
+		shelves_[slot.shelf].lastUsedFrame = theApplication().numFrames();
+		if (shelfTag)
+			*shelfTag = DynamicFontAtlas::shelfTag(slot.shelf);
+	}
+	else if (shelfTag)
+		*shelfTag = NoShelfTag;
+
+	return &slot.glyph;
+}
+
+int DynamicFontAtlas::kerning(unsigned int first, unsigned int second) const
+{
+#ifdef WITH_IMGUI
+	if (info_ == nullptr)
+		return 0;
+	return roundToInt(stbtt_GetCodepointKernAdvance(&info_->fontInfo, static_cast<int>(first), static_cast<int>(second)) * scale_);
+#else
+	return 0;
+#endif
+}
+
+bool DynamicFontAtlas::touchShelf(uint64_t shelfTag)
+{
+	if (shelfTag == RetryShelfTag)
+		return (failedFrame_ == theApplication().numFrames());
+
+	const unsigned int shelfIndex = static_cast<unsigned int>(shelfTag & 0xFFFFFFFF);
+	if (shelfIndex >= shelves_.size() || DynamicFontAtlas::shelfTag(shelfIndex) != shelfTag)
+		return false;
+
+	shelves_[shelfIndex].lastUsedFrame = theApplication().numFrames();
+	return true;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+unsigned int DynamicFontAtlas::rasterise(unsigned int codepoint)
+{
+#ifdef WITH_IMGUI
+	if (info_ == nullptr || stbtt_FindGlyphIndex(&info_->fontInfo, static_cast<int>(codepoint)) == 0)
+		return InvalidSlot;
+
+	ZoneScoped;
+	int advance = 0;
+	int leftSideBearing = 0;
+	stbtt_GetCodepointHMetrics(&info_->fontInfo, static_cast<int>(codepoint), &advance, &leftSideBearing);
+	int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+	stbtt_GetCodepointBitmapBox(&info_->fontInfo, static_cast<int>(codepoint), scale_, scale_, &x0, &y0, &x1, &y1);
+	const unsigned int width = static_cast<unsigned int>(x1 - x0);
+	const unsigned int height = static_cast<unsigned int>(y1 - y0);
+	const int xAdvance = roundToInt(advance * scale_);
+
+	if (width == 0 || height == 0)
+	{
+		// A glyph without pixels does not need any space in the texture
+		const unsigned int slotIndex = acquireSlot();
+		slots_[slotIndex].codepoint = codepoint;
+		slots_[slotIndex].shelf = NoShelf;
+		slots_[slotIndex].glyph.set(0, 0, 0, 0, 0, 0, xAdvance);
+		return slotIndex;
+	}
+
+	const unsigned int paddedWidth = width + GlyphPadding * 2;
+	const unsigned int paddedHeight = height + GlyphPadding * 2;
+	const int shelfIndex = findShelf(paddedWidth, paddedHeight);
+	if (shelfIndex < 0)
+	{
+		addFailure(codepoint);
+		return InvalidSlot;
+	}
+
+	Shelf &shelf = shelves_[shelfIndex];
+	const unsigned int x = shelf.nextX;
+	const unsigned int y = shelf.y;
+	shelf.nextX += paddedWidth;
+
+	// Rows are aligned to four bytes, the default unpack alignment
+	const unsigned int stride = (paddedWidth + 3) & ~3U;
+	const unsigned int bitmapSize = stride * paddedHeight;
+	if (bitmap_.capacity() < bitmapSize)
+		bitmap_.setCapacity(bitmapSize);
+	bitmap_.setSize(bitmapSize);
+	// The padding is uploaded too, clearing what an evicted glyph has left in the texture
+	memset(bitmap_.data(), 0, bitmapSize);
+	unsigned char *glyphPixels = bitmap_.data() + GlyphPadding * stride + GlyphPadding;
+	stbtt_MakeCodepointBitmap(&info_->fontInfo, glyphPixels, static_cast<int>(width), static_cast<int>(height),
+	                          static_cast<int>(stride), scale_, scale_, static_cast<int>(codepoint));
+	texture_->loadFromTexels(bitmap_.data(), x, y, paddedWidth, paddedHeight);
+
+	const unsigned int slotIndex = acquireSlot();
+	GlyphSlot &slot = slots_[slotIndex];
+	slot.codepoint = codepoint;
+	slot.shelf = static_cast<unsigned int>(shelfIndex);
+	slot.glyph.set(x + GlyphPadding, y + GlyphPadding, width, height, x0, static_cast<int>(base_) + y0, xAdvance);
+	shelf.slots.pushBack(slotIndex);
+
+	return slotIndex;
+#else
+	return InvalidSlot;
+#endif
+}
+
+bool DynamicFontAtlas::hasFailed(unsigned int codepoint) const
+{
+	if (failedFrame_ != theApplication().numFrames())
+		return false;
+
+	for (unsigned int failedCodepoint : failedCodepoints_)
+	{
+		if (failedCodepoint == codepoint)
+			return true;
+	}
+	return false;
+}
+
+void DynamicFontAtlas::addFailure(unsigned int codepoint)
+{
+	const unsigned long int currentFrame = theApplication().numFrames();
+	if (failedFrame_ != currentFrame)
+	{
+		failedCodepoints_.clear();
+		failedFrame_ = currentFrame;
+	}
+	failedCodepoints_.pushBack(codepoint);
+
+	numFailures_++;
+	if (currentFrame >= nextWarningFrame_)
+	{
+		LOGW_X("No space left in the dynamic font atlas for %u glyph(s), the last one being codepoint %u", numFailures_, codepoint);
+		numFailures_ = 0;
+		nextWarningFrame_ = currentFrame + FullWarningInterval;
+	}
+}
+
+int DynamicFontAtlas::findShelf(unsigned int width, unsigned int height)
+{
+	const unsigned int shelfHeight = ((height + ShelfHeightStep - 1) / ShelfHeightStep) * ShelfHeightStep;
+	if (width > size_ || shelfHeight > size_)
+		return -1;
+
+	// The shortest shelf where the glyph fits
+	int bestShelf = -1;
+	for (unsigned int i = 0; i < shelves_.size(); i++)
+	{
+		const Shelf &shelf = shelves_[i];
+		if (shelf.height >= height && size_ - shelf.nextX >= width &&
+		    (bestShelf < 0 || shelf.height < shelves_[bestShelf].height))
+		{
+			bestShelf = static_cast<int>(i);
+		}
+	}
+
+	// A new shelf is preferred to one much taller than the glyph
+	if (bestShelf >= 0 && shelves_[bestShelf].height <= shelfHeight * 2)
+		return bestShelf;
+
+	if (nextShelfY_ + shelfHeight <= size_)
+	{
+		shelves_.emplaceBack();
+		Shelf &shelf = shelves_.back();
+		shelf.y = nextShelfY_;
+		shelf.height = shelfHeight;
+		shelf.epoch = nextEpoch_++;
+		nextShelfY_ += shelfHeight;
+		return static_cast<int>(shelves_.size() - 1);
+	}
+
+	if (bestShelf >= 0)
+		return bestShelf;
+
+	// The least recently used shelf that is tall enough, the shortest one among those used in the same frame
+	const unsigned long int currentFrame = theApplication().numFrames();
+	int lruShelf = -1;
+	for (unsigned int i = 0; i < shelves_.size(); i++)
+	{
+		const Shelf &shelf = shelves_[i];
+		if (shelf.height < height || shelf.lastUsedFrame == currentFrame)
+			continue;
+
+		if (lruShelf < 0 || shelf.lastUsedFrame < shelves_[lruShelf].lastUsedFrame ||
+		    (shelf.lastUsedFrame == shelves_[lruShelf].lastUsedFrame && shelf.height < shelves_[lruShelf].height))
+		{
+			lruShelf = static_cast<int>(i);
+		}
+	}
+
+	if (lruShelf >= 0)
+		evictShelf(static_cast<unsigned int>(lruShelf));
+	return lruShelf;
+}
+
+void DynamicFontAtlas::evictShelf(unsigned int shelfIndex)
+{
+	Shelf &shelf = shelves_[shelfIndex];
+	for (unsigned int slotIndex : shelf.slots)
+	{
+		glyphIndices_.remove(slots_[slotIndex].codepoint);
+		freeSlots_.pushBack(slotIndex);
+	}
+	RenderStatistics::addFontAtlasGlyphs(-static_cast<int>(shelf.slots.size()));
+	RenderStatistics::addFontAtlasEviction();
+
+	shelf.slots.clear();
+	shelf.nextX = 0;
+	shelf.epoch = nextEpoch_++;
+}
+
+void DynamicFontAtlas::clear()
+{
+	RenderStatistics::addFontAtlasGlyphs(-static_cast<int>(glyphIndices_.size()));
+	glyphIndices_.clear();
+	slots_.clear();
+	freeSlots_.clear();
+	shelves_.clear();
+	nextShelfY_ = 0;
+	failedCodepoints_.clear();
+}
+
+unsigned int DynamicFontAtlas::acquireSlot()
+{
+	if (freeSlots_.isEmpty() == false)
+	{
+		const unsigned int slotIndex = freeSlots_.back();
+		freeSlots_.popBack();
+		return slotIndex;
+	}
+
+	slots_.emplaceBack();
+	return slots_.size() - 1;
+}
+
+}
@@ -0,0 +1,257 @@
+#include <cstring> // for memcmp()
+#include "common_macros.h"
+#include <nctl/HashMapIterator.h>
+#include <nctl/HashFunctions.h>
+#include <nctl/Utf8.h>
+#include "GlyphRunCache.h"
+#include "Font.h"
+#include "FontGlyph.h"
+#include "DynamicFontAtlas.h"
+#include "Texture.h"
+#include "tracy.h"
+
+namespace ncine {
+
+namespace {
+	uint64_t hashRun(const Font *font, unsigned int fontGeneration, bool withKerning, const char *text, unsigned int length)
+	{
+		uint64_t hash = nctl::fasthash64(&font, sizeof(const Font *), 0);
+		hash = nctl::fasthash64(&fontGeneration, sizeof(unsigned int), hash);
+		hash = nctl::fasthash64(&withKerning, sizeof(bool), hash);
+		return nctl::fasthash64(text, length, hash);
+	}
+}
+
+///////////////////////////////////////////////////////////
+// GlyphRun
+///////////////////////////////////////////////////////////
+
+GlyphRun::GlyphRun()
+    : font_(nullptr), fontGeneration_(0), withKerning_(false), text_(32), hash_(0),
+      length_(0.0f), version_(0), refCount_(0), quads_(32), nextInBucket_(nullptr)
+{
+}
+
+bool GlyphRun::matches(const Font *font, bool withKerning, const char *text, unsigned int length) const
+{
+	return (font_ == font && fontGeneration_ == font->generation_ && withKerning_ == withKerning &&
+	        text_.length() == length && memcmp(text_.data(), text, length) == 0);
+}
+
+bool GlyphRun::touchAtlasShelves()
+{
+	DynamicFontAtlas *dynamicAtlas = font_->dynamicAtlas_.get();
+	if (dynamicAtlas == nullptr)
+		return false;
+
+	for (uint64_t shelfTag : shelfTags_)
+	{
+		if (dynamicAtlas->touchShelf(shelfTag) == false)
+		{
+			// Some glyphs have been evicted from the atlas or found no space, they are rasterised again
+			layout();
+			return true;
+		}
+	}
+	return false;
+}
+
+void GlyphRun::layout()
+{
+	ZoneScoped;
+	quads_.clear();
+	shelfTags_.clear();
+	version_++;
+
+	DynamicFontAtlas *dynamicAtlas = font_->dynamicAtlas_.get();
+	// A font that only holds glyph metrics has no texture
+	const Vector2i texSize = (font_->texture() != nullptr) ? font_->texture()->size() : font_->textureSize();
+
+	float xAdvance = 0.0f;
+	const char *current = text_.data();
+	const char *end = current + text_.length();
+	while (current < end)
+	{
+		unsigned int codepoint = nctl::Utf8::InvalidUnicode;
+		const char *next = nctl::Utf8::utf8ToCodePoint(current, codepoint);
+
+		const FontGlyph *glyph = nullptr;
+		if (codepoint != nctl::Utf8::InvalidUnicode)
+		{
+			if (dynamicAtlas)
+			{
+				uint64_t shelfTag = DynamicFontAtlas::NoShelfTag;
+				glyph = dynamicAtlas->glyph(codepoint, &shelfTag);
+				if (shelfTag != DynamicFontAtlas::NoShelfTag)
+				{
+					bool isNewTag = true;
+					for (uint64_t tag : shelfTags_)
+					{
+						if (tag == shelfTag)
+						{
+							isNewTag = false;
+							break;
+						}
+					}
+					if (isNewTag)
+						shelfTags_.pushBack(shelfTag);
+				}
+			}
+			else
+				glyph = font_->glyph(codepoint);
+		}
+
+		if (glyph)
+		{
+			const Vector2i size = glyph->size();
+			// Glyphs without pixels, like spaces, only advance the line
+			if (size.x > 0 && size.y > 0)
+			{
+				const Vector2i offset = glyph->offset();
+				const Recti texRect = glyph->texRect();
+
+				const float leftPos = xAdvance + offset.x;
+				const float topPos = static_cast<float>(-offset.y);
+
+				quads_.emplaceBack();
+				VertexKernels::Quad &quad = quads_.back();
+				quad.positions[0] = leftPos;
+				quad.positions[1] = topPos - size.y;
+				quad.positions[2] = leftPos + size.x;
+				quad.positions[3] = topPos;
+				quad.texCoords[0] = float(texRect.x) / float(texSize.x);
+				quad.texCoords[1] = float(texRect.y + texRect.h) / float(texSize.y);
+				quad.texCoords[2] = float(texRect.x + texRect.w) / float(texSize.x);
+				quad.texCoords[3] = float(texRect.y) / float(texSize.y);
+			}
+
+			xAdvance += glyph->xAdvance();
+			if (withKerning_ && next < end)
+			{
+				unsigned int nextCodepoint = nctl::Utf8::InvalidUnicode;
+				nctl::Utf8::utf8ToCodePoint(next, nextCodepoint);
+				xAdvance += font_->kerning(codepoint, nextCodepoint);
+			}
+		}
+		current = next;
+	}
+
+	length_ = xAdvance;
+}
+
+///////////////////////////////////////////////////////////
+// GlyphRunCache
+///////////////////////////////////////////////////////////
+
+GlyphRunCache::GlyphRunCache()
+    : buckets_(256), freeRuns_(MaxFreeRuns), numRuns_(0), numShared_(0), numLayouts_(0)
+{
+}
+
+GlyphRunCache::~GlyphRunCache()
+{
+	if (numRuns_ > 0)
+		LOGW_X("%u glyph runs are still in use", numRuns_);
+
+	for (nctl::HashMap<uint64_t, GlyphRun *>::ConstIterator i = buckets_.cBegin(); i != buckets_.cEnd(); ++i)
+	{
+		GlyphRun *run = i.value();
+		while (run != nullptr)
+		{
+			GlyphRun *nextRun = run->nextInBucket_;
+			delete run;
+			run = nextRun;
+		}
+	}
+}
+
+GlyphRun *GlyphRunCache::acquire(const Font *font, bool withKerning, const char *text, unsigned int length)
+{
+	ASSERT(font);
+	ASSERT(text);
+
+	const uint64_t hash = hashRun(font, font->generation_, withKerning, text, length);
+	GlyphRun **firstRun = buckets_.find(hash);
+	if (firstRun != nullptr)
+	{
+		for (GlyphRun *run = *firstRun; run != nullptr; run = run->nextInBucket_)
+		{
+			if (run->matches(font, withKerning, text, length))
+			{
+				run->refCount_++;
+				numShared_++;
+				return run;
+			}
+		}
+	}
+
+	GlyphRun *run = nullptr;
+	if (freeRuns_.isEmpty() == false)
+	{
+		run = freeRuns_.back().release();
+		freeRuns_.popBack();
+	}
+	else
+		run = new GlyphRun();
+
+	run->font_ = font;
+	run->fontGeneration_ = font->generation_;
+	run->withKerning_ = withKerning;
+	run->text_.assign(text, length);
+	run->hash_ = hash;
+	run->refCount_ = 1;
+	run->layout();
+	numLayouts_++;
+
+	if (firstRun != nullptr)
+	{
+		run->nextInBucket_ = *firstRun;
+		*firstRun = run;
+	}
+	else
+	{
+		run->nextInBucket_ = nullptr;
+		if (buckets_.loadFactor() >= 0.8f)
+			buckets_.rehash(buckets_.capacity() * 2);
+		buckets_.insert(hash, run);
+	}
+	numRuns_++;
+
+	return run;
+}
+
+void GlyphRunCache::release(GlyphRun *run)
+{
+	ASSERT(run);
+	ASSERT(run->refCount_ > 0);
+
+	run->refCount_--;
+	if (run->refCount_ > 0)
+		return;
+
+	GlyphRun **firstRun = buckets_.find(run->hash_);
+	FATAL_ASSERT(firstRun != nullptr);
+	if (*firstRun == run)
+	{
+		if (run->nextInBucket_ != nullptr)
+			*firstRun = run->nextInBucket_;
+		else
+			buckets_.remove(run->hash_);
+	}
+	else
+	{
+		GlyphRun *previousRun = *firstRun;
+		while (previousRun->nextInBucket_ != run)
+			previousRun = previousRun->nextInBucket_;
+		previousRun->nextInBucket_ = run->nextInBucket_;
+	}
+	run->nextInBucket_ = nullptr;
+	numRuns_--;
+
+	if (freeRuns_.size() < MaxFreeRuns)
+		freeRuns_.pushBack(nctl::UniquePtr<GlyphRun>(run));
+	else
+		delete run;
+}
+
+}
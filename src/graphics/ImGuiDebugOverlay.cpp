@@ -16,6 +16,8 @@
 #endif
 
 #include "RenderStatistics.h"
+#include "RenderResources.h"
+#include "BinaryShaderCache.h"
 #ifdef WITH_LUA
 	#include "LuaStatistics.h"
 #endif
@@ -26,6 +28,7 @@
 
 #ifdef WITH_ALLOCATORS
 	#include "allocators_config.h"
+	#include <nctl/FrameArenaAllocator.h>
 #endif
 
 #include "version.h"
@@ -538,7 +541,15 @@ void ImGuiDebugOverlay::guiInitTimes()
 		ImGui::PlotHistogram("Init Times", initTimes, 3, 0, nullptr, 0.0f, initTimes[2], ImVec2(0.0f, 100.0f));
 
 		ImGui::Text("Pre-Init Time: %.3f s", timings[Application::Timings::PRE_INIT]);
-		ImGui::Text("Init Time: %.3f s", timings[Application::Timings::INIT_COMMON]);
+		const BinaryShaderCache *binaryCache = RenderResources::binaryShaderCache();
+		if (binaryCache != nullptr && binaryCache->isAvailable())
+		{
+			const BinaryShaderCache::Statistics &stats = binaryCache->statistics();
+			ImGui::Text("Init Time: %.3f s (%s start)", timings[Application::Timings::INIT_COMMON], binaryCache->isWarm() ? "warm" : "cold");
+			ImGui::Text("Program binaries: %u loaded, %u missed, %u rejected, %u saved", stats.loaded, stats.missed, stats.rejected, stats.saved);
+		}
+		else
+			ImGui::Text("Init Time: %.3f s", timings[Application::Timings::INIT_COMMON]);
 		ImGui::Text("Application Init Time: %.3f s", timings[Application::Timings::APP_INIT]);
 	}
 }
@@ -589,6 +600,9 @@ void ImGuiDebugOverlay::guiGraphicsCapabilities()
 		ImGui::Text("GL_MAX_VERTEX_ATTRIB_STRIDE: %d", gfxCaps.value(IGfxCapabilities::GLIntValues::MAX_VERTEX_ATTRIB_STRIDE));
 #endif
 		ImGui::Text("GL_MAX_COLOR_ATTACHMENTS: %d", gfxCaps.value(IGfxCapabilities::GLIntValues::MAX_COLOR_ATTACHMENTS));
+#if !defined(__EMSCRIPTEN__)
+		ImGui::Text("GL_NUM_PROGRAM_BINARY_FORMATS: %d", gfxCaps.value(IGfxCapabilities::GLIntValues::NUM_PROGRAM_BINARY_FORMATS));
+#endif
 
 		ImGui::Separator();
 		ImGui::Text("GL_KHR_debug: %d", gfxCaps.hasExtension(IGfxCapabilities::GLExtensions::KHR_DEBUG));
@@ -598,6 +612,7 @@ void ImGuiDebugOverlay::guiGraphicsCapabilities()
 		ImGui::Text("GL_AMD_compressed_ATC_texture: %d", gfxCaps.hasExtension(IGfxCapabilities::GLExtensions::AMD_COMPRESSED_ATC_TEXTURE));
 		ImGui::Text("GL_IMG_texture_compression_pvrtc: %d", gfxCaps.hasExtension(IGfxCapabilities::GLExtensions::IMG_TEXTURE_COMPRESSION_PVRTC));
 		ImGui::Text("GL_KHR_texture_compression_astc_ldr: %d", gfxCaps.hasExtension(IGfxCapabilities::GLExtensions::KHR_TEXTURE_COMPRESSION_ASTC_LDR));
+		ImGui::Text("GL_KHR_parallel_shader_compile: %d", gfxCaps.hasExtension(IGfxCapabilities::GLExtensions::KHR_PARALLEL_SHADER_COMPILE));
 	}
 }
 
@@ -632,10 +647,12 @@ void ImGuiDebugOverlay::guiApplicationConfiguration()
 		ImGui::Separator();
 		ImGui::Text("Buffer mapping: %s", appCfg.useBufferMapping ? "true" : "false");
 		ImGui::Text("Defer shader queries: %s", appCfg.deferShaderQueries ? "true" : "false");
+		ImGui::Text("Binary shader cache: %s", appCfg.useBinaryShaderCache ? "true" : "false");
 		ImGui::Text("VBO size: %lu", appCfg.vboSize);
 		ImGui::Text("IBO size: %lu", appCfg.iboSize);
 		ImGui::Text("Vao pool size: %u", appCfg.vaoPoolSize);
 		ImGui::Text("RenderCommand pool size: %u", appCfg.renderCommandPoolSize);
+		ImGui::Text("Frame arena size: %lu", appCfg.frameArenaSize);
 
 		ImGui::Separator();
 		ImGui::Text("Debug Overlay: %s", appCfg.withDebugOverlay ? "true" : "false");
@@ -660,6 +677,8 @@ void ImGuiDebugOverlay::guiRenderingSettings()
 		ImGui::SameLine();
 		ImGui::Checkbox("Batching with indices", &settings.batchingWithIndices);
 		ImGui::SameLine();
+		ImGui::Checkbox("Parallel batching", &settings.parallelBatching);
+		ImGui::SameLine();
 		ImGui::Checkbox("Culling", &settings.cullingEnabled);
 		ImGui::DragIntRange2("Batch size", &minBatchSize, &maxBatchSize, 1.0f, 0, 512);
 
@@ -1156,6 +1175,25 @@ void ImGuiDebugOverlay::guiAllocators()
 		else
 			ImGui::TextUnformatted("The Lua allocator is the default one");
 	#endif
+
+		nctl::IAllocator &frameAllocator = theApplication().frameAllocator();
+		if (&frameAllocator != &nctl::theDefaultAllocator())
+		{
+			const nctl::FrameArenaAllocator &frameArena = static_cast<const nctl::FrameArenaAllocator &>(frameAllocator);
+			widgetName_.format("Frame Arena \"%s\" (%d allocations, %lu bytes)###FrameArena",
+			                   frameArena.name(), frameArena.numAllocations(), frameArena.usedMemory());
+			if (ImGui::TreeNode(widgetName_.data()))
+			{
+				ImGui::Text("Buffer size: %lu bytes (x2)", frameArena.bufferSize());
+				ImGui::Text("Current frame: %lu bytes", frameArena.frameUsedMemory());
+				ImGui::Text("Last frame: %lu bytes", frameArena.lastFrameUsedMemory());
+				ImGui::Text("Peak: %lu bytes", frameArena.peakUsedMemory());
+				ImGui::Text("Overflows: %u last frame, %lu total", frameArena.lastFrameNumOverflows(), frameArena.numOverflows());
+				ImGui::TreePop();
+			}
+		}
+		else
+			ImGui::TextUnformatted("The frame arena is disabled");
 	}
 
 #endif
@@ -1408,6 +1446,9 @@ void ImGuiDebugOverlay::guiTopLeft()
 	const RenderStatistics::Buffers &vboBuffers = RenderStatistics::buffers(RenderBuffersManager::BufferTypes::ARRAY);
 	const RenderStatistics::Buffers &iboBuffers = RenderStatistics::buffers(RenderBuffersManager::BufferTypes::ELEMENT_ARRAY);
 	const RenderStatistics::Buffers &uboBuffers = RenderStatistics::buffers(RenderBuffersManager::BufferTypes::UNIFORM);
+	const RenderStatistics::UniformData &uniformData = RenderStatistics::uniformData();
+	const RenderStatistics::SceneNodes &sceneNodes = RenderStatistics::sceneNodes();
+	const RenderStatistics::FontAtlases &fontAtlases = RenderStatistics::fontAtlases();
 
 	const ImVec2 windowPos = ImVec2(Margin, Margin);
 	const ImVec2 windowPosPivot = ImVec2(0.0f, 0.0f);
@@ -1427,9 +1468,18 @@ void ImGuiDebugOverlay::guiTopLeft()
 			ImGui::PlotLines("", plotValues_[ValuesType::CULLED_NODES].get(), numValues_, 0, nullptr, 0.0f, FLT_MAX);
 		}
 
+		ImGui::Text("%u transformed nodes, %u skipped, %u AABBs updated", sceneNodes.transformed, sceneNodes.skipped, sceneNodes.aabbsUpdated);
+		ImGui::Text("Update: %.3f ms, culling: %.3f ms, visit: %.3f ms", sceneNodes.updateTime * 1000.0f,
+		            sceneNodes.cullingTime * 1000.0f, sceneNodes.visitTime * 1000.0f);
+
 		ImGui::Text("%u/%u VAOs (%u reuses, %u bindings)", vaoPool.size, vaoPool.capacity, vaoPool.reuses, vaoPool.bindings);
 		ImGui::Text("%u/%u RenderCommands in the pool (%u retrievals)", commandPool.usedSize, commandPool.usedSize + commandPool.freeSize, commandPool.retrievals);
 		ImGui::Text("%.2f Kb in %u Texture(s)", textures.dataSize / 1024.0f, textures.count);
+		if (fontAtlases.count > 0)
+		{
+			ImGui::Text("%u glyph(s) in %u font atlas(es), %.1f%% hit rate, %lu eviction(s)", fontAtlases.glyphs, fontAtlases.count,
+			            fontAtlases.hitRate() * 100.0f, fontAtlases.evictions);
+		}
 		ImGui::Text("%.2f Kb in %u custom VBO(s)", customVbos.dataSize / 1024.0f, customVbos.count);
 		ImGui::Text("%.2f Kb in %u custom IBO(s)", customIbos.dataSize / 1024.0f, customIbos.count);
 		ImGui::Text("%.2f/%lu Kb in %u VBO(s)", vboBuffers.usedSpace / 1024.0f, vboBuffers.size / 1024, vboBuffers.count);
@@ -1452,6 +1502,8 @@ void ImGuiDebugOverlay::guiTopLeft()
 			ImGui::SameLine();
 			ImGui::PlotLines("", plotValues_[ValuesType::UBO_USED].get(), numValues_, 0, nullptr, 0.0f, uboBuffers.size / 1024.0f);
 		}
+		ImGui::Text("%.2f Kb of uniform blocks copied (%.2f Kb batched, %.2f Kb committed)", uniformData.copiedBytes() / 1024.0f,
+		            uniformData.batchedBytes / 1024.0f, uniformData.committedBytes / 1024.0f);
 
 		ImGui::Text("Viewport chain length: %u", Viewport::chain().size());
 
@@ -1591,11 +1643,14 @@ void ImGuiDebugOverlay::guiBottomRight()
 			ImGui::PlotLines("", plotValues_[ValuesType::LUA_USED].get(), numValues_, 0, nullptr, 0.0f, FLT_MAX);
 		}
 
-		ImGui::Text("Operations: %d ops/s", LuaStatistics::operations());
-		if (plotOverlayValues_)
+		if (LuaStatistics::numProfiling() > 0)
 		{
-			ImGui::SameLine();
-			ImGui::PlotLines("", plotValues_[ValuesType::LUA_OPERATIONS].get(), numValues_, 0, nullptr, 0.0f, FLT_MAX);
+			ImGui::Text("Script time: %.1f%%", LuaStatistics::scriptLoad() * 100.0f);
+			if (plotOverlayValues_)
+			{
+				ImGui::SameLine();
+				ImGui::PlotLines("", plotValues_[ValuesType::LUA_SCRIPT_TIME].get(), numValues_, 0, nullptr, 0.0f, 100.0f);
+			}
 		}
 
 		ImGui::Text("Textures: %u, Sprites: %u, Mesh sprites: %u",
@@ -1711,7 +1766,7 @@ void ImGuiDebugOverlay::updateOverlayTimings()
 
 #ifdef WITH_LUA
 	plotValues_[ValuesType::LUA_USED][index_] = LuaStatistics::usedMemory() / 1024.0f;
-	plotValues_[ValuesType::LUA_OPERATIONS][index_] = static_cast<float>(LuaStatistics::operations());
+	plotValues_[ValuesType::LUA_SCRIPT_TIME][index_] = LuaStatistics::scriptLoad() * 100.0f;
 #endif
 }
 
@@ -69,7 +69,8 @@ ImGuiDrawing::ImGuiDrawing(bool withSceneGraph)
 	imguiShaderProgram_->attachShaderFromString(GL_FRAGMENT_SHADER, ShaderStrings::imgui_fs);
 #endif
 	imguiShaderProgram_->link(GLShaderProgram::Introspection::ENABLED);
-	FATAL_ASSERT(imguiShaderProgram_->status() != GLShaderProgram::Status::LINKING_FAILED);
+	// Compilation errors of shaders whose compilation has been postponed are only found at link time
+	FATAL_ASSERT(imguiShaderProgram_->isLinked());
 
 	if (withSceneGraph == false)
 		setupBuffersAndShader();
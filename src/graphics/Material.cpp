@@ -120,6 +120,17 @@ void Material::setUniformsDataPointer(GLubyte *dataPointer)
 	shaderUniformBlocks_.setUniformsDataPointer(&dataPointer[shaderProgram_->uniformsSize()]);
 }
 
+void Material::setUniformsDataPointer(GLubyte *dataPointer, const RenderBuffersManager::Parameters &uboParams)
+{
+	ASSERT(shaderProgram_);
+	ASSERT(dataPointer);
+
+	uniformsHostBuffer_.reset(nullptr);
+	uniformsHostBufferSize_ = 0;
+	shaderUniforms_.setUniformsDataPointer(dataPointer);
+	shaderUniformBlocks_.setUniformBufferParameters(uboParams);
+}
+
 const GLTexture *Material::texture(unsigned int unit) const
 {
 	const GLTexture *texture = nullptr;
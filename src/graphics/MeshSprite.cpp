@@ -6,6 +6,14 @@
 
 namespace ncine {
 
+///////////////////////////////////////////////////////////
+// STATIC DEFINITIONS
+///////////////////////////////////////////////////////////
+
+#if NCINE_WITH_ALLOCATORS
+NCTL_DEFINE_SLAB_ALLOCATED(MeshSprite, 64)
+#endif
+
 ///////////////////////////////////////////////////////////
 // CONSTRUCTORS and DESTRUCTOR
 ///////////////////////////////////////////////////////////
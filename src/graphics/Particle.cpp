@@ -3,6 +3,14 @@
 
 namespace ncine {
 
+///////////////////////////////////////////////////////////
+// STATIC DEFINITIONS
+///////////////////////////////////////////////////////////
+
+#if NCINE_WITH_ALLOCATORS
+NCTL_DEFINE_SLAB_ALLOCATED(Particle, 256)
+#endif
+
 ///////////////////////////////////////////////////////////
 // CONSTRUCTORS and DESTRUCTOR
 ///////////////////////////////////////////////////////////
@@ -0,0 +1,430 @@
+#include <cstring> // for memcpy()
+#include "common_macros.h"
+#include "ReadbackQueue.h"
+#include "GLBufferObject.h"
+#include "GLFramebufferObject.h"
+#include "GLTexture.h"
+#include "FileSystem.h"
+#include "Application.h"
+#ifdef WITH_PNG
+	#include "TextureSaverPng.h"
+#endif
+#ifdef WITH_WEBP
+	#include "TextureSaverWebP.h"
+#endif
+#ifdef WITH_THREADS
+	#include "IThreadCommand.h"
+	#include "Thread.h"
+	#include "Profiler.h"
+#endif
+#include "tracy.h"
+
+namespace ncine {
+
+namespace {
+	/// The timeout used when a readback has to be waited for, one second
+	const GLuint64 WaitTimeout = 1000000000ULL;
+
+	unsigned int bytesPerPixel(Texture::Format format)
+	{
+		switch (format)
+		{
+			case Texture::Format::R8:
+				return 1;
+			case Texture::Format::RG8:
+				return 2;
+			case Texture::Format::RGB8:
+				return 3;
+			case Texture::Format::RGBA8:
+			default:
+				return 4;
+		}
+	}
+
+	GLenum glFormat(Texture::Format format)
+	{
+		switch (format)
+		{
+			case Texture::Format::R8:
+				return GL_RED;
+			case Texture::Format::RG8:
+				return GL_RG;
+			case Texture::Format::RGB8:
+				return GL_RGB;
+			case Texture::Format::RGBA8:
+			default:
+				return GL_RGBA;
+		}
+	}
+
+	bool encodeToFile(unsigned char *pixels, int width, int height, Texture::Format format, const char *filename)
+	{
+		ITextureSaver::Properties properties;
+		properties.width = width;
+		properties.height = height;
+		properties.format = (format == Texture::Format::RGBA8) ? ITextureSaver::Format::RGBA8 : ITextureSaver::Format::RGB8;
+		// Pixels have already been flipped while copying them out of the pixel buffer object
+		properties.verticalFlip = false;
+		properties.pixels = pixels;
+
+#ifdef WITH_PNG
+		if (fs::hasExtension(filename, "png"))
+		{
+			TextureSaverPng saver;
+			return saver.saveToFile(properties, filename);
+		}
+#endif
+#ifdef WITH_WEBP
+		if (fs::hasExtension(filename, "webp"))
+		{
+			TextureSaverWebP saver;
+			TextureSaverWebP::WebPProperties webpProperties;
+			webpProperties.lossless = true;
+			return saver.saveToFile(properties, webpProperties, filename);
+		}
+#endif
+
+		LOGE_X("Cannot save \"%s\", extension unknown: \"%s\"", filename, fs::extension(filename));
+		return false;
+	}
+
+#ifdef WITH_THREADS
+	/// A thread command that encodes read back pixels to a file
+	class EncodeCommand : public IThreadCommand
+	{
+	  public:
+		EncodeCommand(nctl::UniquePtr<unsigned char[]> pixels, int width, int height, Texture::Format format, const nctl::String &filename)
+		    : pixels_(nctl::move(pixels)), width_(width), height_(height), format_(format), filename_(filename) {}
+
+		void execute() override { encodeToFile(pixels_.get(), width_, height_, format_, filename_.data()); }
+
+	  private:
+		nctl::UniquePtr<unsigned char[]> pixels_;
+		int width_;
+		int height_;
+		Texture::Format format_;
+		nctl::String filename_;
+	};
+#endif
+}
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+ReadbackQueue::Readback::Readback()
+    : fence(nullptr), frame(0), width(0), height(0), format(Texture::Format::RGBA8),
+      callback(nullptr), userData(nullptr), verticalFlip(false)
+{
+}
+
+ReadbackQueue::ReadbackQueue()
+    : first_(0), numPending_(0), isCompleting_(false)
+#ifdef WITH_THREADS
+      , encodeThreadShouldQuit_(false)
+#endif
+{
+}
+
+ReadbackQueue::~ReadbackQueue()
+{
+	finish();
+
+#ifdef WITH_THREADS
+	if (encodeThread_)
+	{
+		encodeMutex_.lock();
+		encodeThreadShouldQuit_ = true;
+		encodeCondVar_.signal();
+		encodeMutex_.unlock();
+		encodeThread_->join();
+	}
+#endif
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool ReadbackQueue::isFileFormatSupported(const char *filename)
+{
+	ASSERT(filename);
+#ifdef WITH_PNG
+	if (fs::hasExtension(filename, "png"))
+		return true;
+#endif
+#ifdef WITH_WEBP
+	if (fs::hasExtension(filename, "webp"))
+		return true;
+#endif
+	return false;
+}
+
+bool ReadbackQueue::readTexture(GLTexture &texture, unsigned int level, const Request &request)
+{
+#if defined(__EMSCRIPTEN__)
+	// WebGL cannot map buffers, pixel buffer objects can only be read with a blocking call
+	return false;
+#else
+	if (isCompleting_)
+	{
+		LOGW("A readback cannot be started from the callback of another one");
+		return false;
+	}
+
+	ZoneScoped;
+	const unsigned int pixelSize = bytesPerPixel(request.format);
+	const GLsizeiptr dataSize = request.width * request.height * pixelSize;
+	Readback &readback = nextReadback(request, dataSize);
+
+	glGetError();
+	readback.pbo->bind();
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	#if !defined(WITH_OPENGLES)
+	// With a pixel buffer object bound the pointer is an offset inside it
+	texture.getTexImage(level, glFormat(request.format), GL_UNSIGNED_BYTE, nullptr);
+	#else
+	if (readFbo_ == nullptr)
+		readFbo_ = nctl::makeUnique<GLFramebufferObject>();
+	readFbo_->bind(GL_READ_FRAMEBUFFER);
+	glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, texture.target(), texture.glHandle(), level);
+	glReadPixels(0, 0, request.width, request.height, glFormat(request.format), GL_UNSIGNED_BYTE, nullptr);
+	glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, texture.target(), 0, 0);
+	GLFramebufferObject::unbind(GL_READ_FRAMEBUFFER);
+	#endif
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	// Other reads should write to client memory
+	readback.pbo->unbind();
+	const GLenum error = glGetError();
+
+	if (error != GL_NO_ERROR)
+		return false;
+
+	submit(readback);
+	return true;
+#endif
+}
+
+bool ReadbackQueue::readScreen(const Request &request)
+{
+#if defined(__EMSCRIPTEN__)
+	// WebGL cannot map buffers, pixel buffer objects can only be read with a blocking call
+	return false;
+#else
+	if (isCompleting_)
+	{
+		LOGW("A readback cannot be started from the callback of another one");
+		return false;
+	}
+
+	ZoneScoped;
+	const unsigned int pixelSize = bytesPerPixel(request.format);
+	const GLsizeiptr dataSize = request.width * request.height * pixelSize;
+	Readback &readback = nextReadback(request, dataSize);
+
+	glGetError();
+	readback.pbo->bind();
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	GLFramebufferObject::unbind(GL_READ_FRAMEBUFFER);
+	glReadPixels(0, 0, request.width, request.height, glFormat(request.format), GL_UNSIGNED_BYTE, nullptr);
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	readback.pbo->unbind();
+	const GLenum error = glGetError();
+
+	if (error != GL_NO_ERROR)
+		return false;
+
+	submit(readback);
+	return true;
+#endif
+}
+
+unsigned int ReadbackQueue::poll()
+{
+	if (numPending_ == 0)
+		return 0;
+
+	ZoneScoped;
+	const unsigned long int frame = theApplication().numFrames();
+	while (numPending_ > 0)
+	{
+		Readback &readback = readbacks_[first_];
+		const GLenum status = glClientWaitSync(readback.fence, 0, 0);
+		if (status == GL_TIMEOUT_EXPIRED)
+		{
+			// Readbacks complete in order, a more recent one cannot be ready before this one
+			if (frame - readback.frame < MaxFramesInFlight)
+				break;
+			glClientWaitSync(readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT, WaitTimeout);
+		}
+		complete(readback, true);
+	}
+
+	return numPending_;
+}
+
+void ReadbackQueue::finish()
+{
+	if (numPending_ == 0)
+		return;
+
+	ZoneScoped;
+	while (numPending_ > 0)
+	{
+		Readback &readback = readbacks_[first_];
+		glClientWaitSync(readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT, WaitTimeout);
+		// Files are encoded on the calling thread, the encoding one might be about to quit
+		complete(readback, false);
+	}
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+ReadbackQueue::Readback &ReadbackQueue::nextReadback(const Request &request, GLsizeiptr dataSize)
+{
+	if (numPending_ == NumBuffers)
+	{
+		// The ring is full, the oldest readback is waited for to reuse its buffer
+		Readback &oldest = readbacks_[first_];
+		glClientWaitSync(oldest.fence, GL_SYNC_FLUSH_COMMANDS_BIT, WaitTimeout);
+		complete(oldest, true);
+	}
+
+	Readback &readback = readbacks_[(first_ + numPending_) % NumBuffers];
+	if (readback.pbo == nullptr)
+	{
+		readback.pbo = nctl::makeUnique<GLBufferObject>(GL_PIXEL_PACK_BUFFER);
+		readback.pbo->setObjectLabel("Readback_PBO");
+	}
+	// Buffers only grow, so that capturing frames of the same size never reallocates them
+	if (readback.pbo->size() < dataSize)
+		readback.pbo->bufferData(dataSize, nullptr, GL_STREAM_READ);
+
+	readback.width = request.width;
+	readback.height = request.height;
+	readback.format = request.format;
+	readback.callback = request.callback;
+	readback.userData = request.userData;
+	readback.verticalFlip = request.verticalFlip;
+	if (request.filename != nullptr)
+		readback.filename = request.filename;
+	else
+		readback.filename.clear();
+
+	return readback;
+}
+
+void ReadbackQueue::submit(Readback &readback)
+{
+	readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	readback.frame = theApplication().numFrames();
+	numPending_++;
+}
+
+void ReadbackQueue::complete(Readback &readback, bool encodeOnThread)
+{
+	ZoneScoped;
+	glDeleteSync(readback.fence);
+	readback.fence = nullptr;
+	first_ = (first_ + 1) % NumBuffers;
+	numPending_--;
+
+	const unsigned int rowSize = readback.width * bytesPerPixel(readback.format);
+	const GLsizeiptr dataSize = rowSize * readback.height;
+	const unsigned char *mappedPixels = static_cast<const unsigned char *>(readback.pbo->mapBufferRange(0, dataSize, GL_MAP_READ_BIT));
+	if (mappedPixels == nullptr)
+	{
+		LOGE("Cannot map the pixel buffer object of a readback");
+		return;
+	}
+
+	if (readback.filename.isEmpty())
+	{
+		Texture::Readback texels;
+		texels.pixels = mappedPixels;
+		texels.width = readback.width;
+		texels.height = readback.height;
+		texels.format = readback.format;
+		// The buffer is still mapped and its slot is free, a new readback could reuse it
+		isCompleting_ = true;
+		readback.callback(texels, readback.userData);
+		isCompleting_ = false;
+		readback.pbo->unmap();
+		return;
+	}
+
+	// The mapped memory is copied so that the buffer can be reused while the pixels are being encoded
+	nctl::UniquePtr<unsigned char[]> pixels = nctl::makeUnique<unsigned char[]>(dataSize);
+	if (readback.verticalFlip)
+	{
+		for (int i = 0; i < readback.height; i++)
+			memcpy(pixels.get() + i * rowSize, mappedPixels + (readback.height - 1 - i) * rowSize, rowSize);
+	}
+	else
+		memcpy(pixels.get(), mappedPixels, dataSize);
+	readback.pbo->unmap();
+
+#ifdef WITH_THREADS
+	if (encodeOnThread)
+	{
+		enqueueEncode(nctl::makeUnique<EncodeCommand>(nctl::move(pixels), readback.width, readback.height, readback.format, readback.filename));
+		return;
+	}
+#endif
+	encodeToFile(pixels.get(), readback.width, readback.height, readback.format, readback.filename.data());
+}
+
+#ifdef WITH_THREADS
+void ReadbackQueue::enqueueEncode(nctl::UniquePtr<IThreadCommand> encodeCommand)
+{
+	if (encodeThread_ == nullptr)
+	{
+		encodeThread_ = nctl::makeUnique<Thread>(encodeFunction, this);
+	#if !defined(__EMSCRIPTEN__) && !defined(__APPLE__)
+		encodeThread_->setName("ReadbackEncoder");
+	#endif
+	}
+
+	encodeMutex_.lock();
+	// Every queued command holds a copy of the pixels, capturing faster than encoding has to wait
+	while (encodeQueue_.size() >= MaxQueuedEncodes)
+		encodeSpaceCondVar_.wait(encodeMutex_);
+	encodeQueue_.pushBack(nctl::move(encodeCommand));
+	encodeCondVar_.signal();
+	encodeMutex_.unlock();
+}
+
+void ReadbackQueue::encodeFunction(void *arg)
+{
+	ReadbackQueue *queue = static_cast<ReadbackQueue *>(arg);
+	#ifndef WITH_TRACY
+	Profiler::setThreadName("ReadbackEncoder");
+	#endif
+
+	while (true)
+	{
+		queue->encodeMutex_.lock();
+		while (queue->encodeQueue_.isEmpty() && queue->encodeThreadShouldQuit_ == false)
+			queue->encodeCondVar_.wait(queue->encodeMutex_);
+
+		// Pending files are still encoded when quitting, so that no capture is lost at shutdown
+		if (queue->encodeQueue_.isEmpty())
+		{
+			queue->encodeMutex_.unlock();
+			break;
+		}
+
+		nctl::UniquePtr<IThreadCommand> encodeCommand = nctl::move(queue->encodeQueue_.front());
+		queue->encodeQueue_.popFront();
+		queue->encodeSpaceCondVar_.signal();
+		queue->encodeMutex_.unlock();
+
+		ZoneScopedN("Encode readback");
+		encodeCommand->execute();
+	}
+}
+#endif
+
+}
@@ -1,20 +1,45 @@
-#include <cstring> // for memcpy()
 #include "GLShaderProgram.h"
 #include "RenderBatcher.h"
 #include "RenderCommand.h"
 #include "RenderCommandPool.h"
 #include "RenderResources.h"
+#include "RenderStatistics.h"
 #include "Application.h"
+#include "VertexKernels.h"
 #include <nctl/StaticHashMapIterator.h>
+#include "tracy.h"
+
+#ifdef WITH_THREADS
+	#include "IThreadPool.h"
+#endif
 
 namespace ncine {
 
+namespace {
+	/// Minimum number of batched commands for the batches to be filled in parallel
+	const unsigned int MinParallelFillCommands = 1024;
+}
+
 ///////////////////////////////////////////////////////////
 // STATIC DEFINITIONS
 ///////////////////////////////////////////////////////////
 
 unsigned int RenderBatcher::UboMaxSize = 0;
 
+#ifdef WITH_THREADS
+class RenderBatcher::FillCommand : public IThreadCommand
+{
+  public:
+	explicit FillCommand(const nctl::SharedPtr<SharedFillJobs> &sharedJobs)
+	    : sharedJobs_(sharedJobs) {}
+
+	void execute() override { fillNextBatches(*sharedJobs_); }
+
+  private:
+	nctl::SharedPtr<SharedFillJobs> sharedJobs_;
+};
+#endif
+
 ///////////////////////////////////////////////////////////
 // CONSTRUCTORS and DESTRUCTOR
 ///////////////////////////////////////////////////////////
@@ -105,6 +130,8 @@ void RenderBatcher::createBatches(const nctl::Array<RenderCommand *> &srcQueue,
 	// If the queue has only one command the for loop didn't execute, the command has to passthrough
 	if (srcQueue.size() == 1)
 		destQueue.pushBack(srcQueue[0]);
+
+	fillBatches();
 }
 
 void RenderBatcher::reset()
@@ -164,8 +191,9 @@ RenderCommand *RenderBatcher::collectCommands(
 
 		GLUniformBlockCache *batchBlock = batchCommand->material().uniformBlock(uniformBlockName.data());
 		ASSERT(batchBlock);
+		// Every block starts at an aligned offset of the uniform buffer, the alignment amount is included
 		if (batchBlock)
-			nonInstancesBlocksSize += uniformBlockCache.size() - uniformBlockCache.alignAmount();
+			nonInstancesBlocksSize += batchBlock->size();
 	}
 
 	// Set to true if at least one command in the batch has indices or forced by a rendering settings
@@ -178,7 +206,7 @@ RenderCommand *RenderBatcher::collectCommands(
 			batchingWithIndices = true;
 
 		// Don't request more bytes than a UBO can hold
-		const unsigned long currentSize = nonBlockUniformsSize + nonInstancesBlocksSize + instancesBlockSize;
+		const unsigned long currentSize = nonInstancesBlocksSize + instancesBlockSize;
 		if (currentSize + singleInstanceBlockSize > UboMaxSize)
 			break;
 		else
@@ -188,20 +216,6 @@ RenderCommand *RenderBatcher::collectCommands(
 	}
 	nextStart = it;
 
-	batchCommand->material().setUniformsDataPointer(acquireMemory(nonBlockUniformsSize + nonInstancesBlocksSize + instancesBlockSize));
-	// Copying data for non-instances uniform blocks from the first command in the batch
-	for (const GLUniformBlockCache &uniformBlockCache : allUniformBlocks)
-	{
-		uniformBlockName = uniformBlockCache.uniformBlock()->name();
-		if (uniformBlockName == Material::InstanceBlockName)
-			continue;
-
-		GLUniformBlockCache *batchBlock = batchCommand->material().uniformBlock(uniformBlockName.data());
-		const bool dataCopied = batchBlock->copyData(uniformBlockCache.dataPointer());
-		ASSERT(dataCopied);
-		batchBlock->setUsedSize(uniformBlockCache.usedSize());
-	}
-
 	// Setting sampler uniforms for GL_TEXTURE* units
 	const GLShaderUniforms::UniformHashMapType allUniforms = refCommand->material().allUniforms();
 	for (const GLUniformCache &uniformCache : allUniforms)
@@ -280,7 +294,139 @@ RenderCommand *RenderBatcher::collectCommands(
 			destIdx = batchCommand->geometry().acquireIndexPointer(instancesIndicesAmount);
 	}
 
-	it = start;
+	// Uniform blocks live directly in the uniform buffer range of the batch, only the other uniforms need host memory
+	instancesBlockSize = (nextStart - start) * singleInstanceBlockSize;
+	const RenderBuffersManager::Parameters uboParams = RenderResources::buffersManager().acquireMemory(RenderBuffersManager::BufferTypes::UNIFORM, nonInstancesBlocksSize + instancesBlockSize);
+	batchCommand->material().setUniformsDataPointer(acquireMemory(nonBlockUniformsSize), uboParams);
+	GLubyte *blockPointer = uboParams.mapBase + uboParams.offset;
+	unsigned long batchedUniformBytes = instancesBlockSize;
+	// Copying data for non-instances uniform blocks from the first command in the batch
+	for (const GLUniformBlockCache &uniformBlockCache : allUniformBlocks)
+	{
+		uniformBlockName = uniformBlockCache.uniformBlock()->name();
+		if (uniformBlockName == Material::InstanceBlockName)
+			continue;
+
+		GLUniformBlockCache *batchBlock = batchCommand->material().uniformBlock(uniformBlockName.data());
+		batchBlock->setDataPointer(blockPointer);
+		batchBlock->setUsedSize(uniformBlockCache.usedSize());
+		const bool dataCopied = batchBlock->copyData(uniformBlockCache.dataPointer());
+		ASSERT(dataCopied);
+		blockPointer += batchBlock->size();
+		batchedUniformBytes += uniformBlockCache.usedSize();
+	}
+	// The instances block is the last one, it only takes the space needed by the instances in the batch
+	instancesBlock->setDataPointer(blockPointer);
+	RenderStatistics::addBatchedUniformBytes(batchedUniformBytes);
+
+	// Vertices, indices and instance data are copied later, when all batches have reserved their memory
+	FillJob fillJob;
+	fillJob.batchCommand = batchCommand;
+	fillJob.start = &(*start);
+	fillJob.end = fillJob.start + (nextStart - start);
+	fillJob.instancesBlock = instancesBlock;
+	fillJob.singleInstanceBlockSize = singleInstanceBlockSize;
+	fillJob.numFloatsVertexFormat = NumFloatsVertexFormat;
+	fillJob.batchingWithIndices = batchingWithIndices;
+	fillJob.destVtx = destVtx;
+	fillJob.destIdx = destIdx;
+	fillJobs_.pushBack(fillJob);
+
+	for (unsigned int i = 0; i < GLTexture::MaxTextureUnits; i++)
+		batchCommand->material().setTexture(i, refCommand->material().texture(i));
+	batchCommand->material().setBlendingEnabled(refCommand->material().isBlendingEnabled());
+	batchCommand->material().setBlendingFactors(refCommand->material().srcBlendingFactor(), refCommand->material().destBlendingFactor());
+	batchCommand->setBatchSize(nextStart - start);
+	batchCommand->material().uniformBlock(Material::InstancesBlockName)->setUsedSize((nextStart - start) * singleInstanceBlockSize);
+	batchCommand->setLayer(refCommand->layer());
+	batchCommand->setVisitOrder(refCommand->visitOrder());
+
+	if (batchedShaderHasAttributes)
+	{
+		const unsigned int totalVertices = instancesVertexDataSize / SizeVertexFormatAndIndex;
+		batchCommand->geometry().setDrawParameters(refCommand->geometry().primitiveType(), 0, totalVertices);
+		batchCommand->geometry().setNumElementsPerVertex(NumFloatsVertexFormatAndIndex);
+		batchCommand->geometry().setNumIndices(instancesIndicesAmount);
+	}
+	else
+		batchCommand->geometry().setDrawParameters(GL_TRIANGLES, 0, 6 * (nextStart - start));
+
+	return batchCommand;
+}
+
+void RenderBatcher::fillBatches()
+{
+	if (fillJobs_.isEmpty())
+		return;
+
+	ZoneScopedN("Fill batches");
+
+#ifdef WITH_THREADS
+	IThreadPool &threadPool = theServiceLocator().threadPool();
+	unsigned int numBatchedCommands = 0;
+	for (const FillJob &job : fillJobs_)
+		numBatchedCommands += job.end - job.start;
+	const bool fillInParallel = theApplication().renderingSettings().parallelBatching && threadPool.numThreads() > 0 &&
+	                            fillJobs_.size() > 1 && numBatchedCommands >= MinParallelFillCommands;
+
+	if (fillInParallel)
+	{
+		// The main thread fills batches too, one less worker is needed
+		const unsigned int numWorkers = (threadPool.numThreads() < fillJobs_.size() - 1) ? threadPool.numThreads() : fillJobs_.size() - 1;
+		if (sharedFillJobs_ == nullptr || sharedFillJobs_.useCount() > 1)
+			sharedFillJobs_ = nctl::makeShared<SharedFillJobs>();
+		SharedFillJobs &sharedJobs = *sharedFillJobs_;
+		sharedJobs.jobs = fillJobs_.data();
+		sharedJobs.numJobs = static_cast<int32_t>(fillJobs_.size());
+		sharedJobs.nextJob.store(0);
+		sharedJobs.numFilledJobs.store(0);
+		for (unsigned int i = 0; i < numWorkers; i++)
+			threadPool.enqueueCommand(nctl::makeUnique<FillCommand>(sharedFillJobs_));
+
+		fillNextBatches(sharedJobs);
+
+		// Only the batches already claimed by a worker are waited for, commands starting late find none left
+		sharedJobs.mutex.lock();
+		while (sharedJobs.numFilledJobs.load() < sharedJobs.numJobs)
+			sharedJobs.condVar.wait(sharedJobs.mutex);
+		sharedJobs.mutex.unlock();
+	}
+	else
+#endif
+	{
+		for (const FillJob &job : fillJobs_)
+			fillBatch(job);
+	}
+
+	for (const FillJob &job : fillJobs_)
+	{
+		if (job.destVtx)
+		{
+			job.batchCommand->geometry().releaseVertexPointer();
+			if (job.destIdx)
+				job.batchCommand->geometry().releaseIndexPointer();
+		}
+	}
+	fillJobs_.clear();
+}
+
+/*! \note The function only touches the commands of the batch and the memory reserved for it, so batches can be filled in parallel */
+void RenderBatcher::fillBatch(const FillJob &job)
+{
+	RenderCommand *const *start = job.start;
+	RenderCommand *const *nextStart = job.end;
+	GLUniformBlockCache *instancesBlock = job.instancesBlock;
+	const unsigned int singleInstanceBlockSize = job.singleInstanceBlockSize;
+	const bool batchingWithIndices = job.batchingWithIndices;
+	const bool batchedShaderHasAttributes = (job.destVtx != nullptr);
+
+	const unsigned int NumFloatsVertexFormat = job.numFloatsVertexFormat;
+	const unsigned int NumFloatsVertexFormatAndIndex = NumFloatsVertexFormat + 1; // index is an `int`, same size as a `float`
+
+	float *destVtx = job.destVtx;
+	GLushort *destIdx = job.destIdx;
+
+	RenderCommand *const *it = start;
 	unsigned int instancesBlockOffset = 0;
 	unsigned short batchFirstVertexId = 0;
 	while (it != nextStart)
@@ -303,90 +449,73 @@ RenderCommand *RenderBatcher::collectCommands(
 			// Vertex of a degenerate triangle, if not a starting element and there are more than one in the batch
 			if (it != start && nextStart - start > 1 && !batchingWithIndices)
 			{
-				memcpy(destVtx, srcVtx, SizeVertexFormat);
-				*reinterpret_cast<int *>(static_cast<void *>(&destVtx[NumFloatsVertexFormat])) = meshIndex; // last element is the index
-				destVtx += NumFloatsVertexFormatAndIndex;
-			}
-			for (unsigned int i = 0; i < numVertices; i++)
-			{
-				memcpy(destVtx, srcVtx, SizeVertexFormat);
-				*reinterpret_cast<int *>(static_cast<void *>(&destVtx[NumFloatsVertexFormat])) = meshIndex; // last element is the index
+				VertexKernels::copyWithIndex(destVtx, srcVtx, 1, NumFloatsVertexFormat, meshIndex);
 				destVtx += NumFloatsVertexFormatAndIndex;
-				srcVtx += NumFloatsVertexFormat; // source format does not include an index
 			}
+			// The last element of every vertex is the mesh index
+			VertexKernels::copyWithIndex(destVtx, srcVtx, numVertices, NumFloatsVertexFormat, meshIndex);
+			destVtx += numVertices * NumFloatsVertexFormatAndIndex;
 			// Vertex of a degenerate triangle, if not an ending element and there are more than one in the batch
 			if (it != nextStart - 1 && nextStart - start > 1 && !batchingWithIndices)
 			{
-				srcVtx -= NumFloatsVertexFormat;
-				memcpy(destVtx, srcVtx, SizeVertexFormat);
-				*reinterpret_cast<int *>(static_cast<void *>(&destVtx[NumFloatsVertexFormat])) = meshIndex; // last element is the index
+				const float *lastSrcVtx = srcVtx + (numVertices - 1) * NumFloatsVertexFormat;
+				VertexKernels::copyWithIndex(destVtx, lastSrcVtx, 1, NumFloatsVertexFormat, meshIndex);
 				destVtx += NumFloatsVertexFormatAndIndex;
 			}
 
-			if (instancesIndicesAmount > 0)
+			if (destIdx)
 			{
-				unsigned short vertexId = 0;
 				const unsigned int numIndices = command->geometry().numIndices() ? command->geometry().numIndices() : numVertices;
 				const GLushort *srcIdx = command->geometry().hostIndexPointer();
 
 				// Index of a degenerate triangle, if not a starting element and there are more than one in the batch
 				if (it != start && nextStart - start > 1)
 				{
-					*destIdx = batchFirstVertexId + (srcIdx ? *srcIdx : vertexId);
+					*destIdx = batchFirstVertexId + (srcIdx ? *srcIdx : 0);
 					destIdx++;
 				}
-				for (unsigned int i = 0; i < numIndices; i++)
+				if (srcIdx)
+					VertexKernels::addOffset(destIdx, srcIdx, numIndices, batchFirstVertexId);
+				else
 				{
-					*destIdx = batchFirstVertexId + (srcIdx ? *srcIdx : vertexId);
-					destIdx++;
-					vertexId++;
-					if (srcIdx)
-						srcIdx++;
+					for (unsigned int i = 0; i < numIndices; i++)
+						destIdx[i] = batchFirstVertexId + i;
 				}
+				destIdx += numIndices;
 				// Index of a degenerate triangle, if not an ending element and there are more than one in the batch
 				if (it != nextStart - 1 && nextStart - start > 1)
 				{
-					if (srcIdx)
-						srcIdx--;
-					*destIdx = batchFirstVertexId + (srcIdx ? *srcIdx : vertexId - 1);
+					*destIdx = batchFirstVertexId + (srcIdx ? srcIdx[numIndices - 1] : numIndices - 1);
 					destIdx++;
 				}
 
-				batchFirstVertexId += srcIdx ? numVertices : vertexId;
+				batchFirstVertexId += srcIdx ? numVertices : numIndices;
 			}
 		}
 
 		++it;
 	}
+}
 
-	if (batchedShaderHasAttributes)
-	{
-		batchCommand->geometry().releaseVertexPointer();
-		if (destIdx)
-			batchCommand->geometry().releaseIndexPointer();
-	}
-
-	for (unsigned int i = 0; i < GLTexture::MaxTextureUnits; i++)
-		batchCommand->material().setTexture(i, refCommand->material().texture(i));
-	batchCommand->material().setBlendingEnabled(refCommand->material().isBlendingEnabled());
-	batchCommand->material().setBlendingFactors(refCommand->material().srcBlendingFactor(), refCommand->material().destBlendingFactor());
-	batchCommand->setBatchSize(nextStart - start);
-	batchCommand->material().uniformBlock(Material::InstancesBlockName)->setUsedSize(instancesBlockOffset);
-	batchCommand->setLayer(refCommand->layer());
-	batchCommand->setVisitOrder(refCommand->visitOrder());
-
-	if (batchedShaderHasAttributes)
+#ifdef WITH_THREADS
+/*! \note The jobs array is only read after claiming a batch, it can be released as soon as all of them have been filled */
+void RenderBatcher::fillNextBatches(SharedFillJobs &sharedJobs)
+{
+	const int32_t numJobs = sharedJobs.numJobs;
+	int32_t jobIndex = sharedJobs.nextJob.fetchAdd(1);
+	while (jobIndex < numJobs)
 	{
-		const unsigned int totalVertices = instancesVertexDataSize / SizeVertexFormatAndIndex;
-		batchCommand->geometry().setDrawParameters(refCommand->geometry().primitiveType(), 0, totalVertices);
-		batchCommand->geometry().setNumElementsPerVertex(NumFloatsVertexFormatAndIndex);
-		batchCommand->geometry().setNumIndices(instancesIndicesAmount);
+		fillBatch(sharedJobs.jobs[jobIndex]);
+		if (sharedJobs.numFilledJobs.fetchAdd(1) + 1 == numJobs)
+		{
+			sharedJobs.mutex.lock();
+			sharedJobs.condVar.signal();
+			sharedJobs.mutex.unlock();
+		}
+		jobIndex = sharedJobs.nextJob.fetchAdd(1);
 	}
-	else
-		batchCommand->geometry().setDrawParameters(GL_TRIANGLES, 0, 6 * (nextStart - start));
-
-	return batchCommand;
 }
+#endif
 
 unsigned char *RenderBatcher::acquireMemory(unsigned int bytes)
 {
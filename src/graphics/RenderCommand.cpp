@@ -14,6 +14,10 @@ namespace ncine {
 
 const float RenderCommand::LayerStep = 1.0f / static_cast<float>(0xFFFF);
 
+#if NCINE_WITH_ALLOCATORS
+NCTL_DEFINE_SLAB_ALLOCATED(RenderCommand, 256)
+#endif
+
 ///////////////////////////////////////////////////////////
 // CONSTRUCTORS and DESTRUCTOR
 ///////////////////////////////////////////////////////////
@@ -9,7 +9,8 @@ namespace ncine {
 ///////////////////////////////////////////////////////////
 
 RenderCommandPool::RenderCommandPool(unsigned int poolSize)
-    : freeCommandsPool_(poolSize), usedCommandsPool_(poolSize)
+    : commandsPool_(poolSize), usedCommandsPool_(poolSize),
+      freeCommandsLists_(FreeListsHashSize), numFreeCommands_(0)
 {
 }
 
@@ -21,10 +22,11 @@ RenderCommandPool::~RenderCommandPool() = default;
 
 RenderCommand *RenderCommandPool::add()
 {
-	nctl::UniquePtr<RenderCommand> newCommand = nctl::makeUnique<RenderCommand>();
-	usedCommandsPool_.pushBack(nctl::move(newCommand));
+	commandsPool_.pushBack(nctl::makeUnique<RenderCommand>());
+	RenderCommand *newCommand = commandsPool_.back().get();
+	usedCommandsPool_.pushBack(newCommand);
 
-	return usedCommandsPool_.back().get();
+	return newCommand;
 }
 
 RenderCommand *RenderCommandPool::add(GLShaderProgram *shaderProgram)
@@ -39,18 +41,13 @@ RenderCommand *RenderCommandPool::retrieve(GLShaderProgram *shaderProgram)
 {
 	RenderCommand *retrievedCommand = nullptr;
 
-	for (unsigned int i = 0; i < freeCommandsPool_.size(); i++)
+	nctl::Array<RenderCommand *> *freeCommands = freeCommandsLists_.find(shaderProgram);
+	if (freeCommands != nullptr && freeCommands->isEmpty() == false)
 	{
-		const unsigned int poolSize = freeCommandsPool_.size();
-		nctl::UniquePtr<RenderCommand> &command = freeCommandsPool_[i];
-		if (command && command->material().shaderProgram() == shaderProgram)
-		{
-			retrievedCommand = command.get();
-			usedCommandsPool_.pushBack(nctl::move(command));
-			command = nctl::move(freeCommandsPool_[poolSize - 1]);
-			freeCommandsPool_.popBack();
-			break;
-		}
+		retrievedCommand = freeCommands->back();
+		freeCommands->popBack();
+		numFreeCommands_--;
+		usedCommandsPool_.pushBack(retrievedCommand);
 	}
 
 	if (retrievedCommand)
@@ -75,11 +72,32 @@ RenderCommand *RenderCommandPool::retrieveOrAdd(GLShaderProgram *shaderProgram,
 
 void RenderCommandPool::reset()
 {
-	RenderStatistics::gatherCommandPoolStatistics(usedCommandsPool_.size(), freeCommandsPool_.size());
+	RenderStatistics::gatherCommandPoolStatistics(usedCommandsPool_.size(), numFreeCommands_);
 
-	for (nctl::UniquePtr<RenderCommand> &command : usedCommandsPool_)
-		freeCommandsPool_.pushBack(nctl::move(command));
+	for (RenderCommand *command : usedCommandsPool_)
+		freeListForShader(command->material().shaderProgram()).pushBack(command);
+	numFreeCommands_ += usedCommandsPool_.size();
 	usedCommandsPool_.clear();
 }
 
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+nctl::Array<RenderCommand *> &RenderCommandPool::freeListForShader(const GLShaderProgram *shaderProgram)
+{
+	nctl::Array<RenderCommand *> *freeCommands = freeCommandsLists_.find(shaderProgram);
+	if (freeCommands == nullptr)
+	{
+		// Keep the load factor low enough for the hashmap to never be full
+		if (freeCommandsLists_.size() * 4 >= freeCommandsLists_.capacity() * 3)
+			freeCommandsLists_.rehash(freeCommandsLists_.capacity() * 2);
+
+		freeCommandsLists_.emplace(shaderProgram);
+		freeCommands = freeCommandsLists_.find(shaderProgram);
+	}
+
+	return *freeCommands;
+}
+
 }
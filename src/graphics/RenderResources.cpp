@@ -5,6 +5,9 @@
 #include "RenderVaoPool.h"
 #include "RenderCommandPool.h"
 #include "RenderBatcher.h"
+#include "BinaryShaderCache.h"
+#include "GlyphRunCache.h"
+#include "ReadbackQueue.h"
 #include "Camera.h"
 #include "Application.h"
 
@@ -24,6 +27,10 @@ nctl::UniquePtr<RenderBuffersManager> RenderResources::buffersManager_;
 nctl::UniquePtr<RenderVaoPool> RenderResources::vaoPool_;
 nctl::UniquePtr<RenderCommandPool> RenderResources::renderCommandPool_;
 nctl::UniquePtr<RenderBatcher> RenderResources::renderBatcher_;
+nctl::UniquePtr<BinaryShaderCache> RenderResources::binaryShaderCache_;
+nctl::UniquePtr<GlyphRunCache> RenderResources::glyphRunCache_;
+GLShaderProgramQueue RenderResources::shaderProgramQueue_;
+nctl::UniquePtr<ReadbackQueue> RenderResources::readbackQueue_;
 
 nctl::UniquePtr<GLShaderProgram> RenderResources::defaultShaderPrograms_[16];
 nctl::HashMap<const GLShaderProgram *, GLShaderProgram *> RenderResources::batchedShaders_(32);
@@ -203,6 +210,12 @@ void RenderResources::setCurrentViewport(Viewport *viewport)
 	currentViewport_ = viewport;
 }
 
+void RenderResources::createBinaryShaderCache()
+{
+	// Created before any other resource as every shader program can be loaded from the cache
+	binaryShaderCache_ = nctl::makeUnique<BinaryShaderCache>(theApplication().appConfiguration().useBinaryShaderCache);
+}
+
 void RenderResources::create()
 {
 	LOGI("Creating rendering resources...");
@@ -212,6 +225,8 @@ void RenderResources::create()
 	vaoPool_ = nctl::makeUnique<RenderVaoPool>(appCfg.vaoPoolSize);
 	renderCommandPool_ = nctl::makeUnique<RenderCommandPool>(appCfg.vaoPoolSize);
 	renderBatcher_ = nctl::makeUnique<RenderBatcher>();
+	glyphRunCache_ = nctl::makeUnique<GlyphRunCache>();
+	readbackQueue_ = nctl::makeUnique<ReadbackQueue>();
 	defaultCamera_ = nctl::makeUnique<Camera>();
 	currentCamera_ = defaultCamera_.get();
 
@@ -269,7 +284,8 @@ void RenderResources::create()
 		shaderToLoad.shaderProgram->attachShaderFromString(GL_FRAGMENT_SHADER, shaderToLoad.fragmentShader);
 #endif
 		shaderToLoad.shaderProgram->setObjectLabel(shaderToLoad.objectLabel);
-		const bool hasLinked = shaderToLoad.shaderProgram->link(shaderToLoad.introspection);
+		// With deferred queries all the programs are submitted to the driver before waiting for any of them
+		const bool hasLinked = shaderProgramQueue_.submit(*shaderToLoad.shaderProgram, shaderToLoad.introspection);
 		FATAL_ASSERT(hasLinked == true);
 	}
 
@@ -290,6 +306,8 @@ void RenderResources::createMinimal()
 	const AppConfiguration &appCfg = theApplication().appConfiguration();
 	buffersManager_ = nctl::makeUnique<RenderBuffersManager>(appCfg.useBufferMapping, appCfg.vboSize, appCfg.iboSize);
 	vaoPool_ = nctl::makeUnique<RenderVaoPool>(appCfg.vaoPoolSize);
+	glyphRunCache_ = nctl::makeUnique<GlyphRunCache>();
+	readbackQueue_ = nctl::makeUnique<ReadbackQueue>();
 
 	LOGI("Minimal rendering resources created");
 }
@@ -300,12 +318,17 @@ void RenderResources::dispose()
 		shaderProgram.reset(nullptr);
 
 	ASSERT(cameraUniformDataMap_.isEmpty());
+	ASSERT(shaderProgramQueue_.isEmpty());
 
 	defaultCamera_.reset(nullptr);
 	renderBatcher_.reset(nullptr);
 	renderCommandPool_.reset(nullptr);
 	vaoPool_.reset(nullptr);
 	buffersManager_.reset(nullptr);
+	binaryShaderCache_.reset(nullptr);
+	glyphRunCache_.reset(nullptr);
+	// Pending readbacks are completed before their buffers are deleted
+	readbackQueue_.reset(nullptr);
 
 	LOGI("Rendering resources disposed");
 }
@@ -18,6 +18,9 @@ unsigned int RenderStatistics::index_ = 0;
 unsigned int RenderStatistics::culledNodes_[2] = { 0, 0 };
 RenderStatistics::VaoPool RenderStatistics::vaoPool_;
 RenderStatistics::CommandPool RenderStatistics::commandPool_;
+RenderStatistics::UniformData RenderStatistics::uniformData_;
+RenderStatistics::SceneNodes RenderStatistics::sceneNodes_[2];
+RenderStatistics::FontAtlases RenderStatistics::fontAtlases_;
 
 ///////////////////////////////////////////////////////////
 // PRIVATE FUNCTIONS
@@ -27,6 +30,8 @@ void RenderStatistics::reset()
 {
 	TracyPlot("Vertices", static_cast<int64_t>(allCommands_.vertices));
 	TracyPlot("Render Commands", static_cast<int64_t>(allCommands_.commands));
+	TracyPlot("Uniform Bytes Copied", static_cast<int64_t>(uniformData_.copiedBytes()));
+	TracyPlot("Transformed Nodes", static_cast<int64_t>(sceneNodes_[index_].transformed));
 
 	for (unsigned int i = 0; i < RenderCommand::CommandTypes::COUNT; i++)
 		typedCommands_[i].reset();
@@ -38,9 +43,11 @@ void RenderStatistics::reset()
 	// Ping pong index for last and current frame
 	index_ = (index_ + 1) % 2;
 	culledNodes_[index_] = 0;
+	sceneNodes_[index_].reset();
 
 	vaoPool_.reset();
 	commandPool_.reset();
+	uniformData_.reset();
 }
 
 void RenderStatistics::gatherStatistics(const RenderCommand &command)
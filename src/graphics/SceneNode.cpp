@@ -1,5 +1,6 @@
 #include "SceneNode.h"
 #include "Application.h"
+#include "RenderStatistics.h"
 #include "tracy.h"
 
 namespace ncine {
@@ -10,6 +11,10 @@ namespace ncine {
 
 const float SceneNode::MinRotation = 0.5f;
 
+#if NCINE_WITH_ALLOCATORS
+NCTL_DEFINE_SLAB_ALLOCATED(SceneNode, 64)
+#endif
+
 ///////////////////////////////////////////////////////////
 // CONSTRUCTORS and DESTRUCTOR
 ///////////////////////////////////////////////////////////
@@ -23,8 +28,8 @@ SceneNode::SceneNode(SceneNode *parent, float x, float y)
       position_(x, y), anchorPoint_(0.0f, 0.0f), scaleFactor_(1.0f, 1.0f), rotation_(0.0f),
       color_(Color::White), layer_(0), absPosition_(0.0f, 0.0f), absScaleFactor_(1.0f, 1.0f),
       absRotation_(0.0f), absColor_(Color::White), absLayer_(0),
-      worldMatrix_(Matrix4x4f::Identity), localMatrix_(Matrix4x4f::Identity),
-      shouldDeleteChildrenOnDestruction_(true), dirtyBits_(0xFF), lastFrameUpdated_(0)
+      worldMatrix_(Matrix4x4f::Identity), localMatrix_(Matrix4x4f::Identity), previousWorldMatrix_(Matrix4x4f::Identity),
+      shouldDeleteChildrenOnDestruction_(true), dirtyBits_(0xFF), lastFrameUpdated_(0), lastFixedUpdate_(0)
 {
 	setParent(parent);
 }
@@ -70,7 +75,7 @@ SceneNode::SceneNode(SceneNode &&other)
       position_(other.position_), anchorPoint_(other.anchorPoint_),
       scaleFactor_(other.scaleFactor_), rotation_(other.rotation_), color_(other.color_),
       layer_(other.layer_), shouldDeleteChildrenOnDestruction_(other.shouldDeleteChildrenOnDestruction_),
-      dirtyBits_(other.dirtyBits_), lastFrameUpdated_(other.lastFrameUpdated_)
+      dirtyBits_(other.dirtyBits_), lastFrameUpdated_(other.lastFrameUpdated_), lastFixedUpdate_(0)
 {
 	swapChildPointer(this, &other);
 	for (SceneNode *child : children_)
@@ -95,6 +100,7 @@ SceneNode &SceneNode::operator=(SceneNode &&other)
 	shouldDeleteChildrenOnDestruction_ = other.shouldDeleteChildrenOnDestruction_;
 	dirtyBits_ = other.dirtyBits_;
 	lastFrameUpdated_ = other.lastFrameUpdated_;
+	lastFixedUpdate_ = 0;
 
 	swapChildPointer(this, &other);
 	for (SceneNode *child : children_)
@@ -334,7 +340,8 @@ SceneNode::SceneNode(const SceneNode &other)
       scaleFactor_(other.scaleFactor_), rotation_(other.rotation_), color_(other.color_),
       layer_(other.layer_), absPosition_(0.0f, 0.0f), absScaleFactor_(1.0f, 1.0f), absRotation_(0.0f),
       absColor_(Color::White), absLayer_(0), worldMatrix_(Matrix4x4f::Identity), localMatrix_(Matrix4x4f::Identity),
-      shouldDeleteChildrenOnDestruction_(other.shouldDeleteChildrenOnDestruction_), dirtyBits_(0xFF)
+      previousWorldMatrix_(Matrix4x4f::Identity), shouldDeleteChildrenOnDestruction_(other.shouldDeleteChildrenOnDestruction_),
+      dirtyBits_(0xFF), lastFixedUpdate_(0)
 {
 	setParent(other.parent_);
 }
@@ -362,7 +369,24 @@ void SceneNode::swapChildPointer(SceneNode *first, SceneNode *second)
 
 void SceneNode::transform()
 {
-	ZoneScoped;
+	const bool withInterpolation = theApplication().hasFixedTimeStep();
+	if (withInterpolation)
+	{
+		const unsigned long int fixedUpdate = theApplication().numFixedUpdates();
+		if (lastFixedUpdate_ != fixedUpdate)
+		{
+			// A node that skipped the previous update, like a newly emitted particle, cannot interpolate from a stale matrix.
+			// Fixed updates start from one, a node that has never been transformed has no previous matrix at all.
+			if (lastFixedUpdate_ > 0 && lastFixedUpdate_ + 1 == fixedUpdate)
+			{
+				previousWorldMatrix_ = worldMatrix_;
+				dirtyBits_.reset(DirtyBitPositions::StaleInterpolationBit);
+			}
+			else
+				dirtyBits_.set(DirtyBitPositions::StaleInterpolationBit);
+			lastFixedUpdate_ = fixedUpdate;
+		}
+	}
 
 	if (parent_ && layer_ == 0)
 		absLayer_ = parent_->absLayer_;
@@ -394,7 +418,11 @@ void SceneNode::transform()
 	}
 
 	if (dirtyBits_.test(DirtyBitPositions::TransformationBit) == false)
+	{
+		RenderStatistics::addSkippedNode();
 		return;
+	}
+	RenderStatistics::addTransformedNode();
 
 	// Calculating world and local matrices
 	localMatrix_ = Matrix4x4f::translation(position_.x, position_.y, 0.0f);
@@ -417,6 +445,31 @@ void SceneNode::transform()
 
 	absPosition_.x = worldMatrix_[3][0];
 	absPosition_.y = worldMatrix_[3][1];
+
+	if (withInterpolation)
+		dirtyBits_.set(DirtyBitPositions::InterpolationBit);
+}
+
+/*! \note Matrices are interpolated component-wise, which is accurate for the small changes of a single time step.
+ *  When the node stops changing, the exact world matrix is returned once more before the interpolation ends. */
+Matrix4x4f SceneNode::interpolatedWorldMatrix()
+{
+	if (dirtyBits_.test(DirtyBitPositions::StaleInterpolationBit))
+	{
+		previousWorldMatrix_ = worldMatrix_;
+		dirtyBits_.reset(DirtyBitPositions::StaleInterpolationBit);
+	}
+
+	if (dirtyBits_.test(DirtyBitPositions::InterpolationBit) == false)
+		return worldMatrix_;
+	else if (previousWorldMatrix_ == worldMatrix_)
+	{
+		dirtyBits_.reset(DirtyBitPositions::InterpolationBit);
+		return worldMatrix_;
+	}
+
+	const float factor = theApplication().interpolationFactor();
+	return previousWorldMatrix_ + (worldMatrix_ - previousWorldMatrix_) * factor;
 }
 
 }
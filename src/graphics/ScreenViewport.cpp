@@ -56,6 +56,16 @@ void ScreenViewport::resize(int width, int height)
 // PRIVATE FUNCTIONS
 ///////////////////////////////////////////////////////////
 
+void ScreenViewport::fixedUpdate(float timeStep)
+{
+	for (int i = chain_.size() - 1; i >= 0; i--)
+	{
+		if (chain_[i])
+			chain_[i]->fixedUpdate(timeStep);
+	}
+	Viewport::fixedUpdate(timeStep);
+}
+
 void ScreenViewport::update()
 {
 	for (int i = chain_.size() - 1; i >= 0; i--)
@@ -5,6 +5,7 @@
 #include "Shader.h"
 #include "GLShaderProgram.h"
 #include "RenderResources.h"
+#include "Application.h"
 #include "tracy.h"
 
 #ifdef WITH_EMBEDDED_SHADERS
@@ -54,7 +55,9 @@ namespace {
 
 Shader::Shader()
     : Object(ObjectType::SHADER),
-      glShaderProgram_(nctl::makeUnique<GLShaderProgram>(GLShaderProgram::QueryPhase::IMMEDIATE))
+      glShaderProgram_(nctl::makeUnique<GLShaderProgram>(theApplication().appConfiguration().deferShaderQueries
+                                                             ? GLShaderProgram::QueryPhase::DEFERRED
+                                                             : GLShaderProgram::QueryPhase::IMMEDIATE))
 {
 }
 
@@ -162,7 +165,7 @@ bool Shader::loadFromMemory(const char *shaderName, Introspection introspection,
 	glShaderProgram_->setObjectLabel(shaderName);
 	glShaderProgram_->attachShaderFromString(GL_VERTEX_SHADER, vertex);
 	glShaderProgram_->attachShaderFromString(GL_FRAGMENT_SHADER, fragment);
-	glShaderProgram_->link(shaderToShaderProgramIntrospection(introspection));
+	RenderResources::shaderProgramQueue().submit(*glShaderProgram_, shaderToShaderProgramIntrospection(introspection));
 
 	return isLinked();
 }
@@ -191,7 +194,7 @@ bool Shader::loadFromMemory(const char *shaderName, Introspection introspection,
 	glShaderProgram_->setObjectLabel(shaderName);
 	loadDefaultShader(vertex);
 	glShaderProgram_->attachShaderFromString(GL_FRAGMENT_SHADER, fragment);
-	glShaderProgram_->link(shaderToShaderProgramIntrospection(introspection));
+	RenderResources::shaderProgramQueue().submit(*glShaderProgram_, shaderToShaderProgramIntrospection(introspection));
 
 	return isLinked();
 }
@@ -221,7 +224,7 @@ bool Shader::loadFromMemory(const char *shaderName, Introspection introspection,
 	glShaderProgram_->setObjectLabel(shaderName);
 	glShaderProgram_->attachShaderFromString(GL_VERTEX_SHADER, vertex);
 	loadDefaultShader(fragment);
-	glShaderProgram_->link(shaderToShaderProgramIntrospection(introspection));
+	RenderResources::shaderProgramQueue().submit(*glShaderProgram_, shaderToShaderProgramIntrospection(introspection));
 
 	return isLinked();
 }
@@ -250,7 +253,7 @@ bool Shader::loadFromFile(const char *shaderName, Introspection introspection, c
 	glShaderProgram_->setObjectLabel(shaderName);
 	glShaderProgram_->attachShader(GL_VERTEX_SHADER, vertex);
 	glShaderProgram_->attachShader(GL_FRAGMENT_SHADER, fragment);
-	glShaderProgram_->link(shaderToShaderProgramIntrospection(introspection));
+	RenderResources::shaderProgramQueue().submit(*glShaderProgram_, shaderToShaderProgramIntrospection(introspection));
 
 	return isLinked();
 }
@@ -279,7 +282,7 @@ bool Shader::loadFromFile(const char *shaderName, Introspection introspection, D
 	glShaderProgram_->setObjectLabel(shaderName);
 	loadDefaultShader(vertex);
 	glShaderProgram_->attachShader(GL_FRAGMENT_SHADER, fragment);
-	glShaderProgram_->link(shaderToShaderProgramIntrospection(introspection));
+	RenderResources::shaderProgramQueue().submit(*glShaderProgram_, shaderToShaderProgramIntrospection(introspection));
 
 	return isLinked();
 }
@@ -309,7 +312,7 @@ bool Shader::loadFromFile(const char *shaderName, Introspection introspection, c
 	glShaderProgram_->setObjectLabel(shaderName);
 	glShaderProgram_->attachShader(GL_VERTEX_SHADER, vertex);
 	loadDefaultShader(fragment);
-	glShaderProgram_->link(shaderToShaderProgramIntrospection(introspection));
+	RenderResources::shaderProgramQueue().submit(*glShaderProgram_, shaderToShaderProgramIntrospection(introspection));
 
 	return isLinked();
 }
@@ -0,0 +1,73 @@
+#include "ShaderProgramStatus.h"
+
+namespace ncine {
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool ShaderProgramStatus::isLinked() const
+{
+	return (value_ == Status::LINKING ||
+	        value_ == Status::LINKED ||
+	        value_ == Status::LINKED_WITH_DEFERRED_QUERIES ||
+	        value_ == Status::LINKED_WITH_INTROSPECTION);
+}
+
+bool ShaderProgramStatus::hasDeferredQueries() const
+{
+	return (value_ == Status::LINKING || value_ == Status::LINKED_WITH_DEFERRED_QUERIES);
+}
+
+bool ShaderProgramStatus::failCompilation()
+{
+	if (value_ != Status::NOT_LINKED && hasDeferredQueries() == false)
+		return false;
+
+	value_ = Status::COMPILATION_FAILED;
+	return true;
+}
+
+bool ShaderProgramStatus::deferLink(bool canPollCompletion)
+{
+	if (value_ != Status::NOT_LINKED)
+		return false;
+
+	value_ = canPollCompletion ? Status::LINKING : Status::LINKED_WITH_DEFERRED_QUERIES;
+	return true;
+}
+
+bool ShaderProgramStatus::completeLink()
+{
+	if (value_ != Status::LINKING)
+		return false;
+
+	value_ = Status::LINKED_WITH_DEFERRED_QUERIES;
+	return true;
+}
+
+bool ShaderProgramStatus::checkLink(bool hasLinked)
+{
+	// Checking a program still in the `LINKING` status blocks until the driver has completed it
+	if (value_ != Status::NOT_LINKED && hasDeferredQueries() == false)
+		return false;
+
+	value_ = hasLinked ? Status::LINKED : Status::LINKING_FAILED;
+	return true;
+}
+
+bool ShaderProgramStatus::completeIntrospection()
+{
+	if (value_ != Status::LINKED)
+		return false;
+
+	value_ = Status::LINKED_WITH_INTROSPECTION;
+	return true;
+}
+
+void ShaderProgramStatus::reset()
+{
+	value_ = Status::NOT_LINKED;
+}
+
+}
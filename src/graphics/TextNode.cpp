@@ -1,13 +1,23 @@
 #include "TextNode.h"
 #include "FontGlyph.h"
+#include "GlyphRunCache.h"
 #include "Texture.h"
 #include "RenderCommand.h"
 #include "RenderResources.h"
+#include "VertexKernels.h"
 #include "GLDebug.h"
 #include "tracy.h"
 
 namespace ncine {
 
+///////////////////////////////////////////////////////////
+// STATIC DEFINITIONS
+///////////////////////////////////////////////////////////
+
+#if NCINE_WITH_ALLOCATORS
+NCTL_DEFINE_SLAB_ALLOCATED(TextNode, 32)
+#endif
+
 ///////////////////////////////////////////////////////////
 // CONSTRUCTORS and DESTRUCTOR
 ///////////////////////////////////////////////////////////
@@ -31,13 +41,40 @@ TextNode::TextNode(SceneNode *parent, Font *font, unsigned int maxStringLength)
     : DrawableNode(parent, 0.0f, 0.0f), string_(maxStringLength), dirtyDraw_(true),
       dirtyBoundaries_(true), withKerning_(true), font_(font),
       interleavedVertices_(maxStringLength * 4 + (maxStringLength - 1) * 2),
-      xAdvance_(0.0f), yAdvance_(0.0f), lineLengths_(4), alignment_(Alignment::LEFT),
+      lines_(4), alignment_(Alignment::LEFT),
       lineHeight_(font ? font->lineHeight() : 0.0f), instanceBlock_(nullptr)
 {
 	ASSERT(maxStringLength > 0);
 	init();
 }
 
+TextNode::~TextNode() = default;
+
+TextNode::TextNode(TextNode &&) = default;
+
+TextNode &TextNode::operator=(TextNode &&) = default;
+
+TextNode::Line::~Line()
+{
+	GlyphRunCache *glyphRunCache = RenderResources::glyphRunCache();
+	// The cache could have already been disposed together with its runs
+	if (run != nullptr && glyphRunCache != nullptr)
+		glyphRunCache->release(run);
+}
+
+TextNode::Line::Line(Line &&other)
+    : run(other.run), version(other.version)
+{
+	other.run = nullptr;
+}
+
+TextNode::Line &TextNode::Line::operator=(Line &&other)
+{
+	nctl::swap(run, other.run);
+	nctl::swap(version, other.version);
+	return *this;
+}
+
 ///////////////////////////////////////////////////////////
 // PUBLIC FUNCTIONS
 ///////////////////////////////////////////////////////////
@@ -90,7 +127,9 @@ void TextNode::setFont(Font *font)
 		const bool hasChanged = renderCommand_->material().setShaderProgramType(shaderProgramType);
 		if (hasChanged)
 			shaderHasChanged();
-		renderCommand_->material().setTexture(*font_->texture());
+		// A font that only holds glyph metrics has no texture
+		if (font_->texture())
+			renderCommand_->material().setTexture(*font_->texture());
 
 		dirtyDraw_ = true;
 		dirtyBoundaries_ = true;
@@ -116,11 +155,11 @@ void TextNode::enableKerning(bool withKerning)
 
 void TextNode::setAlignment(Alignment alignment)
 {
+	// Alignment is applied when generating vertices, the lines do not need to be laid out again
 	if (alignment != alignment_)
 	{
 		alignment_ = alignment;
 		dirtyDraw_ = true;
-		dirtyBoundaries_ = true;
 	}
 }
 
@@ -177,7 +216,7 @@ Vector2f TextNode::calculateBoundaries(const Font &font, bool withKerning, const
 					{
 						unsigned int nextCodepoint = nctl::Utf8::InvalidUnicode;
 						string.utf8ToCodePoint(i + codePointLength, nextCodepoint);
-						xAdvance += glyph->kerning(nextCodepoint);
+						xAdvance += font.kerning(codepoint, nextCodepoint);
 					}
 				}
 			}
@@ -209,58 +248,30 @@ bool TextNode::draw(RenderQueue &renderQueue)
 	if (string_.isEmpty())
 		return false;
 
-	if (font_ && dirtyDraw_)
+	if (font_)
 	{
-		ZoneScoped;
-		// Clear every previous quad before drawing again
-		interleavedVertices_.clear();
-
-		unsigned int currentLine = 0;
-		xAdvance_ = calculateAlignment(currentLine) - width_ * 0.5f;
-		yAdvance_ = 0.0f - height_ * 0.5f;
-		const unsigned int length = string_.length();
-		for (unsigned int i = 0; i < length;) // increments handled by UTF-8 decoding
+		calculateBoundaries();
+		for (Line &line : lines_)
 		{
-			if (string_[i] == '\n')
-			{
-				currentLine++;
-				xAdvance_ = calculateAlignment(currentLine) - width_ * 0.5f;
-				yAdvance_ += lineHeight_;
-				i++; // manual increment as newline character is not decoded
-			}
-			else
-			{
-				unsigned int codepoint = nctl::Utf8::InvalidUnicode;
-				const int codePointLength = string_.utf8ToCodePoint(i, codepoint);
-				const FontGlyph *glyph = (codepoint != nctl::Utf8::InvalidUnicode) ? font_->glyph(codepoint) : nullptr;
-				if (glyph)
-				{
-					Degenerate degen = Degenerate::NONE;
-					if (length > 1)
-					{
-						if (i == 0)
-							degen = Degenerate::END;
-						else if (i == length - 1)
-							degen = Degenerate::START;
-						else
-							degen = Degenerate::START_END;
-					}
-					processGlyph(glyph, degen);
+			if (line.run == nullptr)
+				continue;
 
-					if (withKerning_)
-					{
-						// font kerning
-						if (i + codePointLength < length)
-						{
-							unsigned int nextCodepoint = nctl::Utf8::InvalidUnicode;
-							string_.utf8ToCodePoint(i + codePointLength, nextCodepoint);
-							xAdvance_ += glyph->kerning(nextCodepoint);
-						}
-					}
-				}
-				i += codePointLength; // manual increment to next codepoint
+			// Glyphs stored in evicted shelves of a dynamic font are rasterised again by the run
+			line.run->touchAtlasShelves();
+			// A shared run could have also been laid out again by another node
+			if (line.run->version() != line.version)
+			{
+				dirtyDraw_ = true;
+				// The length of a run laid out again can differ, changing the node width and the line alignments
+				dirtyBoundaries_ = true;
 			}
 		}
+		calculateBoundaries();
+	}
+
+	if (font_ && dirtyDraw_)
+	{
+		processLines();
 
 		// Vertices are updated only if the string changes
 		renderCommand_->geometry().setNumVertices(interleavedVertices_.size());
@@ -280,7 +291,7 @@ TextNode::TextNode(const TextNode &other)
       string_(other.string_), dirtyDraw_(true), dirtyBoundaries_(true),
       withKerning_(other.withKerning_), font_(other.font_),
       interleavedVertices_(string_.capacity() * 4 + (string_.capacity() - 1) * 2),
-      xAdvance_(0.0f), yAdvance_(0.0f), lineLengths_(4), alignment_(other.alignment_),
+      lines_(4), alignment_(other.alignment_),
       lineHeight_(font_ ? font_->lineHeight() : 0.0f), instanceBlock_(nullptr)
 {
 	init();
@@ -316,7 +327,7 @@ void TextNode::init()
 	renderCommand_->material().setShaderProgramType(shaderProgramType);
 	shaderHasChanged();
 
-	if (font_)
+	if (font_ && font_->texture())
 		renderCommand_->material().setTexture(*font_->texture());
 
 	renderCommand_->geometry().setPrimitiveType(GL_TRIANGLE_STRIP);
@@ -331,60 +342,53 @@ void TextNode::calculateBoundaries() const
 		const float oldWidth = width_;
 		const float oldHeight = height_;
 
-		lineLengths_.clear();
+		GlyphRunCache *glyphRunCache = RenderResources::glyphRunCache();
+		FATAL_ASSERT(glyphRunCache != nullptr);
+
 		float xAdvanceMax = 0.0f; // longest line
-		xAdvance_ = 0.0f;
-		yAdvance_ = 0.0f;
-		const unsigned int length = string_.length();
-		for (unsigned int i = 0; i < length;) // increments handled by UTF-8 decoding
+		unsigned int numLines = 0;
+		const char *lineStart = string_.data();
+		const char *stringEnd = lineStart + string_.length();
+		while (lineStart <= stringEnd)
 		{
-			if (string_[i] == '\n')
+			const char *lineEnd = lineStart;
+			while (lineEnd < stringEnd && *lineEnd != '\n')
+				lineEnd++;
+			const unsigned int lineLength = static_cast<unsigned int>(lineEnd - lineStart);
+
+			if (numLines == lines_.size())
+				lines_.emplaceBack();
+			Line &line = lines_[numLines];
+
+			// Only the lines that have changed are laid out again, unless another node already uses the same run
+			const bool isSameLine = (line.run != nullptr) ? line.run->matches(font_, withKerning_, lineStart, lineLength) : (lineLength == 0);
+			if (isSameLine == false)
 			{
-				lineLengths_.pushBack(xAdvance_);
-				if (xAdvance_ > xAdvanceMax)
-					xAdvanceMax = xAdvance_;
-				xAdvance_ = 0.0f;
-				yAdvance_ += lineHeight_;
-				i++; // manual increment as newline character is not decoded
+				GlyphRun *run = (lineLength > 0) ? glyphRunCache->acquire(font_, withKerning_, lineStart, lineLength) : nullptr;
+				// A new run has a different version, the vertices will be generated again
+				line = Line(run);
 			}
-			else
-			{
-				unsigned int codepoint = nctl::Utf8::InvalidUnicode;
-				const int codePointLength = string_.utf8ToCodePoint(i, codepoint);
-				const FontGlyph *glyph = (codepoint != nctl::Utf8::InvalidUnicode) ? font_->glyph(codepoint) : nullptr;
-				if (glyph)
-				{
-					xAdvance_ += glyph->xAdvance();
-					if (withKerning_)
-					{
-						// font kerning
-						if (i + codePointLength < length)
-						{
-							unsigned int nextCodepoint = nctl::Utf8::InvalidUnicode;
-							string_.utf8ToCodePoint(i + codePointLength, nextCodepoint);
-							xAdvance_ += glyph->kerning(nextCodepoint);
-						}
-					}
-				}
-				i += codePointLength; // manual increment to next codepoint
-			}
-		}
 
-		// If the string does not end with a new line character,
-		// last line height has not been taken into account before
-		if (!string_.isEmpty() && string_[string_.length() - 1] != '\n')
-			yAdvance_ += lineHeight_;
+			if (line.run != nullptr && line.run->length() > xAdvanceMax)
+				xAdvanceMax = line.run->length();
 
-		lineLengths_.pushBack(xAdvance_);
-		if (xAdvance_ > xAdvanceMax)
-			xAdvanceMax = xAdvance_;
+			numLines++;
+			lineStart = lineEnd + 1;
+		}
+		// Releasing the runs of the lines that have been removed
+		if (lines_.size() > numLines)
+			lines_.setSize(numLines);
+
+		// The last line height is only taken into account if the string does not end with a new line character
+		const bool lastLineIsEmpty = (lines_.isEmpty() || lines_.back().run == nullptr);
+		const float yAdvance = (numLines - 1) * lineHeight_ + (lastLineIsEmpty ? 0.0f : lineHeight_);
 
 		// Update node size and anchor points
 		TextNode *mutableNode = const_cast<TextNode *>(this);
 		// Total advance on the X-axis for the longest line (horizontal boundary)
 		mutableNode->width_ = xAdvanceMax;
 		// Total advance on the Y-axis for the entire string (vertical boundary)
-		mutableNode->height_ = yAdvance_;
+		mutableNode->height_ = yAdvance;
 		mutableNode->dirtyBits_.set(DirtyBitPositions::AabbBit);
 
 		if (oldWidth > 0.0f && oldHeight > 0.0f)
@@ -399,6 +403,8 @@ void TextNode::calculateBoundaries() const
 
 float TextNode::calculateAlignment(unsigned int lineIndex) const
 {
+	const GlyphRun *run = lines_[lineIndex].run;
+	const float lineLength = (run != nullptr) ? run->length() : 0.0f;
 	float alignOffset = 0.0f;
 
 	switch (alignment_)
@@ -407,46 +413,61 @@ float TextNode::calculateAlignment(unsigned int lineIndex) const
 			alignOffset = 0.0f;
 			break;
 		case Alignment::CENTER:
-			alignOffset = (width_ - lineLengths_[lineIndex]) * 0.5f;
+			alignOffset = (width_ - lineLength) * 0.5f;
 			break;
 		case Alignment::RIGHT:
-			alignOffset = width_ - lineLengths_[lineIndex];
+			alignOffset = width_ - lineLength;
 			break;
 	}
 
 	return alignOffset;
 }
 
-void TextNode::processGlyph(const FontGlyph *glyph, Degenerate degen)
+void TextNode::processLines()
 {
-	const Vector2i size = glyph->size();
-	const Vector2i offset = glyph->offset();
-
-	const float leftPos = xAdvance_ + offset.x;
-	const float rightPos = leftPos + size.x;
-	const float topPos = -yAdvance_ - offset.y;
-	const float bottomPos = topPos - size.y;
-
-	const Vector2i texSize = font_->texture()->size();
-	const Recti texRect = glyph->texRect();
-
-	const float leftCoord = float(texRect.x) / float(texSize.x);
-	const float rightCoord = float(texRect.x + texRect.w) / float(texSize.x);
-	const float bottomCoord = float(texRect.y + texRect.h) / float(texSize.y);
-	const float topCoord = float(texRect.y) / float(texSize.y);
-
-	if (degen == Degenerate::START || degen == Degenerate::START_END)
-		interleavedVertices_.pushBack(Vertex(leftPos, bottomPos, leftCoord, bottomCoord));
-
-	interleavedVertices_.pushBack(Vertex(leftPos, bottomPos, leftCoord, bottomCoord));
-	interleavedVertices_.pushBack(Vertex(leftPos, topPos, leftCoord, topCoord));
-	interleavedVertices_.pushBack(Vertex(rightPos, bottomPos, rightCoord, bottomCoord));
-	interleavedVertices_.pushBack(Vertex(rightPos, topPos, rightCoord, topCoord));
-
-	if (degen == Degenerate::START_END || degen == Degenerate::END)
-		interleavedVertices_.pushBack(Vertex(rightPos, topPos, rightCoord, topCoord));
-
-	xAdvance_ += glyph->xAdvance();
+	ZoneScoped;
+	// Clear every previous quad before drawing again
+	interleavedVertices_.clear();
+
+	unsigned int numQuads = 0;
+	for (const Line &line : lines_)
+		numQuads += (line.run != nullptr) ? line.run->numQuads() : 0;
+
+	// Every quad but the first and the last one is joined to the others by two degenerate vertices
+	const unsigned int numVertices = (numQuads > 0) ? numQuads * 4 + (numQuads - 1) * 2 : 0;
+	if (numVertices > interleavedVertices_.capacity())
+		interleavedVertices_.setCapacity(numVertices);
+	interleavedVertices_.setSize(numVertices);
+	Vertex *vertices = interleavedVertices_.data();
+
+	unsigned int quadIndex = 0;
+	for (unsigned int i = 0; i < lines_.size(); i++)
+	{
+		Line &line = lines_[i];
+		if (line.run == nullptr)
+			continue;
+
+		const float xOffset = calculateAlignment(i) - width_ * 0.5f;
+		const float yOffset = height_ * 0.5f - i * lineHeight_;
+		const VertexKernels::Quad *runQuads = line.run->quads();
+		for (unsigned int j = 0; j < line.run->numQuads(); j++)
+		{
+			VertexKernels::Quad quad = runQuads[j];
+			quad.positions[0] += xOffset;
+			quad.positions[1] += yOffset;
+			quad.positions[2] += xOffset;
+			quad.positions[3] += yOffset;
+
+			if (quadIndex > 0)
+				*vertices++ = Vertex(quad.positions[0], quad.positions[1], quad.texCoords[0], quad.texCoords[1]);
+			VertexKernels::quadsToStrip(reinterpret_cast<float *>(vertices), &quad, 1);
+			vertices += 4;
+			if (quadIndex < numQuads - 1)
+				*vertices++ = Vertex(quad.positions[2], quad.positions[3], quad.texCoords[2], quad.texCoords[3]);
+			quadIndex++;
+		}
+		line.version = line.run->version();
+	}
 }
 
 void TextNode::shaderHasChanged()
@@ -465,9 +486,9 @@ void TextNode::shaderHasChanged()
 
 void TextNode::updateRenderCommand()
 {
-	if (dirtyBits_.test(DirtyBitPositions::TransformationBit))
+	if (dirtyBits_.test(DirtyBitPositions::TransformationBit) || dirtyBits_.test(DirtyBitPositions::InterpolationBit))
 	{
-		renderCommand_->setTransformation(worldMatrix_);
+		renderCommand_->setTransformation(interpolatedWorldMatrix());
 		dirtyBits_.reset(DirtyBitPositions::TransformationBit);
 	}
 	if (dirtyBits_.test(DirtyBitPositions::ColorBit))
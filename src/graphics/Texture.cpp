@@ -2,14 +2,43 @@
 #include "common_headers.h"
 #include "common_macros.h"
 #include <nctl/CString.h>
+#include <nctl/algorithms.h>
 #include "Texture.h"
 #include "TextureLoaderRaw.h"
 #include "GLTexture.h"
 #include "RenderStatistics.h"
+#include "RenderResources.h"
+#include "ReadbackQueue.h"
 #include "tracy.h"
 
+#ifdef WITH_ALLOCATORS
+	#include "Application.h"
+#endif
+
 namespace ncine {
 
+namespace {
+
+#ifdef WITH_ALLOCATORS
+	using PixelsPtr = nctl::UniquePtr<uint32_t[], nctl::AllocDelete<uint32_t[]>>;
+
+	// The converted pixels are only needed until the upload, they can come from the frame arena
+	PixelsPtr allocatePixels(unsigned int numPixels)
+	{
+		nctl::IAllocator &allocator = theApplication().frameAllocator();
+		return (numPixels > 0) ? nctl::allocateUnique<uint32_t[]>(allocator, numPixels) : PixelsPtr(nullptr, nctl::AllocDelete<uint32_t[]>(&allocator));
+	}
+#else
+	using PixelsPtr = nctl::UniquePtr<uint32_t[]>;
+
+	PixelsPtr allocatePixels(unsigned int numPixels)
+	{
+		return (numPixels > 0) ? nctl::makeUnique<uint32_t[]>(numPixels) : PixelsPtr();
+	}
+#endif
+
+}
+
 GLenum ncFormatToInternal(Texture::Format format)
 {
 	switch (format)
@@ -256,13 +285,13 @@ bool Texture::loadFromTexels(const unsigned char *bufferPtr, Recti region)
 bool Texture::loadFromTexels(const unsigned char *bufferPtr, unsigned int level, unsigned int x, unsigned int y, unsigned int width, unsigned int height)
 {
 	const unsigned char *data = bufferPtr;
-	nctl::UniquePtr<uint32_t[]> chromaPixels;
+	PixelsPtr chromaPixels = allocatePixels(0);
 
 	if (format_ == Format::RGB8 && isChromaKeyEnabled_)
 	{
 		format_ = Format::RGBA8;
 		const unsigned int numPixels = width * height - (y * width + x);
-		chromaPixels = nctl::makeUnique<uint32_t[]>(numPixels);
+		chromaPixels = allocatePixels(numPixels);
 		chromaKeyPixels(chromaPixels.get(), bufferPtr, numPixels, chromaKeyColor_);
 		data = reinterpret_cast<const unsigned char *>(chromaPixels.get());
 	}
@@ -300,6 +329,51 @@ bool Texture::saveToMemory(unsigned char *bufferPtr, unsigned int level)
 #endif
 }
 
+bool Texture::readTexelsAsync(ReadbackCallback callback, void *userData)
+{
+	return readTexelsAsync(0, callback, userData);
+}
+
+/*! \note The texels are copied into a pixel buffer object and mapped only when the copy has completed */
+bool Texture::readTexelsAsync(unsigned int level, ReadbackCallback callback, void *userData)
+{
+	ASSERT(callback);
+	if (isCompressed_ || static_cast<int>(level) >= mipMapLevels_)
+		return false;
+
+	ReadbackQueue::Request request;
+	request.width = nctl::max(width_ >> level, 1);
+	request.height = nctl::max(height_ >> level, 1);
+	request.format = format_;
+	request.callback = callback;
+	request.userData = userData;
+
+	return RenderResources::readbackQueue().readTexture(*glTexture_, level, request);
+}
+
+/*! \note Textures generated by rendering to them are stored from bottom to top and need a vertical flip */
+bool Texture::saveToFileAsync(const char *filename, bool verticalFlip)
+{
+	ASSERT(filename);
+	// Image savers only support three and four channels
+	if (isCompressed_ || (format_ != Format::RGB8 && format_ != Format::RGBA8))
+		return false;
+	if (ReadbackQueue::isFileFormatSupported(filename) == false)
+	{
+		LOGE_X("Cannot save \"%s\", the image format is not supported", filename);
+		return false;
+	}
+
+	ReadbackQueue::Request request;
+	request.width = width_;
+	request.height = height_;
+	request.format = format_;
+	request.filename = filename;
+	request.verticalFlip = verticalFlip;
+
+	return RenderResources::readbackQueue().readTexture(*glTexture_, 0, request);
+}
+
 unsigned int Texture::numChannels() const
 {
 	switch (format_)
@@ -487,7 +561,7 @@ void Texture::load(const ITextureLoader &texLoader)
 	int levelHeight = height_;
 
 	GLenum format = texFormat.format();
-	nctl::UniquePtr<uint32_t[]> chromaPixels;
+	PixelsPtr chromaPixels = allocatePixels(0);
 
 	for (int mipIdx = 0; mipIdx < texLoader.mipMapCount(); mipIdx++)
 	{
@@ -496,7 +570,7 @@ void Texture::load(const ITextureLoader &texLoader)
 		{
 			format = GL_RGBA;
 			const unsigned int numPixels = levelWidth * levelHeight;
-			chromaPixels = nctl::makeUnique<uint32_t[]>(numPixels);
+			chromaPixels = allocatePixels(numPixels);
 			chromaKeyPixels(chromaPixels.get(), texLoader.pixels(mipIdx), numPixels, chromaKeyColor_);
 			data = reinterpret_cast<const unsigned char *>(chromaPixels.get());
 		}
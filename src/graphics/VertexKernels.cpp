@@ -0,0 +1,215 @@
+#include <cstring> // for memcpy()
+#include "VertexKernels.h"
+
+#if defined(__AVX2__)
+	#define NCINE_KERNELS_AVX2 (1)
+	#define NCINE_KERNELS_SSE2 (1)
+	#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define NCINE_KERNELS_SSE2 (1)
+	#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	#define NCINE_KERNELS_NEON (1)
+	#include <arm_neon.h>
+#endif
+
+namespace ncine {
+
+namespace {
+	/// Number of elements of the vertex format that has a vectorised path
+	const unsigned int VectorisedNumFloats = 4;
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+const char *VertexKernels::instructionSet()
+{
+#if NCINE_KERNELS_AVX2
+	return "AVX2";
+#elif NCINE_KERNELS_SSE2
+	return "SSE2";
+#elif NCINE_KERNELS_NEON
+	return "NEON";
+#else
+	return "Scalar";
+#endif
+}
+
+void VertexKernels::copyWithIndex(float *dest, const float *src, unsigned int numVertices, unsigned int numFloats, int index)
+{
+#if NCINE_KERNELS_SSE2 || NCINE_KERNELS_NEON
+	if (numFloats != VectorisedNumFloats)
+	{
+		copyWithIndexScalar(dest, src, numVertices, numFloats, index);
+		return;
+	}
+
+	// Four vertices of four elements plus the index fill exactly five vector registers
+	const unsigned int numGroups = numVertices / 4;
+	#if NCINE_KERNELS_SSE2
+	const __m128 indexVec = _mm_castsi128_ps(_mm_set1_epi32(index));
+	for (unsigned int i = 0; i < numGroups; i++)
+	{
+		const __m128 v0 = _mm_loadu_ps(src);
+		const __m128 v1 = _mm_loadu_ps(src + 4);
+		const __m128 v2 = _mm_loadu_ps(src + 8);
+		const __m128 v3 = _mm_loadu_ps(src + 12);
+
+		const __m128 indexV1 = _mm_shuffle_ps(indexVec, v1, _MM_SHUFFLE(0, 0, 0, 0));
+		const __m128 v1Index = _mm_shuffle_ps(v1, indexVec, _MM_SHUFFLE(0, 0, 3, 3));
+		const __m128 indexV3 = _mm_shuffle_ps(indexVec, v3, _MM_SHUFFLE(0, 0, 0, 0));
+		const __m128 v3Index = _mm_shuffle_ps(v3, indexVec, _MM_SHUFFLE(0, 0, 3, 3));
+
+		_mm_storeu_ps(dest, v0);
+		_mm_storeu_ps(dest + 4, _mm_shuffle_ps(indexV1, v1, _MM_SHUFFLE(2, 1, 2, 0)));
+		_mm_storeu_ps(dest + 8, _mm_shuffle_ps(v1Index, v2, _MM_SHUFFLE(1, 0, 2, 0)));
+		_mm_storeu_ps(dest + 12, _mm_shuffle_ps(v2, indexV3, _MM_SHUFFLE(2, 0, 3, 2)));
+		_mm_storeu_ps(dest + 16, _mm_shuffle_ps(v3, v3Index, _MM_SHUFFLE(2, 0, 2, 1)));
+
+		src += 16;
+		dest += 20;
+	}
+	#else
+	const float32x4_t indexVec = vreinterpretq_f32_s32(vdupq_n_s32(index));
+	for (unsigned int i = 0; i < numGroups; i++)
+	{
+		const float32x4_t v0 = vld1q_f32(src);
+		const float32x4_t v1 = vld1q_f32(src + 4);
+		const float32x4_t v2 = vld1q_f32(src + 8);
+		const float32x4_t v3 = vld1q_f32(src + 12);
+
+		vst1q_f32(dest, v0);
+		vst1q_f32(dest + 4, vextq_f32(indexVec, v1, 3));
+		vst1q_f32(dest + 8, vextq_f32(v1, vextq_f32(indexVec, v2, 3), 3));
+		vst1q_f32(dest + 12, vextq_f32(v2, vextq_f32(indexVec, v3, 3), 2));
+		vst1q_f32(dest + 16, vextq_f32(v3, indexVec, 1));
+
+		src += 16;
+		dest += 20;
+	}
+	#endif
+
+	copyWithIndexScalar(dest, src, numVertices - numGroups * 4, numFloats, index);
+#else
+	copyWithIndexScalar(dest, src, numVertices, numFloats, index);
+#endif
+}
+
+void VertexKernels::addOffset(unsigned short *dest, const unsigned short *src, unsigned int numIndices, unsigned short offset)
+{
+	unsigned int i = 0;
+#if NCINE_KERNELS_AVX2
+	const __m256i offsetVec256 = _mm256_set1_epi16(static_cast<short>(offset));
+	for (; i + 16 <= numIndices; i += 16)
+	{
+		const __m256i indices = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + i), _mm256_add_epi16(indices, offsetVec256));
+	}
+#endif
+#if NCINE_KERNELS_SSE2
+	const __m128i offsetVec = _mm_set1_epi16(static_cast<short>(offset));
+	for (; i + 8 <= numIndices; i += 8)
+	{
+		const __m128i indices = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i), _mm_add_epi16(indices, offsetVec));
+	}
+#elif NCINE_KERNELS_NEON
+	const uint16x8_t offsetVec = vdupq_n_u16(offset);
+	for (; i + 8 <= numIndices; i += 8)
+		vst1q_u16(dest + i, vaddq_u16(vld1q_u16(src + i), offsetVec));
+#endif
+
+	addOffsetScalar(dest + i, src + i, numIndices - i, offset);
+}
+
+void VertexKernels::quadsToStrip(float *dest, const Quad *quads, unsigned int numQuads)
+{
+#if NCINE_KERNELS_SSE2
+	for (unsigned int i = 0; i < numQuads; i++)
+	{
+		const __m128 positions = _mm_loadu_ps(quads[i].positions);
+		const __m128 texCoords = _mm_loadu_ps(quads[i].texCoords);
+
+		_mm_storeu_ps(dest, _mm_shuffle_ps(positions, texCoords, _MM_SHUFFLE(1, 0, 1, 0)));
+		_mm_storeu_ps(dest + 4, _mm_shuffle_ps(positions, texCoords, _MM_SHUFFLE(3, 0, 3, 0)));
+		_mm_storeu_ps(dest + 8, _mm_shuffle_ps(positions, texCoords, _MM_SHUFFLE(1, 2, 1, 2)));
+		_mm_storeu_ps(dest + 12, _mm_shuffle_ps(positions, texCoords, _MM_SHUFFLE(3, 2, 3, 2)));
+		dest += 16;
+	}
+#elif NCINE_KERNELS_NEON
+	for (unsigned int i = 0; i < numQuads; i++)
+	{
+		const float32x4_t positions = vld1q_f32(quads[i].positions);
+		const float32x4_t texCoords = vld1q_f32(quads[i].texCoords);
+
+		// Left and right in the first lane, bottom and top in the second one
+		const float32x2x2_t posLrBt = vtrn_f32(vget_low_f32(positions), vget_high_f32(positions));
+		const float32x2x2_t texLrBt = vtrn_f32(vget_low_f32(texCoords), vget_high_f32(texCoords));
+		const float32x2x2_t posLlRr = vzip_f32(posLrBt.val[0], posLrBt.val[0]);
+		const float32x2x2_t texLlRr = vzip_f32(texLrBt.val[0], texLrBt.val[0]);
+
+		// Storing four vectors interleaved writes the four vertices of the strip
+		float32x4x4_t vertices;
+		vertices.val[0] = vcombine_f32(posLlRr.val[0], posLlRr.val[1]);
+		vertices.val[1] = vcombine_f32(posLrBt.val[1], posLrBt.val[1]);
+		vertices.val[2] = vcombine_f32(texLlRr.val[0], texLlRr.val[1]);
+		vertices.val[3] = vcombine_f32(texLrBt.val[1], texLrBt.val[1]);
+		vst4q_f32(dest, vertices);
+		dest += 16;
+	}
+#else
+	quadsToStripScalar(dest, quads, numQuads);
+#endif
+}
+
+void VertexKernels::copyWithIndexScalar(float *dest, const float *src, unsigned int numVertices, unsigned int numFloats, int index)
+{
+	for (unsigned int i = 0; i < numVertices; i++)
+	{
+		memcpy(dest, src, numFloats * sizeof(float));
+		memcpy(dest + numFloats, &index, sizeof(int)); // last element is the index
+		src += numFloats;
+		dest += numFloats + 1;
+	}
+}
+
+void VertexKernels::addOffsetScalar(unsigned short *dest, const unsigned short *src, unsigned int numIndices, unsigned short offset)
+{
+	for (unsigned int i = 0; i < numIndices; i++)
+		dest[i] = static_cast<unsigned short>(src[i] + offset);
+}
+
+void VertexKernels::quadsToStripScalar(float *dest, const Quad *quads, unsigned int numQuads)
+{
+	for (unsigned int i = 0; i < numQuads; i++)
+	{
+		const float *pos = quads[i].positions;
+		const float *tex = quads[i].texCoords;
+
+		// Bottom left
+		dest[0] = pos[0];
+		dest[1] = pos[1];
+		dest[2] = tex[0];
+		dest[3] = tex[1];
+		// Top left
+		dest[4] = pos[0];
+		dest[5] = pos[3];
+		dest[6] = tex[0];
+		dest[7] = tex[3];
+		// Bottom right
+		dest[8] = pos[2];
+		dest[9] = pos[1];
+		dest[10] = tex[2];
+		dest[11] = tex[1];
+		// Top right
+		dest[12] = pos[2];
+		dest[13] = pos[3];
+		dest[14] = tex[2];
+		dest[15] = tex[3];
+		dest += 16;
+	}
+}
+
+}
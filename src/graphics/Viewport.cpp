@@ -12,6 +12,7 @@
 #include "GLViewport.h"
 #include "GLScissorTest.h"
 #include "GLDebug.h"
+#include "RenderStatistics.h"
 #include "tracy.h"
 
 #ifdef WITH_QT5
@@ -338,6 +339,18 @@ void Viewport::calculateCullingRect()
 	}
 }
 
+/*! \note Nodes shared by more than one viewport are only updated once per fixed time step */
+void Viewport::fixedUpdate(float timeStep)
+{
+	if (rootNode_ && rootNode_->lastFixedUpdate() < theApplication().numFixedUpdates())
+	{
+		ZoneScoped;
+		const TimeStamp updateStart = TimeStamp::now();
+		rootNode_->update(timeStep);
+		RenderStatistics::addUpdateTime(updateStart.secondsSince());
+	}
+}
+
 void Viewport::update()
 {
 	RenderResources::setCurrentViewport(this);
@@ -347,10 +360,17 @@ void Viewport::update()
 	if (rootNode_)
 	{
 		ZoneScoped;
-		if (rootNode_->lastFrameUpdated() < theApplication().numFrames())
+		// With a fixed time step the nodes have already been updated by `fixedUpdate()`
+		if (rootNode_->lastFrameUpdated() < theApplication().numFrames() && theApplication().hasFixedTimeStep() == false)
+		{
+			const TimeStamp updateStart = TimeStamp::now();
 			rootNode_->update(theApplication().interval());
+			RenderStatistics::addUpdateTime(updateStart.secondsSince());
+		}
 		// AABBs should update after nodes have been transformed
+		const TimeStamp cullingStart = TimeStamp::now();
 		updateCulling(rootNode_);
+		RenderStatistics::addCullingTime(cullingStart.secondsSince());
 	}
 
 	stateBits_.set(StateBitPositions::UpdatedBit);
@@ -363,8 +383,10 @@ void Viewport::visit()
 	if (rootNode_)
 	{
 		ZoneScoped;
+		const TimeStamp visitStart = TimeStamp::now();
 		unsigned int visitOrderIndex = 0;
 		rootNode_->visit(*renderQueue_, visitOrderIndex);
+		RenderStatistics::addVisitTime(visitStart.secondsSince());
 	}
 
 	stateBits_.set(StateBitPositions::VisitedBit);
@@ -0,0 +1,207 @@
+#include <cstring> // for strlen()
+#include "common_macros.h"
+#include <nctl/HashFunctions.h>
+#include "BinaryShaderCache.h"
+#include "IGfxCapabilities.h"
+#include "ServiceLocator.h"
+#include "FileSystem.h"
+#include "IFile.h"
+
+namespace ncine {
+
+namespace {
+	/// The four characters "NCSB" identifying a cached binary file
+	const uint32_t Signature = 0x4253434E;
+	/// The version of the cached binary file format
+	const uint32_t Version = 1;
+
+	const char *CacheDirectory = "shader_cache";
+	const char *CacheExtension = "bin";
+
+	uint64_t hashInfoString(const unsigned char *string, uint64_t hash)
+	{
+		if (string != nullptr)
+		{
+			const char *chars = reinterpret_cast<const char *>(string);
+			hash = nctl::fasthash64(chars, strlen(chars), hash);
+		}
+		return hash;
+	}
+}
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+BinaryShaderCache::BinaryShaderCache(bool enable)
+    : isAvailable_(false), driverHash_(0), directory_(fs::MaxPathLength)
+{
+#if !defined(__EMSCRIPTEN__)
+	const IGfxCapabilities &gfxCaps = theServiceLocator().gfxCapabilities();
+	const int numFormats = gfxCaps.value(IGfxCapabilities::GLIntValues::NUM_PROGRAM_BINARY_FORMATS);
+	if (enable == false || numFormats <= 0 || fs::savePath().isEmpty())
+		return;
+
+	const IGfxCapabilities::GlInfoStrings &infoStrings = gfxCaps.glInfoStrings();
+	driverHash_ = hashInfoString(infoStrings.vendor, 0);
+	driverHash_ = hashInfoString(infoStrings.renderer, driverHash_);
+	driverHash_ = hashInfoString(infoStrings.glVersion, driverHash_);
+
+	directory_ = fs::joinPath(fs::savePath(), CacheDirectory);
+	if (fs::isDirectory(directory_.data()) == false)
+		fs::createDir(directory_.data());
+
+	isAvailable_ = fs::isDirectory(directory_.data());
+	if (isAvailable_)
+		LOGI_X("Binary shader cache directory: \"%s\"", directory_.data());
+	else
+		LOGW_X("Cannot create the binary shader cache directory \"%s\"", directory_.data());
+#endif
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool BinaryShaderCache::loadFromCache(uint64_t hash, GLuint program)
+{
+#if !defined(__EMSCRIPTEN__)
+	if (isAvailable_ == false)
+		return false;
+
+	const nctl::String path = filename(hash);
+	if (fs::isFile(path.data()) == false)
+	{
+		statistics_.missed++;
+		return false;
+	}
+
+	nctl::UniquePtr<IFile> fileHandle = IFile::createFileHandle(path.data());
+	fileHandle->setExitOnFailToOpen(false);
+	fileHandle->open(IFile::OpenMode::READ | IFile::OpenMode::BINARY);
+	if (fileHandle->isOpened() == false)
+	{
+		statistics_.missed++;
+		return false;
+	}
+
+	Header header;
+	const unsigned long int headerBytes = fileHandle->read(&header, sizeof(Header));
+	const bool validHeader = (headerBytes == sizeof(Header) && header.signature == Signature && header.version == Version &&
+	                          header.driverHash == driverHash_ && header.length > 0 &&
+	                          static_cast<unsigned long int>(fileHandle->size()) == sizeof(Header) + header.length);
+
+	bool hasLinked = false;
+	if (validHeader)
+	{
+		nctl::UniquePtr<unsigned char[]> binary = nctl::makeUnique<unsigned char[]>(header.length);
+		if (fileHandle->read(binary.get(), header.length) == header.length)
+		{
+			glProgramBinary(program, static_cast<GLenum>(header.format), binary.get(), static_cast<GLsizei>(header.length));
+
+			GLint status = GL_FALSE;
+			glGetProgramiv(program, GL_LINK_STATUS, &status);
+			hasLinked = (status == GL_TRUE);
+		}
+	}
+	fileHandle->close();
+
+	if (hasLinked == false)
+	{
+		// The binary is stale or corrupted, it will be replaced by a new one after compilation
+		LOGW_X("Rejecting the cached program binary \"%s\"", path.data());
+		fs::deleteFile(path.data());
+		statistics_.rejected++;
+		return false;
+	}
+
+	statistics_.loaded++;
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool BinaryShaderCache::saveToCache(uint64_t hash, GLuint program)
+{
+#if !defined(__EMSCRIPTEN__)
+	if (isAvailable_ == false)
+		return false;
+
+	GLint length = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0)
+		return false;
+
+	nctl::UniquePtr<unsigned char[]> binary = nctl::makeUnique<unsigned char[]>(length);
+	GLsizei bytesWritten = 0;
+	GLenum format = 0;
+	glGetProgramBinary(program, length, &bytesWritten, &format, binary.get());
+	if (bytesWritten <= 0)
+		return false;
+
+	Header header;
+	header.signature = Signature;
+	header.version = Version;
+	header.driverHash = driverHash_;
+	header.format = static_cast<uint32_t>(format);
+	header.length = static_cast<uint32_t>(bytesWritten);
+
+	const nctl::String path = filename(hash);
+	nctl::UniquePtr<IFile> fileHandle = IFile::createFileHandle(path.data());
+	fileHandle->setExitOnFailToOpen(false);
+	fileHandle->open(IFile::OpenMode::WRITE | IFile::OpenMode::BINARY);
+	if (fileHandle->isOpened() == false)
+		return false;
+
+	const unsigned long int written = fileHandle->write(&header, sizeof(Header)) + fileHandle->write(binary.get(), header.length);
+	fileHandle->close();
+
+	if (written != sizeof(Header) + header.length)
+	{
+		LOGW_X("Cannot write the program binary \"%s\"", path.data());
+		fs::deleteFile(path.data());
+		return false;
+	}
+
+	statistics_.saved++;
+	return true;
+#else
+	return false;
+#endif
+}
+
+unsigned int BinaryShaderCache::clear()
+{
+	unsigned int numDeleted = 0;
+	if (isAvailable_ == false)
+		return numDeleted;
+
+	fs::Directory dir(directory_.data());
+	while (const char *entryName = dir.readNext())
+	{
+		if (fs::hasExtension(entryName, CacheExtension))
+		{
+			const nctl::String path = fs::joinPath(directory_, entryName);
+			if (fs::deleteFile(path.data()))
+				numDeleted++;
+		}
+	}
+	dir.close();
+
+	LOGI_X("Deleted %u program binaries from the cache", numDeleted);
+	return numDeleted;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+nctl::String BinaryShaderCache::filename(uint64_t hash) const
+{
+	nctl::String name(32);
+	name.format("%08x%08x.%s", static_cast<uint32_t>(hash >> 32), static_cast<uint32_t>(hash), CacheExtension);
+	return fs::joinPath(directory_, name);
+}
+
+}
@@ -123,9 +123,11 @@ void GLBufferObject::bindBufferRange(GLuint index, GLintptr offset, GLsizei ptrs
 void *GLBufferObject::mapBufferRange(GLintptr offset, GLsizeiptr length, GLbitfield access)
 {
 	FATAL_ASSERT(mapped_ == false);
-	mapped_ = true;
 	bind();
-	return glMapBufferRange(target_, offset, length, access);
+	void *mapPtr = glMapBufferRange(target_, offset, length, access);
+	// A buffer that could not be mapped should not be unmapped
+	mapped_ = (mapPtr != nullptr);
+	return mapPtr;
 }
 
 void GLBufferObject::flushMappedBufferRange(GLintptr offset, GLsizeiptr length)
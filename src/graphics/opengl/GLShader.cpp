@@ -1,8 +1,10 @@
+#include <cstring> // for strlen()
 #include "common_macros.h"
 #include "GLShader.h"
 #include "GLDebug.h"
 #include "IFile.h"
 #include <nctl/StaticString.h>
+#include <nctl/HashFunctions.h>
 
 #if defined(__EMSCRIPTEN__) || defined(WITH_ANGLE)
 	#include "Application.h"
@@ -27,7 +29,7 @@ char GLShader::infoLogString_[MaxInfoLogLength];
 ///////////////////////////////////////////////////////////
 
 GLShader::GLShader(GLenum type)
-    : glHandle_(0), status_(Status::NOT_COMPILED)
+    : glHandle_(0), status_(Status::NOT_COMPILED), sourceHash_(0)
 {
 	if (patchLines.isEmpty())
 	{
@@ -82,6 +84,9 @@ void GLShader::loadFromString(const char *string)
 
 	const GLchar *source_lines[2] = { patchLines.data(), string };
 	glShaderSource(glHandle_, 2, source_lines, nullptr);
+
+	sourceHash_ = nctl::fasthash64(patchLines.data(), patchLines.length(), 0);
+	sourceHash_ = nctl::fasthash64(string, strlen(string), sourceHash_);
 }
 
 void GLShader::loadFromFile(const char *filename)
@@ -100,6 +105,9 @@ void GLShader::loadFromFile(const char *filename)
 		const GLint lengths[2] = { static_cast<GLint>(patchLines.length()), length };
 		glShaderSource(glHandle_, 2, source_lines, lengths);
 
+		sourceHash_ = nctl::fasthash64(patchLines.data(), patchLines.length(), 0);
+		sourceHash_ = nctl::fasthash64(source.data(), static_cast<size_t>(length), sourceHash_);
+
 		setObjectLabel(filename);
 	}
 }
@@ -1,11 +1,19 @@
 #include <nctl/StaticHashMapIterator.h>
+#include <nctl/HashFunctions.h>
 #include "GLShaderProgram.h"
 #include "GLShader.h"
 #include "GLDebug.h"
+#include "BinaryShaderCache.h"
+#include "GLShaderProgramQueue.h"
 #include "RenderResources.h"
 #include "RenderVaoPool.h"
+#include "ServiceLocator.h"
 #include "tracy.h"
 
+#ifndef GL_COMPLETION_STATUS_KHR
+	#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
 namespace ncine {
 
 ///////////////////////////////////////////////////////////
@@ -26,8 +34,8 @@ GLShaderProgram::GLShaderProgram()
 
 GLShaderProgram::GLShaderProgram(QueryPhase queryPhase)
     : glHandle_(0), attachedShaders_(AttachedShadersInitialSize),
-      status_(Status::NOT_LINKED), queryPhase_(queryPhase), shouldLogOnErrors_(true),
-      uniformsSize_(0), uniformBlocksSize_(0), uniforms_(UniformsInitialSize),
+      queryPhase_(queryPhase), shouldLogOnErrors_(true),
+      binaryHash_(0), uniformsSize_(0), uniformBlocksSize_(0), uniforms_(UniformsInitialSize),
       uniformBlocks_(UniformBlocksInitialSize), attributes_(AttributesInitialSize)
 {
 	glHandle_ = glCreateProgram();
@@ -55,6 +63,9 @@ GLShaderProgram::GLShaderProgram(const char *vertexFile, const char *fragmentFil
 
 GLShaderProgram::~GLShaderProgram()
 {
+	// Deferred queries can move a program out of the `LINKING` status before the queue polls it
+	RenderResources::shaderProgramQueue().remove(this);
+
 	if (boundProgram_ == glHandle_)
 		glUseProgram(0);
 
@@ -69,9 +80,22 @@ GLShaderProgram::~GLShaderProgram()
 
 bool GLShaderProgram::isLinked() const
 {
-	return (status_ == Status::LINKED ||
-	        status_ == Status::LINKED_WITH_DEFERRED_QUERIES ||
-	        status_ == Status::LINKED_WITH_INTROSPECTION);
+	return status_.isLinked();
+}
+
+bool GLShaderProgram::checkLinkCompletion()
+{
+	if (status_.value() == Status::LINKING)
+	{
+		GLint completionStatus = GL_FALSE;
+		glGetProgramiv(glHandle_, GL_COMPLETION_STATUS_KHR, &completionStatus);
+		if (completionStatus == GL_FALSE)
+			return false;
+
+		status_.completeLink();
+	}
+
+	return (status_.value() != Status::NOT_LINKED);
 }
 
 unsigned int GLShaderProgram::retrieveInfoLogLength() const
@@ -100,10 +124,7 @@ bool GLShaderProgram::attachShader(GLenum type, const char *filename)
 	nctl::UniquePtr<GLShader> shader = nctl::makeUnique<GLShader>(type, filename);
 	glAttachShader(glHandle_, shader->glHandle());
 
-	const GLShader::ErrorChecking errorChecking = (queryPhase_ == GLShaderProgram::QueryPhase::IMMEDIATE)
-	                                                  ? GLShader::ErrorChecking::IMMEDIATE
-	                                                  : GLShader::ErrorChecking::DEFERRED;
-	const bool hasCompiled = shader->compile(errorChecking, shouldLogOnErrors_);
+	const bool hasCompiled = compileShader(type, *shader);
 
 	if (hasCompiled)
 	{
@@ -111,7 +132,7 @@ bool GLShaderProgram::attachShader(GLenum type, const char *filename)
 		attachedShaders_.pushBack(nctl::move(shader));
 	}
 	else
-		status_ = Status::COMPILATION_FAILED;
+		status_.failCompilation();
 
 	return hasCompiled;
 }
@@ -122,15 +143,12 @@ bool GLShaderProgram::attachShaderFromString(GLenum type, const char *string)
 	shader->loadFromString(string);
 	glAttachShader(glHandle_, shader->glHandle());
 
-	const GLShader::ErrorChecking errorChecking = (queryPhase_ == GLShaderProgram::QueryPhase::IMMEDIATE)
-	                                                  ? GLShader::ErrorChecking::IMMEDIATE
-	                                                  : GLShader::ErrorChecking::DEFERRED;
-	const bool hasCompiled = shader->compile(errorChecking, shouldLogOnErrors_);
+	const bool hasCompiled = compileShader(type, *shader);
 
 	if (hasCompiled)
 		attachedShaders_.pushBack(nctl::move(shader));
 	else
-		status_ = Status::COMPILATION_FAILED;
+		status_.failCompilation();
 
 	return hasCompiled;
 }
@@ -138,13 +156,38 @@ bool GLShaderProgram::attachShaderFromString(GLenum type, const char *string)
 bool GLShaderProgram::link(Introspection introspection)
 {
 	introspection_ = introspection;
-	glLinkProgram(glHandle_);
+	// A shader that failed to compile has not been attached, linking without it would hide the error
+	if (status_.value() == Status::COMPILATION_FAILED)
+		return false;
+
+	if (loadBinary() == false)
+	{
+		// Compiling the shaders whose compilation has been postponed to find the program binary in the cache
+		const GLShader::ErrorChecking errorChecking = (queryPhase_ == GLShaderProgram::QueryPhase::IMMEDIATE)
+		                                                  ? GLShader::ErrorChecking::IMMEDIATE
+		                                                  : GLShader::ErrorChecking::DEFERRED;
+		for (nctl::UniquePtr<GLShader> &shader : attachedShaders_)
+		{
+			if (shader->status() == GLShader::Status::NOT_COMPILED && shader->compile(errorChecking, shouldLogOnErrors_) == false)
+			{
+				status_.failCompilation();
+				return false;
+			}
+		}
+
+#if !defined(__EMSCRIPTEN__)
+		if (binaryHash_ != 0)
+			glProgramParameteri(glHandle_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+		glLinkProgram(glHandle_);
+	}
 
 	if (queryPhase_ == QueryPhase::IMMEDIATE)
 	{
 		const bool linkCheck = checkLinking();
 		if (linkCheck == false)
 			return false;
+		saveBinary();
 
 		// After linking, shader objects are not needed anymore
 		for (const nctl::UniquePtr<GLShader> &shader : attachedShaders_)
@@ -156,8 +199,9 @@ bool GLShaderProgram::link(Introspection introspection)
 	}
 	else
 	{
-		status_ = GLShaderProgram::Status::LINKED_WITH_DEFERRED_QUERIES;
-		return true;
+		// With parallel compilation the driver can be polled to know when the program is ready
+		const bool parallelCompile = theServiceLocator().gfxCapabilities().hasExtension(IGfxCapabilities::GLExtensions::KHR_PARALLEL_SHADER_COMPILE);
+		return status_.deferLink(parallelCompile);
 	}
 }
 
@@ -184,6 +228,7 @@ GLVertexFormat::Attribute *GLShaderProgram::attribute(const char *name)
 {
 	ASSERT(name);
 	GLVertexFormat::Attribute *vertexAttribute = nullptr;
+	deferredQueries();
 
 	int location = -1;
 	const bool attributeFound = attributeLocations_.contains(name, location);
@@ -211,8 +256,11 @@ void GLShaderProgram::defineVertexFormat(const GLBufferObject *vbo, const GLBuff
 
 void GLShaderProgram::reset()
 {
-	if (status_ != Status::NOT_LINKED && status_ != Status::COMPILATION_FAILED)
+	// Shaders that failed to compile or are waiting to be compiled at link time are still attached
+	if (status_.value() != Status::NOT_LINKED || attachedShaders_.isEmpty() == false)
 	{
+		RenderResources::shaderProgramQueue().remove(this);
+
 		uniforms_.clear();
 		uniformBlocks_.clear();
 		attributes_.clear();
@@ -235,7 +283,8 @@ void GLShaderProgram::reset()
 		glHandle_ = glCreateProgram();
 	}
 
-	status_ = Status::NOT_LINKED;
+	status_.reset();
+	binaryHash_ = 0;
 }
 
 void GLShaderProgram::setObjectLabel(const char *label)
@@ -247,20 +296,68 @@ void GLShaderProgram::setObjectLabel(const char *label)
 // PRIVATE FUNCTIONS
 ///////////////////////////////////////////////////////////
 
+bool GLShaderProgram::compileShader(GLenum type, GLShader &shader)
+{
+	const BinaryShaderCache *binaryCache = RenderResources::binaryShaderCache();
+	if (binaryCache != nullptr && binaryCache->isAvailable() && shader.sourceHash() != 0)
+	{
+		// Compilation is postponed to linking time, as the program binary might be found in the cache
+		const uint64_t typeAndSource[2] = { static_cast<uint64_t>(type), shader.sourceHash() };
+		binaryHash_ = nctl::fasthash64(typeAndSource, sizeof(typeAndSource), binaryHash_);
+		return true;
+	}
+
+	const GLShader::ErrorChecking errorChecking = (queryPhase_ == GLShaderProgram::QueryPhase::IMMEDIATE)
+	                                                  ? GLShader::ErrorChecking::IMMEDIATE
+	                                                  : GLShader::ErrorChecking::DEFERRED;
+	return shader.compile(errorChecking, shouldLogOnErrors_);
+}
+
+bool GLShaderProgram::loadBinary()
+{
+	BinaryShaderCache *binaryCache = RenderResources::binaryShaderCache();
+	if (binaryHash_ == 0 || binaryCache == nullptr || status_.value() == Status::COMPILATION_FAILED)
+		return false;
+
+	const bool hasLoaded = binaryCache->loadFromCache(binaryHash_, glHandle_);
+	if (hasLoaded)
+	{
+		// The program is already linked, the attached shaders have never been compiled and are not needed
+		for (const nctl::UniquePtr<GLShader> &shader : attachedShaders_)
+			glDetachShader(glHandle_, shader->glHandle());
+		attachedShaders_.clear();
+		binaryHash_ = 0;
+	}
+
+	return hasLoaded;
+}
+
+void GLShaderProgram::saveBinary()
+{
+	BinaryShaderCache *binaryCache = RenderResources::binaryShaderCache();
+	if (binaryHash_ != 0 && binaryCache != nullptr)
+		binaryCache->saveToCache(binaryHash_, glHandle_);
+	binaryHash_ = 0;
+}
+
 bool GLShaderProgram::deferredQueries()
 {
-	if (status_ == GLShaderProgram::Status::LINKED_WITH_DEFERRED_QUERIES)
+	if (status_.hasDeferredQueries())
 	{
 		for (nctl::UniquePtr<GLShader> &attachedShader : attachedShaders_)
 		{
 			const bool compileCheck = attachedShader->checkCompilation(shouldLogOnErrors_);
 			if (compileCheck == false)
+			{
+				status_.failCompilation();
 				return false;
+			}
 		}
 
 		const bool linkCheck = checkLinking();
 		if (linkCheck == false)
 			return false;
+		saveBinary();
 
 		// After linking, shader objects are not needed anymore
 		for (const nctl::UniquePtr<GLShader> &shader : attachedShaders_)
@@ -274,7 +371,7 @@ bool GLShaderProgram::deferredQueries()
 
 bool GLShaderProgram::checkLinking()
 {
-	if (status_ == Status::LINKED || status_ == Status::LINKED_WITH_INTROSPECTION)
+	if (status_.value() == Status::LINKED || status_.value() == Status::LINKED_WITH_INTROSPECTION)
 		return true;
 
 	GLint status;
@@ -293,17 +390,17 @@ bool GLShaderProgram::checkLinking()
 			}
 		}
 
-		status_ = Status::LINKING_FAILED;
+		status_.checkLink(false);
 		return false;
 	}
 
-	status_ = Status::LINKED;
+	status_.checkLink(true);
 	return true;
 }
 
 void GLShaderProgram::performIntrospection()
 {
-	if (introspection_ != Introspection::DISABLED && status_ != Status::LINKED_WITH_INTROSPECTION)
+	if (introspection_ != Introspection::DISABLED && status_.value() != Status::LINKED_WITH_INTROSPECTION)
 	{
 		const GLUniformBlock::DiscoverUniforms discover = (introspection_ == Introspection::NO_UNIFORMS_IN_BLOCKS)
 		                                                      ? GLUniformBlock::DiscoverUniforms::DISABLED
@@ -313,7 +410,7 @@ void GLShaderProgram::performIntrospection()
 		discoverUniformBlocks(discover);
 		discoverAttributes();
 		initVertexFormat();
-		status_ = Status::LINKED_WITH_INTROSPECTION;
+		status_.completeIntrospection();
 	}
 }
 
@@ -0,0 +1,60 @@
+#include "common_macros.h"
+#include "GLShaderProgramQueue.h"
+#include "tracy.h"
+
+namespace ncine {
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+GLShaderProgramQueue::GLShaderProgramQueue()
+    : pending_(PendingInitialSize)
+{
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool GLShaderProgramQueue::submit(GLShaderProgram &program, GLShaderProgram::Introspection introspection)
+{
+	const bool hasLinked = program.link(introspection);
+	if (program.status() == GLShaderProgram::Status::LINKING)
+		pending_.pushBack(&program);
+
+	return hasLinked;
+}
+
+bool GLShaderProgramQueue::remove(const GLShaderProgram *program)
+{
+	for (unsigned int i = 0; i < pending_.size(); i++)
+	{
+		if (pending_[i] == program)
+		{
+			pending_.unorderedRemoveAt(i);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+unsigned int GLShaderProgramQueue::poll()
+{
+	ZoneScoped;
+	// Iterating backwards as completed programs are removed by swapping them with the last one
+	for (int i = static_cast<int>(pending_.size()) - 1; i >= 0; i--)
+	{
+		GLShaderProgram *program = pending_[i];
+		if (program->checkLinkCompletion())
+		{
+			program->deferredQueries();
+			pending_.unorderedRemoveAt(static_cast<unsigned int>(i));
+		}
+	}
+
+	return pending_.size();
+}
+
+}
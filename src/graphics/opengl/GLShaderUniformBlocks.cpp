@@ -1,6 +1,7 @@
 #include "GLShaderUniformBlocks.h"
 #include "GLShaderProgram.h"
 #include "RenderResources.h"
+#include "RenderStatistics.h"
 #include <nctl/StaticHashMapIterator.h>
 #include <nctl/CString.h>
 #include <cstring> // for memcpy()
@@ -12,7 +13,7 @@ namespace ncine {
 ///////////////////////////////////////////////////////////
 
 GLShaderUniformBlocks::GLShaderUniformBlocks()
-    : shaderProgram_(nullptr), dataPointer_(nullptr)
+    : shaderProgram_(nullptr), dataPointer_(nullptr), dataInUniformBuffer_(false)
 {
 }
 
@@ -39,7 +40,9 @@ void GLShaderUniformBlocks::bind()
 		for (GLUniformBlockCache &uniformBlockCache : uniformBlockCaches_)
 		{
 			uniformBlockCache.setBlockBinding(uniformBlockCache.index());
-			const GLintptr offset = static_cast<GLintptr>(uboParams_.offset) + moreOffset;
+			const GLintptr offset = dataInUniformBuffer_
+			                            ? static_cast<GLintptr>(uniformBlockCache.dataPointer() - uboParams_.mapBase)
+			                            : static_cast<GLintptr>(uboParams_.offset) + moreOffset;
 			ASSERT(offset % offsetAlignment == 0);
 			uboParams_.object->bindBufferRange(uniformBlockCache.bindingIndex(), offset, uniformBlockCache.usedSize());
 			moreOffset += uniformBlockCache.usedSize();
@@ -71,6 +74,7 @@ void GLShaderUniformBlocks::setUniformsDataPointer(GLubyte *dataPointer)
 		return;
 
 	dataPointer_ = dataPointer;
+	dataInUniformBuffer_ = false;
 	int offset = 0;
 	for (GLUniformBlockCache &uniformBlockCache : uniformBlockCaches_)
 	{
@@ -79,6 +83,19 @@ void GLShaderUniformBlocks::setUniformsDataPointer(GLubyte *dataPointer)
 	}
 }
 
+void GLShaderUniformBlocks::setUniformBufferParameters(const RenderBuffersManager::Parameters &uboParams)
+{
+	ASSERT(uboParams.object);
+	ASSERT(uboParams.mapBase);
+
+	if (shaderProgram_->status() != GLShaderProgram::Status::LINKED_WITH_INTROSPECTION)
+		return;
+
+	uboParams_ = uboParams;
+	dataPointer_ = uboParams.mapBase + uboParams.offset;
+	dataInUniformBuffer_ = true;
+}
+
 GLUniformBlockCache *GLShaderUniformBlocks::uniformBlock(const char *name)
 {
 	ASSERT(name);
@@ -96,6 +113,10 @@ void GLShaderUniformBlocks::commitUniformBlocks()
 {
 	if (shaderProgram_)
 	{
+		// Block data has already been written in place, there is nothing to copy
+		if (dataInUniformBuffer_)
+			return;
+
 		if (shaderProgram_->status() == GLShaderProgram::Status::LINKED_WITH_INTROSPECTION)
 		{
 			int totalUsedSize = 0;
@@ -125,6 +146,7 @@ void GLShaderUniformBlocks::commitUniformBlocks()
 					}
 					else
 						memcpy(uboParams_.mapBase + uboParams_.offset, dataPointer_, totalUsedSize);
+					RenderStatistics::addCommittedUniformBytes(totalUsedSize);
 				}
 			}
 		}
@@ -0,0 +1,77 @@
+#ifndef CLASS_NCINE_BINARYSHADERCACHE
+#define CLASS_NCINE_BINARYSHADERCACHE
+
+#include <cstdint> // for uint64_t
+#define NCINE_INCLUDE_OPENGL
+#include "common_headers.h"
+
+#include <nctl/String.h>
+
+namespace ncine {
+
+/// A class that stores linked shader program binaries on disk to avoid compiling them again
+/*! Binaries are retrieved with `glGetProgramBinary()` and stored in the save path, named after
+ *  a hash of the shader sources. A cached binary is ignored and deleted if it was created by
+ *  a different driver or if the driver rejects it, the shaders are then compiled as usual. */
+class BinaryShaderCache
+{
+  public:
+	/// Cache usage statistics since the application started
+	struct Statistics
+	{
+		/// Number of programs loaded from a cached binary
+		unsigned int loaded = 0;
+		/// Number of programs that were not found in the cache
+		unsigned int missed = 0;
+		/// Number of cached binaries rejected by the driver or by the header checks
+		unsigned int rejected = 0;
+		/// Number of program binaries saved in the cache
+		unsigned int saved = 0;
+	};
+
+	explicit BinaryShaderCache(bool enable);
+
+	/// Returns true if the cache is enabled and the driver supports program binaries
+	inline bool isAvailable() const { return isAvailable_; }
+	/// Returns the directory where the program binaries are stored
+	inline const nctl::String &directory() const { return directory_; }
+	/// Returns the cache usage statistics
+	inline const Statistics &statistics() const { return statistics_; }
+	/// Returns true if all the programs requested until now have been loaded from the cache
+	inline bool isWarm() const { return (statistics_.loaded > 0 && statistics_.missed == 0 && statistics_.rejected == 0); }
+
+	/// Tries to load the binary associated with the hash into the program, returns true if the program is linked
+	bool loadFromCache(uint64_t hash, GLuint program);
+	/// Retrieves the binary of a linked program and saves it in the cache
+	bool saveToCache(uint64_t hash, GLuint program);
+	/// Deletes all program binaries from the cache, returns the number of deleted files
+	unsigned int clear();
+
+  private:
+	/// The header written at the beginning of every cached binary file
+	struct Header
+	{
+		uint32_t signature;
+		uint32_t version;
+		uint64_t driverHash;
+		uint32_t format;
+		uint32_t length;
+	};
+
+	bool isAvailable_;
+	/// A hash of the OpenGL vendor, renderer and version strings
+	uint64_t driverHash_;
+	nctl::String directory_;
+	Statistics statistics_;
+
+	nctl::String filename(uint64_t hash) const;
+
+	/// Deleted copy constructor
+	BinaryShaderCache(const BinaryShaderCache &) = delete;
+	/// Deleted assignment operator
+	BinaryShaderCache &operator=(const BinaryShaderCache &) = delete;
+};
+
+}
+
+#endif
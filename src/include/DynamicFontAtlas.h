@@ -0,0 +1,160 @@
+#ifndef CLASS_NCINE_DYNAMICFONTATLAS
+#define CLASS_NCINE_DYNAMICFONTATLAS
+
+#include <cstdint>
+#include <nctl/Array.h>
+#include <nctl/HashMap.h>
+#include <nctl/UniquePtr.h>
+#include "FontGlyph.h"
+
+namespace ncine {
+
+class Texture;
+
+/// A fixed size texture atlas where the glyphs of a TrueType font are rasterised when first requested
+/*! Glyphs are packed in horizontal shelves. When the atlas is full, the least recently used shelf is evicted
+ *  and its glyphs are rasterised again if requested later. Shelves used in the current frame are never evicted.
+ *  \note TrueType rasterisation is provided by the `imstb_truetype` library vendored with Dear ImGui */
+class DynamicFontAtlas
+{
+  public:
+	/// Default side in pixels of the square atlas texture
+	static const unsigned int DefaultSize = 1024;
+	/// The shelf tag returned for glyphs without pixels, like the space character
+	static const uint64_t NoShelfTag = 0xFFFFFFFFFFFFFFFFULL;
+	/// The shelf tag returned for glyphs that found no space in the current frame, touching it fails from the next one
+	static const uint64_t RetryShelfTag = 0xFFFFFFFFFFFFFFFEULL;
+
+	/// Returns true if TrueType rasterisation has been compiled in
+	static bool isAvailable();
+
+	DynamicFontAtlas();
+	~DynamicFontAtlas();
+
+	/// Loads a TrueType font from a memory buffer, the buffer is copied
+	bool loadFromMemory(const char *bufferName, const unsigned char *bufferPtr, unsigned long int bufferSize, unsigned int pixelHeight, unsigned int size);
+	/// Loads a TrueType font from a file
+	bool loadFromFile(const char *filename, unsigned int pixelHeight, unsigned int size);
+
+	/// Returns the atlas texture
+	inline Texture *texture() { return texture_.get(); }
+	/// Returns the side in pixels of the atlas texture
+	inline unsigned int size() const { return size_; }
+	/// Returns the line height in pixels
+	inline unsigned int lineHeight() const { return lineHeight_; }
+	/// Returns the distance in pixels from the top of the line to the baseline
+	inline unsigned int base() const { return base_; }
+	/// Returns the number of glyphs in the font file
+	inline unsigned int numFontGlyphs() const { return numFontGlyphs_; }
+	/// Returns the number of glyphs currently stored in the atlas
+	inline unsigned int numResidentGlyphs() const { return glyphIndices_.size(); }
+
+	/// Returns the glyph for a codepoint, rasterising it in the atlas if needed
+	/*! \note The pointer is valid until the next glyph request */
+	inline const FontGlyph *glyph(unsigned int codepoint) { return glyph(codepoint, nullptr); }
+	/// Returns the glyph for a codepoint, and the tag of the shelf where it is stored
+	/*! \note A glyph that cannot be stored is not rasterised again in the same frame, the `RetryShelfTag` is returned for it */
+	const FontGlyph *glyph(unsigned int codepoint, uint64_t *shelfTag);
+	/// Returns the kerning amount in pixels between two codepoints
+	int kerning(unsigned int first, unsigned int second) const;
+
+	/// Marks a shelf as used in the current frame, returns false if it has been evicted since the tag was retrieved
+	bool touchShelf(uint64_t shelfTag);
+
+  private:
+	static const unsigned int InvalidSlot = ~0U;
+	static const unsigned int NoShelf = ~0U;
+	/// Empty pixels around every glyph, so that linear filtering never samples a neighbour
+	static const unsigned int GlyphPadding = 1;
+	/// Shelf heights are rounded up to a multiple of this value to make them reusable by similar glyphs
+	static const unsigned int ShelfHeightStep = 4;
+	/// Minimum number of frames between two warnings about a full atlas
+	static const unsigned int FullWarningInterval = 300;
+
+	struct Shelf
+	{
+		unsigned int y;
+		unsigned int height;
+		/// The horizontal position where the next glyph will be packed
+		unsigned int nextX;
+		/// A new epoch is assigned every time the shelf is evicted, it invalidates the previous tags
+		unsigned int epoch;
+		unsigned long int lastUsedFrame;
+		/// Indices of the glyph slots packed in the shelf
+		nctl::Array<unsigned int> slots;
+
+		Shelf()
+		    : y(0), height(0), nextX(0), epoch(0), lastUsedFrame(0) {}
+	};
+
+	struct GlyphSlot
+	{
+		unsigned int codepoint;
+		unsigned int shelf;
+		FontGlyph glyph;
+
+		GlyphSlot()
+		    : codepoint(0), shelf(0) {}
+	};
+
+	/// The private TrueType font information
+	struct TrueTypeInfo;
+	nctl::UniquePtr<TrueTypeInfo> info_;
+	nctl::UniquePtr<unsigned char[]> fontData_;
+	nctl::UniquePtr<Texture> texture_;
+
+	unsigned int size_;
+	unsigned int pixelHeight_;
+	float scale_;
+	unsigned int lineHeight_;
+	unsigned int base_;
+	unsigned int numFontGlyphs_;
+
+	nctl::Array<Shelf> shelves_;
+	/// The vertical position where the next shelf will be opened
+	unsigned int nextShelfY_;
+	/// Epochs are never reused, so that a tag retrieved before a reload cannot match a new shelf
+	unsigned int nextEpoch_;
+
+	nctl::Array<GlyphSlot> slots_;
+	nctl::Array<unsigned int> freeSlots_;
+	/// Maps a codepoint to the index of its slot
+	nctl::HashMap<unsigned int, unsigned int> glyphIndices_;
+	/// A staging buffer for the rasterised glyph bitmap and its padding
+	nctl::Array<unsigned char> bitmap_;
+
+	/// Codepoints that found no space in the atlas during `failedFrame_`
+	nctl::Array<unsigned int> failedCodepoints_;
+	unsigned long int failedFrame_;
+	/// Number of glyphs that found no space since the last warning
+	unsigned int numFailures_;
+	/// The first frame when a new warning about a full atlas can be logged
+	unsigned long int nextWarningFrame_;
+
+	/// Returns the tag of a shelf, made of its current epoch in the high 32 bits and its index in the low ones
+	inline uint64_t shelfTag(unsigned int shelfIndex) const { return (uint64_t(shelves_[shelfIndex].epoch) << 32) | shelfIndex; }
+
+	/// Rasterises a glyph and uploads it to the atlas, returns the index of its slot or `InvalidSlot`
+	unsigned int rasterise(unsigned int codepoint);
+	/// Returns true if a glyph has already found no space in the current frame
+	bool hasFailed(unsigned int codepoint) const;
+	/// Remembers a glyph that found no space until the end of the frame and warns about it, at most once per interval
+	void addFailure(unsigned int codepoint);
+	/// Returns a shelf with enough space for a glyph of the specified size, evicting one if needed
+	int findShelf(unsigned int width, unsigned int height);
+	/// Removes all glyphs from a shelf and invalidates its tags
+	void evictShelf(unsigned int shelfIndex);
+	/// Removes all glyphs and shelves from the atlas
+	void clear();
+	/// Returns the index of a free glyph slot
+	unsigned int acquireSlot();
+
+	/// Deleted copy constructor
+	DynamicFontAtlas(const DynamicFontAtlas &) = delete;
+	/// Deleted assignment operator
+	DynamicFontAtlas &operator=(const DynamicFontAtlas &) = delete;
+};
+
+}
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef CLASS_NCINE_GLSHADER
 #define CLASS_NCINE_GLSHADER
 
+#include <cstdint> // for uint64_t
 #define NCINE_INCLUDE_OPENGL
 #include "common_headers.h"
 
@@ -30,6 +31,8 @@ class GLShader
 
 	inline GLuint glHandle() const { return glHandle_; }
 	inline Status status() const { return status_; }
+	/// Returns a hash of the shader source, patch lines included, or zero if no source has been loaded
+	inline uint64_t sourceHash() const { return sourceHash_; }
 
 	void loadFromString(const char *string);
 	void loadFromFile(const char *filename);
@@ -45,6 +48,7 @@ class GLShader
 
 	GLuint glHandle_;
 	Status status_;
+	uint64_t sourceHash_;
 
 	/// Deleted copy constructor
 	GLShader(const GLShader &) = delete;
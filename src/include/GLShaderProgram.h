@@ -9,6 +9,7 @@
 #include "GLUniformBlock.h"
 #include "GLAttribute.h"
 #include "GLVertexFormat.h"
+#include "ShaderProgramStatus.h"
 
 namespace ncine {
 
@@ -25,15 +26,7 @@ class GLShaderProgram
 		DISABLED
 	};
 
-	enum class Status
-	{
-		NOT_LINKED,
-		COMPILATION_FAILED,
-		LINKING_FAILED,
-		LINKED,
-		LINKED_WITH_DEFERRED_QUERIES,
-		LINKED_WITH_INTROSPECTION
-	};
+	using Status = ShaderProgramStatus::Status;
 
 	enum class QueryPhase
 	{
@@ -43,17 +36,22 @@ class GLShaderProgram
 
 	GLShaderProgram();
 	explicit GLShaderProgram(QueryPhase queryPhase);
+	/// Attaches the two shaders and links the program
+	/*! \note Compilation errors could only be found at link time, check `isLinked()` after construction */
 	GLShaderProgram(const char *vertexFile, const char *fragmentFile, Introspection introspection, QueryPhase queryPhase);
 	GLShaderProgram(const char *vertexFile, const char *fragmentFile, Introspection introspection);
 	GLShaderProgram(const char *vertexFile, const char *fragmentFile);
 	~GLShaderProgram();
 
 	inline GLuint glHandle() const { return glHandle_; }
-	inline Status status() const { return status_; }
+	inline Status status() const { return status_.value(); }
 	inline Introspection introspection() const { return introspection_; }
 	inline QueryPhase queryPhase() const { return queryPhase_; }
 
 	bool isLinked() const;
+	/// Returns true if the driver has completed the compilation and the link, without blocking
+	/*! \note A completed program moves from the `LINKING` status to `LINKED_WITH_DEFERRED_QUERIES` */
+	bool checkLinkCompletion();
 
 	/// Returns the length of the information log including the null termination character
 	unsigned int retrieveInfoLogLength() const;
@@ -65,8 +63,14 @@ class GLShaderProgram
 	/// Returns the total memory needed for all uniforms inside of blocks
 	inline unsigned int uniformBlocksSize() const { return uniformBlocksSize_; }
 
+	/// Attaches a shader to the program, returning false if it has failed to compile
+	/*! \note When the binary shader cache is available compilation is postponed to link time, as the program
+	 *  might be found in the cache. The function then always returns true and errors are reported by `link()` and `status()`. */
 	bool attachShader(GLenum type, const char *filename);
+	/// Attaches a shader from a string, with the same return value as `attachShader()`
 	bool attachShaderFromString(GLenum type, const char *string);
+	/// Links the program, returning false if an attached shader has failed to compile or the link has failed
+	/*! \note With deferred queries errors are only found when the program is first used, check `isLinked()` then */
 	bool link(Introspection introspection);
 	void use();
 	bool validate();
@@ -102,13 +106,17 @@ class GLShaderProgram
 	GLuint glHandle_;
 	static const int AttachedShadersInitialSize = 4;
 	nctl::Array<nctl::UniquePtr<GLShader>> attachedShaders_;
-	Status status_;
+	ShaderProgramStatus status_;
 	Introspection introspection_;
 	QueryPhase queryPhase_;
 
 	/// A flag indicating whether the shader program should automatically log errors (the information log)
 	bool shouldLogOnErrors_;
 
+	/// A hash of the attached shader sources used as the binary cache key
+	/*! \note The value is zero if the binary cache is not used or the binary has already been loaded or saved */
+	uint64_t binaryHash_;
+
 	unsigned int uniformsSize_;
 	unsigned int uniformBlocksSize_;
 
@@ -122,6 +130,10 @@ class GLShaderProgram
 	nctl::StaticHashMap<nctl::String, int, GLVertexFormat::MaxAttributes> attributeLocations_;
 	GLVertexFormat vertexFormat_;
 
+	bool compileShader(GLenum type, GLShader &shader);
+	bool loadBinary();
+	void saveBinary();
+
 	bool deferredQueries();
 	bool checkLinking();
 	void performIntrospection();
@@ -138,6 +150,7 @@ class GLShaderProgram
 
 	friend class GLShaderUniforms;
 	friend class GLShaderUniformBlocks;
+	friend class GLShaderProgramQueue;
 };
 
 }
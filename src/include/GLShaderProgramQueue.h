@@ -0,0 +1,44 @@
+#ifndef CLASS_NCINE_GLSHADERPROGRAMQUEUE
+#define CLASS_NCINE_GLSHADERPROGRAMQUEUE
+
+#include <nctl/Array.h>
+#include "GLShaderProgram.h"
+
+namespace ncine {
+
+/// A class to link shader programs in a batch and to poll them until they are ready to be used
+/*! Programs should use the deferred query phase, so that compilation and linking are only submitted to the driver.
+ *  When `GL_KHR_parallel_shader_compile` is available their completion can be polled without blocking,
+ *  otherwise they behave as usual and block on their first use. */
+class GLShaderProgramQueue
+{
+  public:
+	GLShaderProgramQueue();
+
+	/// Returns the number of programs whose link has not completed yet
+	inline unsigned int numPending() const { return pending_.size(); }
+	/// Returns true if no program is waiting for the link to complete
+	inline bool isEmpty() const { return pending_.isEmpty(); }
+
+	/// Links a program whose shaders have already been attached and tracks it until its link completes
+	/*! \return False if the link has already failed */
+	bool submit(GLShaderProgram &program, GLShaderProgram::Introspection introspection);
+	/// Stops tracking a program, to be called before deleting or resetting it
+	bool remove(const GLShaderProgram *program);
+	/// Performs the deferred queries of every program that has completed, without blocking
+	/*! \return The number of programs still linking */
+	unsigned int poll();
+
+  private:
+	static const unsigned int PendingInitialSize = 16;
+	nctl::Array<GLShaderProgram *> pending_;
+
+	/// Deleted copy constructor
+	GLShaderProgramQueue(const GLShaderProgramQueue &) = delete;
+	/// Deleted assignment operator
+	GLShaderProgramQueue &operator=(const GLShaderProgramQueue &) = delete;
+};
+
+}
+
+#endif
@@ -24,6 +24,9 @@ class GLShaderUniformBlocks
 	inline void setProgram(GLShaderProgram *shaderProgram) { setProgram(shaderProgram, nullptr, nullptr); }
 	void setProgram(GLShaderProgram *shaderProgram, const char *includeOnly, const char *exclude);
 	void setUniformsDataPointer(GLubyte *dataPointer);
+	/// Uses uniform blocks whose data pointers have already been set inside the specified uniform buffer range
+	/*! \note Nothing is copied when committing, every block is bound at the offset of its data pointer in the buffer */
+	void setUniformBufferParameters(const RenderBuffersManager::Parameters &uboParams);
 
 	inline unsigned int numUniformBlocks() const { return uniformBlockCaches_.size(); }
 	inline bool hasUniformBlock(const char *name) const { return (uniformBlockCaches_.find(name) != nullptr); }
@@ -40,6 +43,8 @@ class GLShaderUniformBlocks
 
 	/// Uniform buffer parameters for binding
 	RenderBuffersManager::Parameters uboParams_;
+	/// True if block data pointers point directly inside the uniform buffer range
+	bool dataInUniformBuffer_;
 
 	UniformHashMapType uniformBlockCaches_;
 
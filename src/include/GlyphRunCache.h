@@ -0,0 +1,106 @@
+#ifndef CLASS_NCINE_GLYPHRUNCACHE
+#define CLASS_NCINE_GLYPHRUNCACHE
+
+#include <cstdint>
+#include <nctl/Array.h>
+#include <nctl/HashMap.h>
+#include <nctl/String.h>
+#include <nctl/UniquePtr.h>
+#include "VertexKernels.h"
+
+namespace ncine {
+
+class Font;
+
+/// The glyph quads of a single line of text, laid out with a font
+/*! Quads are in line space, with the origin at the left of the line top, so that a run
+ *  can be shared by text nodes with different alignments and line heights. */
+class GlyphRun
+{
+  public:
+	GlyphRun();
+
+	/// Returns the text of the line
+	inline const nctl::String &text() const { return text_; }
+	/// Returns the horizontal advance of the whole line
+	inline float length() const { return length_; }
+	/// Returns a number that changes every time the run is laid out again
+	inline unsigned int version() const { return version_; }
+	/// Returns the number of glyph quads, glyphs without pixels have none
+	inline unsigned int numQuads() const { return quads_.size(); }
+	/// Returns the array of glyph quads
+	inline const VertexKernels::Quad *quads() const { return quads_.data(); }
+
+	/// Returns true if the run has been laid out for the specified line
+	bool matches(const Font *font, bool withKerning, const char *text, unsigned int length) const;
+	/// Keeps the atlas shelves of a dynamic font from being evicted, the run is laid out again if one of them already was
+	/*! Glyphs that found no space in a previous frame are requested again too.
+	 *  \note It returns true if the run has been laid out again */
+	bool touchAtlasShelves();
+
+  private:
+	const Font *font_;
+	unsigned int fontGeneration_;
+	bool withKerning_;
+	nctl::String text_;
+	uint64_t hash_;
+	float length_;
+	unsigned int version_;
+	unsigned int refCount_;
+	nctl::Array<VertexKernels::Quad> quads_;
+	/// The tags of the dynamic font atlas shelves holding the glyphs of the run
+	nctl::Array<uint64_t> shelfTags_;
+	/// The next run in the same bucket of the cache
+	GlyphRun *nextInBucket_;
+
+	/// Decodes the text and lays out its glyphs
+	void layout();
+
+	/// Deleted copy constructor
+	GlyphRun(const GlyphRun &) = delete;
+	/// Deleted assignment operator
+	GlyphRun &operator=(const GlyphRun &) = delete;
+
+	friend class GlyphRunCache;
+};
+
+/// A cache that shares the glyph runs of identical lines of text between text nodes
+/*! Runs are reference counted, a run is recycled as soon as no text node uses it anymore. */
+class GlyphRunCache
+{
+  public:
+	GlyphRunCache();
+	~GlyphRunCache();
+
+	/// Returns the number of runs in use
+	inline unsigned int numRuns() const { return numRuns_; }
+	/// Returns the number of times a run in use has been shared instead of laid out
+	inline unsigned long int numShared() const { return numShared_; }
+	/// Returns the number of runs that have been laid out
+	inline unsigned long int numLayouts() const { return numLayouts_; }
+
+	/// Returns a run for a line of text, laying it out only if no text node is using the same one
+	GlyphRun *acquire(const Font *font, bool withKerning, const char *text, unsigned int length);
+	/// Releases a run previously acquired
+	void release(GlyphRun *run);
+
+  private:
+	/// Maximum number of unused runs kept to avoid allocations
+	static const unsigned int MaxFreeRuns = 64;
+
+	/// Maps a hash of the font and of the text to the first run of a bucket
+	nctl::HashMap<uint64_t, GlyphRun *> buckets_;
+	nctl::Array<nctl::UniquePtr<GlyphRun>> freeRuns_;
+	unsigned int numRuns_;
+	unsigned long int numShared_;
+	unsigned long int numLayouts_;
+
+	/// Deleted copy constructor
+	GlyphRunCache(const GlyphRunCache &) = delete;
+	/// Deleted assignment operator
+	GlyphRunCache &operator=(const GlyphRunCache &) = delete;
+};
+
+}
+
+#endif
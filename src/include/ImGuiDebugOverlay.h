@@ -56,7 +56,7 @@ class ImGuiDebugOverlay : public IDebugOverlay
 			TOTAL_VERTICES,
 #ifdef WITH_LUA
 			LUA_USED,
-			LUA_OPERATIONS,
+			LUA_SCRIPT_TIME,
 #endif
 			COUNT
 		};
@@ -30,6 +30,7 @@ class LuaAnimatedSprite
 
 	static int frame(lua_State *L);
 	static int setFrame(lua_State *L);
+	static int setFrames(lua_State *L);
 };
 
 }
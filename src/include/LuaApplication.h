@@ -25,6 +25,12 @@ class LuaApplication
 	static int screenViewport(lua_State *L);
 	static int interval(lua_State *L);
 	static int numFrames(lua_State *L);
+	static int numFixedUpdates(lua_State *L);
+	static int interpolationFactor(lua_State *L);
+
+	static int frameStatistics(lua_State *L);
+	static int saveFrameStatistics(lua_State *L);
+	static int resetFrameStatistics(lua_State *L);
 
 	static int width(lua_State *L);
 	static int height(lua_State *L);
@@ -37,6 +43,7 @@ class LuaApplication
 	static int setAutoSuspension(lua_State *L);
 
 	static int quit(lua_State *L);
+	static int refreshCallbacks(lua_State *L);
 };
 
 }
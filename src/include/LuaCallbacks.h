@@ -0,0 +1,109 @@
+#ifndef CLASS_NCINE_LUACALLBACKS
+#define CLASS_NCINE_LUACALLBACKS
+
+struct lua_State;
+
+namespace ncine {
+
+/// Caches registry references to the script callbacks and to the tables used to pass events to them
+/*! Every callback is looked up in the `ncine` table only the first time it is called after a script has been loaded.
+ *  Event tables are created once and their fields are overwritten for every new event of the same kind. */
+class LuaCallbacks
+{
+  public:
+	/// The functions that the engine calls in the `ncine` table
+	struct Callback
+	{
+		enum Enum
+		{
+			ON_PRE_INIT,
+			ON_INIT,
+			ON_FRAME_START,
+			ON_FIXED_UPDATE,
+			ON_POST_UPDATE,
+			ON_DRAW_VIEWPORT,
+			ON_FRAME_END,
+			ON_RESIZE_WINDOW,
+			ON_SHUTDOWN,
+			ON_SUSPEND,
+			ON_RESUME,
+
+			ON_KEY_PRESSED,
+			ON_KEY_RELEASED,
+			ON_TEXT_INPUT,
+			ON_TOUCH_DOWN,
+			ON_TOUCH_UP,
+			ON_TOUCH_MOVE,
+			ON_POINTER_DOWN,
+			ON_POINTER_UP,
+			ON_ACCELERATION,
+			ON_MOUSE_BUTTON_PRESSED,
+			ON_MOUSE_BUTTON_RELEASED,
+			ON_MOUSE_MOVED,
+			ON_SCROLL_INPUT,
+			ON_JOY_BUTTON_PRESSED,
+			ON_JOY_BUTTON_RELEASED,
+			ON_JOY_HAT_MOVED,
+			ON_JOY_AXIS_MOVED,
+			ON_JOYMAPPED_BUTTON_PRESSED,
+			ON_JOYMAPPED_BUTTON_RELEASED,
+			ON_JOYMAPPED_AXIS_MOVED,
+			ON_JOY_CONNECTED,
+			ON_JOY_DISCONNECTED,
+			ON_QUIT_REQUEST,
+
+			COUNT
+		};
+	};
+
+	/// The kinds of event tables passed to the callbacks
+	struct EventTable
+	{
+		enum Enum
+		{
+			KEYBOARD,
+			TEXT_INPUT,
+			TOUCH,
+			ACCELEROMETER,
+			MOUSE,
+			MOUSE_STATE,
+			SCROLL,
+			JOY_BUTTON,
+			JOY_HAT,
+			JOY_AXIS,
+			JOY_MAPPED_BUTTON,
+			JOY_MAPPED_AXIS,
+			JOY_CONNECTION,
+
+			COUNT
+		};
+	};
+
+	LuaCallbacks();
+
+	/// Pushes a function of the `ncine` table and returns true, or pushes nothing and returns false if it is not defined
+	static bool pushFunction(lua_State *L, Callback::Enum callback, const char *name);
+	/// Pushes the table reused for every event of the specified kind
+	/*! \note Scripts should copy the fields they want to keep, as the table will be overwritten by the next event */
+	static void pushEventTable(lua_State *L, EventTable::Enum table, int numFields);
+
+	/// Releases the function references, they will be looked up again the next time they are called
+	void refreshFunctions(lua_State *L);
+	/// Releases all references
+	void release(lua_State *L);
+	/// Forgets all references without releasing them, when the state they belong to has been closed
+	void reset();
+
+  private:
+	int functionRefs_[Callback::COUNT];
+	int tableRefs_[EventTable::COUNT];
+
+	/// Deleted copy constructor
+	LuaCallbacks(const LuaCallbacks &) = delete;
+	/// Deleted assignment operator
+	LuaCallbacks &operator=(const LuaCallbacks &) = delete;
+};
+
+}
+
+#endif
@@ -54,28 +54,27 @@ void LuaClassTracker<T>::newObject(lua_State *L, Args &&... args)
 template <class T>
 int LuaClassTracker<T>::deleteObject(lua_State *L)
 {
-	void *pointer = nullptr;
+	LuaHandleTable::Handle handle = LuaHandleTable::InvalidHandle;
 
-	if (lua_isuserdata(L, -1))
-		pointer = lua_touserdata(L, -1);
+	if (lua_islightuserdata(L, -1))
+		handle = LuaHandleTable::toHandle(lua_touserdata(L, -1));
+
+	LuaHandleTable &handles = LuaStateManager::manager(L)->handles();
+	LuaTypes::UserDataType type = LuaTypes::UNKNOWN;
+	void *pointer = handles.object(handle, type);
 
 	if (pointer != nullptr)
 	{
 		T *object = reinterpret_cast<T *>(pointer);
 
-		LuaStateManager *stateManager = LuaStateManager::manager(L);
-
-		// A tracked object might also end up among untracked data
-		stateManager->untrackedUserDatas().remove(pointer);
-
-		const LuaTypes::UserDataType type = stateManager->trackedType(pointer);
 		ASSERT(type == LuaTypes::classToUserDataType(object));
-		const bool isTracked = (stateManager->trackedUserDatas().find(pointer) != nullptr);
+		const bool isTracked = handles.isTracked(handle);
 		ASSERT(isTracked == true);
 
+		// The handle of an untracked object is invalidated but the object is not deleted
+		handles.remove(handle);
 		if (isTracked)
 		{
-			stateManager->trackedUserDatas().remove(pointer);
 #if !NCINE_WITH_ALLOCATORS
 			delete object;
 #else
@@ -105,14 +104,10 @@ void LuaClassTracker<T>::storeTrackedUserData(lua_State *L, T *object)
 {
 	FATAL_ASSERT(object != nullptr);
 
-	LuaStateManager *stateManager = LuaStateManager::manager(L);
-
-	nctl::HashMap<void *, LuaTypes::UserDataType> &hashMap = stateManager->trackedUserDatas();
-	if (hashMap.loadFactor() >= 0.8f)
-		hashMap.rehash(hashMap.capacity() * 2);
-	hashMap.insert(object, LuaTypes::classToUserDataType(object));
+	LuaHandleTable &handles = LuaStateManager::manager(L)->handles();
+	const LuaHandleTable::Handle handle = handles.add(object, LuaTypes::classToUserDataType(object), LuaHandleTable::Tracking::TRACKED);
 
-	lua_pushlightuserdata(L, reinterpret_cast<void *>(object));
+	lua_pushlightuserdata(L, LuaHandleTable::toUserData(handle));
 }
 
 }
@@ -17,6 +17,7 @@ class LuaEventHandler :
 	void onPreInit(AppConfiguration &config) override;
 	void onInit() override;
 	void onFrameStart() override;
+	void onFixedUpdate(float timeStep) override;
 	void onPostUpdate() override;
 	void onDrawViewport(Viewport &viewport) override;
 	void onFrameEnd() override;
@@ -17,6 +17,8 @@ class LuaMouseEvents
 
 	static void pushMouseEvent(lua_State *L, const MouseEvent &event);
 	static void pushMouseState(lua_State *L, const MouseState &state);
+	static void pushMouseState(lua_State *L, const MouseState &state, int outIndex);
+	static void pushMouseStateEvent(lua_State *L, const MouseState &state);
 	static void pushScrollEvent(lua_State *L, const ScrollEvent &event);
 };
 
@@ -42,10 +42,12 @@ class LuaSceneNode
 	static int setEnabled(lua_State *L);
 
 	static int position(lua_State *L);
+	static int positionXY(lua_State *L);
 	static int setPosition(lua_State *L);
 	static int absAnchorPoint(lua_State *L);
 	static int setAbsAnchorPoint(lua_State *L);
 	static int scale(lua_State *L);
+	static int scaleXY(lua_State *L);
 	static int setScaleX(lua_State *L);
 	static int setScaleY(lua_State *L);
 	static int setScale(lua_State *L);
@@ -53,6 +55,7 @@ class LuaSceneNode
 	static int setRotation(lua_State *L);
 
 	static int color(lua_State *L);
+	static int colorRGBA(lua_State *L);
 	static int setColor(lua_State *L);
 	static int alpha(lua_State *L);
 	static int setAlpha(lua_State *L);
@@ -62,6 +65,12 @@ class LuaSceneNode
 
 	static int lastFrameUpdated(lua_State *L);
 
+	static int positions(lua_State *L);
+	static int setPositions(lua_State *L);
+	static int setScales(lua_State *L);
+	static int setRotations(lua_State *L);
+	static int setColors(lua_State *L);
+
 	friend class LuaDrawableNode;
 	friend class LuaParticleSystem;
 };
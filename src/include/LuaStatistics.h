@@ -25,25 +25,26 @@ class LuaStatistics
 	static inline unsigned int numTrackedUserDatas() { return numTrackedUserDatas_; }
 	static inline unsigned int numTypedUserDatas(LuaTypes::UserDataType type) { return numTypedUserDatas_[type]; }
 	static inline size_t usedMemory() { return usedMemory_; }
-	static inline int operations() { return operations_[(index_ + 1) % 2]; }
+	/// Returns the number of states with a running profiler
+	static inline unsigned int numProfiling() { return numProfiling_; }
+	/// Returns the fraction of time spent running scripts in the last second, as estimated by the running profilers
+	static inline float scriptLoad() { return scriptLoad_; }
 
   private:
-	static const int OperationsCount = 1000;
-
 	static nctl::Array<LuaStateManager *> managers_;
 	static unsigned int numTrackedUserDatas_;
 	static unsigned int numTypedUserDatas_[LuaTypes::UserDataType::UNKNOWN + 1];
 	static size_t usedMemory_;
-	static TimeStamp lastOpsUpdateTime_;
-	static unsigned int index_;
-	static int operations_[2];
+	static unsigned int numProfiling_;
+	static float scriptLoad_;
+	static double lastSampledTime_;
+	static TimeStamp lastLoadUpdateTime_;
 
 	static void registerState(LuaStateManager *manager);
 	static void unregisterState(LuaStateManager *manager);
 
 	static inline void allocMemory(size_t bytes) { usedMemory_ += bytes; }
 	static inline void freeMemory(size_t bytes) { ASSERT(usedMemory_ >= bytes); usedMemory_ -= bytes; }
-	static void countOperations();
 
 	friend class LuaStateManager;
 };
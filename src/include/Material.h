@@ -96,6 +96,8 @@ class Material
 	void setDefaultAttributesParameters();
 	void reserveUniformsDataMemory();
 	void setUniformsDataPointer(GLubyte *dataPointer);
+	/// Sets the data pointer of uniforms only, uniform blocks already point inside the specified uniform buffer range
+	void setUniformsDataPointer(GLubyte *dataPointer, const RenderBuffersManager::Parameters &uboParams);
 
 	/// Wrapper around `GLShaderUniforms::hasUniform()`
 	inline bool hasUniform(const char *name) const { return shaderUniforms_.hasUniform(name); }
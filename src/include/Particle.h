@@ -35,6 +35,10 @@ class Particle : public Sprite
 	/// Returns true if the particle is still alive
 	inline bool isAlive() const { return life_ > 0.0f; }
 
+#if NCINE_WITH_ALLOCATORS
+	NCTL_DECLARE_SLAB_ALLOCATED()
+#endif
+
   protected:
 	/// Returns a copy of this object
 	/*! \note This method is protected as it should only be called by a `ParticleSystem` */
@@ -0,0 +1,137 @@
+#ifndef CLASS_NCINE_READBACKQUEUE
+#define CLASS_NCINE_READBACKQUEUE
+
+#define NCINE_INCLUDE_OPENGL
+#include "common_headers.h"
+#include <nctl/String.h>
+#include <nctl/UniquePtr.h>
+#include "Texture.h"
+#ifdef WITH_THREADS
+	#include <nctl/List.h>
+	#include "ThreadSync.h"
+#endif
+
+namespace ncine {
+
+class GLBufferObject;
+class GLFramebufferObject;
+class GLTexture;
+class IThreadCommand;
+class Thread;
+
+/// A class to read back pixels from the GPU without stalling, through a ring of pixel buffer objects
+/*! Every readback copies the pixels into a pixel buffer object and inserts a fence after the copy.
+ *  The queue is polled once per frame, readbacks whose fence has been signalled are mapped and then
+ *  either passed to a callback or encoded to a file by a dedicated thread.
+ *  Encoding does not use the thread pool, as the rendering waits for its commands every frame.
+ *  \note A readback cannot be started from the callback of another one */
+class ReadbackQueue
+{
+  public:
+	/// The number of pixel buffer objects in the ring
+	static const unsigned int NumBuffers = 4;
+	/// The number of frames after which a readback is waited for if its fence has not been signalled yet
+	static const unsigned int MaxFramesInFlight = 3;
+	/// The number of files waiting to be encoded after which a new one waits for the encoding thread
+	static const unsigned int MaxQueuedEncodes = 2;
+
+	/// The description of the pixels to read back and of what to do with them
+	struct Request
+	{
+		Request()
+		    : width(0), height(0), format(Texture::Format::RGBA8), callback(nullptr),
+		      userData(nullptr), filename(nullptr), verticalFlip(false) {}
+
+		int width;
+		int height;
+		Texture::Format format;
+		/// The function invoked on the main thread with the pixels, if the readback is not saved to a file
+		Texture::ReadbackCallback callback;
+		void *userData;
+		/// The name of the PNG or WebP file where to save the pixels
+		const char *filename;
+		bool verticalFlip;
+	};
+
+	ReadbackQueue();
+	~ReadbackQueue();
+
+	/// Returns the number of readbacks that have not completed yet
+	inline unsigned int numPending() const { return numPending_; }
+	/// Returns true if no readback is waiting to complete
+	inline bool isEmpty() const { return numPending_ == 0; }
+
+	/// Returns true if the extension of the file name is one of the image formats that can be saved
+	static bool isFileFormatSupported(const char *filename);
+
+	/// Starts reading back the texels of a texture mip level
+	bool readTexture(GLTexture &texture, unsigned int level, const Request &request);
+	/// Starts reading back the pixels of the default framebuffer
+	bool readScreen(const Request &request);
+	/// Completes every readback whose fence has been signalled, or that is too old, in submission order
+	/*! \return The number of readbacks still pending */
+	unsigned int poll();
+	/// Waits for every pending readback and completes it, encoding files on the calling thread
+	void finish();
+
+  private:
+	struct Readback
+	{
+		Readback();
+
+		nctl::UniquePtr<GLBufferObject> pbo;
+		GLsync fence;
+		unsigned long int frame;
+		int width;
+		int height;
+		Texture::Format format;
+		Texture::ReadbackCallback callback;
+		void *userData;
+		nctl::String filename;
+		bool verticalFlip;
+	};
+
+	Readback readbacks_[NumBuffers];
+	/// The index of the oldest pending readback
+	unsigned int first_;
+	unsigned int numPending_;
+	/// True while a readback callback is being invoked
+	bool isCompleting_;
+#if defined(WITH_OPENGLES)
+	/// The framebuffer used to read texels with `glReadPixels()`, as `glGetTexImage()` is not available
+	nctl::UniquePtr<GLFramebufferObject> readFbo_;
+#endif
+#ifdef WITH_THREADS
+	/// The thread that encodes files, created with the first readback to save
+	nctl::UniquePtr<Thread> encodeThread_;
+	/// The encoding commands waiting for the thread, in submission order
+	nctl::List<nctl::UniquePtr<IThreadCommand>> encodeQueue_;
+	Mutex encodeMutex_;
+	CondVariable encodeCondVar_;
+	/// Signalled when the encoding thread takes a command from the queue
+	CondVariable encodeSpaceCondVar_;
+	/// Set when the queue is destroyed, the thread exits after encoding the remaining files
+	bool encodeThreadShouldQuit_;
+
+	/// Hands an encoding command over to the encoding thread, creating it if needed
+	/*! \note It waits if there are already `MaxQueuedEncodes` commands in the queue */
+	void enqueueEncode(nctl::UniquePtr<IThreadCommand> encodeCommand);
+	static void encodeFunction(void *arg);
+#endif
+
+	/// Returns the next readback of the ring, completing it first if it is still pending
+	Readback &nextReadback(const Request &request, GLsizeiptr dataSize);
+	/// Inserts the fence after the copy and marks the readback as pending
+	void submit(Readback &readback);
+	/// Maps the pixel buffer object of a readback and hands its pixels over
+	void complete(Readback &readback, bool encodeOnThread);
+
+	/// Deleted copy constructor
+	ReadbackQueue(const ReadbackQueue &) = delete;
+	/// Deleted assignment operator
+	ReadbackQueue &operator=(const ReadbackQueue &) = delete;
+};
+
+}
+
+#endif
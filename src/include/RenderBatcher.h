@@ -3,10 +3,16 @@
 
 #include <nctl/Array.h>
 #include <nctl/UniquePtr.h>
+#ifdef WITH_THREADS
+	#include <nctl/Atomic.h>
+	#include <nctl/SharedPtr.h>
+	#include "ThreadSync.h"
+#endif
 
 namespace ncine {
 
 class RenderCommand;
+class GLUniformBlockCache;
 
 /// A class that batches render commands together
 class RenderBatcher
@@ -31,11 +37,60 @@ class RenderBatcher
 		nctl::UniquePtr<unsigned char[]> buffer;
 	};
 
-	/// Memory buffers to collect UBO data before committing it
-	/*! \note It is a RAM buffer and cannot be handled by the `RenderBuffersManager` */
+	/// Memory buffers for the batch uniforms that are not part of a block
+	/*! \note Uniform blocks are written directly in the uniform buffer ranges acquired from the `RenderBuffersManager` */
 	nctl::Array<ManagedBuffer> buffers_;
 
+	/// The data needed to fill a batch once its memory ranges have been reserved
+	struct FillJob
+	{
+		RenderCommand *batchCommand;
+		RenderCommand *const *start;
+		RenderCommand *const *end;
+		GLUniformBlockCache *instancesBlock;
+		unsigned int singleInstanceBlockSize;
+		unsigned int numFloatsVertexFormat;
+		bool batchingWithIndices;
+		/// Destination of vertices, `nullptr` if the batched shader has no attributes
+		float *destVtx;
+		/// Destination of indices, `nullptr` if the batch is not using them
+		unsigned short *destIdx;
+	};
+
+	/// Batches whose memory has been reserved but that still need to be filled
+	nctl::Array<FillJob> fillJobs_;
+
+#ifdef WITH_THREADS
+	/// The batches to be filled in parallel, shared with the fill commands
+	/*! A command that starts when no batch is left to fill only touches this structure, never the batcher */
+	struct SharedFillJobs
+	{
+		SharedFillJobs()
+		    : jobs(nullptr), numJobs(0) {}
+
+		const FillJob *jobs;
+		int32_t numJobs;
+		/// Index of the next batch to be filled by the main thread or a worker
+		nctl::Atomic32 nextJob;
+		/// Number of batches that have been filled
+		nctl::Atomic32 numFilledJobs;
+		Mutex mutex;
+		CondVariable condVar;
+	};
+
+	/// A thread pool command that fills batches until there are none left
+	class FillCommand;
+
+	/// Reused every frame, unless a late fill command from a previous one still holds it
+	nctl::SharedPtr<SharedFillJobs> sharedFillJobs_;
+#endif
+
 	RenderCommand *collectCommands(nctl::Array<RenderCommand *>::ConstIterator start, nctl::Array<RenderCommand *>::ConstIterator end, nctl::Array<RenderCommand *>::ConstIterator &nextStart);
+	void fillBatches();
+	static void fillBatch(const FillJob &job);
+#ifdef WITH_THREADS
+	static void fillNextBatches(SharedFillJobs &sharedJobs);
+#endif
 
 	unsigned char *acquireMemory(unsigned int bytes);
 	void createBuffer(unsigned int size);
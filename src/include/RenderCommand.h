@@ -6,6 +6,11 @@
 #include "Geometry.h"
 #include "Texture.h"
 
+#include <ncine/config.h>
+#if NCINE_WITH_ALLOCATORS
+	#include <nctl/SlabAllocator.h>
+#endif
+
 namespace ncine {
 
 class Color;
@@ -39,6 +44,10 @@ class RenderCommand
 	explicit RenderCommand(CommandTypes::Enum profilingType);
 	RenderCommand();
 
+#if NCINE_WITH_ALLOCATORS
+	NCTL_DECLARE_SLAB_ALLOCATED()
+#endif
+
 	/// Returns the command type for profiling counter
 	inline CommandTypes::Enum profilingType() const { return profilingType_; }
 	/// Sets the command type for profiling counter
@@ -2,6 +2,7 @@
 #define CLASS_NCINE_RENDERCOMMANDPOOL
 
 #include <nctl/Array.h>
+#include <nctl/HashMap.h>
 #include <nctl/UniquePtr.h>
 #include "Material.h"
 
@@ -10,6 +11,7 @@ namespace ncine {
 class RenderCommand;
 
 /// The class that creates and handles the pool of render commands
+/*! Free commands are kept in a separate list for every shader program, so that a retrieval takes constant time. */
 class RenderCommandPool
 {
   public:
@@ -29,12 +31,24 @@ class RenderCommandPool
 	/// Retrieves (or adds) a command with the specified OpenGL shader program
 	RenderCommand *retrieveOrAdd(GLShaderProgram *shaderProgram, bool &commandAdded);
 
-	/// Releases all used commands and returnsi them in the free array
+	/// Releases all used commands and returns them to the free lists
 	void reset();
 
   private:
-	nctl::Array<nctl::UniquePtr<RenderCommand>> freeCommandsPool_;
-	nctl::Array<nctl::UniquePtr<RenderCommand>> usedCommandsPool_;
+	/// The initial capacity of the hashmap of free lists
+	static const unsigned int FreeListsHashSize = 32;
+
+	/// The array that owns all the commands created by the pool
+	nctl::Array<nctl::UniquePtr<RenderCommand>> commandsPool_;
+	/// The array of commands that have been added or retrieved since the last reset
+	nctl::Array<RenderCommand *> usedCommandsPool_;
+	/// The lists of free commands, one for every shader program
+	nctl::HashMap<const GLShaderProgram *, nctl::Array<RenderCommand *>> freeCommandsLists_;
+	/// The number of commands in all the free lists
+	unsigned int numFreeCommands_;
+
+	/// Returns the free list associated with the specified shader program, creating it if needed
+	nctl::Array<RenderCommand *> &freeListForShader(const GLShaderProgram *shaderProgram);
 };
 
 }
@@ -10,6 +10,7 @@
 #include "Matrix4x4.h"
 #include "GLShaderProgram.h" // For the UniquePtr to invoke the destructor
 #include "GLShaderUniforms.h"
+#include "GLShaderProgramQueue.h"
 
 namespace ncine {
 
@@ -17,6 +18,9 @@ class RenderBuffersManager;
 class RenderVaoPool;
 class RenderCommandPool;
 class RenderBatcher;
+class BinaryShaderCache;
+class GlyphRunCache;
+class ReadbackQueue;
 class Camera;
 class Viewport;
 
@@ -67,6 +71,14 @@ class RenderResources
 	static inline RenderVaoPool &vaoPool() { return *vaoPool_; }
 	static inline RenderCommandPool &renderCommandPool() { return *renderCommandPool_; }
 	static inline RenderBatcher &renderBatcher() { return *renderBatcher_; }
+	/// Returns the cache of linked shader program binaries, if it has been created
+	static inline BinaryShaderCache *binaryShaderCache() { return binaryShaderCache_.get(); }
+	/// Returns the cache of glyph runs shared by text nodes, if it has been created
+	static inline GlyphRunCache *glyphRunCache() { return glyphRunCache_.get(); }
+	/// Returns the queue of shader programs that are being linked by the driver
+	static inline GLShaderProgramQueue &shaderProgramQueue() { return shaderProgramQueue_; }
+	/// Returns the queue of asynchronous pixel readbacks
+	static inline ReadbackQueue &readbackQueue() { return *readbackQueue_; }
 
 	static GLShaderProgram *shaderProgram(Material::ShaderProgramType shaderProgramType);
 
@@ -89,6 +101,10 @@ class RenderResources
 	static nctl::UniquePtr<RenderVaoPool> vaoPool_;
 	static nctl::UniquePtr<RenderCommandPool> renderCommandPool_;
 	static nctl::UniquePtr<RenderBatcher> renderBatcher_;
+	static nctl::UniquePtr<BinaryShaderCache> binaryShaderCache_;
+	static nctl::UniquePtr<GlyphRunCache> glyphRunCache_;
+	static GLShaderProgramQueue shaderProgramQueue_;
+	static nctl::UniquePtr<ReadbackQueue> readbackQueue_;
 
 	static nctl::UniquePtr<GLShaderProgram> defaultShaderPrograms_[16];
 	static nctl::HashMap<const GLShaderProgram *, GLShaderProgram *> batchedShaders_;
@@ -105,6 +121,7 @@ class RenderResources
 	static void updateCameraUniforms();
 	static void setCurrentViewport(Viewport *viewport);
 
+	static void createBinaryShaderCache();
 	static void create();
 	static void createMinimal();
 	static void dispose();
@@ -132,6 +132,86 @@ class RenderStatistics
 		friend RenderStatistics;
 	};
 
+	/// Bytes of uniform block data written into mapped uniform buffers during a frame
+	class UniformData
+	{
+	  public:
+		/// Bytes written by the batcher directly into the uniform buffer ranges of batches
+		unsigned long batchedBytes;
+		/// Bytes copied from the host memory of commands into uniform buffers when committing
+		unsigned long committedBytes;
+
+		UniformData()
+		    : batchedBytes(0), committedBytes(0) {}
+
+		/// Returns the number of bytes copied to uniform buffers during the frame
+		inline unsigned long copiedBytes() const { return batchedBytes + committedBytes; }
+
+	  private:
+		void reset()
+		{
+			batchedBytes = 0;
+			committedBytes = 0;
+		}
+		friend RenderStatistics;
+	};
+
+	/// Aggregated counters and timings of the scenegraph traversals of all viewports during a frame
+	class SceneNodes
+	{
+	  public:
+		/// Number of nodes whose world matrix has been computed
+		unsigned int transformed;
+		/// Number of nodes whose world matrix was still valid according to their dirty bits
+		unsigned int skipped;
+		/// Number of drawable node AABBs that have been computed
+		unsigned int aabbsUpdated;
+		/// Seconds spent in the update traversals, fixed time step ones included
+		float updateTime;
+		/// Seconds spent in the culling traversals
+		float cullingTime;
+		/// Seconds spent in the visit traversals
+		float visitTime;
+
+		SceneNodes()
+		    : transformed(0), skipped(0), aabbsUpdated(0), updateTime(0.0f), cullingTime(0.0f), visitTime(0.0f) {}
+
+	  private:
+		void reset()
+		{
+			transformed = 0;
+			skipped = 0;
+			aabbsUpdated = 0;
+			updateTime = 0.0f;
+			cullingTime = 0.0f;
+			visitTime = 0.0f;
+		}
+		friend RenderStatistics;
+	};
+
+	/// Aggregated statistics of the dynamic font atlases
+	/*! \note Lookups, misses and evictions are counted since the application started */
+	class FontAtlases
+	{
+	  public:
+		/// Number of dynamic font atlases
+		unsigned int count;
+		/// Number of glyphs stored in the atlases
+		unsigned int glyphs;
+		/// Number of glyph requests
+		unsigned long lookups;
+		/// Number of glyph requests that needed a rasterisation
+		unsigned long misses;
+		/// Number of shelves evicted to make space for new glyphs
+		unsigned long evictions;
+
+		FontAtlases()
+		    : count(0), glyphs(0), lookups(0), misses(0), evictions(0) {}
+
+		/// Returns the ratio of glyph requests that have been found in an atlas
+		inline float hitRate() const { return (lookups > 0) ? (lookups - misses) / static_cast<float>(lookups) : 0.0f; }
+	};
+
 	/// Returns the aggregated command statistics for all types
 	static inline const Commands &allCommands() { return allCommands_; }
 	/// Returns the commnad statistics for the specified type
@@ -158,6 +238,15 @@ class RenderStatistics
 	/// Returns statistics about the render command pools
 	static inline const CommandPool &commandPool() { return commandPool_; }
 
+	/// Returns the statistics about uniform block data copied to uniform buffers
+	static inline const UniformData &uniformData() { return uniformData_; }
+
+	/// Returns the counters and timings of the scenegraph traversals
+	static inline const SceneNodes &sceneNodes() { return sceneNodes_[(index_ + 1) % 2]; }
+
+	/// Returns the aggregated statistics of the dynamic font atlases
+	static inline const FontAtlases &fontAtlases() { return fontAtlases_; }
+
   private:
 	/// The string used to output OpenGL debug group information
 	static nctl::String debugString_;
@@ -172,6 +261,9 @@ class RenderStatistics
 	static unsigned int culledNodes_[2];
 	static VaoPool vaoPool_;
 	static CommandPool commandPool_;
+	static UniformData uniformData_;
+	static SceneNodes sceneNodes_[2];
+	static FontAtlases fontAtlases_;
 
 	static void reset();
 	static void gatherStatistics(const RenderCommand &command);
@@ -220,8 +312,28 @@ class RenderStatistics
 	static inline void addVaoPoolReuse() { vaoPool_.reuses++; }
 	static inline void addVaoPoolBinding() { vaoPool_.bindings++; }
 	static inline void addCommandPoolRetrieval() { commandPool_.retrievals++; }
+	static inline void addBatchedUniformBytes(unsigned long bytes) { uniformData_.batchedBytes += bytes; }
+	static inline void addCommittedUniformBytes(unsigned long bytes) { uniformData_.committedBytes += bytes; }
+	static inline void addTransformedNode() { sceneNodes_[index_].transformed++; }
+	static inline void addSkippedNode() { sceneNodes_[index_].skipped++; }
+	static inline void addUpdatedAabb() { sceneNodes_[index_].aabbsUpdated++; }
+	static inline void addUpdateTime(float seconds) { sceneNodes_[index_].updateTime += seconds; }
+	static inline void addCullingTime(float seconds) { sceneNodes_[index_].cullingTime += seconds; }
+	static inline void addVisitTime(float seconds) { sceneNodes_[index_].visitTime += seconds; }
+	static inline void addFontAtlas() { fontAtlases_.count++; }
+	static inline void removeFontAtlas() { fontAtlases_.count--; }
+	static inline void addFontAtlasLookup(bool miss)
+	{
+		fontAtlases_.lookups++;
+		if (miss)
+			fontAtlases_.misses++;
+	}
+	static inline void addFontAtlasGlyphs(int glyphs) { fontAtlases_.glyphs += glyphs; }
+	static inline void addFontAtlasEviction() { fontAtlases_.evictions++; }
 
+	friend class Viewport;
 	friend class ScreenViewport;
+	friend class SceneNode;
 	friend class RenderQueue;
 	friend class RenderBuffersManager;
 	friend class Texture;
@@ -229,6 +341,9 @@ class RenderStatistics
 	friend class DrawableNode;
 	friend class RenderVaoPool;
 	friend class RenderCommandPool;
+	friend class RenderBatcher;
+	friend class GLShaderUniformBlocks;
+	friend class DynamicFontAtlas;
 };
 
 }
@@ -17,6 +17,7 @@ class ScreenViewport : public Viewport
 	void resize(int width, int height);
 
   private:
+	void fixedUpdate(float timeStep);
 	void update();
 	void visit();
 	void sortAndCommitQueue();
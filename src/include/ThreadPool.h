@@ -5,6 +5,7 @@
 #include <nctl/List.h>
 #include "ThreadSync.h"
 #include <nctl/Array.h>
+#include <nctl/Atomic.h>
 #include "Thread.h"
 
 namespace ncine {
@@ -21,6 +22,8 @@ class ThreadPool : public IThreadPool
 
 	/// Enqueues a command request for a worker thread
 	void enqueueCommand(nctl::UniquePtr<IThreadCommand> threadCommand) override;
+	/// Returns the number of worker threads
+	inline unsigned int numThreads() const override { return numThreads_; }
 
   private:
 	struct ThreadStruct
@@ -29,6 +32,8 @@ class ThreadPool : public IThreadPool
 		Mutex *queueMutex;
 		CondVariable *queueCV;
 		bool shouldQuit;
+		/// Used by every worker to get a different index for its name
+		nctl::Atomic32 numStartedWorkers;
 	};
 
 	nctl::List<nctl::UniquePtr<IThreadCommand>> queue_;
@@ -0,0 +1,43 @@
+#ifndef NCINE_RING_COPY
+#define NCINE_RING_COPY
+
+#include <nctl/Atomic.h>
+
+namespace ncine {
+
+/// Copies the most recent elements of a ring buffer filled by a single writer thread, returns their number
+/*! The writer stores an element at `writeIndex` modulo the capacity, then increments the index with a release store.
+ *  Elements overwritten while copying are discarded, including the one the writer might be working on.
+ *  \param startIndex The elements before this index are not copied
+ *  \param firstIndex Receives the index of the first copied element */
+template <class T>
+unsigned int copyRingElements(const T *ring, unsigned int capacity, nctl::Atomic64 &writeIndex, int64_t startIndex, T *dest, int64_t &firstIndex)
+{
+	const int64_t endIndex = writeIndex.load(nctl::Atomic64::MemoryModel::ACQUIRE);
+	if (endIndex - startIndex > capacity)
+		startIndex = endIndex - capacity;
+
+	for (int64_t index = startIndex; index < endIndex; index++)
+		dest[index - startIndex] = ring[static_cast<unsigned int>(index % capacity)];
+
+	const int64_t newEndIndex = writeIndex.load(nctl::Atomic64::MemoryModel::ACQUIRE);
+	int64_t numOverwritten = newEndIndex + 1 - capacity - startIndex;
+	if (numOverwritten < 0)
+		numOverwritten = 0;
+	else if (numOverwritten > endIndex - startIndex)
+		numOverwritten = endIndex - startIndex;
+
+	const unsigned int numElements = static_cast<unsigned int>(endIndex - startIndex - numOverwritten);
+	if (numOverwritten > 0)
+	{
+		for (unsigned int i = 0; i < numElements; i++)
+			dest[i] = dest[i + numOverwritten];
+	}
+
+	firstIndex = startIndex + numOverwritten;
+	return numElements;
+}
+
+}
+
+#endif
@@ -24,6 +24,7 @@ namespace AnimatedSprite {
 
 	static const char *frame = "frame";
 	static const char *setFrame = "set_frame";
+	static const char *setFrames = "set_frames";
 }}
 
 ///////////////////////////////////////////////////////////
@@ -54,6 +55,7 @@ void LuaAnimatedSprite::expose(LuaStateManager *stateManager)
 
 	LuaUtils::addFunction(L, LuaNames::AnimatedSprite::frame, frame);
 	LuaUtils::addFunction(L, LuaNames::AnimatedSprite::setFrame, setFrame);
+	LuaUtils::addFunction(L, LuaNames::AnimatedSprite::setFrames, setFrames);
 
 	LuaSprite::exposeFunctions(L);
 
@@ -202,4 +204,23 @@ int LuaAnimatedSprite::setFrame(lua_State *L)
 	return 0;
 }
 
+int LuaAnimatedSprite::setFrames(lua_State *L)
+{
+	const unsigned int numSprites = static_cast<unsigned int>(LuaUtils::rawLen(L, 1));
+	LuaUtils::assertArrayLength(L, 2, numSprites);
+
+	for (unsigned int i = 0; i < numSprites; i++)
+	{
+		AnimatedSprite *sprite = LuaUntrackedUserData<AnimatedSprite>::retrieveArrayElement(L, 1, i + 1);
+		LuaUtils::rawGeti(L, 2, i + 1);
+		const unsigned int frameNum = LuaUtils::retrieve<uint32_t>(L, -1);
+		LuaUtils::pop(L);
+
+		if (sprite)
+			sprite->setFrame(frameNum);
+	}
+
+	return 0;
+}
+
 }
@@ -15,24 +15,32 @@ namespace AppConfiguration {
 	static const char *consoleLogLevel = "console_log_level";
 	static const char *fileLogLevel = "file_log_level";
 	static const char *frameTimerLogInterval = "log_interval";
+	static const char *frameStatisticsSize = "frame_statistics_size";
+	static const char *frameStatisticsFile = "frame_statistics_file";
+	static const char *profilerTraceFile = "profiler_trace_file";
 
 	static const char *resolution = "resolution";
 	static const char *inFullscreen = "fullscreen";
 	static const char *isResizable = "resizable";
 	static const char *frameLimit = "frame_limit";
+	static const char *fixedTimeStep = "fixed_time_step";
+	static const char *maxFixedUpdates = "max_fixed_updates";
 
 	static const char *windowTitle = "window_title";
 	static const char *windowIconFilename = "window_icon";
 
 	static const char *useBufferMapping = "buffer_mapping";
 	static const char *deferShaderQueries = "defer_shader_queries";
+	static const char *useBinaryShaderCache = "binary_shader_cache";
 	static const char *fixedBatchSize = "fixed_batch_size";
 	static const char *vboSize = "vbo_size";
 	static const char *iboSize = "ibo_size";
 	static const char *vaoPoolSize = "vao_pool_size";
 	static const char *renderCommandPoolSize = "rendercommand_pool_size";
+	static const char *frameArenaSize = "frame_arena_size";
 
 	static const char *withDebugOverlay = "debug_overlay";
+	static const char *withProfiler = "profiler";
 	static const char *withAudio = "audio";
 	static const char *withThreads = "threads";
 	static const char *withScenegraph = "scenegraph";
@@ -62,24 +70,32 @@ void LuaAppConfiguration::push(lua_State *L, const AppConfiguration &appCfg)
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::consoleLogLevel, static_cast<int64_t>(appCfg.consoleLogLevel));
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::fileLogLevel, static_cast<int64_t>(appCfg.fileLogLevel));
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::frameTimerLogInterval, appCfg.frameTimerLogInterval);
+	LuaUtils::pushField(L, LuaNames::AppConfiguration::frameStatisticsSize, appCfg.frameStatisticsSize);
+	LuaUtils::pushField(L, LuaNames::AppConfiguration::frameStatisticsFile, appCfg.frameStatisticsFile.data());
+	LuaUtils::pushField(L, LuaNames::AppConfiguration::profilerTraceFile, appCfg.profilerTraceFile.data());
 
 	LuaVector2iUtils::pushField(L, LuaNames::AppConfiguration::resolution, appCfg.resolution);
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::inFullscreen, appCfg.inFullscreen);
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::isResizable, appCfg.isResizable);
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::frameLimit, appCfg.frameLimit);
+	LuaUtils::pushField(L, LuaNames::AppConfiguration::fixedTimeStep, appCfg.fixedTimeStep);
+	LuaUtils::pushField(L, LuaNames::AppConfiguration::maxFixedUpdates, appCfg.maxFixedUpdates);
 
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::windowTitle, appCfg.windowTitle.data());
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::windowIconFilename, appCfg.windowIconFilename.data());
 
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::useBufferMapping, appCfg.useBufferMapping);
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::deferShaderQueries, appCfg.deferShaderQueries);
+	LuaUtils::pushField(L, LuaNames::AppConfiguration::useBinaryShaderCache, appCfg.useBinaryShaderCache);
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::fixedBatchSize, appCfg.fixedBatchSize);
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::vboSize, static_cast<int64_t>(appCfg.vboSize));
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::iboSize, static_cast<int64_t>(appCfg.iboSize));
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::vaoPoolSize, appCfg.vaoPoolSize);
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::renderCommandPoolSize, appCfg.renderCommandPoolSize);
+	LuaUtils::pushField(L, LuaNames::AppConfiguration::frameArenaSize, static_cast<int64_t>(appCfg.frameArenaSize));
 
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::withDebugOverlay, appCfg.withDebugOverlay);
+	LuaUtils::pushField(L, LuaNames::AppConfiguration::withProfiler, appCfg.withProfiler);
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::withAudio, appCfg.withAudio);
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::withThreads, appCfg.withThreads);
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::withScenegraph, appCfg.withScenegraph);
@@ -124,6 +140,12 @@ void LuaAppConfiguration::retrieveAndSet(lua_State *L, AppConfiguration &appCfg)
 	appCfg.fileLogLevel = fileLogLevel;
 	const float logInterval = LuaUtils::retrieveField<float>(L, -1, LuaNames::AppConfiguration::frameTimerLogInterval);
 	appCfg.frameTimerLogInterval = logInterval;
+	const unsigned int frameStatisticsSize = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::AppConfiguration::frameStatisticsSize);
+	appCfg.frameStatisticsSize = frameStatisticsSize;
+	const char *frameStatisticsFile = LuaUtils::retrieveField<const char *>(L, -1, LuaNames::AppConfiguration::frameStatisticsFile);
+	appCfg.frameStatisticsFile = frameStatisticsFile;
+	const char *profilerTraceFile = LuaUtils::retrieveField<const char *>(L, -1, LuaNames::AppConfiguration::profilerTraceFile);
+	appCfg.profilerTraceFile = profilerTraceFile;
 
 	const Vector2i resolution = LuaVector2iUtils::retrieveTableField(L, -1, LuaNames::AppConfiguration::resolution);
 	appCfg.resolution = resolution;
@@ -133,6 +155,10 @@ void LuaAppConfiguration::retrieveAndSet(lua_State *L, AppConfiguration &appCfg)
 	appCfg.isResizable = isResizable;
 	const unsigned int frameLimit = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::AppConfiguration::frameLimit);
 	appCfg.frameLimit = frameLimit;
+	const float fixedTimeStep = LuaUtils::retrieveField<float>(L, -1, LuaNames::AppConfiguration::fixedTimeStep);
+	appCfg.fixedTimeStep = fixedTimeStep;
+	const unsigned int maxFixedUpdates = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::AppConfiguration::maxFixedUpdates);
+	appCfg.maxFixedUpdates = maxFixedUpdates;
 
 	const char *windowTitle = LuaUtils::retrieveField<const char *>(L, -1, LuaNames::AppConfiguration::windowTitle);
 	appCfg.windowTitle = windowTitle;
@@ -143,6 +169,8 @@ void LuaAppConfiguration::retrieveAndSet(lua_State *L, AppConfiguration &appCfg)
 	appCfg.useBufferMapping = useBufferMapping;
 	const bool deferShaderQueries = LuaUtils::retrieveField<bool>(L, -1, LuaNames::AppConfiguration::deferShaderQueries);
 	appCfg.deferShaderQueries = deferShaderQueries;
+	const bool useBinaryShaderCache = LuaUtils::retrieveField<bool>(L, -1, LuaNames::AppConfiguration::useBinaryShaderCache);
+	appCfg.useBinaryShaderCache = useBinaryShaderCache;
 	const unsigned int fixedBatchSize = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::AppConfiguration::fixedBatchSize);
 	appCfg.fixedBatchSize = fixedBatchSize;
 	const unsigned long vboSize = LuaUtils::retrieveField<uint64_t>(L, -1, LuaNames::AppConfiguration::vboSize);
@@ -153,9 +181,13 @@ void LuaAppConfiguration::retrieveAndSet(lua_State *L, AppConfiguration &appCfg)
 	appCfg.vaoPoolSize = vaoPoolSize;
 	const unsigned int renderCommandPoolSize = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::AppConfiguration::renderCommandPoolSize);
 	appCfg.renderCommandPoolSize = renderCommandPoolSize;
+	const unsigned long frameArenaSize = LuaUtils::retrieveField<uint64_t>(L, -1, LuaNames::AppConfiguration::frameArenaSize);
+	appCfg.frameArenaSize = frameArenaSize;
 
 	const bool withDebugOverlay = LuaUtils::retrieveField<bool>(L, -1, LuaNames::AppConfiguration::withDebugOverlay);
 	appCfg.withDebugOverlay = withDebugOverlay;
+	const bool withProfiler = LuaUtils::retrieveField<bool>(L, -1, LuaNames::AppConfiguration::withProfiler);
+	appCfg.withProfiler = withProfiler;
 	const bool withAudio = LuaUtils::retrieveField<bool>(L, -1, LuaNames::AppConfiguration::withAudio);
 	appCfg.withAudio = withAudio;
 	const bool withThreads = LuaUtils::retrieveField<bool>(L, -1, LuaNames::AppConfiguration::withThreads);
@@ -4,7 +4,10 @@
 #include "LuaApplication.h"
 #include "LuaUntrackedUserData.h"
 #include "LuaVector2Utils.h"
+#include "LuaStateManager.h"
+#include "LuaCallbacks.h"
 #include "Application.h"
+#include "FrameStatistics.h"
 #include "FileSystem.h"
 
 namespace ncine {
@@ -26,6 +29,12 @@ namespace Application {
 	static const char *screenViewport = "get_screen_viewport";
 	static const char *interval = "get_interval";
 	static const char *numFrames = "get_num_frames";
+	static const char *numFixedUpdates = "get_num_fixed_updates";
+	static const char *interpolationFactor = "get_interpolation_factor";
+
+	static const char *frameStatistics = "get_frame_statistics";
+	static const char *saveFrameStatistics = "save_frame_statistics";
+	static const char *resetFrameStatistics = "reset_frame_statistics";
 
 	static const char *width = "get_width";
 	static const char *height = "get_height";
@@ -38,10 +47,12 @@ namespace Application {
 	static const char *setAutoSuspension = "set_auto_suspension";
 
 	static const char *quit = "quit";
+	static const char *refreshCallbacks = "refresh_callbacks";
 
 	namespace RenderingSettings {
 		static const char *batchingEnabled = "batching";
 		static const char *batchingWithIndices = "batching_with_indices";
+		static const char *parallelBatching = "parallel_batching";
 		static const char *cullingEnabled = "culling";
 		static const char *minBatchSize = "min_batch_size";
 		static const char *maxBatchSize = "max_batch_size";
@@ -53,6 +64,16 @@ namespace Application {
 		static const char *showInterface = "interface";
 	}
 
+	namespace FrameStatistics {
+		static const char *numFrames = "frames";
+		static const char *numHitches = "hitches";
+		static const char *mean = "mean";
+		static const char *p50 = "p50";
+		static const char *p95 = "p95";
+		static const char *p99 = "p99";
+		static const char *max = "max";
+	}
+
 	namespace GuiSettings {
 		static const char *imguiLayer = "imgui_layer";
 		static const char *nuklearLayer = "nuklear_layer";
@@ -82,6 +103,12 @@ void LuaApplication::expose(lua_State *L)
 	LuaUtils::addFunction(L, LuaNames::Application::screenViewport, screenViewport);
 	LuaUtils::addFunction(L, LuaNames::Application::interval, interval);
 	LuaUtils::addFunction(L, LuaNames::Application::numFrames, numFrames);
+	LuaUtils::addFunction(L, LuaNames::Application::numFixedUpdates, numFixedUpdates);
+	LuaUtils::addFunction(L, LuaNames::Application::interpolationFactor, interpolationFactor);
+
+	LuaUtils::addFunction(L, LuaNames::Application::frameStatistics, frameStatistics);
+	LuaUtils::addFunction(L, LuaNames::Application::saveFrameStatistics, saveFrameStatistics);
+	LuaUtils::addFunction(L, LuaNames::Application::resetFrameStatistics, resetFrameStatistics);
 
 	LuaUtils::addFunction(L, LuaNames::Application::width, width);
 	LuaUtils::addFunction(L, LuaNames::Application::height, height);
@@ -94,6 +121,7 @@ void LuaApplication::expose(lua_State *L)
 	LuaUtils::addFunction(L, LuaNames::Application::setAutoSuspension, setAutoSuspension);
 
 	LuaUtils::addFunction(L, LuaNames::Application::quit, quit);
+	LuaUtils::addFunction(L, LuaNames::Application::refreshCallbacks, refreshCallbacks);
 
 	lua_setfield(L, -2, LuaNames::Application::Application);
 }
@@ -106,9 +134,10 @@ int LuaApplication::renderingSettings(lua_State *L)
 {
 	const Application::RenderingSettings &settings = theApplication().renderingSettings();
 
-	lua_createtable(L, 0, 5);
+	lua_createtable(L, 0, 6);
 	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::batchingEnabled, settings.batchingEnabled);
 	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::batchingWithIndices, settings.batchingWithIndices);
+	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::parallelBatching, settings.parallelBatching);
 	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::cullingEnabled, settings.cullingEnabled);
 	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::minBatchSize, settings.minBatchSize);
 	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::maxBatchSize, settings.maxBatchSize);
@@ -128,6 +157,7 @@ int LuaApplication::setRenderingSettings(lua_State *L)
 
 	settings.batchingEnabled = LuaUtils::retrieveField<bool>(L, -1, LuaNames::Application::RenderingSettings::batchingEnabled);
 	settings.batchingWithIndices = LuaUtils::retrieveField<bool>(L, -1, LuaNames::Application::RenderingSettings::batchingWithIndices);
+	settings.parallelBatching = LuaUtils::retrieveField<bool>(L, -1, LuaNames::Application::RenderingSettings::parallelBatching);
 	settings.cullingEnabled = LuaUtils::retrieveField<bool>(L, -1, LuaNames::Application::RenderingSettings::cullingEnabled);
 	settings.minBatchSize = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::Application::RenderingSettings::minBatchSize);
 	settings.maxBatchSize = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::Application::RenderingSettings::maxBatchSize);
@@ -171,8 +201,8 @@ int LuaApplication::guiSettings(lua_State *L)
 	lua_createtable(L, 0, 4);
 	LuaUtils::pushField(L, LuaNames::Application::GuiSettings::imguiLayer, settings.imguiLayer);
 	LuaUtils::pushField(L, LuaNames::Application::GuiSettings::nuklearLayer, settings.nuklearLayer);
-	LuaUtils::pushField(L, LuaNames::Application::GuiSettings::imguiViewport, settings.imguiViewport);
-	LuaUtils::pushField(L, LuaNames::Application::GuiSettings::nuklearViewport, settings.nuklearViewport);
+	LuaUntrackedUserData<Viewport>::pushField(L, LuaNames::Application::GuiSettings::imguiViewport, settings.imguiViewport);
+	LuaUntrackedUserData<Viewport>::pushField(L, LuaNames::Application::GuiSettings::nuklearViewport, settings.nuklearViewport);
 
 	return 1;
 }
@@ -189,8 +219,12 @@ int LuaApplication::setGuiSettings(lua_State *L)
 
 	settings.imguiLayer = LuaUtils::retrieveField<unsigned int>(L, -1, LuaNames::Application::GuiSettings::imguiLayer);
 	settings.nuklearLayer = LuaUtils::retrieveField<unsigned int>(L, -1, LuaNames::Application::GuiSettings::nuklearLayer);
-	settings.imguiViewport = reinterpret_cast<Viewport *>(LuaUtils::retrieveFieldLightUserData(L, -1, LuaNames::Application::GuiSettings::imguiViewport));
-	settings.nuklearViewport = reinterpret_cast<Viewport *>(LuaUtils::retrieveFieldLightUserData(L, -1, LuaNames::Application::GuiSettings::imguiViewport));
+	LuaUtils::getField(L, -1, LuaNames::Application::GuiSettings::imguiViewport);
+	settings.imguiViewport = LuaUntrackedUserData<Viewport>::retrieveOrNil(L, -1);
+	LuaUtils::pop(L);
+	LuaUtils::getField(L, -1, LuaNames::Application::GuiSettings::nuklearViewport);
+	settings.nuklearViewport = LuaUntrackedUserData<Viewport>::retrieveOrNil(L, -1);
+	LuaUtils::pop(L);
 
 	return 0;
 }
@@ -219,6 +253,57 @@ int LuaApplication::numFrames(lua_State *L)
 	return 1;
 }
 
+int LuaApplication::numFixedUpdates(lua_State *L)
+{
+	LuaUtils::push(L, static_cast<uint64_t>(theApplication().numFixedUpdates()));
+	return 1;
+}
+
+int LuaApplication::interpolationFactor(lua_State *L)
+{
+	LuaUtils::push(L, theApplication().interpolationFactor());
+	return 1;
+}
+
+/*! \note Every stage has its own table of statistics, with durations in seconds */
+int LuaApplication::frameStatistics(lua_State *L)
+{
+	FrameStatistics::Summary summary;
+	theApplication().frameStatistics().computeSummary(summary);
+
+	lua_createtable(L, 0, FrameStatistics::Stages::COUNT + 2);
+	LuaUtils::pushField(L, LuaNames::Application::FrameStatistics::numFrames, summary.numFrames);
+	LuaUtils::pushField(L, LuaNames::Application::FrameStatistics::numHitches, summary.numHitches);
+	for (unsigned int i = 0; i < FrameStatistics::Stages::COUNT; i++)
+	{
+		const FrameStatistics::StageSummary &stage = summary.stages[i];
+		lua_createtable(L, 0, 5);
+		LuaUtils::pushField(L, LuaNames::Application::FrameStatistics::mean, stage.mean);
+		LuaUtils::pushField(L, LuaNames::Application::FrameStatistics::p50, stage.p50);
+		LuaUtils::pushField(L, LuaNames::Application::FrameStatistics::p95, stage.p95);
+		LuaUtils::pushField(L, LuaNames::Application::FrameStatistics::p99, stage.p99);
+		LuaUtils::pushField(L, LuaNames::Application::FrameStatistics::max, stage.max);
+		lua_setfield(L, -2, FrameStatistics::stageName(i));
+	}
+
+	return 1;
+}
+
+int LuaApplication::saveFrameStatistics(lua_State *L)
+{
+	const char *filename = LuaUtils::retrieve<const char *>(L, -1);
+	const bool saved = theApplication().frameStatistics().save(filename, FrameStatistics::formatFromExtension(filename));
+	LuaUtils::push(L, saved);
+
+	return 1;
+}
+
+int LuaApplication::resetFrameStatistics(lua_State *L)
+{
+	theApplication().frameStatistics().reset();
+	return 0;
+}
+
 int LuaApplication::width(lua_State *L)
 {
 	LuaUtils::push(L, theApplication().width());
@@ -233,7 +318,7 @@ int LuaApplication::height(lua_State *L)
 
 int LuaApplication::resolution(lua_State *L)
 {
-	LuaVector2fUtils::push(L, theApplication().resolution());
+	LuaVector2fUtils::push(L, theApplication().resolution(), 1);
 	return 1;
 }
 
@@ -269,4 +354,10 @@ int LuaApplication::quit(lua_State *L)
 	return 0;
 }
 
+int LuaApplication::refreshCallbacks(lua_State *L)
+{
+	LuaStateManager::manager(L)->callbacks().refreshFunctions(L);
+	return 0;
+}
+
 }
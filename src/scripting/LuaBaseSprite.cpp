@@ -104,10 +104,10 @@ int LuaBaseSprite::resetTexture(lua_State *L)
 
 int LuaBaseSprite::texRect(lua_State *L)
 {
-	BaseSprite *sprite = LuaUntrackedUserData<BaseSprite>::retrieve(L, -1);
+	BaseSprite *sprite = LuaUntrackedUserData<BaseSprite>::retrieve(L, 1);
 
 	if (sprite)
-		LuaRectiUtils::push(L, sprite->texRect());
+		LuaRectiUtils::push(L, sprite->texRect(), 2);
 	else
 		LuaUtils::pushNil(L);
 
@@ -128,10 +128,10 @@ int LuaBaseSprite::setTexRect(lua_State *L)
 
 int LuaBaseSprite::anchorPoint(lua_State *L)
 {
-	BaseSprite *sprite = LuaUntrackedUserData<BaseSprite>::retrieve(L, -1);
+	BaseSprite *sprite = LuaUntrackedUserData<BaseSprite>::retrieve(L, 1);
 
 	if (sprite)
-		LuaVector2fUtils::push(L, sprite->anchorPoint());
+		LuaVector2fUtils::push(L, sprite->anchorPoint(), 2);
 	else
 		LuaUtils::pushNil(L);
 
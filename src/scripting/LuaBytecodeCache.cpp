@@ -0,0 +1,215 @@
+#define NCINE_INCLUDE_LUA
+#include "common_headers.h"
+#include "common_macros.h"
+#include <cstring> // for strlen()
+#include <nctl/Array.h>
+#include <nctl/HashFunctions.h>
+
+#include "LuaBytecodeCache.h"
+#include "FileSystem.h"
+#include "IFile.h"
+
+namespace ncine {
+
+namespace {
+	/// The four characters "NCLB" identifying a cached chunk file
+	const uint32_t Signature = 0x424C434E;
+	/// The version of the cached chunk file format
+	const uint32_t Version = 1;
+
+	const char *CacheDirectory = "lua_cache";
+	const char *CacheExtension = "luac";
+	/// The maximum number of characters of the chunk base name in a cached chunk file name
+	const unsigned int MaxNameLength = 32;
+
+	int dumpWriter(lua_State *L, const void *p, size_t sz, void *ud)
+	{
+		nctl::Array<char> *bytecode = static_cast<nctl::Array<char> *>(ud);
+		const char *bytes = static_cast<const char *>(p);
+		bytecode->insertRange(bytecode->size(), bytes, bytes + sz);
+		return 0;
+	}
+}
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+LuaBytecodeCache::LuaBytecodeCache()
+    : isAvailable_(false), directory_(fs::MaxPathLength)
+{
+	if (fs::savePath().isEmpty())
+		return;
+
+	directory_ = fs::joinPath(fs::savePath(), CacheDirectory);
+	if (fs::isDirectory(directory_.data()) == false)
+		fs::createDir(directory_.data());
+
+	isAvailable_ = fs::isDirectory(directory_.data());
+	if (isAvailable_)
+		LOGI_X("Lua bytecode cache directory: \"%s\"", directory_.data());
+	else
+		LOGW_X("Cannot create the Lua bytecode cache directory \"%s\"", directory_.data());
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+/*! \note The chunk name is part of the hash because it is stored in the debug information of the compiled chunk */
+uint64_t LuaBytecodeCache::hash(const char *chunkName, const char *source, unsigned long int length)
+{
+	uint64_t hash = nctl::fasthash64(LUA_RELEASE, strlen(LUA_RELEASE), 0);
+	// The terminating character separates the name from the source
+	hash = nctl::fasthash64(chunkName, strlen(chunkName) + 1, hash);
+	return nctl::fasthash64(source, length, hash);
+}
+
+bool LuaBytecodeCache::loadFromCache(lua_State *L, uint64_t hash, const char *chunkName)
+{
+	if (isAvailable_ == false)
+		return false;
+
+	const nctl::String path = filename(chunkName);
+	if (fs::isFile(path.data()) == false)
+	{
+		statistics_.missed++;
+		return false;
+	}
+
+	nctl::UniquePtr<IFile> fileHandle = IFile::createFileHandle(path.data());
+	fileHandle->setExitOnFailToOpen(false);
+	fileHandle->open(IFile::OpenMode::READ | IFile::OpenMode::BINARY);
+	if (fileHandle->isOpened() == false)
+	{
+		statistics_.missed++;
+		return false;
+	}
+
+	Header header;
+	const unsigned long int headerBytes = fileHandle->read(&header, sizeof(Header));
+	const bool validHeader = (headerBytes == sizeof(Header) && header.signature == Signature && header.version == Version &&
+	                          header.length > 0 && static_cast<unsigned long int>(fileHandle->size()) == sizeof(Header) + header.length);
+
+	// The source has changed since the chunk was cached, the file will be overwritten after compilation
+	if (validHeader && header.hash != hash)
+	{
+		fileHandle->close();
+		statistics_.missed++;
+		return false;
+	}
+
+	bool hasLoaded = false;
+	if (validHeader)
+	{
+		nctl::UniquePtr<char[]> bytecode = nctl::makeUnique<char[]>(header.length);
+		if (fileHandle->read(bytecode.get(), header.length) == header.length)
+		{
+			// Only binary chunks are accepted, Lua checks their version and number formats
+			const int status = luaL_loadbufferx(L, bytecode.get(), header.length, chunkName, "b");
+			hasLoaded = (status == LUA_OK);
+			if (hasLoaded == false)
+				lua_pop(L, 1);
+		}
+	}
+	fileHandle->close();
+
+	if (hasLoaded == false)
+	{
+		// The chunk is stale or corrupted, it will be replaced by a new one after compilation
+		LOGW_X("Rejecting the cached Lua chunk \"%s\"", path.data());
+		fs::deleteFile(path.data());
+		statistics_.rejected++;
+		return false;
+	}
+
+	statistics_.loaded++;
+	return true;
+}
+
+bool LuaBytecodeCache::saveToCache(lua_State *L, uint64_t hash, const char *chunkName)
+{
+	if (isAvailable_ == false)
+		return false;
+
+	ASSERT(lua_isfunction(L, -1));
+	nctl::Array<char> bytecode(4096);
+	// Debug information is kept, so that error messages still report the right lines
+	if (lua_dump(L, dumpWriter, &bytecode, 0) != 0 || bytecode.isEmpty())
+		return false;
+
+	Header header;
+	header.signature = Signature;
+	header.version = Version;
+	header.hash = hash;
+	header.length = bytecode.size();
+	header.padding = 0;
+
+	const nctl::String path = filename(chunkName);
+	nctl::UniquePtr<IFile> fileHandle = IFile::createFileHandle(path.data());
+	fileHandle->setExitOnFailToOpen(false);
+	fileHandle->open(IFile::OpenMode::WRITE | IFile::OpenMode::BINARY);
+	if (fileHandle->isOpened() == false)
+		return false;
+
+	const unsigned long int written = fileHandle->write(&header, sizeof(Header)) + fileHandle->write(bytecode.data(), header.length);
+	fileHandle->close();
+
+	if (written != sizeof(Header) + header.length)
+	{
+		LOGW_X("Cannot write the cached Lua chunk \"%s\"", path.data());
+		fs::deleteFile(path.data());
+		return false;
+	}
+
+	statistics_.saved++;
+	return true;
+}
+
+unsigned int LuaBytecodeCache::clear()
+{
+	unsigned int numDeleted = 0;
+	if (isAvailable_ == false)
+		return numDeleted;
+
+	fs::Directory dir(directory_.data());
+	while (const char *entryName = dir.readNext())
+	{
+		if (fs::hasExtension(entryName, CacheExtension))
+		{
+			const nctl::String path = fs::joinPath(directory_, entryName);
+			if (fs::deleteFile(path.data()))
+				numDeleted++;
+		}
+	}
+	dir.close();
+
+	LOGI_X("Deleted %u compiled chunks from the Lua bytecode cache", numDeleted);
+	return numDeleted;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+/*! \note The base name makes the file recognizable, the hash of the whole chunk name tells apart scripts with the same base name */
+nctl::String LuaBytecodeCache::filename(const char *chunkName) const
+{
+	const nctl::String baseName = fs::baseName(chunkName);
+	const uint64_t nameHash = nctl::fasthash64(chunkName, strlen(chunkName), 0);
+
+	nctl::String name(MaxNameLength + 32);
+	name.assign(baseName.data(), (baseName.length() < MaxNameLength) ? baseName.length() : MaxNameLength);
+	// Only letters, digits, dashes and underscores are kept in the file name
+	for (unsigned int i = 0; i < name.length(); i++)
+	{
+		const char c = name[i];
+		if ((c < 'a' || c > 'z') && (c < 'A' || c > 'Z') && (c < '0' || c > '9') && c != '-' && c != '_')
+			name[i] = '_';
+	}
+	name.formatAppend("_%08x%08x.%s", static_cast<uint32_t>(nameHash >> 32), static_cast<uint32_t>(nameHash), CacheExtension);
+
+	return fs::joinPath(directory_, name);
+}
+
+}
@@ -0,0 +1,93 @@
+#define NCINE_INCLUDE_LUA
+#include "common_headers.h"
+
+#include "LuaCallbacks.h"
+#include "LuaStateManager.h"
+#include "LuaNames.h"
+
+namespace ncine {
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+LuaCallbacks::LuaCallbacks()
+{
+	reset();
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool LuaCallbacks::pushFunction(lua_State *L, Callback::Enum callback, const char *name)
+{
+	int &ref = LuaStateManager::manager(L)->callbacks().functionRefs_[callback];
+
+	if (ref == LUA_NOREF)
+	{
+		if (lua_getglobal(L, LuaNames::ncine) == LUA_TTABLE)
+			lua_getfield(L, -1, name);
+		else
+			lua_pushnil(L);
+
+		if (lua_isfunction(L, -1) == false)
+		{
+			lua_pop(L, 1);
+			lua_pushnil(L);
+		}
+
+		// A missing function is remembered too, as a `LUA_REFNIL` reference
+		ref = luaL_ref(L, LUA_REGISTRYINDEX);
+		lua_pop(L, 1);
+	}
+
+	if (ref == LUA_REFNIL)
+		return false;
+
+	lua_rawgeti(L, LUA_REGISTRYINDEX, ref);
+	return true;
+}
+
+void LuaCallbacks::pushEventTable(lua_State *L, EventTable::Enum table, int numFields)
+{
+	int &ref = LuaStateManager::manager(L)->callbacks().tableRefs_[table];
+
+	if (ref == LUA_NOREF)
+	{
+		lua_createtable(L, 0, numFields);
+		lua_pushvalue(L, -1);
+		ref = luaL_ref(L, LUA_REGISTRYINDEX);
+	}
+	else
+		lua_rawgeti(L, LUA_REGISTRYINDEX, ref);
+}
+
+void LuaCallbacks::refreshFunctions(lua_State *L)
+{
+	for (unsigned int i = 0; i < Callback::COUNT; i++)
+	{
+		luaL_unref(L, LUA_REGISTRYINDEX, functionRefs_[i]);
+		functionRefs_[i] = LUA_NOREF;
+	}
+}
+
+void LuaCallbacks::release(lua_State *L)
+{
+	refreshFunctions(L);
+	for (unsigned int i = 0; i < EventTable::COUNT; i++)
+	{
+		luaL_unref(L, LUA_REGISTRYINDEX, tableRefs_[i]);
+		tableRefs_[i] = LUA_NOREF;
+	}
+}
+
+void LuaCallbacks::reset()
+{
+	for (unsigned int i = 0; i < Callback::COUNT; i++)
+		functionRefs_[i] = LUA_NOREF;
+	for (unsigned int i = 0; i < EventTable::COUNT; i++)
+		tableRefs_[i] = LUA_NOREF;
+}
+
+}
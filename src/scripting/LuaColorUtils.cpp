@@ -25,6 +25,32 @@ void LuaColorUtils::push(lua_State *L, const Colorf &color)
 	LuaUtils::pushField(L, LuaNames::Color::a, color.a());
 }
 
+/*! \note The table at `outIndex` is filled and pushed again, a new table is only created if there is none */
+void LuaColorUtils::push(lua_State *L, const Colorf &color, int outIndex)
+{
+	if (LuaUtils::isTable(L, outIndex) == false)
+	{
+		push(L, color);
+		return;
+	}
+
+	LuaUtils::pushValue(L, outIndex);
+	LuaUtils::pushField(L, LuaNames::Color::r, color.r());
+	LuaUtils::pushField(L, LuaNames::Color::g, color.g());
+	LuaUtils::pushField(L, LuaNames::Color::b, color.b());
+	LuaUtils::pushField(L, LuaNames::Color::a, color.a());
+}
+
+/*! \return The number of values pushed on the stack, one per channel */
+int LuaColorUtils::pushValues(lua_State *L, const Colorf &color)
+{
+	LuaUtils::push(L, color.r());
+	LuaUtils::push(L, color.g());
+	LuaUtils::push(L, color.b());
+	LuaUtils::push(L, color.a());
+	return 4;
+}
+
 void LuaColorUtils::pushField(lua_State *L, const char *name, const Colorf &color)
 {
 	push(L, color);
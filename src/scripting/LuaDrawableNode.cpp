@@ -142,10 +142,10 @@ int LuaDrawableNode::height(lua_State *L)
 
 int LuaDrawableNode::size(lua_State *L)
 {
-	DrawableNode *node = LuaUntrackedUserData<DrawableNode>::retrieve(L, -1);
+	DrawableNode *node = LuaUntrackedUserData<DrawableNode>::retrieve(L, 1);
 
 	if (node)
-		LuaVector2fUtils::push(L, node->size());
+		LuaVector2fUtils::push(L, node->size(), 2);
 	else
 		LuaUtils::pushNil(L);
 
@@ -154,10 +154,10 @@ int LuaDrawableNode::size(lua_State *L)
 
 int LuaDrawableNode::anchorPoint(lua_State *L)
 {
-	DrawableNode *node = LuaUntrackedUserData<DrawableNode>::retrieve(L, -1);
+	DrawableNode *node = LuaUntrackedUserData<DrawableNode>::retrieve(L, 1);
 
 	if (node)
-		LuaVector2fUtils::push(L, node->anchorPoint());
+		LuaVector2fUtils::push(L, node->anchorPoint(), 2);
 	else
 		LuaUtils::pushNil(L);
 
@@ -260,10 +260,10 @@ int LuaDrawableNode::lastFrameRendered(lua_State *L)
 
 int LuaDrawableNode::aabb(lua_State *L)
 {
-	DrawableNode *node = LuaUntrackedUserData<DrawableNode>::retrieve(L, -1);
+	DrawableNode *node = LuaUntrackedUserData<DrawableNode>::retrieve(L, 1);
 
 	if (node)
-		LuaRectfUtils::push(L, node->aabb());
+		LuaRectfUtils::push(L, node->aabb(), 2);
 	else
 		LuaUtils::pushNil(L);
 
@@ -106,6 +106,11 @@ void LuaEventHandler::onFrameStart()
 	LuaIAppEventHandler::onFrameStart(luaState_->state());
 }
 
+void LuaEventHandler::onFixedUpdate(float timeStep)
+{
+	LuaIAppEventHandler::onFixedUpdate(luaState_->state(), timeStep);
+}
+
 void LuaEventHandler::onPostUpdate()
 {
 	LuaIAppEventHandler::onPostUpdate(luaState_->state());
@@ -121,10 +121,10 @@ int LuaFont::base(lua_State *L)
 
 int LuaFont::textureSize(lua_State *L)
 {
-	Font *font = LuaUntrackedUserData<Font>::retrieve(L, -1);
+	Font *font = LuaUntrackedUserData<Font>::retrieve(L, 1);
 
 	if (font)
-		LuaVector2iUtils::push(L, font->textureSize());
+		LuaVector2iUtils::push(L, font->textureSize(), 2);
 	else
 		LuaUtils::pushNil(L);
 
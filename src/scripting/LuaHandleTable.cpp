@@ -0,0 +1,126 @@
+#include "common_macros.h"
+#include "LuaHandleTable.h"
+
+namespace ncine {
+
+///////////////////////////////////////////////////////////
+// STATIC DEFINITIONS
+///////////////////////////////////////////////////////////
+
+const unsigned int LuaHandleTable::IndexBits;
+const unsigned int LuaHandleTable::TypeBits;
+const unsigned int LuaHandleTable::GenerationBits;
+const unsigned int LuaHandleTable::MaxObjects;
+const LuaHandleTable::Handle LuaHandleTable::InvalidHandle;
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+LuaHandleTable::LuaHandleTable(unsigned int capacity)
+    : numTracked_(0), numTypedTracked_(), freeListHead_(0), freeListTail_(0),
+      slots_(capacity + 1), objectHandles_(capacity > 0 ? capacity : 1)
+{
+	// First element reserved, a zero handle is never valid and a zero index terminates the free list
+	slots_.pushBack({ nullptr, InvalidHandle, 0, 0, Tracking::UNTRACKED });
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+/*! \note An untracked object that is already in the table keeps its handle and its type.
+ *  A tracked object replaces a stale untracked one at the same address. */
+LuaHandleTable::Handle LuaHandleTable::add(void *object, LuaTypes::UserDataType type, Tracking tracking)
+{
+	FATAL_ASSERT(object != nullptr);
+	ASSERT(type < LuaTypes::UNKNOWN);
+
+	Handle handle = InvalidHandle;
+	if (objectHandles_.contains(object, handle))
+	{
+		if (tracking == Tracking::UNTRACKED || slots_[index(handle)].tracking == Tracking::TRACKED)
+		{
+			ASSERT(tracking == Tracking::UNTRACKED);
+			return handle;
+		}
+		remove(handle);
+	}
+
+	unsigned int slotIndex = freeListHead_;
+	if (slotIndex != 0)
+	{
+		freeListHead_ = slots_[slotIndex].nextFree;
+		if (freeListHead_ == 0)
+			freeListTail_ = 0;
+	}
+	else
+	{
+		FATAL_ASSERT_MSG_X(slots_.size() <= MaxObjects, "Cannot expose more than %u objects to Lua", MaxObjects);
+		slotIndex = slots_.size();
+		slots_.pushBack({ nullptr, InvalidHandle, 0, 0, Tracking::UNTRACKED });
+	}
+
+	Slot &slot = slots_[slotIndex];
+	slot.object = object;
+	slot.handle = (slot.generation << (IndexBits + TypeBits)) | (static_cast<unsigned int>(type) << IndexBits) | slotIndex;
+	slot.nextFree = 0;
+	slot.tracking = tracking;
+
+	if (objectHandles_.loadFactor() >= 0.8f)
+		objectHandles_.rehash(objectHandles_.capacity() * 2);
+	objectHandles_.insert(object, slot.handle);
+
+	if (tracking == Tracking::TRACKED)
+	{
+		numTracked_++;
+		numTypedTracked_[type]++;
+	}
+
+	return slot.handle;
+}
+
+bool LuaHandleTable::remove(Handle handle)
+{
+	if (isValid(handle) == false)
+		return false;
+
+	const unsigned int slotIndex = index(handle);
+	Slot &slot = slots_[slotIndex];
+
+	if (slot.tracking == Tracking::TRACKED)
+	{
+		LuaTypes::UserDataType type = LuaTypes::UNKNOWN;
+		object(handle, type);
+		ASSERT(numTracked_ > 0 && numTypedTracked_[type] > 0);
+		numTracked_--;
+		numTypedTracked_[type]--;
+	}
+	objectHandles_.remove(slot.object);
+
+	slot.object = nullptr;
+	slot.handle = InvalidHandle;
+	// Every handle pointing to the slot becomes stale
+	slot.generation = (slot.generation + 1) & ((1U << GenerationBits) - 1);
+	slot.nextFree = 0;
+
+	if (freeListTail_ != 0)
+		slots_[freeListTail_].nextFree = slotIndex;
+	else
+		freeListHead_ = slotIndex;
+	freeListTail_ = slotIndex;
+
+	return true;
+}
+
+void LuaHandleTable::removeUntracked()
+{
+	for (unsigned int i = 1; i < slots_.size(); i++)
+	{
+		const Slot &slot = slots_[i];
+		if (slot.handle != InvalidHandle && slot.tracking == Tracking::UNTRACKED)
+			remove(slot.handle);
+	}
+}
+
+}
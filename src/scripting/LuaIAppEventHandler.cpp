@@ -8,6 +8,8 @@
 #include "LuaAppConfiguration.h"
 #include "LuaNames.h"
 #include "LuaUtils.h"
+#include "LuaUntrackedUserData.h"
+#include "LuaCallbacks.h"
 
 #include "tracy.h"
 
@@ -18,6 +20,7 @@ namespace LuaIAppEventHandler {
 	static const char *onPreInit = "on_pre_init";
 	static const char *onInit = "on_init";
 	static const char *onFrameStart = "on_frame_start";
+	static const char *onFixedUpdate = "on_fixed_update";
 	static const char *onPostUpdate = "on_post_update";
 	static const char *onDrawViewport = "on_draw_viewport";
 	static const char *onFrameEnd = "on_frame_end";
@@ -28,26 +31,32 @@ namespace LuaIAppEventHandler {
 }}
 
 namespace {
-	void callFunction(lua_State *L, const char *functionName, bool cannotFindWarning)
+	/// Pushes a cached script function, returns false if it is not defined
+	bool pushFunction(lua_State *L, LuaCallbacks::Callback::Enum callback, const char *functionName, bool cannotFindWarning)
 	{
-		lua_getglobal(L, LuaNames::ncine);
-		const int type = lua_getfield(L, -1, functionName);
+		const bool found = LuaCallbacks::pushFunction(L, callback, functionName);
+		if (found == false && cannotFindWarning)
+			LOGW_X("Cannot find the Lua function \"%s\"", functionName);
+		return found;
+	}
 
-		if (type == LUA_TFUNCTION)
-		{
-			const int status = lua_pcall(L, 0, 0, 0);
-			if (status != LUA_OK)
-			{
-				LOGE_X("Error running Lua function \"%s\" (%s):\n%s", functionName, LuaDebug::statusToString(status), lua_tostring(L, -1));
-				lua_pop(L, 1);
-			}
-		}
-		else
+	/// Calls the function below the arguments on the stack, the results are left on the stack only if the call succeeds
+	bool callFunction(lua_State *L, const char *functionName, int numArgs, int numResults)
+	{
+		const int status = lua_pcall(L, numArgs, numResults, 0);
+		if (status != LUA_OK)
 		{
-			lua_pop(L, 2);
-			if (cannotFindWarning)
-				LOGW_X("Cannot find the Lua function \"%s\"", functionName);
+			LOGE_X("Error running Lua function \"%s\" (%s):\n%s", functionName, LuaDebug::statusToString(status), lua_tostring(L, -1));
+			lua_pop(L, 1);
+			return false;
 		}
+		return true;
+	}
+
+	void callFunction(lua_State *L, LuaCallbacks::Callback::Enum callback, const char *functionName, bool cannotFindWarning)
+	{
+		if (pushFunction(L, callback, functionName, cannotFindWarning))
+			callFunction(L, functionName, 0, 0);
 	}
 }
 
@@ -58,115 +67,88 @@ namespace {
 void LuaIAppEventHandler::onPreInit(lua_State *L, AppConfiguration &config)
 {
 	ZoneScopedN("Lua onPreInit");
-	lua_getglobal(L, LuaNames::ncine);
-	const int type = lua_getfield(L, -1, LuaNames::LuaIAppEventHandler::onPreInit);
-
-	if (type == LUA_TFUNCTION)
+	if (pushFunction(L, LuaCallbacks::Callback::ON_PRE_INIT, LuaNames::LuaIAppEventHandler::onPreInit, true))
 	{
 		LuaAppConfiguration::push(L, config);
-		const int status = lua_pcall(L, 1, 1, 0);
-		if (status != LUA_OK)
+		if (callFunction(L, LuaNames::LuaIAppEventHandler::onPreInit, 1, 1))
 		{
-			LOGE_X("Error running Lua function \"%s\" (%s):\n%s", LuaNames::LuaIAppEventHandler::onPreInit, LuaDebug::statusToString(status), lua_tostring(L, -1));
+			LuaAppConfiguration::retrieveAndSet(L, config);
 			lua_pop(L, 1);
 		}
-		else
-			LuaAppConfiguration::retrieveAndSet(L, config);
-	}
-	else
-	{
-		lua_pop(L, 2);
-		LOGW_X("Cannot find the Lua function \"%s\"", LuaNames::LuaIAppEventHandler::onPreInit);
 	}
 }
 
 void LuaIAppEventHandler::onInit(lua_State *L)
 {
 	ZoneScopedN("Lua onInit");
-	callFunction(L, LuaNames::LuaIAppEventHandler::onInit, true);
+	callFunction(L, LuaCallbacks::Callback::ON_INIT, LuaNames::LuaIAppEventHandler::onInit, true);
 }
 
 void LuaIAppEventHandler::onFrameStart(lua_State *L)
 {
 	ZoneScopedN("Lua onFrameStart");
-	callFunction(L, LuaNames::LuaIAppEventHandler::onFrameStart, false);
+	callFunction(L, LuaCallbacks::Callback::ON_FRAME_START, LuaNames::LuaIAppEventHandler::onFrameStart, false);
+}
+
+void LuaIAppEventHandler::onFixedUpdate(lua_State *L, float timeStep)
+{
+	ZoneScopedN("Lua onFixedUpdate");
+	if (pushFunction(L, LuaCallbacks::Callback::ON_FIXED_UPDATE, LuaNames::LuaIAppEventHandler::onFixedUpdate, false))
+	{
+		LuaUtils::push(L, timeStep);
+		callFunction(L, LuaNames::LuaIAppEventHandler::onFixedUpdate, 1, 0);
+	}
 }
 
 void LuaIAppEventHandler::onPostUpdate(lua_State *L)
 {
 	ZoneScopedN("Lua onPostUpdate");
-	callFunction(L, LuaNames::LuaIAppEventHandler::onPostUpdate, false);
+	callFunction(L, LuaCallbacks::Callback::ON_POST_UPDATE, LuaNames::LuaIAppEventHandler::onPostUpdate, false);
 }
 
 void LuaIAppEventHandler::onDrawViewport(lua_State *L, Viewport &viewport)
 {
 	ZoneScopedN("Lua onDrawViewport");
-	lua_getglobal(L, LuaNames::ncine);
-	const int type = lua_getfield(L, -1, LuaNames::LuaIAppEventHandler::onDrawViewport);
-
-	if (type == LUA_TFUNCTION)
+	if (pushFunction(L, LuaCallbacks::Callback::ON_DRAW_VIEWPORT, LuaNames::LuaIAppEventHandler::onDrawViewport, true))
 	{
-		LuaUtils::push(L, static_cast<void *>(&viewport));
-		const int status = lua_pcall(L, 1, 1, 0);
-		if (status != LUA_OK)
-		{
-			LOGE_X("Error running Lua function \"%s\" (%s):\n%s", LuaNames::LuaIAppEventHandler::onDrawViewport, LuaDebug::statusToString(status), lua_tostring(L, -1));
-			lua_pop(L, 1);
-		}
-	}
-	else
-	{
-		lua_pop(L, 2);
-		LOGW_X("Cannot find the Lua function \"%s\"", LuaNames::LuaIAppEventHandler::onDrawViewport);
+		LuaUntrackedUserData<Viewport>::push(L, &viewport);
+		callFunction(L, LuaNames::LuaIAppEventHandler::onDrawViewport, 1, 0);
 	}
 }
 
 void LuaIAppEventHandler::onFrameEnd(lua_State *L)
 {
 	ZoneScopedN("Lua onFrameEnd");
-	callFunction(L, LuaNames::LuaIAppEventHandler::onFrameEnd, false);
+	callFunction(L, LuaCallbacks::Callback::ON_FRAME_END, LuaNames::LuaIAppEventHandler::onFrameEnd, false);
 }
 
 void LuaIAppEventHandler::onResizeWindow(lua_State *L, int width, int height)
 {
 	ZoneScopedN("Lua onResizeWindow");
-	lua_getglobal(L, LuaNames::ncine);
-	const int type = lua_getfield(L, -1, LuaNames::LuaIAppEventHandler::onResizeWindow);
-
-	if (type == LUA_TFUNCTION)
+	if (pushFunction(L, LuaCallbacks::Callback::ON_RESIZE_WINDOW, LuaNames::LuaIAppEventHandler::onResizeWindow, true))
 	{
 		LuaUtils::push(L, width);
 		LuaUtils::push(L, height);
-		const int status = lua_pcall(L, 2, 1, 0);
-		if (status != LUA_OK)
-		{
-			LOGE_X("Error running Lua function \"%s\" (%s):\n%s", LuaNames::LuaIAppEventHandler::onResizeWindow, LuaDebug::statusToString(status), lua_tostring(L, -1));
-			lua_pop(L, 1);
-		}
-	}
-	else
-	{
-		lua_pop(L, 2);
-		LOGW_X("Cannot find the Lua function \"%s\"", LuaNames::LuaIAppEventHandler::onResizeWindow);
+		callFunction(L, LuaNames::LuaIAppEventHandler::onResizeWindow, 2, 0);
 	}
 }
 
 void LuaIAppEventHandler::onShutdown(lua_State *L)
 {
 	ZoneScopedN("Lua onShutdown");
-	callFunction(L, LuaNames::LuaIAppEventHandler::onShutdown, true);
+	callFunction(L, LuaCallbacks::Callback::ON_SHUTDOWN, LuaNames::LuaIAppEventHandler::onShutdown, true);
 }
 
 void LuaIAppEventHandler::onSuspend(lua_State *L)
 {
 	ZoneScopedN("Lua onSuspend");
-	callFunction(L, LuaNames::LuaIAppEventHandler::onSuspend, true);
+	callFunction(L, LuaCallbacks::Callback::ON_SUSPEND, LuaNames::LuaIAppEventHandler::onSuspend, true);
 }
 
 void LuaIAppEventHandler::onResume(lua_State *L)
 {
 	ZoneScopedN("Lua onResume");
-	callFunction(L, LuaNames::LuaIAppEventHandler::onResume, true);
+	callFunction(L, LuaCallbacks::Callback::ON_RESUME, LuaNames::LuaIAppEventHandler::onResume, true);
 }
 
 }
@@ -8,6 +8,7 @@
 #include "LuaTouchEvents.h"
 #include "LuaDebug.h"
 #include "LuaNames.h"
+#include "LuaCallbacks.h"
 #include "InputEvents.h"
 
 namespace ncine {
@@ -45,468 +46,150 @@ namespace IInputEventHandler {
 	static const char *onQuitRequest = "on_quit_request";
 }}
 
+namespace {
+	/// Calls a cached script function passing it an event table
+	template <class EventType>
+	void callFunction(lua_State *L, LuaCallbacks::Callback::Enum callback, const char *functionName,
+	                  void (*pushEvent)(lua_State *, const EventType &), const EventType &event)
+	{
+		if (LuaCallbacks::pushFunction(L, callback, functionName))
+		{
+			pushEvent(L, event);
+			const int status = lua_pcall(L, 1, 0, 0);
+			if (status != LUA_OK)
+			{
+				LOGE_X("Error running Lua function \"%s\" (%s):\n%s", functionName, LuaDebug::statusToString(status), lua_tostring(L, -1));
+				lua_pop(L, 1);
+			}
+		}
+	}
+}
+
 ///////////////////////////////////////////////////////////
 // PUBLIC FUNCTIONS
 ///////////////////////////////////////////////////////////
 
 void LuaIInputEventHandler::onKeyPressed(lua_State *L, const KeyboardEvent &event)
 {
-	lua_getglobal(L, LuaNames::ncine);
-	const int type = lua_getfield(L, -1, LuaNames::IInputEventHandler::onKeyPressed);
-
-	if (type != LUA_TNIL)
-	{
-		ASSERT(type == LUA_TFUNCTION);
-		LuaKeyboardEvents::pushKeyboardEvent(L, event);
-		const int status = lua_pcall(L, 1, 0, 0);
-		if (status != LUA_OK)
-		{
-			LOGE_X("Error running Lua function \"%s\" (%s):\n%s", LuaNames::IInputEventHandler::onKeyPressed, LuaDebug::statusToString(status), lua_tostring(L, -1));
-			lua_pop(L, 1);
-		}
-	}
-	else
-		lua_pop(L, 2);
+	callFunction(L, LuaCallbacks::Callback::ON_KEY_PRESSED, LuaNames::IInputEventHandler::onKeyPressed, LuaKeyboardEvents::pushKeyboardEvent, event);
 }
 
 void LuaIInputEventHandler::onKeyReleased(lua_State *L, const KeyboardEvent &event)
 {
-	lua_getglobal(L, LuaNames::ncine);
-	const int type = lua_getfield(L, -1, LuaNames::IInputEventHandler::onKeyReleased);
-
-	if (type != LUA_TNIL)
-	{
-		ASSERT(type == LUA_TFUNCTION);
-		LuaKeyboardEvents::pushKeyboardEvent(L, event);
-		const int status = lua_pcall(L, 1, 0, 0);
-		if (status != LUA_OK)
-		{
-			LOGE_X("Error running Lua function \"%s\" (%s):\n%s", LuaNames::IInputEventHandler::onKeyReleased, LuaDebug::statusToString(status), lua_tostring(L, -1));
-			lua_pop(L, 1);
-		}
-	}
-	else
-		lua_pop(L, 2);
+	callFunction(L, LuaCallbacks::Callback::ON_KEY_RELEASED, LuaNames::IInputEventHandler::onKeyReleased, LuaKeyboardEvents::pushKeyboardEvent, event);
 }
 
 void LuaIInputEventHandler::onTextInput(lua_State *L, const TextInputEvent &event)
 {
-	lua_getglobal(L, LuaNames::ncine);
-	const int type = lua_getfield(L, -1, LuaNames::IInputEventHandler::onTextInput);
-
-	if (type != LUA_TNIL)
-	{
-		ASSERT(type == LUA_TFUNCTION);
-		LuaKeyboardEvents::pushTextInputEvent(L, event);
-		const int status = lua_pcall(L, 1, 0, 0);
-		if (status != LUA_OK)
-		{
-			LOGE_X("Error running Lua function \"%s\" (%s):\n%s", LuaNames::IInputEventHandler::onTextInput, LuaDebug::statusToString(status), lua_tostring(L, -1));
-			lua_pop(L, 1);
-		}
-	}
-	else
-		lua_pop(L, 2);
+	callFunction(L, LuaCallbacks::Callback::ON_TEXT_INPUT, LuaNames::IInputEventHandler::onTextInput, LuaKeyboardEvents::pushTextInputEvent, event);
 }
 
 void LuaIInputEventHandler::onTouchDown(lua_State *L, const TouchEvent &event)
 {
-	lua_getglobal(L, LuaNames::ncine);
-	const int type = lua_getfield(L, -1, LuaNames::IInputEventHandler::onTouchDown);
-
-	if (type != LUA_TNIL)
-	{
-		ASSERT(type == LUA_TFUNCTION);
-		LuaTouchEvents::pushTouchEvent(L, event);
-		const int status = lua_pcall(L, 1, 0, 0);
-		if (status != LUA_OK)
-		{
-			LOGE_X("Error running Lua function \"%s\" (%s):\n%s", LuaNames::IInputEventHandler::onTouchDown, LuaDebug::statusToString(status), lua_tostring(L, -1));
-			lua_pop(L, 1);
-		}
-	}
-	else
-		lua_pop(L, 2);
+	callFunction(L, LuaCallbacks::Callback::ON_TOUCH_DOWN, LuaNames::IInputEventHandler::onTouchDown, LuaTouchEvents::pushTouchEvent, event);
 }
 
 void LuaIInputEventHandler::onTouchUp(lua_State *L, const TouchEvent &event)
 {
-	lua_getglobal(L, LuaNames::ncine);
-	const int type = lua_getfield(L, -1, LuaNames::IInputEventHandler::onTouchUp);
-
-	if (type != LUA_TNIL)
-	{
-		ASSERT(type == LUA_TFUNCTION);
-		LuaTouchEvents::pushTouchEvent(L, event);
-		const int status = lua_pcall(L, 1, 0, 0);
-		if (status != LUA_OK)
-		{
-			LOGE_X("Error running Lua function \"%s\" (%s):\n%s", LuaNames::IInputEventHandler::onTouchUp, LuaDebug::statusToString(status), lua_tostring(L, -1));
-			lua_pop(L, 1);
-		}
-	}
-	else
-		lua_pop(L, 2);
+	callFunction(L, LuaCallbacks::Callback::ON_TOUCH_UP, LuaNames::IInputEventHandler::onTouchUp, LuaTouchEvents::pushTouchEvent, event);
 }
 
 void LuaIInputEventHandler::onTouchMove(lua_State *L, const TouchEvent &event)
 {
-	lua_getglobal(L, LuaNames::ncine);
-	const int type = lua_getfield(L, -1, LuaNames::IInputEventHandler::onTouchMove);
-
-	if (type != LUA_TNIL)
-	{
-		ASSERT(type == LUA_TFUNCTION);
-		LuaTouchEvents::pushTouchEvent(L, event);
-		const int status = lua_pcall(L, 1, 0, 0);
-		if (status != LUA_OK)
-		{
-			LOGE_X("Error running Lua function \"%s\" (%s):\n%s", LuaNames::IInputEventHandler::onTouchMove, LuaDebug::statusToString(status), lua_tostring(L, -1));
-			lua_pop(L, 1);
-		}
-	}
-	else
-		lua_pop(L, 2);
+	callFunction(L, LuaCallbacks::Callback::ON_TOUCH_MOVE, LuaNames::IInputEventHandler::onTouchMove, LuaTouchEvents::pushTouchEvent, event);
 }
 
 void LuaIInputEventHandler::onPointerDown(lua_State *L, const TouchEvent &event)
 {
-	lua_getglobal(L, LuaNames::ncine);
-	const int type = lua_getfield(L, -1, LuaNames::IInputEventHandler::onPointerDown);
-
-	if (type != LUA_TNIL)
-	{
-		ASSERT(type == LUA_TFUNCTION);
-		LuaTouchEvents::pushTouchEvent(L, event);
-		const int status = lua_pcall(L, 1, 0, 0);
-		if (status != LUA_OK)
-		{
-			LOGE_X("Error running Lua function \"%s\" (%s):\n%s", LuaNames::IInputEventHandler::onPointerDown, LuaDebug::statusToString(status), lua_tostring(L, -1));
-			lua_pop(L, 1);
-		}
-	}
-	else
-		lua_pop(L, 2);
+	callFunction(L, LuaCallbacks::Callback::ON_POINTER_DOWN, LuaNames::IInputEventHandler::onPointerDown, LuaTouchEvents::pushTouchEvent, event);
 }
 
 void LuaIInputEventHandler::onPointerUp(lua_State *L, const TouchEvent &event)
 {
-	lua_getglobal(L, LuaNames::ncine);
-	const int type = lua_getfield(L, -1, LuaNames::IInputEventHandler::onPointerUp);
-
-	if (type != LUA_TNIL)
-	{
-		ASSERT(type == LUA_TFUNCTION);
-		LuaTouchEvents::pushTouchEvent(L, event);
-		const int status = lua_pcall(L, 1, 0, 0);
-		if (status != LUA_OK)
-		{
-			LOGE_X("Error running Lua function \"%s\" (%s):\n%s", LuaNames::IInputEventHandler::onPointerUp, LuaDebug::statusToString(status), lua_tostring(L, -1));
-			lua_pop(L, 1);
-		}
-	}
-	else
-		lua_pop(L, 2);
+	callFunction(L, LuaCallbacks::Callback::ON_POINTER_UP, LuaNames::IInputEventHandler::onPointerUp, LuaTouchEvents::pushTouchEvent, event);
 }
 
 #ifdef __ANDROID__
 void LuaIInputEventHandler::onAcceleration(lua_State *L, const AccelerometerEvent &event)
 {
-	lua_getglobal(L, LuaNames::ncine);
-	const int type = lua_getfield(L, -1, LuaNames::IInputEventHandler::onAcceleration);
-
-	if (type != LUA_TNIL)
-	{
-		ASSERT(type == LUA_TFUNCTION);
-		LuaTouchEvents::pushAccelerometerEvent(L, event);
-		const int status = lua_pcall(L, 1, 0, 0);
-		if (status != LUA_OK)
-		{
-			LOGE_X("Error running Lua function \"%s\" (%s):\n%s", LuaNames::IInputEventHandler::onAcceleration, LuaDebug::statusToString(status), lua_tostring(L, -1));
-			lua_pop(L, 1);
-		}
-	}
-	else
-		lua_pop(L, 2);
+	callFunction(L, LuaCallbacks::Callback::ON_ACCELERATION, LuaNames::IInputEventHandler::onAcceleration, LuaTouchEvents::pushAccelerometerEvent, event);
 }
 #endif
 
 void LuaIInputEventHandler::onMouseButtonPressed(lua_State *L, const MouseEvent &event)
 {
-	lua_getglobal(L, LuaNames::ncine);
-	const int type = lua_getfield(L, -1, LuaNames::IInputEventHandler::onMouseButtonPressed);
-
-	if (type != LUA_TNIL)
-	{
-		ASSERT(type == LUA_TFUNCTION);
-		LuaMouseEvents::pushMouseEvent(L, event);
-		const int status = lua_pcall(L, 1, 0, 0);
-		if (status != LUA_OK)
-		{
-			LOGE_X("Error running Lua function \"%s\" (%s):\n%s", LuaNames::IInputEventHandler::onMouseButtonPressed, LuaDebug::statusToString(status), lua_tostring(L, -1));
-			lua_pop(L, 1);
-		}
-	}
-	else
-		lua_pop(L, 2);
+	callFunction(L, LuaCallbacks::Callback::ON_MOUSE_BUTTON_PRESSED, LuaNames::IInputEventHandler::onMouseButtonPressed, LuaMouseEvents::pushMouseEvent, event);
 }
 
 void LuaIInputEventHandler::onMouseButtonReleased(lua_State *L, const MouseEvent &event)
 {
-	lua_getglobal(L, LuaNames::ncine);
-	const int type = lua_getfield(L, -1, LuaNames::IInputEventHandler::onMouseButtonReleased);
-
-	if (type != LUA_TNIL)
-	{
-		ASSERT(type == LUA_TFUNCTION);
-		LuaMouseEvents::pushMouseEvent(L, event);
-		const int status = lua_pcall(L, 1, 0, 0);
-		if (status != LUA_OK)
-		{
-			LOGE_X("Error running Lua function \"%s\" (%s):\n%s", LuaNames::IInputEventHandler::onMouseButtonReleased, LuaDebug::statusToString(status), lua_tostring(L, -1));
-			lua_pop(L, 1);
-		}
-	}
-	else
-		lua_pop(L, 2);
+	callFunction(L, LuaCallbacks::Callback::ON_MOUSE_BUTTON_RELEASED, LuaNames::IInputEventHandler::onMouseButtonReleased, LuaMouseEvents::pushMouseEvent, event);
 }
 
 void LuaIInputEventHandler::onMouseMoved(lua_State *L, const MouseState &state)
 {
-	lua_getglobal(L, LuaNames::ncine);
-	const int type = lua_getfield(L, -1, LuaNames::IInputEventHandler::onMouseMoved);
-
-	if (type != LUA_TNIL)
-	{
-		ASSERT(type == LUA_TFUNCTION);
-		LuaMouseEvents::pushMouseState(L, state);
-		const int status = lua_pcall(L, 1, 0, 0);
-		if (status != LUA_OK)
-		{
-			LOGE_X("Error running Lua function \"%s\" (%s):\n%s", LuaNames::IInputEventHandler::onMouseMoved, LuaDebug::statusToString(status), lua_tostring(L, -1));
-			lua_pop(L, 1);
-		}
-	}
-	else
-		lua_pop(L, 2);
+	callFunction(L, LuaCallbacks::Callback::ON_MOUSE_MOVED, LuaNames::IInputEventHandler::onMouseMoved, LuaMouseEvents::pushMouseStateEvent, state);
 }
 
 void LuaIInputEventHandler::onScrollInput(lua_State *L, const ScrollEvent &event)
 {
-	lua_getglobal(L, LuaNames::ncine);
-	const int type = lua_getfield(L, -1, LuaNames::IInputEventHandler::onScrollInput);
-
-	if (type != LUA_TNIL)
-	{
-		ASSERT(type == LUA_TFUNCTION);
-		LuaMouseEvents::pushScrollEvent(L, event);
-		const int status = lua_pcall(L, 1, 0, 0);
-		if (status != LUA_OK)
-		{
-			LOGE_X("Error running Lua function \"%s\" (%s):\n%s", LuaNames::IInputEventHandler::onScrollInput, LuaDebug::statusToString(status), lua_tostring(L, -1));
-			lua_pop(L, 1);
-		}
-	}
-	else
-		lua_pop(L, 2);
+	callFunction(L, LuaCallbacks::Callback::ON_SCROLL_INPUT, LuaNames::IInputEventHandler::onScrollInput, LuaMouseEvents::pushScrollEvent, event);
 }
 
 void LuaIInputEventHandler::onJoyButtonPressed(lua_State *L, const JoyButtonEvent &event)
 {
-	lua_getglobal(L, LuaNames::ncine);
-	const int type = lua_getfield(L, -1, LuaNames::IInputEventHandler::onJoyButtonPressed);
-
-	if (type != LUA_TNIL)
-	{
-		ASSERT(type == LUA_TFUNCTION);
-		LuaJoystickEvents::pushJoyButtonEvent(L, event);
-		const int status = lua_pcall(L, 1, 0, 0);
-		if (status != LUA_OK)
-		{
-			LOGE_X("Error running Lua function \"%s\" (%s):\n%s", LuaNames::IInputEventHandler::onJoyButtonPressed, LuaDebug::statusToString(status), lua_tostring(L, -1));
-			lua_pop(L, 1);
-		}
-	}
-	else
-		lua_pop(L, 2);
+	callFunction(L, LuaCallbacks::Callback::ON_JOY_BUTTON_PRESSED, LuaNames::IInputEventHandler::onJoyButtonPressed, LuaJoystickEvents::pushJoyButtonEvent, event);
 }
 
 void LuaIInputEventHandler::onJoyButtonReleased(lua_State *L, const JoyButtonEvent &event)
 {
-	lua_getglobal(L, LuaNames::ncine);
-	const int type = lua_getfield(L, -1, LuaNames::IInputEventHandler::onJoyButtonReleased);
-
-	if (type != LUA_TNIL)
-	{
-		ASSERT(type == LUA_TFUNCTION);
-		LuaJoystickEvents::pushJoyButtonEvent(L, event);
-		const int status = lua_pcall(L, 1, 0, 0);
-		if (status != LUA_OK)
-		{
-			LOGE_X("Error running Lua function \"%s\" (%s):\n%s", LuaNames::IInputEventHandler::onJoyButtonReleased, LuaDebug::statusToString(status), lua_tostring(L, -1));
-			lua_pop(L, 1);
-		}
-	}
-	else
-		lua_pop(L, 2);
+	callFunction(L, LuaCallbacks::Callback::ON_JOY_BUTTON_RELEASED, LuaNames::IInputEventHandler::onJoyButtonReleased, LuaJoystickEvents::pushJoyButtonEvent, event);
 }
 
 void LuaIInputEventHandler::onJoyHatMoved(lua_State *L, const JoyHatEvent &event)
 {
-	lua_getglobal(L, LuaNames::ncine);
-	const int type = lua_getfield(L, -1, LuaNames::IInputEventHandler::onJoyHatMoved);
-
-	if (type != LUA_TNIL)
-	{
-		ASSERT(type == LUA_TFUNCTION);
-		LuaJoystickEvents::pushJoyHatEvent(L, event);
-		const int status = lua_pcall(L, 1, 0, 0);
-		if (status != LUA_OK)
-		{
-			LOGE_X("Error running Lua function \"%s\" (%s):\n%s", LuaNames::IInputEventHandler::onJoyHatMoved, LuaDebug::statusToString(status), lua_tostring(L, -1));
-			lua_pop(L, 1);
-		}
-	}
-	else
-		lua_pop(L, 2);
+	callFunction(L, LuaCallbacks::Callback::ON_JOY_HAT_MOVED, LuaNames::IInputEventHandler::onJoyHatMoved, LuaJoystickEvents::pushJoyHatEvent, event);
 }
 
 void LuaIInputEventHandler::onJoyAxisMoved(lua_State *L, const JoyAxisEvent &event)
 {
-	lua_getglobal(L, LuaNames::ncine);
-	const int type = lua_getfield(L, -1, LuaNames::IInputEventHandler::onJoyAxisMoved);
-
-	if (type != LUA_TNIL)
-	{
-		ASSERT(type == LUA_TFUNCTION);
-		LuaJoystickEvents::pushJoyAxisEvent(L, event);
-		const int status = lua_pcall(L, 1, 0, 0);
-		if (status != LUA_OK)
-		{
-			LOGE_X("Error running Lua function \"%s\" (%s):\n%s", LuaNames::IInputEventHandler::onJoyAxisMoved, LuaDebug::statusToString(status), lua_tostring(L, -1));
-			lua_pop(L, 1);
-		}
-	}
-	else
-		lua_pop(L, 2);
+	callFunction(L, LuaCallbacks::Callback::ON_JOY_AXIS_MOVED, LuaNames::IInputEventHandler::onJoyAxisMoved, LuaJoystickEvents::pushJoyAxisEvent, event);
 }
 
 void LuaIInputEventHandler::onJoyMappedButtonPressed(lua_State *L, const JoyMappedButtonEvent &event)
 {
-	lua_getglobal(L, LuaNames::ncine);
-	const int type = lua_getfield(L, -1, LuaNames::IInputEventHandler::onJoyMappedButtonPressed);
-
-	if (type != LUA_TNIL)
-	{
-		ASSERT(type == LUA_TFUNCTION);
-		LuaJoystickEvents::pushJoyMappedButtonEvent(L, event);
-		const int status = lua_pcall(L, 1, 0, 0);
-		if (status != LUA_OK)
-		{
-			LOGE_X("Error running Lua function \"%s\" (%s):\n%s", LuaNames::IInputEventHandler::onJoyMappedButtonPressed, LuaDebug::statusToString(status), lua_tostring(L, -1));
-			lua_pop(L, 1);
-		}
-	}
-	else
-		lua_pop(L, 2);
+	callFunction(L, LuaCallbacks::Callback::ON_JOYMAPPED_BUTTON_PRESSED, LuaNames::IInputEventHandler::onJoyMappedButtonPressed, LuaJoystickEvents::pushJoyMappedButtonEvent, event);
 }
 
 void LuaIInputEventHandler::onJoyMappedButtonReleased(lua_State *L, const JoyMappedButtonEvent &event)
 {
-	lua_getglobal(L, LuaNames::ncine);
-	const int type = lua_getfield(L, -1, LuaNames::IInputEventHandler::onJoyMappedButtonReleased);
-
-	if (type != LUA_TNIL)
-	{
-		ASSERT(type == LUA_TFUNCTION);
-		LuaJoystickEvents::pushJoyMappedButtonEvent(L, event);
-		const int status = lua_pcall(L, 1, 0, 0);
-		if (status != LUA_OK)
-		{
-			LOGE_X("Error running Lua function \"%s\" (%s):\n%s", LuaNames::IInputEventHandler::onJoyMappedButtonReleased, LuaDebug::statusToString(status), lua_tostring(L, -1));
-			lua_pop(L, 1);
-		}
-	}
-	else
-		lua_pop(L, 2);
+	callFunction(L, LuaCallbacks::Callback::ON_JOYMAPPED_BUTTON_RELEASED, LuaNames::IInputEventHandler::onJoyMappedButtonReleased, LuaJoystickEvents::pushJoyMappedButtonEvent, event);
 }
 
 void LuaIInputEventHandler::onJoyMappedAxisMoved(lua_State *L, const JoyMappedAxisEvent &event)
 {
-	lua_getglobal(L, LuaNames::ncine);
-	const int type = lua_getfield(L, -1, LuaNames::IInputEventHandler::onJoyMappedAxisMoved);
-
-	if (type != LUA_TNIL)
-	{
-		ASSERT(type == LUA_TFUNCTION);
-		LuaJoystickEvents::pushJoyMappedAxisEvent(L, event);
-		const int status = lua_pcall(L, 1, 0, 0);
-		if (status != LUA_OK)
-		{
-			LOGE_X("Error running Lua function \"%s\" (%s):\n%s", LuaNames::IInputEventHandler::onJoyMappedAxisMoved, LuaDebug::statusToString(status), lua_tostring(L, -1));
-			lua_pop(L, 1);
-		}
-	}
-	else
-		lua_pop(L, 2);
+	callFunction(L, LuaCallbacks::Callback::ON_JOYMAPPED_AXIS_MOVED, LuaNames::IInputEventHandler::onJoyMappedAxisMoved, LuaJoystickEvents::pushJoyMappedAxisEvent, event);
 }
 
 void LuaIInputEventHandler::onJoyConnected(lua_State *L, const JoyConnectionEvent &event)
 {
-	lua_getglobal(L, LuaNames::ncine);
-	const int type = lua_getfield(L, -1, LuaNames::IInputEventHandler::onJoyConnected);
-
-	if (type != LUA_TNIL)
-	{
-		ASSERT(type == LUA_TFUNCTION);
-		LuaJoystickEvents::pushJoyConnectionEvent(L, event);
-		const int status = lua_pcall(L, 1, 0, 0);
-		if (status != LUA_OK)
-		{
-			LOGE_X("Error running Lua function \"%s\" (%s):\n%s", LuaNames::IInputEventHandler::onJoyConnected, LuaDebug::statusToString(status), lua_tostring(L, -1));
-			lua_pop(L, 1);
-		}
-	}
-	else
-		lua_pop(L, 2);
+	callFunction(L, LuaCallbacks::Callback::ON_JOY_CONNECTED, LuaNames::IInputEventHandler::onJoyConnected, LuaJoystickEvents::pushJoyConnectionEvent, event);
 }
 
 void LuaIInputEventHandler::onJoyDisconnected(lua_State *L, const JoyConnectionEvent &event)
 {
-	lua_getglobal(L, LuaNames::ncine);
-	const int type = lua_getfield(L, -1, LuaNames::IInputEventHandler::onJoyDisconnected);
-
-	if (type != LUA_TNIL)
-	{
-		ASSERT(type == LUA_TFUNCTION);
-		LuaJoystickEvents::pushJoyConnectionEvent(L, event);
-		const int status = lua_pcall(L, 1, 0, 0);
-		if (status != LUA_OK)
-		{
-			LOGE_X("Error running Lua function \"%s\" (%s):\n%s", LuaNames::IInputEventHandler::onJoyDisconnected, LuaDebug::statusToString(status), lua_tostring(L, -1));
-			lua_pop(L, 1);
-		}
-	}
-	else
-		lua_pop(L, 2);
+	callFunction(L, LuaCallbacks::Callback::ON_JOY_DISCONNECTED, LuaNames::IInputEventHandler::onJoyDisconnected, LuaJoystickEvents::pushJoyConnectionEvent, event);
 }
 
 bool LuaIInputEventHandler::onQuitRequest(lua_State *L)
 {
 	bool shouldQuit = true;
 
-	lua_getglobal(L, LuaNames::ncine);
-	const int type = lua_getfield(L, -1, LuaNames::IInputEventHandler::onQuitRequest);
-
-	if (type != LUA_TNIL)
+	if (LuaCallbacks::pushFunction(L, LuaCallbacks::Callback::ON_QUIT_REQUEST, LuaNames::IInputEventHandler::onQuitRequest))
 	{
-		ASSERT(type == LUA_TFUNCTION);
 		const int status = lua_pcall(L, 0, 1, 0);
 		if (status != LUA_OK)
-		{
 			LOGE_X("Error running Lua function \"%s\" (%s):\n%s", LuaNames::IInputEventHandler::onQuitRequest, LuaDebug::statusToString(status), lua_tostring(L, -1));
-			lua_pop(L, 1);
-		}
 		else
 		{
 			if (lua_isboolean(L, -1) == false)
@@ -514,9 +197,8 @@ bool LuaIInputEventHandler::onQuitRequest(lua_State *L)
 			else
 				shouldQuit = lua_toboolean(L, -1);
 		}
+		lua_pop(L, 1);
 	}
-	else
-		lua_pop(L, 2);
 
 	return shouldQuit;
 }
@@ -111,7 +111,7 @@ void LuaIInputManager::exposeConstants(lua_State *L)
 
 int LuaIInputManager::mouseState(lua_State *L)
 {
-	LuaMouseEvents::pushMouseState(L, theApplication().inputManager().mouseState());
+	LuaMouseEvents::pushMouseState(L, theApplication().inputManager().mouseState(), 1);
 	return 1;
 }
 
@@ -4,6 +4,7 @@
 #include "LuaJoystickEvents.h"
 #include "LuaUntrackedUserData.h"
 #include "LuaNames.h"
+#include "LuaCallbacks.h"
 #include "InputEvents.h"
 
 namespace ncine {
@@ -138,14 +139,14 @@ void LuaJoystickEvents::exposeConstants(lua_State *L)
 
 void LuaJoystickEvents::pushJoyButtonEvent(lua_State *L, const JoyButtonEvent &event)
 {
-	lua_createtable(L, 0, 2);
+	LuaCallbacks::pushEventTable(L, LuaCallbacks::EventTable::JOY_BUTTON, 2);
 	LuaUtils::pushField(L, LuaNames::LuaJoystickEvents::joyId, event.joyId);
 	LuaUtils::pushField(L, LuaNames::LuaJoystickEvents::buttonId, event.buttonId);
 }
 
 void LuaJoystickEvents::pushJoyHatEvent(lua_State *L, const JoyHatEvent &event)
 {
-	lua_createtable(L, 0, 3);
+	LuaCallbacks::pushEventTable(L, LuaCallbacks::EventTable::JOY_HAT, 3);
 	LuaUtils::pushField(L, LuaNames::LuaJoystickEvents::joyId, event.joyId);
 	LuaUtils::pushField(L, LuaNames::LuaJoystickEvents::hatId, event.hatId);
 	LuaUtils::pushField(L, LuaNames::LuaJoystickEvents::hatState, event.hatState);
@@ -153,7 +154,7 @@ void LuaJoystickEvents::pushJoyHatEvent(lua_State *L, const JoyHatEvent &event)
 
 void LuaJoystickEvents::pushJoyAxisEvent(lua_State *L, const JoyAxisEvent &event)
 {
-	lua_createtable(L, 0, 4);
+	LuaCallbacks::pushEventTable(L, LuaCallbacks::EventTable::JOY_AXIS, 4);
 	LuaUtils::pushField(L, LuaNames::LuaJoystickEvents::joyId, event.joyId);
 	LuaUtils::pushField(L, LuaNames::LuaJoystickEvents::axisId, event.axisId);
 	LuaUtils::pushField(L, LuaNames::LuaJoystickEvents::value, event.value);
@@ -162,14 +163,14 @@ void LuaJoystickEvents::pushJoyAxisEvent(lua_State *L, const JoyAxisEvent &event
 
 void LuaJoystickEvents::pushJoyMappedButtonEvent(lua_State *L, const JoyMappedButtonEvent &event)
 {
-	lua_createtable(L, 0, 2);
+	LuaCallbacks::pushEventTable(L, LuaCallbacks::EventTable::JOY_MAPPED_BUTTON, 2);
 	LuaUtils::pushField(L, LuaNames::LuaJoystickEvents::joyId, event.joyId);
 	LuaUtils::pushField(L, LuaNames::LuaJoystickEvents::buttonName, static_cast<int64_t>(event.buttonName));
 }
 
 void LuaJoystickEvents::pushJoyMappedAxisEvent(lua_State *L, const JoyMappedAxisEvent &event)
 {
-	lua_createtable(L, 0, 3);
+	LuaCallbacks::pushEventTable(L, LuaCallbacks::EventTable::JOY_MAPPED_AXIS, 3);
 	LuaUtils::pushField(L, LuaNames::LuaJoystickEvents::joyId, event.joyId);
 	LuaUtils::pushField(L, LuaNames::LuaJoystickEvents::axisName, static_cast<int64_t>(event.axisName));
 	LuaUtils::pushField(L, LuaNames::LuaJoystickEvents::value, event.value);
@@ -177,7 +178,7 @@ void LuaJoystickEvents::pushJoyMappedAxisEvent(lua_State *L, const JoyMappedAxis
 
 void LuaJoystickEvents::pushJoyConnectionEvent(lua_State *L, const JoyConnectionEvent &event)
 {
-	lua_createtable(L, 0, 1);
+	LuaCallbacks::pushEventTable(L, LuaCallbacks::EventTable::JOY_CONNECTION, 1);
 	LuaUtils::pushField(L, LuaNames::LuaJoystickEvents::joyId, event.joyId);
 }
 
@@ -189,8 +190,9 @@ int LuaJoystickEvents::isButtonPressed(lua_State *L)
 {
 	bool isButtonPressed = false;
 
-	void *pointer = LuaUtils::retrieveUserData<void *>(L, -2);
-	const LuaTypes::UserDataType type = LuaStateManager::manager(L)->untrackedType(pointer);
+	LuaTypes::UserDataType type = LuaTypes::UNKNOWN;
+	const LuaHandleTable::Handle handle = LuaHandleTable::toHandle(LuaUtils::retrieveUserData<void>(L, -2));
+	void *pointer = LuaStateManager::manager(L)->handles().object(handle, type);
 
 	if (type == LuaTypes::JOYSTICKSTATE)
 	{
@@ -218,8 +220,9 @@ int LuaJoystickEvents::hatState(lua_State *L)
 {
 	unsigned char hatState = HatState::CENTERED;
 
-	void *pointer = LuaUtils::retrieveUserData<void *>(L, -2);
-	const LuaTypes::UserDataType type = LuaStateManager::manager(L)->untrackedType(pointer);
+	LuaTypes::UserDataType type = LuaTypes::UNKNOWN;
+	const LuaHandleTable::Handle handle = LuaHandleTable::toHandle(LuaUtils::retrieveUserData<void>(L, -2));
+	void *pointer = LuaStateManager::manager(L)->handles().object(handle, type);
 
 	if (type == LuaTypes::JOYSTICKSTATE)
 	{
@@ -240,8 +243,9 @@ int LuaJoystickEvents::axisValue(lua_State *L)
 {
 	float axisValue = 0.0f;
 
-	void *pointer = LuaUtils::retrieveUserData<void *>(L, -2);
-	const LuaTypes::UserDataType type = LuaStateManager::manager(L)->untrackedType(pointer);
+	LuaTypes::UserDataType type = LuaTypes::UNKNOWN;
+	const LuaHandleTable::Handle handle = LuaHandleTable::toHandle(LuaUtils::retrieveUserData<void>(L, -2));
+	void *pointer = LuaStateManager::manager(L)->handles().object(handle, type);
 
 	if (type == LuaTypes::JOYSTICKSTATE)
 	{
@@ -4,6 +4,7 @@
 #include "LuaKeyboardEvents.h"
 #include "LuaUntrackedUserData.h"
 #include "LuaNames.h"
+#include "LuaCallbacks.h"
 #include "InputEvents.h"
 
 namespace ncine {
@@ -41,7 +42,7 @@ void LuaKeyboardEvents::expose(lua_State *L)
 
 void LuaKeyboardEvents::pushKeyboardEvent(lua_State *L, const KeyboardEvent &event)
 {
-	lua_createtable(L, 0, 3);
+	LuaCallbacks::pushEventTable(L, LuaCallbacks::EventTable::KEYBOARD, 3);
 	LuaUtils::pushField(L, LuaNames::LuaKeyboardEvents::scancode, event.scancode);
 	LuaUtils::pushField(L, LuaNames::LuaKeyboardEvents::sym, static_cast<int64_t>(event.sym));
 	LuaUtils::pushField(L, LuaNames::LuaKeyboardEvents::mod, event.mod);
@@ -49,7 +50,7 @@ void LuaKeyboardEvents::pushKeyboardEvent(lua_State *L, const KeyboardEvent &eve
 
 void LuaKeyboardEvents::pushTextInputEvent(lua_State *L, const TextInputEvent &event)
 {
-	lua_createtable(L, 0, 1);
+	LuaCallbacks::pushEventTable(L, LuaCallbacks::EventTable::TEXT_INPUT, 1);
 	LuaUtils::pushField(L, LuaNames::LuaKeyboardEvents::text, event.text);
 }
 
@@ -3,6 +3,7 @@
 
 #include "LuaMouseEvents.h"
 #include "LuaUtils.h"
+#include "LuaCallbacks.h"
 #include "InputEvents.h"
 
 namespace ncine {
@@ -41,6 +42,17 @@ namespace {
 		FIFTH
 	};
 
+	void setMouseStateFields(lua_State *L, const MouseState &state)
+	{
+		LuaUtils::pushField(L, LuaNames::LuaMouseEvents::x, state.x);
+		LuaUtils::pushField(L, LuaNames::LuaMouseEvents::y, state.y);
+		LuaUtils::pushField(L, LuaNames::LuaMouseEvents::isLeftButtonDown, state.isLeftButtonDown());
+		LuaUtils::pushField(L, LuaNames::LuaMouseEvents::isMiddleButtonDown, state.isMiddleButtonDown());
+		LuaUtils::pushField(L, LuaNames::LuaMouseEvents::isRightButtonDown, state.isRightButtonDown());
+		LuaUtils::pushField(L, LuaNames::LuaMouseEvents::isFourthButtonDown, state.isFourthButtonDown());
+		LuaUtils::pushField(L, LuaNames::LuaMouseEvents::isFifthButtonDown, state.isFifthButtonDown());
+	}
+
 }
 
 void LuaMouseEvents::exposeConstants(lua_State *L)
@@ -58,7 +70,7 @@ void LuaMouseEvents::exposeConstants(lua_State *L)
 
 void LuaMouseEvents::pushMouseEvent(lua_State *L, const MouseEvent &event)
 {
-	lua_createtable(L, 0, 3);
+	LuaCallbacks::pushEventTable(L, LuaCallbacks::EventTable::MOUSE, 3);
 	LuaUtils::pushField(L, LuaNames::LuaMouseEvents::x, event.x);
 	LuaUtils::pushField(L, LuaNames::LuaMouseEvents::y, event.y);
 	if (event.isLeftButton())
@@ -71,23 +83,39 @@ void LuaMouseEvents::pushMouseEvent(lua_State *L, const MouseEvent &event)
 		LuaUtils::pushField(L, LuaNames::LuaMouseEvents::button, static_cast<int64_t>(MouseButton::FOURTH));
 	else if (event.isFifthButton())
 		LuaUtils::pushField(L, LuaNames::LuaMouseEvents::button, static_cast<int64_t>(MouseButton::FIFTH));
+	else
+		LuaUtils::pushFieldNil(L, LuaNames::LuaMouseEvents::button);
 }
 
 void LuaMouseEvents::pushMouseState(lua_State *L, const MouseState &state)
 {
 	lua_createtable(L, 0, 7);
-	LuaUtils::pushField(L, LuaNames::LuaMouseEvents::x, state.x);
-	LuaUtils::pushField(L, LuaNames::LuaMouseEvents::y, state.y);
-	LuaUtils::pushField(L, LuaNames::LuaMouseEvents::isLeftButtonDown, state.isLeftButtonDown());
-	LuaUtils::pushField(L, LuaNames::LuaMouseEvents::isMiddleButtonDown, state.isMiddleButtonDown());
-	LuaUtils::pushField(L, LuaNames::LuaMouseEvents::isRightButtonDown, state.isRightButtonDown());
-	LuaUtils::pushField(L, LuaNames::LuaMouseEvents::isFourthButtonDown, state.isFourthButtonDown());
-	LuaUtils::pushField(L, LuaNames::LuaMouseEvents::isFifthButtonDown, state.isFifthButtonDown());
+	setMouseStateFields(L, state);
+}
+
+/*! \note The table at `outIndex` is filled and pushed again, a new table is only created if there is none */
+void LuaMouseEvents::pushMouseState(lua_State *L, const MouseState &state, int outIndex)
+{
+	if (LuaUtils::isTable(L, outIndex) == false)
+	{
+		pushMouseState(L, state);
+		return;
+	}
+
+	LuaUtils::pushValue(L, outIndex);
+	setMouseStateFields(L, state);
+}
+
+/*! \note The table is reused by every mouse moved event, a script should not keep a reference to it */
+void LuaMouseEvents::pushMouseStateEvent(lua_State *L, const MouseState &state)
+{
+	LuaCallbacks::pushEventTable(L, LuaCallbacks::EventTable::MOUSE_STATE, 7);
+	setMouseStateFields(L, state);
 }
 
 void LuaMouseEvents::pushScrollEvent(lua_State *L, const ScrollEvent &event)
 {
-	lua_createtable(L, 0, 2);
+	LuaCallbacks::pushEventTable(L, LuaCallbacks::EventTable::SCROLL, 2);
 	LuaUtils::pushField(L, LuaNames::LuaMouseEvents::x, event.x);
 	LuaUtils::pushField(L, LuaNames::LuaMouseEvents::y, event.y);
 }
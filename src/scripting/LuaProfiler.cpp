@@ -0,0 +1,350 @@
+#define NCINE_INCLUDE_LUA
+#include "common_headers.h"
+#include "common_macros.h"
+#include <nctl/algorithms.h>
+#include <nctl/HashMapIterator.h>
+
+#include "LuaProfiler.h"
+#include "Clock.h"
+#include "Timer.h"
+#include "Thread.h"
+#include "FileSystem.h"
+#include "IFile.h"
+
+namespace ncine {
+
+namespace {
+	/// The address of this variable is the registry key of the profiler of a Lua state
+	const char RegistryKey = 0;
+}
+
+///////////////////////////////////////////////////////////
+// STATIC DEFINITIONS
+///////////////////////////////////////////////////////////
+
+const unsigned int LuaProfiler::MaxSamples;
+const unsigned int LuaProfiler::MaxStackDepth;
+const float LuaProfiler::DefaultInterval = 0.005f;
+const int LuaProfiler::CountHookPeriod;
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+LuaProfiler::LuaProfiler(lua_State *L)
+    : L_(L), running_(false), interval_(DefaultInterval), intervalTicks_(0), nextSampleTicks_(0), sampledTime_(0.0),
+      writeIndex_(0), clearIndex_(0), functions_(64), functionIndices_(128)
+{
+	ASSERT(L_);
+
+	// Hooks only receive the state of the running coroutine, the profiler is found through the shared registry
+	lua_pushlightuserdata(L_, this);
+	lua_rawsetp(L_, LUA_REGISTRYINDEX, &RegistryKey);
+}
+
+/*! \note The Lua state should still be open when the profiler is destroyed */
+LuaProfiler::~LuaProfiler()
+{
+	stop();
+	lua_pushnil(L_);
+	lua_rawsetp(L_, LUA_REGISTRYINDEX, &RegistryKey);
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+/*! \note The samples in the buffer are kept, but they are all weighted by the new interval */
+void LuaProfiler::start(float interval)
+{
+	ASSERT(interval > 0.0f);
+	if (running_)
+		stop();
+
+	if (samples_ == nullptr)
+		samples_ = nctl::makeUnique<Sample[]>(MaxSamples);
+
+	interval_ = interval;
+	intervalTicks_ = static_cast<uint64_t>(interval * clock().frequency());
+	if (intervalTicks_ == 0)
+		intervalTicks_ = 1;
+	running_ = true;
+
+#ifdef WITH_THREADS
+	sampleDue_.store(0, nctl::Atomic32::MemoryModel::RELAXED);
+	timerRunning_.store(1, nctl::Atomic32::MemoryModel::RELEASE);
+	timerThread_ = nctl::makeUnique<Thread>(timerFunction, this);
+	#if !defined(__EMSCRIPTEN__) && !defined(__APPLE__)
+	timerThread_->setName("LuaProfiler");
+	#endif
+#else
+	nextSampleTicks_ = clock().counter() + intervalTicks_;
+#endif
+	// Hooks can only be set by the thread running the scripts, the timer thread never touches the state
+	lua_sethook(L_, sampleHook, LUA_MASKCOUNT, CountHookPeriod);
+}
+
+void LuaProfiler::stop()
+{
+	if (running_ == false)
+		return;
+
+#ifdef WITH_THREADS
+	timerRunning_.store(0, nctl::Atomic32::MemoryModel::RELEASE);
+	timerThread_->join();
+	timerThread_.reset(nullptr);
+#endif
+	lua_sethook(L_, nullptr, 0, 0);
+	running_ = false;
+}
+
+void LuaProfiler::clear()
+{
+	clearIndex_ = writeIndex_;
+	// No sample refers to the functions anymore
+	functions_.clear();
+	functionIndices_.clear();
+}
+
+unsigned int LuaProfiler::numSamples() const
+{
+	return static_cast<unsigned int>(writeIndex_ - firstIndex());
+}
+
+void LuaProfiler::report(nctl::Array<FunctionStats> &stats) const
+{
+	stats.clear();
+	const unsigned int numFunctions = functions_.size();
+	if (numFunctions == 0)
+		return;
+
+	nctl::Array<unsigned int> selfSamples(numFunctions);
+	nctl::Array<unsigned int> totalSamples(numFunctions);
+	// The last sample where a function has been counted, so that recursive calls are counted once
+	nctl::Array<unsigned long int> lastSample(numFunctions);
+	selfSamples.setSize(numFunctions);
+	totalSamples.setSize(numFunctions);
+	lastSample.setSize(numFunctions);
+	for (unsigned int i = 0; i < numFunctions; i++)
+	{
+		selfSamples[i] = 0;
+		totalSamples[i] = 0;
+		lastSample[i] = writeIndex_;
+	}
+
+	for (unsigned long int index = firstIndex(); index < writeIndex_; index++)
+	{
+		const Sample &sample = samples_[index % MaxSamples];
+		selfSamples[sample.frames[0].function]++;
+		for (unsigned int i = 0; i < sample.depth; i++)
+		{
+			const uint32_t function = sample.frames[i].function;
+			if (lastSample[function] != index)
+			{
+				totalSamples[function]++;
+				lastSample[function] = index;
+			}
+		}
+	}
+
+	for (unsigned int i = 0; i < numFunctions; i++)
+	{
+		if (totalSamples[i] > 0)
+			stats.pushBack({ functions_[i].name.data(), selfSamples[i], totalSamples[i], selfSamples[i] * interval_, totalSamples[i] * interval_ });
+	}
+
+	nctl::quicksort(stats.begin(), stats.end(), [](const FunctionStats &a, const FunctionStats &b) {
+		return (a.selfSamples != b.selfSamples) ? a.selfSamples > b.selfSamples : a.totalSamples > b.totalSamples;
+	});
+}
+
+void LuaProfiler::logReport(unsigned int maxFunctions) const
+{
+	nctl::Array<FunctionStats> stats;
+	report(stats);
+
+	LOGI_X("Lua profiler report: %u samples every %.2f ms", numSamples(), interval_ * 1000.0f);
+	for (unsigned int i = 0; i < stats.size() && i < maxFunctions; i++)
+		LOGI_X("%8.2f ms self, %8.2f ms total: %s", stats[i].selfTime * 1000.0f, stats[i].totalTime * 1000.0f, stats[i].name);
+}
+
+bool LuaProfiler::saveCollapsedStacks(const char *filename, bool withLines) const
+{
+	ASSERT(filename);
+
+	const nctl::String path = fs::joinPath(fs::savePath(), filename);
+	nctl::UniquePtr<IFile> fileHandle = IFile::createFileHandle(path.data());
+	fileHandle->setExitOnFailToOpen(false);
+	fileHandle->open(IFile::OpenMode::WRITE | IFile::OpenMode::BINARY);
+	if (fileHandle->isOpened() == false)
+	{
+		LOGW_X("Cannot open the Lua profiler stacks file \"%s\"", path.data());
+		return false;
+	}
+
+	// Samples with the same stack are merged in a single line
+	const unsigned int numStoredSamples = numSamples();
+	nctl::HashMap<nctl::String, unsigned int> stackCounts(numStoredSamples > 0 ? numStoredSamples * 2 : 1);
+	nctl::String stack(256);
+	nctl::String frame(128);
+	for (unsigned long int index = firstIndex(); index < writeIndex_; index++)
+	{
+		const Sample &sample = samples_[index % MaxSamples];
+		stack.clear();
+		for (int i = static_cast<int>(sample.depth) - 1; i >= 0; i--)
+		{
+			const Frame &sampleFrame = sample.frames[i];
+			if (withLines && sampleFrame.line > 0)
+				frame.format("%s:%d", functions_[sampleFrame.function].name.data(), sampleFrame.line);
+			else
+				frame = functions_[sampleFrame.function].name;
+			stack.append(frame);
+			if (i > 0)
+				stack.append(";");
+		}
+		unsigned int *count = stackCounts.find(stack);
+		if (count != nullptr)
+			(*count)++;
+		else
+			stackCounts.insert(stack, 1);
+	}
+
+	bool written = true;
+	nctl::String line(256);
+	for (nctl::HashMap<nctl::String, unsigned int>::ConstIterator i = stackCounts.cBegin(); i != stackCounts.cEnd() && written; ++i)
+	{
+		line.format("%s %u\n", i.key().data(), i.value());
+		written = fileHandle->writeString(line);
+	}
+	fileHandle->close();
+
+	if (written == false)
+	{
+		LOGW_X("Cannot write the Lua profiler stacks file \"%s\"", path.data());
+		return false;
+	}
+
+	LOGI_X("Lua profiler stacks of %u samples saved to \"%s\"", numStoredSamples, path.data());
+	return true;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void LuaProfiler::timerFunction(void *arg)
+{
+	LuaProfiler *profiler = static_cast<LuaProfiler *>(arg);
+
+	while (profiler->timerRunning_.load(nctl::Atomic32::MemoryModel::ACQUIRE) != 0)
+	{
+		Timer::sleep(profiler->interval_);
+		profiler->dueTicks_.store(static_cast<int64_t>(clock().counter()), nctl::Atomic64::MemoryModel::RELAXED);
+		profiler->sampleDue_.store(1, nctl::Atomic32::MemoryModel::RELEASE);
+	}
+}
+
+void LuaProfiler::sampleHook(lua_State *L, lua_Debug *ar)
+{
+	LuaProfiler *profiler = LuaProfiler::profiler(L);
+	if (profiler == nullptr || profiler->running_ == false)
+	{
+		lua_sethook(L, nullptr, 0, 0);
+		return;
+	}
+
+#ifdef WITH_THREADS
+	if (profiler->sampleDue_.load(nctl::Atomic32::MemoryModel::ACQUIRE) == 0)
+		return;
+	profiler->sampleDue_.store(0, nctl::Atomic32::MemoryModel::RELAXED);
+
+	// A sample flagged while no script was running is only seen when one starts, it would not represent the interval
+	const uint64_t now = clock().counter();
+	const uint64_t dueTicks = static_cast<uint64_t>(profiler->dueTicks_.load(nctl::Atomic64::MemoryModel::RELAXED));
+	if (now - dueTicks <= profiler->intervalTicks_)
+		profiler->takeSample(L);
+#else
+	const uint64_t now = clock().counter();
+	if (now >= profiler->nextSampleTicks_)
+	{
+		profiler->takeSample(L);
+		profiler->nextSampleTicks_ = now + profiler->intervalTicks_;
+	}
+#endif
+}
+
+LuaProfiler *LuaProfiler::profiler(lua_State *L)
+{
+	lua_rawgetp(L, LUA_REGISTRYINDEX, &RegistryKey);
+	LuaProfiler *profiler = static_cast<LuaProfiler *>(lua_touserdata(L, -1));
+	lua_pop(L, 1);
+	return profiler;
+}
+
+void LuaProfiler::takeSample(lua_State *L)
+{
+	Sample &sample = samples_[writeIndex_ % MaxSamples];
+	lua_Debug frameInfo;
+
+	unsigned int depth = 0;
+	while (depth < MaxStackDepth && lua_getstack(L, static_cast<int>(depth), &frameInfo))
+	{
+		lua_getinfo(L, "Sln", &frameInfo);
+		sample.frames[depth].function = functionIndex(frameInfo);
+		sample.frames[depth].line = frameInfo.currentline;
+		depth++;
+	}
+
+	if (depth > 0)
+	{
+		sample.depth = depth;
+		writeIndex_++;
+		sampledTime_ += interval_;
+	}
+}
+
+uint32_t LuaProfiler::functionIndex(const lua_Debug &ar)
+{
+	const bool isCFunction = (ar.what[0] == 'C');
+	const bool isMainChunk = (ar.what[0] == 'm');
+	const char *name = (ar.name != nullptr) ? ar.name : (isMainChunk ? "main chunk" : "?");
+
+	// Lua functions are identified by where they are defined, C functions only by the name they are called with
+	const uint64_t key = isCFunction ? (uint64_t(1) << 63) | nctl::FNV1aHashFunc<const char *>()(name)
+	                                 : static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ar.source)) * 31 + static_cast<uint32_t>(ar.linedefined);
+
+	uint32_t index = 0;
+	if (functionIndices_.contains(key, index))
+	{
+		// The source of a collected function might have been reallocated at the same address
+		const FunctionInfo &info = functions_[index];
+		if (info.lineDefined == ar.linedefined && info.source == ar.short_src && (isCFunction == false || info.name == name))
+			return index;
+	}
+
+	index = functions_.size();
+	functions_.emplaceBack();
+	FunctionInfo &info = functions_.back();
+	info.source = ar.short_src;
+	info.lineDefined = ar.linedefined;
+	if (isCFunction)
+		info.name = name;
+	else if (isMainChunk)
+		info.name.format("%s (%s)", name, ar.short_src);
+	else
+		info.name.format("%s (%s:%d)", name, ar.short_src, ar.linedefined);
+
+	if (functionIndices_.loadFactor() >= 0.8f)
+		functionIndices_.rehash(functionIndices_.capacity() * 2);
+	functionIndices_[key] = index;
+
+	return index;
+}
+
+unsigned long int LuaProfiler::firstIndex() const
+{
+	const unsigned long int oldestIndex = (writeIndex_ > MaxSamples) ? writeIndex_ - MaxSamples : 0;
+	return (clearIndex_ > oldestIndex) ? clearIndex_ : oldestIndex;
+}
+
+}
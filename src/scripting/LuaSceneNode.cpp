@@ -32,10 +32,12 @@ namespace SceneNode {
 	static const char *setEnabled = "set_enabled";
 
 	static const char *position = "get_position";
+	static const char *positionXY = "get_position_xy";
 	static const char *setPosition = "set_position";
 	static const char *absAnchorPoint = "get_abs_anchor_point";
 	static const char *setAbsAnchorPoint = "set_abs_anchor_point";
 	static const char *scale = "get_scale";
+	static const char *scaleXY = "get_scale_xy";
 	static const char *setScaleX = "set_scale_x";
 	static const char *setScaleY = "set_scale_y";
 	static const char *setScale = "set_scale";
@@ -43,6 +45,7 @@ namespace SceneNode {
 	static const char *setRotation = "set_rotation";
 
 	static const char *color = "get_color";
+	static const char *colorRGBA = "get_color_rgba";
 	static const char *setColor = "set_color";
 	static const char *alpha = "get_alpha";
 	static const char *setAlpha = "set_alpha";
@@ -52,12 +55,42 @@ namespace SceneNode {
 
 	static const char *lastFrameUpdated = "get_last_frame_updated";
 
+	static const char *positions = "get_positions";
+	static const char *setPositions = "set_positions";
+	static const char *setScales = "set_scales";
+	static const char *setRotations = "set_rotations";
+	static const char *setColors = "set_colors";
+
 	static const char *ENABLED = "ENABLED";
 	static const char *DISABLED = "DISABLED";
 	static const char *SAME_AS_PARENT = "SAME_AS_PARENT";
 	static const char *VisitOrderState = "visit_order_state";
 }}
 
+namespace {
+	/// Returns the number of nodes in the array at `nodesIndex`, checking there are enough values for all of them
+	unsigned int bulkLength(lua_State *L, int nodesIndex, int valuesIndex, unsigned int valuesPerNode)
+	{
+		const unsigned int numNodes = static_cast<unsigned int>(LuaUtils::rawLen(L, nodesIndex));
+		LuaUtils::assertArrayLength(L, valuesIndex, numNodes * valuesPerNode);
+		return numNodes;
+	}
+
+	float retrieveArrayFloat(lua_State *L, int index, int64_t position)
+	{
+		LuaUtils::rawGeti(L, index, position);
+		const float value = LuaUtils::retrieve<float>(L, -1);
+		LuaUtils::pop(L);
+		return value;
+	}
+
+	void setArrayFloat(lua_State *L, int index, int64_t position, float value)
+	{
+		LuaUtils::push(L, value);
+		LuaUtils::rawSeti(L, index, position);
+	}
+}
+
 ///////////////////////////////////////////////////////////
 // PUBLIC FUNCTIONS
 ///////////////////////////////////////////////////////////
@@ -123,10 +156,12 @@ void LuaSceneNode::exposeFunctions(lua_State *L)
 	LuaUtils::addFunction(L, LuaNames::SceneNode::setEnabled, setEnabled);
 
 	LuaUtils::addFunction(L, LuaNames::SceneNode::position, position);
+	LuaUtils::addFunction(L, LuaNames::SceneNode::positionXY, positionXY);
 	LuaUtils::addFunction(L, LuaNames::SceneNode::setPosition, setPosition);
 	LuaUtils::addFunction(L, LuaNames::SceneNode::absAnchorPoint, absAnchorPoint);
 	LuaUtils::addFunction(L, LuaNames::SceneNode::setAbsAnchorPoint, setAbsAnchorPoint);
 	LuaUtils::addFunction(L, LuaNames::SceneNode::scale, scale);
+	LuaUtils::addFunction(L, LuaNames::SceneNode::scaleXY, scaleXY);
 	LuaUtils::addFunction(L, LuaNames::SceneNode::setScaleX, setScaleX);
 	LuaUtils::addFunction(L, LuaNames::SceneNode::setScaleY, setScaleY);
 	LuaUtils::addFunction(L, LuaNames::SceneNode::setScale, setScale);
@@ -134,6 +169,7 @@ void LuaSceneNode::exposeFunctions(lua_State *L)
 	LuaUtils::addFunction(L, LuaNames::SceneNode::setRotation, setRotation);
 
 	LuaUtils::addFunction(L, LuaNames::SceneNode::color, color);
+	LuaUtils::addFunction(L, LuaNames::SceneNode::colorRGBA, colorRGBA);
 	LuaUtils::addFunction(L, LuaNames::SceneNode::setColor, setColor);
 	LuaUtils::addFunction(L, LuaNames::SceneNode::alpha, alpha);
 	LuaUtils::addFunction(L, LuaNames::SceneNode::setAlpha, setAlpha);
@@ -142,6 +178,12 @@ void LuaSceneNode::exposeFunctions(lua_State *L)
 	LuaUtils::addFunction(L, LuaNames::SceneNode::setLayer, setLayer);
 
 	LuaUtils::addFunction(L, LuaNames::SceneNode::lastFrameUpdated, lastFrameUpdated);
+
+	LuaUtils::addFunction(L, LuaNames::SceneNode::positions, positions);
+	LuaUtils::addFunction(L, LuaNames::SceneNode::setPositions, setPositions);
+	LuaUtils::addFunction(L, LuaNames::SceneNode::setScales, setScales);
+	LuaUtils::addFunction(L, LuaNames::SceneNode::setRotations, setRotations);
+	LuaUtils::addFunction(L, LuaNames::SceneNode::setColors, setColors);
 }
 
 int LuaSceneNode::newObject(lua_State *L)
@@ -172,7 +214,7 @@ int LuaSceneNode::parent(lua_State *L)
 	SceneNode *node = LuaUntrackedUserData<SceneNode>::retrieve(L, -1);
 
 	if (node)
-		LuaUtils::push(L, node->parent());
+		LuaUntrackedUserData<SceneNode>::push(L, node->parent());
 	else
 		LuaUtils::pushNil(L);
 
@@ -393,16 +435,28 @@ int LuaSceneNode::setEnabled(lua_State *L)
 
 int LuaSceneNode::position(lua_State *L)
 {
-	SceneNode *node = LuaUntrackedUserData<SceneNode>::retrieve(L, -1);
+	SceneNode *node = LuaUntrackedUserData<SceneNode>::retrieve(L, 1);
 
 	if (node)
-		LuaVector2fUtils::push(L, node->position());
+		LuaVector2fUtils::push(L, node->position(), 2);
 	else
 		LuaUtils::pushNil(L);
 
 	return 1;
 }
 
+/*! \note The two coordinates are returned as separate numbers, without creating a table */
+int LuaSceneNode::positionXY(lua_State *L)
+{
+	SceneNode *node = LuaUntrackedUserData<SceneNode>::retrieve(L, 1);
+
+	if (node)
+		return LuaVector2fUtils::pushValues(L, node->position());
+
+	LuaUtils::pushNil(L);
+	return 1;
+}
+
 int LuaSceneNode::setPosition(lua_State *L)
 {
 	int vectorIndex = 0;
@@ -417,10 +471,10 @@ int LuaSceneNode::setPosition(lua_State *L)
 
 int LuaSceneNode::absAnchorPoint(lua_State *L)
 {
-	SceneNode *node = LuaUntrackedUserData<SceneNode>::retrieve(L, -1);
+	SceneNode *node = LuaUntrackedUserData<SceneNode>::retrieve(L, 1);
 
 	if (node)
-		LuaVector2fUtils::push(L, node->absAnchorPoint());
+		LuaVector2fUtils::push(L, node->absAnchorPoint(), 2);
 	else
 		LuaUtils::pushNil(L);
 
@@ -441,16 +495,28 @@ int LuaSceneNode::setAbsAnchorPoint(lua_State *L)
 
 int LuaSceneNode::scale(lua_State *L)
 {
-	SceneNode *node = LuaUntrackedUserData<SceneNode>::retrieve(L, -1);
+	SceneNode *node = LuaUntrackedUserData<SceneNode>::retrieve(L, 1);
 
 	if (node)
-		LuaVector2fUtils::push(L, node->scale());
+		LuaVector2fUtils::push(L, node->scale(), 2);
 	else
 		LuaUtils::pushNil(L);
 
 	return 1;
 }
 
+/*! \note The two scale factors are returned as separate numbers, without creating a table */
+int LuaSceneNode::scaleXY(lua_State *L)
+{
+	SceneNode *node = LuaUntrackedUserData<SceneNode>::retrieve(L, 1);
+
+	if (node)
+		return LuaVector2fUtils::pushValues(L, node->scale());
+
+	LuaUtils::pushNil(L);
+	return 1;
+}
+
 int LuaSceneNode::setScaleX(lua_State *L)
 {
 	SceneNode *node = LuaUntrackedUserData<SceneNode>::retrieve(L, -2);
@@ -509,17 +575,28 @@ int LuaSceneNode::setRotation(lua_State *L)
 
 int LuaSceneNode::color(lua_State *L)
 {
-	SceneNode *node = LuaUntrackedUserData<SceneNode>::retrieve(L, -1);
-	const Colorf nodeColor(node->color());
+	SceneNode *node = LuaUntrackedUserData<SceneNode>::retrieve(L, 1);
 
 	if (node)
-		LuaColorUtils::push(L, nodeColor);
+		LuaColorUtils::push(L, Colorf(node->color()), 2);
 	else
 		LuaUtils::pushNil(L);
 
 	return 1;
 }
 
+/*! \note The four channels are returned as separate numbers, without creating a table */
+int LuaSceneNode::colorRGBA(lua_State *L)
+{
+	SceneNode *node = LuaUntrackedUserData<SceneNode>::retrieve(L, 1);
+
+	if (node)
+		return LuaColorUtils::pushValues(L, Colorf(node->color()));
+
+	LuaUtils::pushNil(L);
+	return 1;
+}
+
 int LuaSceneNode::setColor(lua_State *L)
 {
 	int colorIndex = 0;
@@ -590,4 +667,85 @@ int LuaSceneNode::lastFrameUpdated(lua_State *L)
 	return 1;
 }
 
+/*! \note The positions are written as consecutive x and y numbers in the optional second argument, or in a new table */
+int LuaSceneNode::positions(lua_State *L)
+{
+	const bool hasOutput = (lua_gettop(L) >= 2 && LuaUtils::isTable(L, 2));
+	const unsigned int numNodes = static_cast<unsigned int>(LuaUtils::rawLen(L, 1));
+	if (hasOutput == false)
+		LuaUtils::createTable(L, static_cast<int>(numNodes * 2), 0);
+	const int outputIndex = hasOutput ? 2 : lua_gettop(L);
+
+	for (unsigned int i = 0; i < numNodes; i++)
+	{
+		const SceneNode *node = LuaUntrackedUserData<SceneNode>::retrieveArrayElement(L, 1, i + 1);
+		const Vector2f pos = node ? node->position() : Vector2f::Zero;
+		setArrayFloat(L, outputIndex, i * 2 + 1, pos.x);
+		setArrayFloat(L, outputIndex, i * 2 + 2, pos.y);
+	}
+
+	if (hasOutput)
+		lua_pushvalue(L, outputIndex);
+
+	return 1;
+}
+
+/*! \note The values array holds consecutive x and y numbers for every node */
+int LuaSceneNode::setPositions(lua_State *L)
+{
+	const unsigned int numNodes = bulkLength(L, 1, 2, 2);
+	for (unsigned int i = 0; i < numNodes; i++)
+	{
+		SceneNode *node = LuaUntrackedUserData<SceneNode>::retrieveArrayElement(L, 1, i + 1);
+		if (node)
+			node->setPosition(retrieveArrayFloat(L, 2, i * 2 + 1), retrieveArrayFloat(L, 2, i * 2 + 2));
+	}
+
+	return 0;
+}
+
+/*! \note The values array holds consecutive horizontal and vertical scale factors for every node */
+int LuaSceneNode::setScales(lua_State *L)
+{
+	const unsigned int numNodes = bulkLength(L, 1, 2, 2);
+	for (unsigned int i = 0; i < numNodes; i++)
+	{
+		SceneNode *node = LuaUntrackedUserData<SceneNode>::retrieveArrayElement(L, 1, i + 1);
+		if (node)
+			node->setScale(Vector2f(retrieveArrayFloat(L, 2, i * 2 + 1), retrieveArrayFloat(L, 2, i * 2 + 2)));
+	}
+
+	return 0;
+}
+
+int LuaSceneNode::setRotations(lua_State *L)
+{
+	const unsigned int numNodes = bulkLength(L, 1, 2, 1);
+	for (unsigned int i = 0; i < numNodes; i++)
+	{
+		SceneNode *node = LuaUntrackedUserData<SceneNode>::retrieveArrayElement(L, 1, i + 1);
+		if (node)
+			node->setRotation(retrieveArrayFloat(L, 2, i + 1));
+	}
+
+	return 0;
+}
+
+/*! \note The values array holds consecutive red, green, blue and alpha numbers for every node */
+int LuaSceneNode::setColors(lua_State *L)
+{
+	const unsigned int numNodes = bulkLength(L, 1, 2, 4);
+	for (unsigned int i = 0; i < numNodes; i++)
+	{
+		SceneNode *node = LuaUntrackedUserData<SceneNode>::retrieveArrayElement(L, 1, i + 1);
+		if (node)
+		{
+			node->setColorF(retrieveArrayFloat(L, 2, i * 4 + 1), retrieveArrayFloat(L, 2, i * 4 + 2),
+			                retrieveArrayFloat(L, 2, i * 4 + 3), retrieveArrayFloat(L, 2, i * 4 + 4));
+		}
+	}
+
+	return 0;
+}
+
 }
@@ -2,12 +2,14 @@
 #include "common_headers.h"
 #include "common_macros.h"
 #include <nctl/CString.h>
-#include <nctl/HashMapIterator.h>
 
 #include "LuaStateManager.h"
 #include "LuaUtils.h"
 #include "LuaDebug.h"
 #include "LuaStatistics.h"
+#include "LuaCallbacks.h"
+#include "LuaProfiler.h"
+#include "LuaBytecodeCache.h"
 #include "LuaNames.h"
 
 #if WITH_SCRIPTING_API
@@ -53,6 +55,7 @@
 #endif
 
 #include "Application.h"
+#include "TimeStamp.h"
 #include <cstring> // for memchr()
 #include "IFile.h"
 
@@ -122,7 +125,7 @@ LuaStateManager::LuaStateManager(ApiType apiType, StatisticsTracking statsTracki
 
 LuaStateManager::LuaStateManager(lua_State *L, ApiType apiType, StatisticsTracking statsTracking, StandardLibraries stdLibraries)
     : L_(L), apiType_(apiType), statsTracking_(statsTracking), stdLibraries_(stdLibraries),
-      trackedUserDatas_(apiType == ApiType::FULL ? 32 : 1), untrackedUserDatas_(32), closeOnDestruction_(false)
+      handles_(32), callbacks_(nctl::makeUnique<LuaCallbacks>()), closeOnDestruction_(false)
 {
 	ASSERT(L_);
 
@@ -194,7 +197,9 @@ bool LuaStateManager::loadFromMemory(const char *bufferName, const char *bufferP
 {
 	if (apiType_ == ApiType::FULL)
 		releaseTrackedMemory();
-	untrackedUserDatas_.clear();
+	handles_.removeUntracked();
+	// A new script might define different callbacks
+	callbacks_->refreshFunctions(L_);
 
 	const char *bufferRead = bufferPtr;
 
@@ -205,6 +210,20 @@ bool LuaStateManager::loadFromMemory(const char *bufferName, const char *bufferP
 		bufferSize -= bufferRead - bufferPtr;
 	}
 
+	const TimeStamp loadStartTime = TimeStamp::now();
+	// Chunks that are already compiled are not cached again
+	const bool useCache = (bytecodeCache_ != nullptr && bytecodeCache_->isAvailable() && bufferSize > 0 && bufferRead[0] != LUA_SIGNATURE[0]);
+	uint64_t hash = 0;
+	if (useCache)
+	{
+		hash = LuaBytecodeCache::hash(bufferName, bufferRead, bufferSize);
+		if (bytecodeCache_->loadFromCache(L_, hash, bufferName))
+		{
+			LOGI_X("Lua script \"%s\" loaded from the bytecode cache in %.3f ms", bufferName, loadStartTime.millisecondsSince());
+			return true;
+		}
+	}
+
 	const int loadStatus = luaL_loadbufferx(L_, bufferRead, bufferSize, bufferName, "bt");
 	if (loadStatus != LUA_OK)
 	{
@@ -217,6 +236,11 @@ bool LuaStateManager::loadFromMemory(const char *bufferName, const char *bufferP
 		return false;
 	}
 
+	const float compileTime = loadStartTime.millisecondsSince();
+	if (useCache)
+		bytecodeCache_->saveToCache(L_, hash, bufferName);
+	LOGI_X("Lua script \"%s\" compiled in %.3f ms", bufferName, compileTime);
+
 	return true;
 }
 
@@ -297,18 +321,13 @@ bool LuaStateManager::runFromMemory(const char *bufferName, const char *bufferPt
 	return runFromMemory(bufferName, bufferPtr, bufferSize, nullptr, nullptr, nullptr);
 }
 
-LuaTypes::UserDataType LuaStateManager::trackedType(void *pointer) const
-{
-	LuaTypes::UserDataType type = LuaTypes::UserDataType::UNKNOWN;
-	trackedUserDatas_.contains(pointer, type);
-	return type;
-}
-
-LuaTypes::UserDataType LuaStateManager::untrackedType(void *pointer) const
+/*! \note Loading compiled chunks skips the syntax checks, the cache directory should only be writable by the application */
+void LuaStateManager::setBytecodeCacheEnabled(bool enabled)
 {
-	LuaTypes::UserDataType type = LuaTypes::UserDataType::UNKNOWN;
-	untrackedUserDatas_.contains(pointer, type);
-	return type;
+	if (enabled && bytecodeCache_ == nullptr)
+		bytecodeCache_ = nctl::makeUnique<LuaBytecodeCache>();
+	else if (enabled == false)
+		bytecodeCache_.reset(nullptr);
 }
 
 LuaStateManager *LuaStateManager::manager(lua_State *L)
@@ -376,12 +395,6 @@ void *LuaStateManager::luaAllocatorWithStatistics(void *ud, void *ptr, size_t os
 	}
 }
 
-void LuaStateManager::luaCountHook(lua_State *L, lua_Debug *ar)
-{
-	if (ar->event == LUA_HOOKCOUNT)
-		LuaStatistics::countOperations();
-}
-
 void LuaStateManager::init(ApiType apiType, StatisticsTracking statsTracking, StandardLibraries stdLibraries)
 {
 	if (stdLibraries == StandardLibraries::LOADED)
@@ -389,10 +402,8 @@ void LuaStateManager::init(ApiType apiType, StatisticsTracking statsTracking, St
 	managers_.pushBack(StateToManager(L_, this));
 
 	if (statsTracking == StatisticsTracking::ENABLED)
-	{
 		LuaStatistics::registerState(this);
-		lua_sethook(L_, luaCountHook, LUA_MASKCOUNT, LuaStatistics::OperationsCount);
-	}
+	profiler_ = nctl::makeUnique<LuaProfiler>(L_);
 
 #ifdef WITH_TRACY
 	tracy::LuaRegister(L_);
@@ -414,9 +425,17 @@ void LuaStateManager::shutdown()
 
 	if (apiType_ == ApiType::FULL)
 		releaseTrackedMemory();
+	handles_.removeUntracked();
+	// The profiler needs the state to remove its hook
+	profiler_.reset(nullptr);
 
 	if (closeOnDestruction_)
+	{
 		lua_close(L_);
+		callbacks_->reset();
+	}
+	else
+		callbacks_->release(L_);
 }
 
 void LuaStateManager::unregisterState()
@@ -440,13 +459,17 @@ void LuaStateManager::unregisterState()
 void LuaStateManager::releaseTrackedMemory()
 {
 #ifdef WITH_SCRIPTING_API
-	if (trackedUserDatas_.isEmpty() == false)
-		LOGW_X("Lua array of tracked userdata is not empty: %d elements", trackedUserDatas_.size());
+	if (handles_.numTracked() > 0)
+		LOGW_X("Lua array of tracked userdata is not empty: %u elements", handles_.numTracked());
 
-	for (nctl::HashMap<void *, LuaTypes::UserDataType>::Iterator i = trackedUserDatas_.begin(); i != trackedUserDatas_.end(); ++i)
+	for (unsigned int i = 0; i < handles_.numSlots(); i++)
 	{
-		const LuaTypes::UserDataType type = i.value();
-		void *object = i.key();
+		const LuaHandleTable::Handle handle = handles_.handleAt(i);
+		if (handles_.isTracked(handle) == false)
+			continue;
+
+		LuaTypes::UserDataType type = LuaTypes::UNKNOWN;
+		void *object = handles_.object(handle, type);
 
 		switch (type)
 		{
@@ -533,9 +556,8 @@ void LuaStateManager::releaseTrackedMemory()
 				break;
 		}
 
-		trackedUserDatas_.remove(object);
+		handles_.remove(handle);
 	}
-	trackedUserDatas_.clear();
 #endif
 }
 
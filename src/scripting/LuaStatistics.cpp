@@ -1,7 +1,7 @@
 #include <nctl/String.h>
-#include <nctl/HashMapIterator.h>
 #include "LuaStatistics.h"
 #include "LuaStateManager.h"
+#include "LuaProfiler.h"
 #include "tracy.h"
 
 namespace ncine {
@@ -14,9 +14,10 @@ nctl::Array<LuaStateManager *> LuaStatistics::managers_(2);
 unsigned int LuaStatistics::numTrackedUserDatas_;
 unsigned int LuaStatistics::numTypedUserDatas_[LuaTypes::UserDataType::UNKNOWN + 1];
 size_t LuaStatistics::usedMemory_ = 0;
-TimeStamp LuaStatistics::lastOpsUpdateTime_;
-unsigned int LuaStatistics::index_ = 0;
-int LuaStatistics::operations_[2] = { 0, 0 };
+unsigned int LuaStatistics::numProfiling_ = 0;
+float LuaStatistics::scriptLoad_ = 0.0f;
+double LuaStatistics::lastSampledTime_ = 0.0;
+TimeStamp LuaStatistics::lastLoadUpdateTime_;
 
 ///////////////////////////////////////////////////////////
 // PUBLIC FUNCTIONS
@@ -27,13 +28,32 @@ void LuaStatistics::update()
 	numTrackedUserDatas_ = 0;
 	for (unsigned int i = 0; i < LuaTypes::UserDataType::UNKNOWN + 1; i++)
 		numTypedUserDatas_[i] = 0;
+	numProfiling_ = 0;
+	double sampledTime = 0.0;
 
 	for (const LuaStateManager *manager : managers_)
 	{
-		numTrackedUserDatas_ += manager->trackedUserDatas_.size();
-		const nctl::HashMap<void *, LuaTypes::UserDataType> &hashMap = manager->trackedUserDatas_;
-		for (nctl::HashMap<void *, LuaTypes::UserDataType>::ConstIterator i = hashMap.begin(); i != hashMap.end(); ++i)
-			numTypedUserDatas_[i.value()]++;
+		// The handle tables keep their counters up to date, no object is visited
+		const LuaHandleTable &handles = manager->handles();
+		numTrackedUserDatas_ += handles.numTracked();
+		for (unsigned int i = 0; i < LuaTypes::UserDataType::UNKNOWN + 1; i++)
+			numTypedUserDatas_[i] += handles.numTracked(static_cast<LuaTypes::UserDataType>(i));
+
+		const LuaProfiler &profiler = manager->profiler();
+		if (profiler.isRunning())
+			numProfiling_++;
+		sampledTime += profiler.sampledTime();
+	}
+
+	const float secsSinceLastUpdate = lastLoadUpdateTime_.secondsSince();
+	if (secsSinceLastUpdate >= 1.0f)
+	{
+		// The sampled time drops when a state is unregistered
+		const double newSampledTime = sampledTime - lastSampledTime_;
+		scriptLoad_ = (newSampledTime > 0.0) ? static_cast<float>(newSampledTime / secsSinceLastUpdate) : 0.0f;
+		TracyPlot("Lua Load", static_cast<double>(scriptLoad_));
+		lastSampledTime_ = sampledTime;
+		lastLoadUpdateTime_ = TimeStamp::now();
 	}
 }
 
@@ -45,7 +65,7 @@ void LuaStatistics::registerState(LuaStateManager *stateManager)
 {
 	managers_.pushBack(stateManager);
 	if (managers_.size() == 1)
-		lastOpsUpdateTime_ = TimeStamp::now();
+		lastLoadUpdateTime_ = TimeStamp::now();
 }
 
 void LuaStatistics::unregisterState(LuaStateManager *stateManager)
@@ -66,21 +86,4 @@ void LuaStatistics::unregisterState(LuaStateManager *stateManager)
 		managers_.unorderedRemoveAt(index);
 }
 
-void LuaStatistics::countOperations()
-{
-	operations_[index_] += OperationsCount;
-
-	const float secsSinceLastUpdate = lastOpsUpdateTime_.secondsSince();
-	if (secsSinceLastUpdate >= 1.0f)
-	{
-		operations_[index_] = int(float(operations_[index_]) / secsSinceLastUpdate);
-		TracyPlot("Lua Ops", static_cast<int64_t>(operations_[index_]));
-		lastOpsUpdateTime_ = TimeStamp::now();
-
-		// Ping pong index for last and current measurement
-		index_ = (index_ + 1) % 2;
-		operations_[index_] = 0;
-	}
-}
-
 }
@@ -348,10 +348,10 @@ int LuaTexture::isChromaKeyEnabled(lua_State *L)
 
 int LuaTexture::chromaKeyColor(lua_State *L)
 {
-	Texture *texture = LuaUntrackedUserData<Texture>::retrieve(L, -1);
+	Texture *texture = LuaUntrackedUserData<Texture>::retrieve(L, 1);
 
 	if (texture)
-		LuaColorUtils::push(L, Colorf(texture->chromaKeyColor()));
+		LuaColorUtils::push(L, Colorf(texture->chromaKeyColor()), 2);
 	else
 		LuaUtils::pushNil(L);
 
@@ -3,6 +3,7 @@
 
 #include "LuaTouchEvents.h"
 #include "LuaUtils.h"
+#include "LuaCallbacks.h"
 #include "InputEvents.h"
 
 namespace ncine {
@@ -26,23 +27,39 @@ namespace LuaTouchEvents {
 
 void LuaTouchEvents::pushTouchEvent(lua_State *L, const TouchEvent &event)
 {
-	lua_newtable(L);
+	LuaCallbacks::pushEventTable(L, LuaCallbacks::EventTable::TOUCH, 2);
 	LuaUtils::pushField(L, LuaNames::LuaTouchEvents::count, event.count);
 	LuaUtils::pushField(L, LuaNames::LuaTouchEvents::actionIndex, event.actionIndex);
 	for (unsigned int i = 0; i < event.count; i++)
 	{
-		lua_createtable(L, 3, 0);
+		// The pointer tables of a previous event are reused as well
+		if (lua_rawgeti(L, -1, i) != LUA_TTABLE)
+		{
+			lua_pop(L, 1);
+			lua_createtable(L, 0, 3);
+			lua_pushvalue(L, -1);
+			lua_rawseti(L, -3, i);
+		}
 		LuaUtils::pushField(L, LuaNames::LuaTouchEvents::id, event.pointers[i].id);
 		LuaUtils::pushField(L, LuaNames::LuaTouchEvents::x, event.pointers[i].x);
 		LuaUtils::pushField(L, LuaNames::LuaTouchEvents::y, event.pointers[i].y);
+		lua_pop(L, 1);
+	}
+
+	// Removing the pointers left by a previous event with more touches
+	for (unsigned int i = event.count; lua_rawgeti(L, -1, i) != LUA_TNIL; i++)
+	{
+		lua_pop(L, 1);
+		lua_pushnil(L);
 		lua_rawseti(L, -2, i);
 	}
+	lua_pop(L, 1);
 }
 
 #ifdef __ANDROID__
 void LuaTouchEvents::pushAccelerometerEvent(lua_State *L, const AccelerometerEvent &event)
 {
-	lua_createtable(L, 3, 0);
+	LuaCallbacks::pushEventTable(L, LuaCallbacks::EventTable::ACCELEROMETER, 3);
 	LuaUtils::pushField(L, LuaNames::LuaTouchEvents::x, event.x);
 	LuaUtils::pushField(L, LuaNames::LuaTouchEvents::y, event.y);
 	LuaUtils::pushField(L, LuaNames::LuaTouchEvents::z, event.z);
@@ -1049,6 +1049,11 @@ void LuaUtils::pushNil(lua_State *L)
 	lua_pushnil(L);
 }
 
+void LuaUtils::pushValue(lua_State *L, int index)
+{
+	lua_pushvalue(L, index);
+}
+
 void LuaUtils::push(lua_State *L, double number)
 {
 	lua_pushnumber(L, number);
@@ -286,10 +286,10 @@ int LuaViewport::numColorAttachments(lua_State *L)
 
 int LuaViewport::viewportRect(lua_State *L)
 {
-	Viewport *viewport = LuaUntrackedUserData<Viewport>::retrieve(L, -1);
+	Viewport *viewport = LuaUntrackedUserData<Viewport>::retrieve(L, 1);
 
 	if (viewport)
-		LuaRectiUtils::push(L, viewport->viewportRect());
+		LuaRectiUtils::push(L, viewport->viewportRect(), 2);
 	else
 		LuaUtils::pushNil(L);
 
@@ -310,10 +310,10 @@ int LuaViewport::setViewportRect(lua_State *L)
 
 int LuaViewport::scissorRect(lua_State *L)
 {
-	Viewport *viewport = LuaUntrackedUserData<Viewport>::retrieve(L, -1);
+	Viewport *viewport = LuaUntrackedUserData<Viewport>::retrieve(L, 1);
 
 	if (viewport)
-		LuaRectiUtils::push(L, viewport->scissorRect());
+		LuaRectiUtils::push(L, viewport->scissorRect(), 2);
 	else
 		LuaUtils::pushNil(L);
 
@@ -334,10 +334,10 @@ int LuaViewport::setScissorRect(lua_State *L)
 
 int LuaViewport::cullingRect(lua_State *L)
 {
-	Viewport *viewport = LuaUntrackedUserData<Viewport>::retrieve(L, -1);
+	Viewport *viewport = LuaUntrackedUserData<Viewport>::retrieve(L, 1);
 
 	if (viewport)
-		LuaRectfUtils::push(L, viewport->cullingRect());
+		LuaRectfUtils::push(L, viewport->cullingRect(), 2);
 	else
 		LuaUtils::pushNil(L);
 
@@ -381,10 +381,10 @@ int LuaViewport::setClearMode(lua_State *L)
 
 int LuaViewport::clearColor(lua_State *L)
 {
-	Viewport *viewport = LuaUntrackedUserData<Viewport>::retrieve(L, -1);
+	Viewport *viewport = LuaUntrackedUserData<Viewport>::retrieve(L, 1);
 
 	if (viewport)
-		LuaColorUtils::push(L, viewport->clearColor());
+		LuaColorUtils::push(L, viewport->clearColor(), 2);
 	else
 		LuaUtils::pushNil(L);
 
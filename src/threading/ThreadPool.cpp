@@ -1,5 +1,7 @@
 #include "ThreadPool.h"
+#include "Profiler.h"
 #include <nctl/String.h>
+#include "tracy.h"
 
 namespace ncine {
 
@@ -70,6 +72,11 @@ void ThreadPool::workerFunction(void *arg)
 	ThreadStruct *threadStruct = static_cast<ThreadStruct *>(arg);
 
 	LOGD_X("Worker thread %u is starting", Thread::self());
+#ifndef WITH_TRACY
+	nctl::String threadName(Profiler::MaxThreadNameLength);
+	threadName.format("WorkerThread#%02d", threadStruct->numStartedWorkers.fetchAdd(1));
+	Profiler::setThreadName(threadName.data());
+#endif
 
 	while (true)
 	{
@@ -88,6 +95,7 @@ void ThreadPool::workerFunction(void *arg)
 		threadStruct->queueMutex->unlock();
 
 		LOGD_X("Worker thread %u is executing its command", Thread::self());
+		ZoneScopedN("Thread command");
 		threadCommand->execute();
 	}
 
@@ -0,0 +1,117 @@
+#include "apptest_batching.h"
+#include <ncine/Application.h>
+#include <ncine/AppConfiguration.h>
+#include <ncine/Random.h>
+#include <ncine/Texture.h>
+#include <ncine/Sprite.h>
+#include <ncine/TextNode.h>
+#include <nctl/String.h>
+#include "apptest_datapath.h"
+
+namespace {
+
+#ifdef __ANDROID__
+const char *TextureFile = "texture2_ETC2.ktx";
+const char *FontTextureFile = "DroidSans32_256_ETC2.ktx";
+#else
+const char *TextureFile = "texture2.png";
+const char *FontTextureFile = "DroidSans32_256.png";
+#endif
+const char *FontFntFile = "DroidSans32_256.fnt";
+
+const unsigned int NumSprites[3] = { 10000, 50000, 100000 };
+const float SpriteScale = 0.1f;
+
+}
+
+nctl::UniquePtr<nc::IAppEventHandler> createAppEventHandler()
+{
+	return nctl::makeUnique<MyEventHandler>();
+}
+
+void MyEventHandler::onPreInit(nc::AppConfiguration &config)
+{
+	setDataPath(config);
+
+	config.withThreads = true;
+	config.withVSync = false;
+}
+
+void MyEventHandler::onInit()
+{
+	nc::SceneNode &rootNode = nc::theApplication().rootNode();
+
+	angle_ = 0.0f;
+	drawTimingIndex_ = 0;
+	drawTimings_.setSize(NumDrawTimings);
+	for (float &drawTiming : drawTimings_)
+		drawTiming = 0.0f;
+
+	font_ = nctl::makeUnique<nc::Font>((prefixDataPath("fonts", FontFntFile)).data(),
+	                                   (prefixDataPath("fonts", FontTextureFile)).data());
+
+	debugString_ = nctl::makeUnique<nctl::String>(128);
+	debugText_ = nctl::makeUnique<nc::TextNode>(&rootNode, font_.get());
+	debugText_->setLayer(1);
+	debugText_->setColor(255, 255, 0, 255);
+	debugText_->setAlignment(nc::TextNode::Alignment::CENTER);
+
+	texture_ = nctl::makeUnique<nc::Texture>((prefixDataPath("textures", TextureFile)).data());
+	spritesNode_ = nctl::makeUnique<nc::SceneNode>(&rootNode, nc::theApplication().width() * 0.5f, nc::theApplication().height() * 0.5f);
+	createSprites(NumSprites[0]);
+}
+
+void MyEventHandler::onFrameStart()
+{
+	angle_ += 10.0f * nc::theApplication().interval();
+	spritesNode_->setRotation(angle_);
+
+	// The draw timing includes the creation of batches
+	drawTimings_[drawTimingIndex_] = nc::theApplication().timings()[nc::Application::Timings::DRAW];
+	drawTimingIndex_ = (drawTimingIndex_ + 1) % NumDrawTimings;
+	float averageDrawTiming = 0.0f;
+	for (const float drawTiming : drawTimings_)
+		averageDrawTiming += drawTiming;
+	averageDrawTiming /= NumDrawTimings;
+
+	const nc::Application::RenderingSettings &settings = nc::theApplication().renderingSettings();
+	debugString_->format("%u sprites, batching: %s, parallel batching: %s\ndraw: %.3f ms, frame: %.3f ms",
+	                     sprites_.size(), settings.batchingEnabled ? "on" : "off", settings.parallelBatching ? "on" : "off",
+	                     averageDrawTiming * 1000.0f, nc::theApplication().interval() * 1000.0f);
+	debugText_->setString(*debugString_);
+	debugText_->setPosition(nc::theApplication().width() * 0.5f, nc::theApplication().height() - debugText_->height() * 0.5f);
+}
+
+void MyEventHandler::onKeyReleased(const nc::KeyboardEvent &event)
+{
+	nc::Application::RenderingSettings &renderingSettings = nc::theApplication().renderingSettings();
+
+	if (event.sym == nc::KeySym::N1)
+		createSprites(NumSprites[0]);
+	else if (event.sym == nc::KeySym::N2)
+		createSprites(NumSprites[1]);
+	else if (event.sym == nc::KeySym::N3)
+		createSprites(NumSprites[2]);
+	else if (event.sym == nc::KeySym::B)
+		renderingSettings.batchingEnabled = !renderingSettings.batchingEnabled;
+	else if (event.sym == nc::KeySym::P)
+		renderingSettings.parallelBatching = !renderingSettings.parallelBatching;
+	else if (event.sym == nc::KeySym::ESCAPE)
+		nc::theApplication().quit();
+}
+
+void MyEventHandler::createSprites(unsigned int numSprites)
+{
+	sprites_.clear();
+	sprites_.setCapacity(numSprites);
+
+	const float halfWidth = nc::theApplication().width() * 0.5f;
+	const float halfHeight = nc::theApplication().height() * 0.5f;
+	for (unsigned int i = 0; i < numSprites; i++)
+	{
+		const float x = nc::random().fastReal(-halfWidth, halfWidth);
+		const float y = nc::random().fastReal(-halfHeight, halfHeight);
+		sprites_.pushBack(nctl::makeUnique<nc::Sprite>(spritesNode_.get(), texture_.get(), x, y));
+		sprites_.back()->setScale(SpriteScale);
+	}
+}
@@ -0,0 +1,58 @@
+#ifndef CLASS_MYEVENTHANDLER
+#define CLASS_MYEVENTHANDLER
+
+#include <ncine/IAppEventHandler.h>
+#include <ncine/IInputEventHandler.h>
+#include <nctl/Array.h>
+#include <nctl/StaticArray.h>
+
+namespace nctl {
+
+class String;
+
+}
+
+namespace ncine {
+
+class AppConfiguration;
+class Texture;
+class SceneNode;
+class Sprite;
+class Font;
+class TextNode;
+
+}
+
+namespace nc = ncine;
+
+/// My nCine event handler
+class MyEventHandler :
+    public nc::IAppEventHandler,
+    public nc::IInputEventHandler
+{
+  public:
+	void onPreInit(nc::AppConfiguration &config) override;
+	void onInit() override;
+	void onFrameStart() override;
+
+	void onKeyReleased(const nc::KeyboardEvent &event) override;
+
+  private:
+	static const unsigned int NumDrawTimings = 60;
+
+	float angle_;
+	unsigned int drawTimingIndex_;
+	nctl::StaticArray<float, NumDrawTimings> drawTimings_;
+
+	nctl::UniquePtr<nctl::String> debugString_;
+	nctl::UniquePtr<nc::Font> font_;
+	nctl::UniquePtr<nc::TextNode> debugText_;
+
+	nctl::UniquePtr<nc::Texture> texture_;
+	nctl::UniquePtr<nc::SceneNode> spritesNode_;
+	nctl::Array<nctl::UniquePtr<nc::Sprite>> sprites_;
+
+	void createSprites(unsigned int numSprites);
+};
+
+#endif
@@ -2,6 +2,7 @@
 #include <ncine/Application.h>
 #include <ncine/LuaIAppEventHandler.h>
 #include <ncine/LuaIInputEventHandler.h>
+#include <ncine/LuaProfiler.h>
 #include <ncine/FileSystem.h>
 #include <ncine/TextNode.h>
 #include "apptest_datapath.h"
@@ -123,7 +124,22 @@ void MyEventHandler::onKeyReleased(const nc::KeyboardEvent &event)
 {
 	nc::LuaIInputEventHandler::onKeyReleased(luaState_.state(), event);
 
-	if (event.sym == nc::KeySym::ESCAPE)
+	if (event.sym == nc::KeySym::F9)
+	{
+		nc::LuaProfiler &profiler = luaState_.profiler();
+		if (profiler.isRunning() == false)
+		{
+			profiler.clear();
+			profiler.start();
+		}
+		else
+		{
+			profiler.stop();
+			profiler.logReport(10);
+			profiler.saveCollapsedStacks("apptest_lua.folded", false);
+		}
+	}
+	else if (event.sym == nc::KeySym::ESCAPE)
 		nc::theApplication().quit();
 }
 
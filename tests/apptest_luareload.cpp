@@ -34,6 +34,8 @@ void MyEventHandler::onPreInit(nc::AppConfiguration &config)
 {
 	setDataPath(config);
 
+	// Unchanged scripts are not compiled again when reloaded or when the test is restarted
+	luaState_.setBytecodeCacheEnabled(true);
 	luaState_.runFromFile((config.dataPath() + "scripts/" + InitScriptFile).data(), InitScriptFile);
 	nc::LuaIAppEventHandler::onPreInit(luaState_.state(), config);
 }
@@ -0,0 +1,191 @@
+#include <ncine/config.h>
+#include <ncine/imgui.h>
+
+#include "apptest_texthud.h"
+#include <nctl/StaticString.h>
+#include <ncine/Application.h>
+#include <ncine/TextNode.h>
+#include <ncine/TimeStamp.h>
+#include "apptest_datapath.h"
+
+namespace {
+
+#ifdef __ANDROID__
+const char *FontTextureFile = "DroidSans32_256_ETC2.ktx";
+#else
+const char *FontTextureFile = "DroidSans32_256.png";
+#endif
+const char *FontFntFile = "DroidSans32_256.fnt";
+
+const char *LabelStrings[] = { "HEALTH", "AMMO", "SHIELD", "SCORE" };
+const unsigned int NumLabelStrings = sizeof(LabelStrings) / sizeof(*LabelStrings);
+
+/// Number of frames used to average the timings
+const unsigned int NumAveragedFrames = 60;
+/// Number of frames between two lines appended to the log
+const unsigned int LogInterval = 10;
+
+nctl::StaticString<128> auxString;
+bool showImGui = true;
+bool countersEnabled = true;
+bool labelsEnabled = true;
+bool logEnabled = true;
+
+float updateTimes[NumAveragedFrames];
+float frameTimes[NumAveragedFrames];
+unsigned int timeIndex = 0;
+
+float average(const float *values)
+{
+	float sum = 0.0f;
+	for (unsigned int i = 0; i < NumAveragedFrames; i++)
+		sum += values[i];
+	return sum / NumAveragedFrames;
+}
+
+}
+
+nctl::UniquePtr<nc::IAppEventHandler> createAppEventHandler()
+{
+	return nctl::makeUnique<MyEventHandler>();
+}
+
+void MyEventHandler::onPreInit(nc::AppConfiguration &config)
+{
+	setDataPath(config);
+}
+
+void MyEventHandler::onInit()
+{
+	nc::SceneNode &rootNode = nc::theApplication().rootNode();
+	const float screenWidth = nc::theApplication().width();
+	const float screenHeight = nc::theApplication().height();
+
+	font_ = nctl::makeUnique<nc::Font>((prefixDataPath("fonts", FontFntFile)).data(),
+	                                   (prefixDataPath("fonts", FontTextureFile)).data());
+
+	const unsigned int numColumns = 8;
+	const float columnWidth = screenWidth / numColumns;
+
+	counters_.setCapacity(NumCounters);
+	for (unsigned int i = 0; i < NumCounters; i++)
+	{
+		counters_.pushBack(nctl::makeUnique<nc::TextNode>(&rootNode, font_.get(), 64));
+		nc::TextNode &counter = *counters_.back();
+		counter.setScale(0.5f);
+		counter.setPosition(columnWidth * (0.5f + i % numColumns), screenHeight * (0.95f - 0.06f * (i / numColumns)));
+	}
+
+	labels_.setCapacity(NumLabels);
+	for (unsigned int i = 0; i < NumLabels; i++)
+	{
+		labels_.pushBack(nctl::makeUnique<nc::TextNode>(&rootNode, font_.get(), 32));
+		nc::TextNode &label = *labels_.back();
+		label.setScale(0.5f);
+		label.setColor(255, 255, 0, 255);
+		label.setPosition(columnWidth * (0.5f + i % numColumns), screenHeight * (0.45f - 0.04f * (i / numColumns)));
+	}
+
+	log_ = nctl::makeUnique<nc::TextNode>(&rootNode, font_.get(), 1024);
+	log_->setScale(0.5f);
+	log_->setColor(0, 255, 255, 255);
+	log_->setPosition(screenWidth * 0.85f, screenHeight * 0.2f);
+	logString_.setCapacity(1024);
+
+	numUpdates_ = 0;
+	numLogLines_ = 0;
+	for (unsigned int i = 0; i < NumAveragedFrames; i++)
+	{
+		updateTimes[i] = 0.0f;
+		frameTimes[i] = 0.0f;
+	}
+
+	updateCounters();
+	updateLabels();
+	appendLogLine();
+}
+
+void MyEventHandler::onFrameStart()
+{
+	// Measuring the time spent by the text nodes to lay out their strings and calculate their boundaries
+	const nc::TimeStamp updateStart = nc::TimeStamp::now();
+	if (countersEnabled)
+		updateCounters();
+	if (labelsEnabled)
+		updateLabels();
+	if (logEnabled && numUpdates_ % LogInterval == 0)
+		appendLogLine();
+	updateTimes[timeIndex] = updateStart.millisecondsSince();
+	frameTimes[timeIndex] = nc::theApplication().interval() * 1000.0f;
+	timeIndex = (timeIndex + 1) % NumAveragedFrames;
+	numUpdates_++;
+
+	ImGui::SetNextWindowSize(ImVec2(350, 220), ImGuiCond_FirstUseEver);
+	ImGui::SetNextWindowPos(ImVec2(50, 50), ImGuiCond_FirstUseEver);
+	if (showImGui)
+	{
+		if (ImGui::Begin("apptest_texthud", &showImGui))
+		{
+			ImGui::Text("Counters: %u, labels: %u, log lines: %u", NumCounters, NumLabels, numLogLines_);
+			ImGui::Checkbox("Update counters", &countersEnabled);
+			ImGui::Checkbox("Update labels", &labelsEnabled);
+			ImGui::Checkbox("Append to the log", &logEnabled);
+			ImGui::Separator();
+			ImGui::Text("Text update: %.3f ms", average(updateTimes));
+			ImGui::PlotLines("##UpdateTimes", updateTimes, NumAveragedFrames, timeIndex, nullptr, 0.0f, FLT_MAX, ImVec2(0.0f, 40.0f));
+			ImGui::Text("Frame time: %.3f ms", average(frameTimes));
+			ImGui::PlotLines("##FrameTimes", frameTimes, NumAveragedFrames, timeIndex, nullptr, 0.0f, FLT_MAX, ImVec2(0.0f, 40.0f));
+		}
+		ImGui::End();
+	}
+}
+
+void MyEventHandler::onKeyReleased(const nc::KeyboardEvent &event)
+{
+	if (event.sym == nc::KeySym::ESCAPE)
+		nc::theApplication().quit();
+	else if (event.mod & nc::KeyMod::CTRL && event.sym == nc::KeySym::H)
+		showImGui = !showImGui;
+}
+
+void MyEventHandler::updateCounters()
+{
+	// Only the first line of every counter changes, the other two are the same for all of them
+	for (unsigned int i = 0; i < NumCounters; i++)
+	{
+		auxString.format("Score: %lu\nLives: 3\nLevel: 1", numUpdates_ * (i + 1));
+		counters_[i]->setString(auxString.data());
+		counters_[i]->width();
+	}
+}
+
+void MyEventHandler::updateLabels()
+{
+	// Many nodes show the same strings, which change together every second
+	const unsigned int firstString = (numUpdates_ / 60) % NumLabelStrings;
+	for (unsigned int i = 0; i < NumLabels; i++)
+	{
+		labels_[i]->setString(LabelStrings[(firstString + i) % NumLabelStrings]);
+		labels_[i]->width();
+	}
+}
+
+void MyEventHandler::appendLogLine()
+{
+	if (numLogLines_ == NumLogLines)
+	{
+		// Dropping the first line to make room for the new one
+		const unsigned int firstLineLength = logString_.findFirstChar('\n') + 1;
+		nctl::String trimmedString(logString_.capacity());
+		trimmedString.assign(logString_, firstLineLength, logString_.length() - firstLineLength);
+		logString_ = trimmedString;
+		numLogLines_--;
+	}
+
+	auxString.format("%sFrame %lu: event logged", logString_.isEmpty() ? "" : "\n", numUpdates_);
+	logString_.append(auxString.data());
+	numLogLines_++;
+
+	log_->setString(logString_);
+	log_->width();
+}
@@ -0,0 +1,53 @@
+#ifndef CLASS_MYEVENTHANDLER
+#define CLASS_MYEVENTHANDLER
+
+#include <ncine/IAppEventHandler.h>
+#include <ncine/IInputEventHandler.h>
+#include <nctl/Array.h>
+#include <nctl/String.h>
+
+namespace ncine {
+
+class AppConfiguration;
+class Font;
+class TextNode;
+
+}
+
+namespace nc = ncine;
+
+/// My nCine event handler
+class MyEventHandler :
+    public nc::IAppEventHandler,
+    public nc::IInputEventHandler
+{
+  public:
+	void onPreInit(nc::AppConfiguration &config) override;
+	void onInit() override;
+	void onFrameStart() override;
+
+	void onKeyReleased(const nc::KeyboardEvent &event) override;
+
+  private:
+	static const unsigned int NumCounters = 64;
+	static const unsigned int NumLabels = 64;
+	static const unsigned int NumLogLines = 16;
+
+	nctl::UniquePtr<nc::Font> font_;
+	/// Text nodes whose first line changes every frame
+	nctl::Array<nctl::UniquePtr<nc::TextNode>> counters_;
+	/// Text nodes sharing the same few strings
+	nctl::Array<nctl::UniquePtr<nc::TextNode>> labels_;
+	/// A text node where a new line is appended every few frames
+	nctl::UniquePtr<nc::TextNode> log_;
+	nctl::String logString_;
+
+	unsigned long int numUpdates_;
+	unsigned int numLogLines_;
+
+	void updateCounters();
+	void updateLabels();
+	void appendLogLine();
+};
+
+#endif
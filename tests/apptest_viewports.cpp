@@ -10,10 +10,6 @@
 #include <ncine/TextNode.h>
 #include <ncine/Viewport.h>
 #include <ncine/Camera.h>
-#include <ncine/TextureSaverPng.h>
-#if NCINE_WITH_WEBP
-	#include <ncine/TextureSaverWebP.h>
-#endif
 #include "apptest_datapath.h"
 
 namespace {
@@ -316,53 +312,21 @@ void MyEventHandler::onFrameStart()
 					ImGui::SameLine();
 					if (ImGui::Button("Save PNG"))
 					{
-						nc::TextureSaverPng saver;
-						nc::TextureSaverPng::Properties props;
-						props.width = currentViewportSize.x;
-						props.height = currentViewportSize.y;
-						props.format = nc::ITextureSaver::Format::RGB8;
+						// Recycling comboString for screenshot filename
+						comboString.format("viewport%d_%dx%d.png", currentComboViewport, currentViewportSize.x, currentViewportSize.y);
 						// Vertical flip as the texture is generated by OpenGL and saved from bottom to top
-						props.verticalFlip = true;
-						if (currentTexture->format() == nc::Texture::Format::RGBA8)
-							props.format = nc::ITextureSaver::Format::RGBA8;
-
-						nc::Texture &tex = *currentViewport.texture();
-						nctl::UniquePtr<unsigned char[]> buffer = nctl::makeUnique<unsigned char[]>(tex.dataSize());
-						const bool savedToMemory = tex.saveToMemory(buffer.get());
-						if (savedToMemory)
-						{
-							props.pixels = buffer.get();
-							// Recycling comboString for screenshot filename
-							comboString.format("viewport%d_%dx%d.png", currentComboViewport, currentViewportSize.x, currentViewportSize.y);
-							saver.saveToFile(props, comboString.data());
-						}
+						if (currentViewport.texture()->saveToFileAsync(comboString.data(), true) == false)
+							LOGW_X("Cannot save \"%s\"", comboString.data());
 					}
 	#if NCINE_WITH_WEBP
 					ImGui::SameLine();
 					if (ImGui::Button("Save WebP"))
 					{
-						nc::TextureSaverWebP saver;
-						nc::TextureSaverWebP::Properties props;
-						nc::TextureSaverWebP::WebPProperties webpProps;
-						props.width = currentViewportSize.x;
-						props.height = currentViewportSize.y;
-						props.format = nc::ITextureSaver::Format::RGB8;
+						// Recycling comboString for screenshot filename
+						comboString.format("viewport%d_%dx%d.webp", currentComboViewport, currentViewportSize.x, currentViewportSize.y);
 						// Vertical flip as the texture is generated by OpenGL and saved from bottom to top
-						props.verticalFlip = true;
-						webpProps.lossless = true;
-						if (currentTexture->format() == nc::Texture::Format::RGBA8)
-							props.format = nc::ITextureSaver::Format::RGBA8;
-
-						nc::Texture &tex = *currentViewport.texture();
-						nctl::UniquePtr<unsigned char[]> buffer = nctl::makeUnique<unsigned char[]>(tex.dataSize());
-						const bool savedToMemory = tex.saveToMemory(buffer.get());
-						if (savedToMemory)
-						{
-							props.pixels = buffer.get();
-							// Recycling comboString for screenshot filename
-							comboString.format("viewport%d_%dx%d.webp", currentComboViewport, currentViewportSize.x, currentViewportSize.y);
-							saver.saveToFile(props, webpProps, comboString.data());
-						}
+						if (currentViewport.texture()->saveToFileAsync(comboString.data(), true) == false)
+							LOGW_X("Cannot save \"%s\"", comboString.data());
 					}
 	#endif
 #endif
@@ -0,0 +1,160 @@
+#include "gtest_allocators.h"
+#include <nctl/Array.h>
+
+namespace {
+
+class AllocatorFrameArenaTest : public ::testing::Test
+{
+  public:
+	AllocatorFrameArenaTest()
+	    : mallocAllocator_(), allocator_("FrameArena", BufferSize, mallocAllocator_) {}
+
+  protected:
+	nctl::MallocAllocator mallocAllocator_;
+	nctl::FrameArenaAllocator allocator_;
+};
+
+TEST(AllocatorFrameArenaDeathTest, AllocateZeroBytes)
+{
+	nctl::MallocAllocator mallocAllocator;
+	nctl::FrameArenaAllocator allocator("FrameArena", BufferSize, mallocAllocator);
+
+	printf("Allocating zero bytes with the FrameArenaAllocator\n");
+	ASSERT_DEATH(allocator.allocate(0), "");
+}
+
+TEST_F(AllocatorFrameArenaTest, BuffersAtConstruction)
+{
+	ASSERT_EQ(allocator_.bufferSize(), BufferSize);
+	ASSERT_EQ(allocator_.size(), BufferSize * 2);
+	ASSERT_EQ(allocator_.usedMemory(), 0);
+	ASSERT_EQ(allocator_.numAllocations(), 0);
+	ASSERT_EQ(mallocAllocator_.numAllocations(), 2);
+}
+
+TEST_F(AllocatorFrameArenaTest, AllocateFromCurrentBuffer)
+{
+	printf("Allocating %d elements with the FrameArenaAllocator\n", NumElements);
+	ElementType *ptr = static_cast<ElementType *>(allocator_.allocate(ElementSize * NumElements));
+	ASSERT_NE(ptr, nullptr);
+	ASSERT_TRUE(allocator_.owns(ptr));
+	ASSERT_EQ(allocator_.numAllocations(), 1);
+	ASSERT_GE(allocator_.frameUsedMemory(), ElementSize * NumElements);
+	fillElements(ptr, NumElements);
+
+	printf("Deallocating does not reclaim memory\n");
+	const size_t usedMemory = allocator_.usedMemory();
+	allocator_.deallocate(ptr);
+	ASSERT_EQ(allocator_.usedMemory(), usedMemory);
+}
+
+TEST_F(AllocatorFrameArenaTest, AllocationsSurviveOneFrame)
+{
+	ElementType *ptr = static_cast<ElementType *>(allocator_.allocate(ElementSize * NumElements));
+	fillElements(ptr, NumElements);
+	const unsigned int firstBuffer = allocator_.currentBuffer();
+
+	printf("Swapping buffers once\n");
+	allocator_.swapBuffers();
+	ASSERT_NE(allocator_.currentBuffer(), firstBuffer);
+	ASSERT_EQ(allocator_.frameUsedMemory(), 0);
+	ASSERT_GE(allocator_.lastFrameUsedMemory(), ElementSize * NumElements);
+	ASSERT_EQ(allocator_.numAllocations(), 1);
+
+	ElementType *newPtr = static_cast<ElementType *>(allocator_.allocate(ElementSize * NumElements));
+	ASSERT_NE(newPtr, ptr);
+	for (unsigned int i = 0; i < NumElements; i++)
+		ASSERT_EQ(ptr[i].a, i);
+
+	printf("Swapping buffers twice\n");
+	allocator_.swapBuffers();
+	ASSERT_EQ(allocator_.currentBuffer(), firstBuffer);
+	ASSERT_EQ(allocator_.numAllocations(), 1);
+	ASSERT_EQ(static_cast<ElementType *>(allocator_.allocate(ElementSize)), ptr);
+}
+
+TEST_F(AllocatorFrameArenaTest, PeakUsedMemory)
+{
+	allocator_.allocate(ElementSize * NumElements);
+	allocator_.swapBuffers();
+	allocator_.allocate(ElementSize);
+	allocator_.swapBuffers();
+
+	printf("Peak used memory: %lu\n", allocator_.peakUsedMemory());
+	ASSERT_GE(allocator_.peakUsedMemory(), ElementSize * NumElements);
+	ASSERT_LT(allocator_.lastFrameUsedMemory(), allocator_.peakUsedMemory());
+}
+
+TEST_F(AllocatorFrameArenaTest, OverflowToSource)
+{
+	printf("Allocating more than the buffer size\n");
+	void *ptr = allocator_.allocate(BufferSize * 2);
+	ASSERT_NE(ptr, nullptr);
+	ASSERT_FALSE(allocator_.owns(ptr));
+	ASSERT_EQ(allocator_.numAllocations(), 1);
+	ASSERT_EQ(mallocAllocator_.numAllocations(), 3);
+
+	allocator_.swapBuffers();
+	ASSERT_EQ(allocator_.lastFrameNumOverflows(), 1);
+	ASSERT_EQ(allocator_.numOverflows(), 1);
+
+	allocator_.deallocate(ptr);
+	ASSERT_EQ(allocator_.numAllocations(), 0);
+	ASSERT_EQ(mallocAllocator_.numAllocations(), 2);
+}
+
+TEST_F(AllocatorFrameArenaTest, ReallocateLastAllocation)
+{
+	const unsigned int NumHalfElements = NumElements / 2;
+	ElementType *first = static_cast<ElementType *>(allocator_.allocate(ElementSize * NumHalfElements));
+	fillElements(first, NumHalfElements);
+	ElementType *last = static_cast<ElementType *>(allocator_.allocate(ElementSize * NumHalfElements));
+	fillElements(last, NumHalfElements);
+
+	printf("Reallocating the last allocation to twice its size\n");
+	ElementType *newPtr = static_cast<ElementType *>(allocator_.reallocate(last, ElementSize * NumElements));
+	ASSERT_NE(newPtr, nullptr);
+	ASSERT_NE(newPtr, last);
+	ASSERT_TRUE(allocator_.owns(newPtr));
+	for (unsigned int i = 0; i < NumHalfElements; i++)
+	{
+		ASSERT_EQ(newPtr[i].a, i);
+		ASSERT_EQ(newPtr[i].b, NumElements - i - 1);
+	}
+
+	printf("The other allocations are not modified\n");
+	for (unsigned int i = 0; i < NumHalfElements; i++)
+	{
+		ASSERT_EQ(first[i].a, i);
+		ASSERT_EQ(last[i].a, i);
+	}
+}
+
+TEST_F(AllocatorFrameArenaTest, ReallocateToSmallerSize)
+{
+	ElementType *ptr = static_cast<ElementType *>(allocator_.allocate(ElementSize * NumElements));
+	fillElements(ptr, NumElements);
+
+	printf("Reallocating an allocation to half its size\n");
+	const size_t usedMemory = allocator_.frameUsedMemory();
+	ElementType *newPtr = static_cast<ElementType *>(allocator_.reallocate(ptr, ElementSize * NumElements / 2));
+	ASSERT_NE(newPtr, nullptr);
+	ASSERT_LT(allocator_.frameUsedMemory() - usedMemory, ElementSize * NumElements);
+	for (unsigned int i = 0; i < NumElements / 2; i++)
+		ASSERT_EQ(newPtr[i].a, i);
+}
+
+TEST_F(AllocatorFrameArenaTest, ArrayWithFrameArena)
+{
+	printf("Growing an array that uses the FrameArenaAllocator\n");
+	nctl::Array<ElementType> array(4, allocator_);
+	for (unsigned int i = 0; i < NumElements; i++)
+		array.emplaceBack(i, NumElements - i - 1, static_cast<float>(i), static_cast<float>(NumElements - i - 1));
+
+	ASSERT_EQ(array.size(), NumElements);
+	for (unsigned int i = 0; i < NumElements; i++)
+		ASSERT_EQ(array[i].a, i);
+	ASSERT_TRUE(allocator_.owns(array.data()));
+}
+
+}
@@ -0,0 +1,148 @@
+#include "gtest_allocators.h"
+
+namespace {
+
+const unsigned int ElementsPerSlab = 8;
+
+class AllocatorSlabTest : public ::testing::Test
+{
+  public:
+	AllocatorSlabTest()
+	    : mallocAllocator_(), allocator_("Slab", ElementSize, nctl::IAllocator::DefaultAlignment, ElementsPerSlab, mallocAllocator_) {}
+
+  protected:
+	nctl::MallocAllocator mallocAllocator_;
+	nctl::SlabAllocator allocator_;
+};
+
+TEST(AllocatorSlabDeathTest, AllocateZeroBytes)
+{
+	nctl::MallocAllocator mallocAllocator;
+	nctl::SlabAllocator allocator("Slab", ElementSize, nctl::IAllocator::DefaultAlignment, ElementsPerSlab, mallocAllocator);
+
+	printf("Allocating zero bytes with the SlabAllocator\n");
+	ASSERT_DEATH(allocator.allocate(0), "");
+}
+
+TEST(AllocatorSlabDeathTest, AllocateTooBig)
+{
+	nctl::MallocAllocator mallocAllocator;
+	nctl::SlabAllocator allocator("Slab", ElementSize, nctl::IAllocator::DefaultAlignment, ElementsPerSlab, mallocAllocator);
+
+	printf("Allocating more bytes than the element size with the SlabAllocator\n");
+	ASSERT_DEATH(allocator.allocate(ElementSize * 2), "");
+}
+
+TEST_F(AllocatorSlabTest, NoSlabsAtConstruction)
+{
+	ASSERT_EQ(allocator_.numSlabs(), 0);
+	ASSERT_EQ(allocator_.capacity(), 0);
+	ASSERT_EQ(allocator_.freeList(), nullptr);
+	ASSERT_EQ(mallocAllocator_.numAllocations(), 0);
+}
+
+TEST_F(AllocatorSlabTest, AllocateDeallocate)
+{
+	ElementType *ptrs[NumElements];
+	printf("Allocating %d elements with the SlabAllocator\n", NumElements);
+	for (unsigned int i = 0; i < NumElements; i++)
+	{
+		ptrs[i] = reinterpret_cast<ElementType *>(allocator_.allocate(ElementSize));
+		ASSERT_NE(ptrs[i], nullptr);
+		ASSERT_EQ(uintptr_t(ptrs[i]) % nctl::IAllocator::DefaultAlignment, 0);
+		ASSERT_TRUE(allocator_.owns(ptrs[i]));
+		ASSERT_EQ(allocator_.numAllocations(), i + 1);
+		ASSERT_EQ(allocator_.usedMemory(), allocator_.elementStride() * (i + 1));
+	}
+
+	printf("Filling the memory with %d integers\n", NumElements);
+	for (unsigned int i = 0; i < NumElements; i++)
+		fillElements(ptrs[i], 1);
+
+	printf("Deallocating %d elements from the SlabAllocator\n", NumElements);
+	for (int i = NumElements - 1; i >= 0; i--)
+	{
+		allocator_.deallocate(ptrs[i]);
+		ASSERT_EQ(allocator_.numAllocations(), i);
+		ASSERT_EQ(allocator_.usedMemory(), allocator_.elementStride() * i);
+	}
+}
+
+TEST_F(AllocatorSlabTest, GrowByDoubling)
+{
+	ElementType *ptrs[Capacity];
+	printf("Allocating %d elements with the SlabAllocator\n", Capacity);
+	for (unsigned int i = 0; i < Capacity; i++)
+		ptrs[i] = reinterpret_cast<ElementType *>(allocator_.allocate(ElementSize));
+
+	// 8 + 8 + 16 + 32 elements
+	ASSERT_EQ(allocator_.numSlabs(), 4);
+	ASSERT_EQ(allocator_.capacity(), Capacity);
+	ASSERT_EQ(allocator_.size(), Capacity * allocator_.elementStride());
+	ASSERT_EQ(allocator_.freeMemory(), 0);
+	ASSERT_EQ(mallocAllocator_.numAllocations(), 4);
+
+	for (unsigned int i = 0; i < Capacity; i++)
+		allocator_.deallocate(ptrs[i]);
+}
+
+TEST_F(AllocatorSlabTest, ReuseFreedElement)
+{
+	void *ptr = allocator_.allocate(ElementSize);
+	allocator_.deallocate(ptr);
+
+	printf("Allocating again after a deallocation\n");
+	void *newPtr = allocator_.allocate(ElementSize);
+	ASSERT_EQ(newPtr, ptr);
+	ASSERT_EQ(allocator_.numSlabs(), 1);
+
+	allocator_.deallocate(newPtr);
+}
+
+TEST_F(AllocatorSlabTest, Reserve)
+{
+	printf("Reserving space for %d elements\n", Capacity);
+	ASSERT_TRUE(allocator_.reserve(Capacity));
+	ASSERT_GE(allocator_.capacity(), Capacity);
+	const unsigned int numSlabs = allocator_.numSlabs();
+
+	ElementType *ptrs[Capacity];
+	for (unsigned int i = 0; i < Capacity; i++)
+		ptrs[i] = reinterpret_cast<ElementType *>(allocator_.allocate(ElementSize));
+	ASSERT_EQ(allocator_.numSlabs(), numSlabs);
+
+	for (unsigned int i = 0; i < Capacity; i++)
+		allocator_.deallocate(ptrs[i]);
+}
+
+TEST_F(AllocatorSlabTest, ReleaseSlabs)
+{
+	void *ptr = allocator_.allocate(ElementSize);
+	printf("Trying to release slabs with an active allocation\n");
+	ASSERT_FALSE(allocator_.releaseSlabs());
+	ASSERT_EQ(mallocAllocator_.numAllocations(), 1);
+
+	allocator_.deallocate(ptr);
+	printf("Releasing slabs without active allocations\n");
+	ASSERT_TRUE(allocator_.releaseSlabs());
+	ASSERT_EQ(allocator_.numSlabs(), 0);
+	ASSERT_EQ(allocator_.size(), 0);
+	ASSERT_EQ(mallocAllocator_.numAllocations(), 0);
+}
+
+TEST(AllocatorTypedSlabTest, CreateDestroy)
+{
+	nctl::TypedSlabAllocator<ElementType> allocator("TypedSlab", ElementsPerSlab);
+	ASSERT_EQ(allocator.elementSize(), sizeof(ElementType));
+
+	printf("Creating an object with the TypedSlabAllocator\n");
+	ElementType *element = allocator.create(1u, 2u, 3.0f, 4.0f);
+	ASSERT_EQ(*element, ElementType(1u, 2u, 3.0f, 4.0f));
+	ASSERT_EQ(allocator.numAllocations(), 1);
+
+	printf("Destroying an object with the TypedSlabAllocator\n");
+	allocator.destroy(element);
+	ASSERT_EQ(allocator.numAllocations(), 0);
+}
+
+}
@@ -0,0 +1,191 @@
+#include "gtest_allocators.h"
+
+namespace {
+
+class AllocatorThreadCacheTest : public ::testing::Test
+{
+  public:
+	AllocatorThreadCacheTest()
+	    : mallocAllocator_(), allocator_("ThreadCache", mallocAllocator_) {}
+
+  protected:
+	nctl::MallocAllocator mallocAllocator_;
+	nctl::ThreadCacheAllocator allocator_;
+};
+
+TEST(AllocatorThreadCacheDeathTest, AllocateZeroBytes)
+{
+	nctl::MallocAllocator mallocAllocator;
+	nctl::ThreadCacheAllocator allocator(mallocAllocator);
+
+	printf("Allocating zero bytes with the ThreadCacheAllocator\n");
+	ASSERT_DEATH(allocator.allocate(0), "");
+}
+
+TEST_F(AllocatorThreadCacheTest, SizeClasses)
+{
+	printf("Checking that every size fits in its size class\n");
+	for (size_t bytes = 1; bytes <= nctl::ThreadCacheAllocator::MaxSmallSize; bytes++)
+	{
+		const unsigned int sizeClass = nctl::ThreadCacheAllocator::sizeClass(bytes);
+		ASSERT_LT(sizeClass, nctl::ThreadCacheAllocator::NumSizeClasses);
+		ASSERT_GE(nctl::ThreadCacheAllocator::classSize(sizeClass), bytes);
+		if (sizeClass > 0)
+		{
+			ASSERT_LT(nctl::ThreadCacheAllocator::classSize(sizeClass - 1), bytes);
+		}
+	}
+
+	for (unsigned int i = 0; i < nctl::ThreadCacheAllocator::NumSizeClasses; i++)
+		ASSERT_EQ(nctl::ThreadCacheAllocator::sizeClass(nctl::ThreadCacheAllocator::classSize(i)), i);
+	ASSERT_EQ(nctl::ThreadCacheAllocator::classSize(nctl::ThreadCacheAllocator::NumSizeClasses - 1), nctl::ThreadCacheAllocator::MaxSmallSize);
+}
+
+TEST_F(AllocatorThreadCacheTest, NoChunksAtConstruction)
+{
+	ASSERT_EQ(allocator_.numChunks(), 0);
+	ASSERT_EQ(allocator_.size(), 0);
+	ASSERT_EQ(mallocAllocator_.numAllocations(), 0);
+}
+
+TEST_F(AllocatorThreadCacheTest, AllocateDeallocate)
+{
+	const size_t classSize = nctl::ThreadCacheAllocator::classSize(nctl::ThreadCacheAllocator::sizeClass(ElementSize));
+
+	ElementType *ptrs[NumElements];
+	printf("Allocating %d elements with the ThreadCacheAllocator\n", NumElements);
+	for (unsigned int i = 0; i < NumElements; i++)
+	{
+		ptrs[i] = reinterpret_cast<ElementType *>(allocator_.allocate(ElementSize));
+		ASSERT_NE(ptrs[i], nullptr);
+		ASSERT_EQ(uintptr_t(ptrs[i]) % nctl::IAllocator::DefaultAlignment, 0);
+	}
+	ASSERT_EQ(allocator_.numChunks(), 1);
+
+	printf("Filling the memory with %d integers\n", NumElements);
+	for (unsigned int i = 0; i < NumElements; i++)
+		fillElements(ptrs[i], 1);
+
+	allocator_.flushThreadCache();
+	ASSERT_EQ(allocator_.numAllocations(), NumElements);
+	ASSERT_EQ(allocator_.usedMemory(), classSize * NumElements);
+
+	printf("Deallocating %d elements\n", NumElements);
+	for (unsigned int i = 0; i < NumElements; i++)
+		allocator_.deallocate(ptrs[i]);
+
+	allocator_.flushThreadCache();
+	ASSERT_EQ(allocator_.numAllocations(), 0);
+	ASSERT_EQ(allocator_.usedMemory(), 0);
+}
+
+TEST_F(AllocatorThreadCacheTest, ReuseFreedBlock)
+{
+	void *ptr = allocator_.allocate(ElementSize);
+	allocator_.deallocate(ptr);
+
+	printf("Allocating again after a deallocation of the same size\n");
+	void *newPtr = allocator_.allocate(ElementSize);
+	ASSERT_EQ(newPtr, ptr);
+
+	allocator_.deallocate(newPtr);
+}
+
+TEST_F(AllocatorThreadCacheTest, FlushThreadCache)
+{
+	const unsigned int sizeClass = nctl::ThreadCacheAllocator::sizeClass(ElementSize);
+
+	void *ptr = allocator_.allocate(ElementSize);
+	ASSERT_GT(allocator_.numCachedBlocks(sizeClass), 0);
+	allocator_.deallocate(ptr);
+
+	printf("Flushing the thread cache to the shared backend\n");
+	allocator_.flushThreadCache();
+	ASSERT_EQ(allocator_.numCachedBlocks(sizeClass), 0);
+	ASSERT_EQ(allocator_.numAllocations(), 0);
+
+	void *newPtr = allocator_.allocate(ElementSize);
+	ASSERT_NE(newPtr, nullptr);
+	ASSERT_EQ(allocator_.numChunks(), 1);
+	allocator_.deallocate(newPtr);
+}
+
+TEST_F(AllocatorThreadCacheTest, LargeAllocation)
+{
+	const size_t bytes = nctl::ThreadCacheAllocator::MaxSmallSize * 2;
+
+	printf("Allocating %lu bytes with the ThreadCacheAllocator\n", bytes);
+	void *ptr = allocator_.allocate(bytes);
+	ASSERT_NE(ptr, nullptr);
+	ASSERT_EQ(uintptr_t(ptr) % nctl::IAllocator::DefaultAlignment, 0);
+	ASSERT_EQ(allocator_.numChunks(), 0);
+	ASSERT_EQ(allocator_.numAllocations(), 1);
+	ASSERT_GE(allocator_.usedMemory(), bytes);
+	ASSERT_EQ(mallocAllocator_.numAllocations(), 1);
+
+	allocator_.deallocate(ptr);
+	ASSERT_EQ(allocator_.numAllocations(), 0);
+	ASSERT_EQ(allocator_.usedMemory(), 0);
+	ASSERT_EQ(mallocAllocator_.numAllocations(), 0);
+}
+
+TEST_F(AllocatorThreadCacheTest, OverAlignedAllocation)
+{
+	const uint8_t alignment = 64;
+
+	printf("Allocating %lu bytes with an alignment of %u bytes\n", ElementSize, alignment);
+	void *ptr = allocator_.allocate(ElementSize, alignment);
+	ASSERT_NE(ptr, nullptr);
+	ASSERT_EQ(uintptr_t(ptr) % alignment, 0);
+
+	allocator_.deallocate(ptr);
+	ASSERT_EQ(mallocAllocator_.numAllocations(), 0);
+}
+
+TEST_F(AllocatorThreadCacheTest, ReallocateSameSizeClass)
+{
+	const size_t classSize = nctl::ThreadCacheAllocator::classSize(nctl::ThreadCacheAllocator::sizeClass(ElementSize));
+
+	void *ptr = allocator_.allocate(ElementSize);
+	printf("Reallocating to %lu bytes\n", classSize);
+	void *newPtr = allocator_.reallocate(ptr, classSize);
+	ASSERT_EQ(newPtr, ptr);
+
+	allocator_.deallocate(newPtr);
+}
+
+TEST_F(AllocatorThreadCacheTest, ReallocateGrow)
+{
+	ElementType *ptr = reinterpret_cast<ElementType *>(allocator_.allocate(ElementSize * NumElements));
+	fillElements(ptr, NumElements);
+
+	printf("Reallocating to %lu bytes\n", ElementSize * Capacity);
+	ElementType *newPtr = reinterpret_cast<ElementType *>(allocator_.reallocate(ptr, ElementSize * Capacity));
+	ASSERT_NE(newPtr, nullptr);
+	ASSERT_NE(newPtr, ptr);
+	for (unsigned int i = 0; i < NumElements; i++)
+	{
+		ASSERT_EQ(newPtr[i].a, i);
+		ASSERT_EQ(newPtr[i].b, NumElements - i - 1);
+	}
+
+	allocator_.deallocate(newPtr);
+	allocator_.flushThreadCache();
+	ASSERT_EQ(allocator_.numAllocations(), 0);
+}
+
+TEST_F(AllocatorThreadCacheTest, ReleaseChunksOnDestruction)
+{
+	nctl::MallocAllocator mallocAllocator;
+	{
+		nctl::ThreadCacheAllocator allocator(mallocAllocator);
+		void *ptr = allocator.allocate(ElementSize);
+		allocator.deallocate(ptr);
+		ASSERT_EQ(mallocAllocator.numAllocations(), 1);
+	}
+
+	printf("Destroying the allocator without active allocations\n");
+	ASSERT_EQ(mallocAllocator.numAllocations(), 0);
+}
+
+}
@@ -0,0 +1,100 @@
+#include <nctl/MallocAllocator.h>
+#include <nctl/ThreadCacheAllocator.h>
+#include <nctl/Atomic.h>
+#include "gtest/gtest.h"
+#include "test_thread_functions.h"
+
+namespace {
+
+const unsigned int NumThreads = 16;
+const unsigned int NumIterations = 1000;
+const unsigned int NumBlocksPerThread = 256;
+
+size_t blockSize(unsigned int index)
+{
+	// Sizes span all the small classes and some large allocations
+	return 8 + (index * 397) % (nctl::ThreadCacheAllocator::MaxSmallSize + 4096);
+}
+
+class AllocatorThreadCacheThreadsTest : public ::testing::Test
+{
+  public:
+	AllocatorThreadCacheThreadsTest()
+	    : mallocAllocator_(), allocator_(nullptr), tr_(this) {}
+
+	void SetUp() override { allocator_ = new nctl::ThreadCacheAllocator(mallocAllocator_); }
+	void TearDown() override
+	{
+		delete allocator_;
+		ASSERT_EQ(mallocAllocator_.numAllocations(), 0);
+	}
+
+	nctl::MallocAllocator mallocAllocator_;
+	nctl::ThreadCacheAllocator *allocator_;
+	nctl::Atomic32 nextThreadIndex_;
+	unsigned int *blocks_[NumThreads * NumBlocksPerThread];
+	ThreadRunner<NumThreads> tr_;
+};
+
+TEST_F(AllocatorThreadCacheThreadsTest, AllocateDeallocateMultithread)
+{
+	tr_.runThreads([](void *arg) -> ThreadRunner<NumThreads>::threadFuncRet {
+		AllocatorThreadCacheThreadsTest *obj = static_cast<AllocatorThreadCacheThreadsTest *>(arg);
+		const unsigned int threadIndex = obj->nextThreadIndex_.fetchAdd(1);
+
+		unsigned int *ptrs[NumBlocksPerThread];
+		for (unsigned int i = 0; i < NumIterations; i++)
+		{
+			const unsigned int numBlocks = (i % NumBlocksPerThread) + 1;
+			for (unsigned int j = 0; j < numBlocks; j++)
+			{
+				ptrs[j] = static_cast<unsigned int *>(obj->allocator_->allocate(blockSize(i + j)));
+				*ptrs[j] = threadIndex;
+			}
+			for (unsigned int j = 0; j < numBlocks; j++)
+			{
+				if (*ptrs[j] != threadIndex)
+					return nullptr;
+				obj->allocator_->deallocate(ptrs[j]);
+			}
+		}
+		return static_cast<AllocatorThreadCacheThreadsTest *>(arg)->tr_.retFunc();
+	});
+
+	printf("Letting all threads join and destroying the allocator\n");
+}
+
+TEST_F(AllocatorThreadCacheThreadsTest, CrossThreadDeallocation)
+{
+	printf("Allocating %u blocks from each of %u threads\n", NumBlocksPerThread, NumThreads);
+	tr_.runThreads([](void *arg) -> ThreadRunner<NumThreads>::threadFuncRet {
+		AllocatorThreadCacheThreadsTest *obj = static_cast<AllocatorThreadCacheThreadsTest *>(arg);
+		const unsigned int threadIndex = obj->nextThreadIndex_.fetchAdd(1);
+
+		for (unsigned int i = 0; i < NumBlocksPerThread; i++)
+		{
+			const unsigned int index = threadIndex * NumBlocksPerThread + i;
+			obj->blocks_[index] = static_cast<unsigned int *>(obj->allocator_->allocate(blockSize(index)));
+			*obj->blocks_[index] = index;
+		}
+		return static_cast<AllocatorThreadCacheThreadsTest *>(arg)->tr_.retFunc();
+	});
+
+	for (unsigned int i = 0; i < NumThreads * NumBlocksPerThread; i++)
+		ASSERT_EQ(*blocks_[i], i);
+
+	printf("Deallocating the blocks from different threads\n");
+	nextThreadIndex_.store(0);
+	tr_.runThreads([](void *arg) -> ThreadRunner<NumThreads>::threadFuncRet {
+		AllocatorThreadCacheThreadsTest *obj = static_cast<AllocatorThreadCacheThreadsTest *>(arg);
+		const unsigned int threadIndex = obj->nextThreadIndex_.fetchAdd(1);
+
+		// Every thread frees the blocks allocated by another one
+		const unsigned int otherIndex = (threadIndex + 1) % NumThreads;
+		for (unsigned int i = 0; i < NumBlocksPerThread; i++)
+			obj->allocator_->deallocate(obj->blocks_[otherIndex * NumBlocksPerThread + i]);
+		return static_cast<AllocatorThreadCacheThreadsTest *>(arg)->tr_.retFunc();
+	});
+}
+
+}
@@ -7,6 +7,9 @@
 #include <nctl/PoolAllocator.h>
 #include <nctl/FreeListAllocator.h>
 #include <nctl/ProxyAllocator.h>
+#include <nctl/SlabAllocator.h>
+#include <nctl/ThreadCacheAllocator.h>
+#include <nctl/FrameArenaAllocator.h>
 #include "gtest/gtest.h"
 
 namespace {
@@ -0,0 +1,496 @@
+#include "gtest_flathashmap.h"
+
+namespace {
+
+class FlatHashMapTest : public ::testing::Test
+{
+  public:
+	FlatHashMapTest()
+	    : hashmap_(Capacity) {}
+
+  protected:
+	void SetUp() override { initFlatHashMap(hashmap_); }
+
+	FlatHashMapTestType hashmap_;
+};
+
+#ifndef __EMSCRIPTEN__
+TEST(FlatHashMapDeathTest, ZeroCapacity)
+{
+	printf("Creating an hashmap of zero capacity\n");
+	ASSERT_DEATH(FlatHashMapTestType newHashmap(0), "");
+}
+#endif
+
+TEST_F(FlatHashMapTest, Capacity)
+{
+	const unsigned int capacity = hashmap_.capacity();
+	printf("Capacity: %u\n", capacity);
+
+	ASSERT_EQ(capacity, Capacity);
+}
+
+TEST_F(FlatHashMapTest, Size)
+{
+	const unsigned int size = hashmap_.size();
+	printf("Size: %u\n", size);
+
+	ASSERT_EQ(size, Size);
+	ASSERT_EQ(calcSize(hashmap_), Size);
+}
+
+TEST_F(FlatHashMapTest, LoadFactor)
+{
+	const float loadFactor = hashmap_.loadFactor();
+	printf("Size: %u, Capacity: %u, Load Factor: %f\n", Size, Capacity, loadFactor);
+
+	ASSERT_FLOAT_EQ(loadFactor, Size / static_cast<float>(Capacity));
+}
+
+TEST_F(FlatHashMapTest, Clear)
+{
+	ASSERT_FALSE(hashmap_.isEmpty());
+	hashmap_.clear();
+	printFlatHashMap(hashmap_);
+	ASSERT_TRUE(hashmap_.isEmpty());
+	ASSERT_EQ(hashmap_.size(), 0u);
+	ASSERT_EQ(hashmap_.capacity(), Capacity);
+}
+
+TEST_F(FlatHashMapTest, RetrieveElements)
+{
+	printf("Retrieving the elements\n");
+	for (unsigned int i = 0; i < Size; i++)
+	{
+		printf("key: %u, value: %d\n", i, hashmap_[i]);
+		ASSERT_EQ(hashmap_[i], i + KeyValueDifference);
+	}
+
+	ASSERT_EQ(hashmap_.size(), Size);
+	ASSERT_EQ(calcSize(hashmap_), Size);
+}
+
+TEST_F(FlatHashMapTest, InsertElements)
+{
+	printf("Inserting elements\n");
+	for (unsigned int i = Size; i < Size * 2; i++)
+		hashmap_.insert(i, i + KeyValueDifference);
+
+	for (unsigned int i = 0; i < Size * 2; i++)
+		ASSERT_EQ(hashmap_[i], i + KeyValueDifference);
+
+	ASSERT_EQ(hashmap_.size(), Size * 2);
+	ASSERT_EQ(calcSize(hashmap_), Size * 2);
+}
+
+TEST_F(FlatHashMapTest, InsertConstElements)
+{
+	printf("Inserting const elements\n");
+	for (unsigned int i = Size; i < Size * 2; i++)
+	{
+		const int value = i + KeyValueDifference;
+		hashmap_.insert(i, value);
+	}
+
+	for (unsigned int i = 0; i < Size * 2; i++)
+		ASSERT_EQ(hashmap_[i], i + KeyValueDifference);
+
+	ASSERT_EQ(hashmap_.size(), Size * 2);
+	ASSERT_EQ(calcSize(hashmap_), Size * 2);
+}
+
+TEST_F(FlatHashMapTest, FailInsertElements)
+{
+	printf("Trying to insert elements already in the hashmap\n");
+	for (unsigned int i = 0; i < Size * 2; i++)
+		hashmap_.insert(i, i + 2 * KeyValueDifference);
+
+	for (unsigned int i = 0; i < Size; i++)
+		ASSERT_EQ(hashmap_[i], i + KeyValueDifference);
+	for (unsigned int i = Size; i < Size * 2; i++)
+		ASSERT_EQ(hashmap_[i], i + 2 * KeyValueDifference);
+
+	ASSERT_EQ(hashmap_.size(), Size * 2);
+	ASSERT_EQ(calcSize(hashmap_), Size * 2);
+}
+
+TEST_F(FlatHashMapTest, FailInsertConstElements)
+{
+	printf("Trying to insert const elements already in the hashmap\n");
+	for (unsigned int i = 0; i < Size * 2; i++)
+	{
+		const int value = i + 2 * KeyValueDifference;
+		hashmap_.insert(i, value);
+	}
+
+	for (unsigned int i = 0; i < Size; i++)
+		ASSERT_EQ(hashmap_[i], i + KeyValueDifference);
+	for (unsigned int i = Size; i < Size * 2; i++)
+		ASSERT_EQ(hashmap_[i], i + 2 * KeyValueDifference);
+
+	ASSERT_EQ(hashmap_.size(), Size * 2);
+	ASSERT_EQ(calcSize(hashmap_), Size * 2);
+}
+
+TEST_F(FlatHashMapTest, EmplaceElements)
+{
+	printf("Emplacing elements\n");
+	for (unsigned int i = Size; i < Size * 2; i++)
+		hashmap_.emplace(i, i + KeyValueDifference);
+
+	for (unsigned int i = 0; i < Size * 2; i++)
+		ASSERT_EQ(hashmap_[i], i + KeyValueDifference);
+
+	ASSERT_EQ(hashmap_.size(), Size * 2);
+	ASSERT_EQ(calcSize(hashmap_), Size * 2);
+}
+
+TEST_F(FlatHashMapTest, FailEmplaceElements)
+{
+	printf("Trying to emplace elements already in the hashmap\n");
+	for (unsigned int i = 0; i < Size * 2; i++)
+		hashmap_.emplace(i, i + 2 * KeyValueDifference);
+
+	for (unsigned int i = 0; i < Size; i++)
+		ASSERT_EQ(hashmap_[i], i + KeyValueDifference);
+	for (unsigned int i = Size; i < Size * 2; i++)
+		ASSERT_EQ(hashmap_[i], i + 2 * KeyValueDifference);
+
+	ASSERT_EQ(hashmap_.size(), Size * 2);
+	ASSERT_EQ(calcSize(hashmap_), Size * 2);
+}
+
+TEST_F(FlatHashMapTest, RemoveElements)
+{
+	printf("Original size: %u\n", hashmap_.size());
+	printf("Removing a couple elements\n");
+	printf("New size: %u\n", hashmap_.size());
+	hashmap_.remove(5);
+	hashmap_.remove(7);
+	printFlatHashMap(hashmap_);
+
+	int value = 0;
+	ASSERT_FALSE(hashmap_.contains(5, value));
+	ASSERT_FALSE(hashmap_.contains(7, value));
+	ASSERT_EQ(hashmap_.size(), Size - 2);
+	ASSERT_EQ(calcSize(hashmap_), Size - 2);
+}
+
+TEST_F(FlatHashMapTest, RehashExtend)
+{
+	const float loadFactor = hashmap_.loadFactor();
+	printf("Original size: %u, capacity: %u, load factor: %f\n", hashmap_.size(), hashmap_.capacity(), hashmap_.loadFactor());
+	printFlatHashMap(hashmap_);
+	ASSERT_EQ(hashmap_.capacity(), Capacity);
+
+	printf("Doubling capacity by rehashing\n");
+	hashmap_.rehash(hashmap_.capacity() * 2);
+	printf("New size: %u, capacity: %u, load factor: %f\n", hashmap_.size(), hashmap_.capacity(), hashmap_.loadFactor());
+	printFlatHashMap(hashmap_);
+
+	ASSERT_EQ(hashmap_.capacity(), Capacity * 2);
+	ASSERT_EQ(hashmap_.size(), Size);
+	ASSERT_EQ(calcSize(hashmap_), Size);
+	ASSERT_FLOAT_EQ(hashmap_.loadFactor(), loadFactor * 0.5f);
+
+	for (unsigned int i = 0; i < Size; i++)
+		ASSERT_EQ(hashmap_[i], i + KeyValueDifference);
+}
+
+TEST_F(FlatHashMapTest, RehashShrink)
+{
+	printf("Original size: %u, capacity: %u, load factor: %f\n", hashmap_.size(), hashmap_.capacity(), hashmap_.loadFactor());
+	printFlatHashMap(hashmap_);
+	ASSERT_EQ(hashmap_.capacity(), Capacity);
+
+	printf("Set capacity to current size by rehashing\n");
+	hashmap_.rehash(hashmap_.size());
+	printf("New size: %u, capacity: %u, load factor: %f\n", hashmap_.size(), hashmap_.capacity(), hashmap_.loadFactor());
+	printFlatHashMap(hashmap_);
+
+	// The capacity cannot be smaller than a group of control bytes
+	ASSERT_EQ(hashmap_.capacity(), GroupSize);
+	ASSERT_EQ(hashmap_.size(), Size);
+	ASSERT_EQ(calcSize(hashmap_), Size);
+	ASSERT_FLOAT_EQ(hashmap_.loadFactor(), Size / static_cast<float>(GroupSize));
+
+	for (unsigned int i = 0; i < Size; i++)
+		ASSERT_EQ(hashmap_[i], i + KeyValueDifference);
+}
+
+TEST_F(FlatHashMapTest, CopyConstruction)
+{
+	printf("Creating a new hashmap with copy construction\n");
+	FlatHashMapTestType newHashmap(hashmap_);
+	printFlatHashMap(newHashmap);
+
+	assertHashMapsAreEqual(hashmap_, newHashmap);
+	ASSERT_EQ(hashmap_.size(), Size);
+	ASSERT_EQ(calcSize(hashmap_), Size);
+	ASSERT_EQ(newHashmap.size(), Size);
+	ASSERT_EQ(calcSize(newHashmap), Size);
+}
+
+TEST_F(FlatHashMapTest, MoveConstruction)
+{
+	printf("Creating a new hashmap with move construction\n");
+	FlatHashMapTestType newHashmap = nctl::move(hashmap_);
+	printFlatHashMap(newHashmap);
+
+	ASSERT_EQ(hashmap_.size(), 0);
+	ASSERT_EQ(newHashmap.capacity(), Capacity);
+	ASSERT_EQ(newHashmap.size(), Size);
+	ASSERT_EQ(calcSize(newHashmap), Size);
+}
+
+TEST_F(FlatHashMapTest, AssignmentOperator)
+{
+	printf("Creating a new hashmap with the assignment operator\n");
+	FlatHashMapTestType newHashmap(Capacity);
+	newHashmap = hashmap_;
+	printFlatHashMap(newHashmap);
+
+	assertHashMapsAreEqual(hashmap_, newHashmap);
+	ASSERT_EQ(hashmap_.size(), Size);
+	ASSERT_EQ(calcSize(hashmap_), Size);
+	ASSERT_EQ(newHashmap.size(), Size);
+	ASSERT_EQ(calcSize(newHashmap), Size);
+}
+
+TEST_F(FlatHashMapTest, MoveAssignmentOperator)
+{
+	printf("Creating a new hashmap with the move assignment operator\n");
+	FlatHashMapTestType newHashmap(Capacity);
+	newHashmap = nctl::move(hashmap_);
+	printFlatHashMap(newHashmap);
+
+	ASSERT_EQ(hashmap_.size(), 0);
+	ASSERT_EQ(newHashmap.capacity(), Capacity);
+	ASSERT_EQ(newHashmap.size(), Size);
+	ASSERT_EQ(calcSize(newHashmap), Size);
+}
+
+TEST_F(FlatHashMapTest, SelfAssignment)
+{
+	printf("Assigning the hashmap to itself with the assignment operator\n");
+	hashmap_ = hashmap_;
+	printFlatHashMap(hashmap_);
+
+	ASSERT_EQ(hashmap_.size(), Size);
+	ASSERT_EQ(calcSize(hashmap_), Size);
+}
+
+TEST_F(FlatHashMapTest, Contains)
+{
+	const int key = 1;
+	int value = 0;
+	const bool found = hashmap_.contains(key, value);
+	printf("Key %d is in the hashmap: %d - Value: %d\n", key, found, value);
+
+	ASSERT_TRUE(found);
+	ASSERT_EQ(value, key + KeyValueDifference);
+}
+
+TEST_F(FlatHashMapTest, DoesNotContain)
+{
+	const int key = 10;
+	int value = 0;
+	const bool found = hashmap_.contains(key, value);
+	printf("Key %d is in the hashmap: %d - Value: %d\n", key, found, value);
+
+	ASSERT_FALSE(found);
+}
+
+TEST_F(FlatHashMapTest, Find)
+{
+	const int key = 1;
+	const int *value = hashmap_.find(key);
+	printf("Key %d is in the hashmap: %d - Value: %d\n", key, value != nullptr, *value);
+
+	ASSERT_TRUE(value != nullptr);
+	ASSERT_EQ(*value, key + KeyValueDifference);
+}
+
+TEST_F(FlatHashMapTest, ConstFind)
+{
+	const FlatHashMapTestType &constHashmap = hashmap_;
+	const int key = 1;
+	const int *value = constHashmap.find(key);
+	printf("Key %d is in the hashmap: %d - Value: %d\n", key, value != nullptr, *value);
+
+	ASSERT_TRUE(value != nullptr);
+	ASSERT_EQ(*value, key + KeyValueDifference);
+}
+
+TEST_F(FlatHashMapTest, CannotFind)
+{
+	const int key = 10;
+	const int *value = hashmap_.find(key);
+	printf("Key %d is in the hashmap: %d\n", key, value != nullptr);
+
+	ASSERT_FALSE(value != nullptr);
+}
+
+TEST_F(FlatHashMapTest, FillCapacity)
+{
+	printf("Creating a new hashmap to fill up to capacity (%u elements)\n", Capacity);
+	FlatHashMapTestType newHashmap(Capacity);
+
+	for (unsigned int i = 0; i < Capacity; i++)
+		newHashmap[i] = i + KeyValueDifference;
+
+	ASSERT_EQ(newHashmap.size(), Capacity);
+	for (unsigned int i = 0; i < Capacity; i++)
+		ASSERT_EQ(newHashmap[i], i + KeyValueDifference);
+}
+
+TEST_F(FlatHashMapTest, RemoveAllFromFull)
+{
+	printf("Creating a new hashmap to fill up to capacity (%u elements)\n", Capacity);
+	FlatHashMapTestType newHashmap(Capacity);
+
+	for (unsigned int i = 0; i < Capacity; i++)
+		newHashmap[i] = i + KeyValueDifference;
+
+	printf("Removing all elements from the hashmap\n");
+	for (unsigned int i = 0; i < Capacity; i++)
+		newHashmap.remove(i);
+
+	ASSERT_EQ(newHashmap.size(), 0);
+	ASSERT_EQ(calcSize(newHashmap), 0);
+}
+
+TEST_F(FlatHashMapTest, CapacityIsRoundedUp)
+{
+	printf("Creating a new hashmap with a capacity of %u\n", Capacity - 1);
+	FlatHashMapTestType newHashmap(Capacity - 1);
+	printf("Capacity: %u\n", newHashmap.capacity());
+
+	ASSERT_EQ(newHashmap.capacity(), Capacity);
+}
+
+TEST_F(FlatHashMapTest, InsertInRemovedBucketsOfFull)
+{
+	printf("Creating a new hashmap to fill up to capacity (%u elements)\n", Capacity);
+	FlatHashMapTestType newHashmap(Capacity);
+
+	for (unsigned int i = 0; i < Capacity; i++)
+		newHashmap[i] = i + KeyValueDifference;
+
+	printf("Replacing every element of the full hashmap with a new one\n");
+	for (unsigned int i = 0; i < Capacity; i++)
+	{
+		newHashmap.remove(i);
+		newHashmap[i + Capacity] = i + KeyValueDifference;
+	}
+
+	ASSERT_EQ(newHashmap.size(), Capacity);
+	ASSERT_EQ(calcSize(newHashmap), Capacity);
+	int value = 0;
+	for (unsigned int i = 0; i < Capacity; i++)
+	{
+		ASSERT_FALSE(newHashmap.contains(i, value));
+		ASSERT_TRUE(newHashmap.contains(i + Capacity, value));
+		ASSERT_EQ(value, i + KeyValueDifference);
+	}
+}
+
+TEST_F(FlatHashMapTest, RehashAfterRemoval)
+{
+	printf("Creating a new hashmap to fill up to capacity (%u elements)\n", Capacity);
+	FlatHashMapTestType newHashmap(Capacity);
+
+	for (unsigned int i = 0; i < Capacity; i++)
+		newHashmap[i] = i + KeyValueDifference;
+	for (unsigned int i = 0; i < Capacity; i += 2)
+		newHashmap.remove(i);
+
+	printf("Rehashing with the same capacity to clear removed buckets\n");
+	newHashmap.rehash(newHashmap.capacity());
+
+	ASSERT_EQ(newHashmap.capacity(), Capacity);
+	ASSERT_EQ(newHashmap.size(), Capacity / 2);
+	ASSERT_EQ(calcSize(newHashmap), Capacity / 2);
+	int value = 0;
+	for (unsigned int i = 0; i < Capacity; i++)
+		ASSERT_EQ(newHashmap.contains(i, value), i % 2 == 1);
+}
+
+const int BigCapacity = 512;
+const int LastElement = BigCapacity / 2;
+
+TEST_F(FlatHashMapTest, StressRemove)
+{
+	printf("Creating a new hashmap with a capacity of %u and filled up to %u elements\n", BigCapacity, LastElement);
+	FlatHashMapTestType newHashmap(BigCapacity);
+
+	for (int i = 0; i < LastElement; i++)
+		newHashmap[i] = i + KeyValueDifference;
+	ASSERT_EQ(newHashmap.size(), LastElement);
+
+	printf("Removing all elements from the hashmap\n");
+	for (int i = 0; i < LastElement; i++)
+	{
+		newHashmap.remove(i);
+		ASSERT_EQ(newHashmap.size(), LastElement - i - 1);
+
+		int value = 0;
+		for (int j = i + 1; j < LastElement; j++)
+			ASSERT_TRUE(newHashmap.contains(j, value));
+		for (int j = 0; j < i + 1; j++)
+			ASSERT_FALSE(newHashmap.contains(j, value));
+	}
+
+	ASSERT_EQ(newHashmap.size(), 0);
+}
+
+TEST_F(FlatHashMapTest, StressReverseRemove)
+{
+	printf("Creating a new hashmap with a capacity of %u and filled up to %u elements\n", BigCapacity, LastElement);
+	FlatHashMapTestType newHashmap(BigCapacity);
+
+	for (int i = 0; i < LastElement; i++)
+		newHashmap[i] = i + KeyValueDifference;
+	ASSERT_EQ(newHashmap.size(), LastElement);
+
+	printf("Removing all elements from the hashmap\n");
+	for (int i = LastElement - 1; i >= 0; i--)
+	{
+		newHashmap.remove(i);
+		ASSERT_EQ(newHashmap.size(), i);
+
+		int value = 0;
+		for (int j = i - 1; j >= 0; j--)
+			ASSERT_TRUE(newHashmap.contains(j, value));
+		for (int j = LastElement; j >= i; j--)
+			ASSERT_FALSE(newHashmap.contains(j, value));
+	}
+
+	ASSERT_EQ(newHashmap.size(), 0);
+}
+
+TEST_F(FlatHashMapTest, StressDefaultHashFunction)
+{
+	printf("Creating a new hashmap with a capacity of %u and filled up to %u elements\n", BigCapacity, BigCapacity);
+	nctl::FlatHashMap<int, int> newHashmap(BigCapacity);
+
+	for (int i = 0; i < BigCapacity; i++)
+		newHashmap[i] = i + KeyValueDifference;
+	ASSERT_EQ(newHashmap.size(), BigCapacity);
+
+	printf("Removing half of the elements from the hashmap\n");
+	for (int i = 0; i < BigCapacity; i += 2)
+		ASSERT_TRUE(newHashmap.remove(i));
+
+	ASSERT_EQ(newHashmap.size(), BigCapacity / 2);
+	for (int i = 0; i < BigCapacity; i++)
+	{
+		const int *value = newHashmap.find(i);
+		if (i % 2 == 0)
+			ASSERT_EQ(value, nullptr);
+		else
+			ASSERT_EQ(*value, i + KeyValueDifference);
+	}
+}
+
+}
@@ -0,0 +1,365 @@
+#include "gtest_flathashset.h"
+
+namespace {
+
+class FlatHashSetTest : public ::testing::Test
+{
+  public:
+	FlatHashSetTest()
+	    : hashset_(Capacity) {}
+
+  protected:
+	void SetUp() override { initFlatHashSet(hashset_); }
+
+	FlatHashSetTestType hashset_;
+};
+
+#ifndef __EMSCRIPTEN__
+TEST(FlatHashSetDeathTest, ZeroCapacity)
+{
+	printf("Creating an hashset of zero capacity\n");
+	ASSERT_DEATH(FlatHashSetTestType newHashset(0), "");
+}
+#endif
+
+TEST_F(FlatHashSetTest, Capacity)
+{
+	const unsigned int capacity = hashset_.capacity();
+	printf("Capacity: %u\n", capacity);
+
+	ASSERT_EQ(capacity, Capacity);
+}
+
+TEST_F(FlatHashSetTest, Size)
+{
+	const unsigned int size = hashset_.size();
+	printf("Size: %u\n", size);
+
+	ASSERT_EQ(size, Size);
+	ASSERT_EQ(calcSize(hashset_), Size);
+}
+
+TEST_F(FlatHashSetTest, LoadFactor)
+{
+	const float loadFactor = hashset_.loadFactor();
+	printf("Size: %u, Capacity: %u, Load Factor: %f\n", Size, Capacity, loadFactor);
+
+	ASSERT_FLOAT_EQ(loadFactor, Size / static_cast<float>(Capacity));
+}
+
+TEST_F(FlatHashSetTest, Clear)
+{
+	ASSERT_FALSE(hashset_.isEmpty());
+	hashset_.clear();
+	printFlatHashSet(hashset_);
+	ASSERT_TRUE(hashset_.isEmpty());
+	ASSERT_EQ(hashset_.size(), 0u);
+	ASSERT_EQ(hashset_.capacity(), Capacity);
+}
+
+TEST_F(FlatHashSetTest, InsertElements)
+{
+	printf("Inserting elements\n");
+	for (unsigned int i = Size; i < Size * 2; i++)
+		hashset_.insert(i);
+
+	for (unsigned int i = 0; i < Size * 2; i++)
+		ASSERT_TRUE(hashset_.contains(i));
+
+	ASSERT_EQ(hashset_.size(), Size * 2);
+	ASSERT_EQ(calcSize(hashset_), Size * 2);
+}
+
+TEST_F(FlatHashSetTest, InsertConstElements)
+{
+	printf("Inserting const elements\n");
+	for (unsigned int i = Size; i < Size * 2; i++)
+	{
+		const int key = i;
+		hashset_.insert(key);
+	}
+
+	for (unsigned int i = 0; i < Size * 2; i++)
+		ASSERT_TRUE(hashset_.contains(i));
+
+	ASSERT_EQ(hashset_.size(), Size * 2);
+	ASSERT_EQ(calcSize(hashset_), Size * 2);
+}
+
+TEST_F(FlatHashSetTest, FailInsertElements)
+{
+	printf("Trying to insert elements already in the hashset\n");
+	for (unsigned int i = 0; i < Size * 2; i++)
+		hashset_.insert(i);
+
+	for (unsigned int i = 0; i < Size * 2; i++)
+		ASSERT_TRUE(hashset_.contains(i));
+
+	ASSERT_EQ(hashset_.size(), Size * 2);
+	ASSERT_EQ(calcSize(hashset_), Size * 2);
+}
+
+TEST_F(FlatHashSetTest, FailInsertConstElements)
+{
+	printf("Trying to insert const elements already in the hashset\n");
+	for (unsigned int i = 0; i < Size * 2; i++)
+	{
+		const int key = i;
+		hashset_.insert(key);
+	}
+
+	for (unsigned int i = 0; i < Size * 2; i++)
+		ASSERT_TRUE(hashset_.contains(i));
+
+	ASSERT_EQ(hashset_.size(), Size * 2);
+	ASSERT_EQ(calcSize(hashset_), Size * 2);
+}
+
+TEST_F(FlatHashSetTest, RemoveElements)
+{
+	printf("Original size: %u\n", hashset_.size());
+	printf("Removing a couple elements\n");
+	printf("New size: %u\n", hashset_.size());
+	hashset_.remove(5);
+	hashset_.remove(7);
+	printFlatHashSet(hashset_);
+
+	ASSERT_FALSE(hashset_.contains(5));
+	ASSERT_FALSE(hashset_.contains(7));
+	ASSERT_EQ(hashset_.size(), Size - 2);
+	ASSERT_EQ(calcSize(hashset_), Size - 2);
+}
+
+TEST_F(FlatHashSetTest, RehashExtend)
+{
+	const float loadFactor = hashset_.loadFactor();
+	printf("Original size: %u, capacity: %u, load factor: %f\n", hashset_.size(), hashset_.capacity(), hashset_.loadFactor());
+	printFlatHashSet(hashset_);
+	ASSERT_EQ(hashset_.capacity(), Capacity);
+
+	printf("Doubling capacity by rehashing\n");
+	hashset_.rehash(hashset_.capacity() * 2);
+	printf("New size: %u, capacity: %u, load factor: %f\n", hashset_.size(), hashset_.capacity(), hashset_.loadFactor());
+	printFlatHashSet(hashset_);
+
+	ASSERT_EQ(hashset_.capacity(), Capacity * 2);
+	ASSERT_EQ(hashset_.size(), Size);
+	ASSERT_EQ(calcSize(hashset_), Size);
+	ASSERT_FLOAT_EQ(hashset_.loadFactor(), loadFactor * 0.5f);
+
+	for (unsigned int i = 0; i < Size; i++)
+		ASSERT_TRUE(hashset_.contains(i));
+}
+
+TEST_F(FlatHashSetTest, RehashShrink)
+{
+	printf("Original size: %u, capacity: %u, load factor: %f\n", hashset_.size(), hashset_.capacity(), hashset_.loadFactor());
+	printFlatHashSet(hashset_);
+	ASSERT_EQ(hashset_.capacity(), Capacity);
+
+	printf("Set capacity to current size by rehashing\n");
+	hashset_.rehash(hashset_.size());
+	printf("New size: %u, capacity: %u, load factor: %f\n", hashset_.size(), hashset_.capacity(), hashset_.loadFactor());
+	printFlatHashSet(hashset_);
+
+	// The capacity cannot be smaller than a group of control bytes
+	ASSERT_EQ(hashset_.capacity(), GroupSize);
+	ASSERT_EQ(hashset_.size(), Size);
+	ASSERT_EQ(calcSize(hashset_), Size);
+	ASSERT_FLOAT_EQ(hashset_.loadFactor(), Size / static_cast<float>(GroupSize));
+
+	for (unsigned int i = 0; i < Size; i++)
+		ASSERT_TRUE(hashset_.contains(i));
+}
+
+TEST_F(FlatHashSetTest, CopyConstruction)
+{
+	printf("Creating a new hashset with copy construction\n");
+	FlatHashSetTestType newHashset(hashset_);
+	printFlatHashSet(newHashset);
+
+	assertHashSetsAreEqual(hashset_, newHashset);
+	ASSERT_EQ(hashset_.size(), Size);
+	ASSERT_EQ(calcSize(hashset_), Size);
+	ASSERT_EQ(newHashset.size(), Size);
+	ASSERT_EQ(calcSize(newHashset), Size);
+}
+
+TEST_F(FlatHashSetTest, MoveConstruction)
+{
+	printf("Creating a new hashset with move construction\n");
+	FlatHashSetTestType newHashset = nctl::move(hashset_);
+	printFlatHashSet(newHashset);
+
+	ASSERT_EQ(hashset_.size(), 0);
+	ASSERT_EQ(newHashset.capacity(), Capacity);
+	ASSERT_EQ(newHashset.size(), Size);
+	ASSERT_EQ(calcSize(newHashset), Size);
+}
+
+TEST_F(FlatHashSetTest, AssignmentOperator)
+{
+	printf("Creating a new hashset with the assignment operator\n");
+	FlatHashSetTestType newHashset(Capacity);
+	newHashset = hashset_;
+	printFlatHashSet(newHashset);
+
+	assertHashSetsAreEqual(hashset_, newHashset);
+	ASSERT_EQ(hashset_.size(), Size);
+	ASSERT_EQ(calcSize(hashset_), Size);
+	ASSERT_EQ(newHashset.size(), Size);
+	ASSERT_EQ(calcSize(newHashset), Size);
+}
+
+TEST_F(FlatHashSetTest, MoveAssignmentOperator)
+{
+	printf("Creating a new hashset with the move assignment operator\n");
+	FlatHashSetTestType newHashset(Capacity);
+	newHashset = nctl::move(hashset_);
+	printFlatHashSet(newHashset);
+
+	ASSERT_EQ(hashset_.size(), 0);
+	ASSERT_EQ(newHashset.capacity(), Capacity);
+	ASSERT_EQ(newHashset.size(), Size);
+	ASSERT_EQ(calcSize(newHashset), Size);
+}
+
+TEST_F(FlatHashSetTest, SelfAssignment)
+{
+	printf("Assigning the hashset to itself with the assignment operator\n");
+	hashset_ = hashset_;
+	printFlatHashSet(hashset_);
+
+	ASSERT_EQ(hashset_.size(), Size);
+	ASSERT_EQ(calcSize(hashset_), Size);
+}
+
+TEST_F(FlatHashSetTest, Contains)
+{
+	const int key = 1;
+	const bool found = hashset_.contains(key);
+	printf("Key %d is in the hashset: %d\n", key, found);
+
+	ASSERT_TRUE(found);
+}
+
+TEST_F(FlatHashSetTest, DoesNotContain)
+{
+	const int key = 10;
+	const bool found = hashset_.contains(key);
+	printf("Key %d is in the hashset: %d\n", key, found);
+
+	ASSERT_FALSE(found);
+}
+
+TEST_F(FlatHashSetTest, Find)
+{
+	const int key = 1;
+	const int *value = hashset_.find(key);
+	printf("Key %d is in the hashset: %d - Value: %d\n", key, value != nullptr, *value);
+
+	ASSERT_TRUE(value != nullptr);
+	ASSERT_EQ(*value, key);
+}
+
+TEST_F(FlatHashSetTest, ConstFind)
+{
+	const FlatHashSetTestType &constHashset = hashset_;
+	const int key = 1;
+	const int *value = constHashset.find(key);
+	printf("Key %d is in the hashset: %d - Value: %d\n", key, value != nullptr, *value);
+
+	ASSERT_TRUE(value != nullptr);
+	ASSERT_EQ(*value, key);
+}
+
+TEST_F(FlatHashSetTest, CannotFind)
+{
+	const int key = 10;
+	const int *value = hashset_.find(key);
+	printf("Key %d is in the hashset: %d\n", key, value != nullptr);
+
+	ASSERT_FALSE(value != nullptr);
+}
+
+TEST_F(FlatHashSetTest, FillCapacity)
+{
+	printf("Creating a new hashset to fill up to capacity (%u elements)\n", Capacity);
+	FlatHashSetTestType newHashset(Capacity);
+
+	for (unsigned int i = 0; i < Capacity; i++)
+		newHashset.insert(i);
+
+	ASSERT_EQ(newHashset.size(), Capacity);
+	for (unsigned int i = 0; i < Capacity; i++)
+		ASSERT_TRUE(newHashset.contains(i));
+}
+
+TEST_F(FlatHashSetTest, RemoveAllFromFull)
+{
+	printf("Creating a new hashset to fill up to capacity (%u elements)\n", Capacity);
+	FlatHashSetTestType newHashset(Capacity);
+
+	for (unsigned int i = 0; i < Capacity; i++)
+		newHashset.insert(i);
+
+	printf("Removing all elements from the hashset\n");
+	for (unsigned int i = 0; i < Capacity; i++)
+		newHashset.remove(i);
+
+	ASSERT_EQ(newHashset.size(), 0);
+	ASSERT_EQ(calcSize(newHashset), 0);
+}
+
+const int BigCapacity = 512;
+const int LastElement = BigCapacity / 2;
+
+TEST_F(FlatHashSetTest, StressRemove)
+{
+	printf("Creating a new hashset with a capacity of %u and filled up to %u elements\n", BigCapacity, LastElement);
+	FlatHashSetTestType newHashset(BigCapacity);
+
+	for (int i = 0; i < LastElement; i++)
+		newHashset.insert(i);
+	ASSERT_EQ(newHashset.size(), LastElement);
+
+	printf("Removing all elements from the hashset\n");
+	for (int i = 0; i < LastElement; i++)
+	{
+		newHashset.remove(i);
+		ASSERT_EQ(newHashset.size(), LastElement - i - 1);
+
+		for (int j = i + 1; j < LastElement; j++)
+			ASSERT_TRUE(newHashset.contains(j));
+		for (int j = 0; j < i + 1; j++)
+			ASSERT_FALSE(newHashset.contains(j));
+	}
+
+	ASSERT_EQ(newHashset.size(), 0);
+}
+
+TEST_F(FlatHashSetTest, StressReverseRemove)
+{
+	printf("Creating a new hashset with a capacity of %u and filled up to %u elements\n", BigCapacity, LastElement);
+	FlatHashSetTestType newHashset(BigCapacity);
+
+	for (int i = 0; i < LastElement; i++)
+		newHashset.insert(i);
+	ASSERT_EQ(newHashset.size(), LastElement);
+
+	printf("Removing all elements from the hashset\n");
+	for (int i = LastElement - 1; i >= 0; i--)
+	{
+		newHashset.remove(i);
+		ASSERT_EQ(newHashset.size(), i);
+
+		for (int j = i - 1; j >= 0; j--)
+			ASSERT_TRUE(newHashset.contains(j));
+		for (int j = LastElement; j >= i; j--)
+			ASSERT_FALSE(newHashset.contains(j));
+	}
+
+	ASSERT_EQ(newHashset.size(), 0);
+}
+
+}
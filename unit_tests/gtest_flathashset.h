@@ -0,0 +1,60 @@
+#ifndef GTEST_FLATHASHSET_H
+#define GTEST_FLATHASHSET_H
+
+#include <nctl/algorithms.h>
+#include <nctl/FlatHashSet.h>
+#include <nctl/FlatHashSetIterator.h>
+#include "gtest/gtest.h"
+
+namespace {
+
+const unsigned int Capacity = 32;
+const unsigned int GroupSize = 16;
+const unsigned int Size = 10;
+using FlatHashSetTestType = nctl::FlatHashSet<int, nctl::FixedHashFunc<int>>;
+
+template <class HashFunc>
+void initFlatHashSet(nctl::FlatHashSet<int, HashFunc> &hashset)
+{
+	for (unsigned int i = 0; i < Size; i++)
+		hashset.insert(i);
+}
+
+template <class HashFunc>
+void printFlatHashSet(const nctl::FlatHashSet<int, HashFunc> &hashset)
+{
+	unsigned int n = 0;
+
+	for (typename nctl::FlatHashSet<int, HashFunc>::ConstIterator i = hashset.begin(); i != hashset.end(); ++i)
+		printf("[%u] hash: %u, key: %d\n", n++, i.hash(), i.key());
+	printf("\n");
+}
+
+template <class HashFunc>
+unsigned int calcSize(const nctl::FlatHashSet<int, HashFunc> &hashset)
+{
+	unsigned int length = 0;
+
+	for (typename nctl::FlatHashSet<int, HashFunc>::ConstIterator i = hashset.begin(); i != hashset.end(); ++i)
+		length++;
+
+	return length;
+}
+
+template <class HashFunc>
+void assertHashSetsAreEqual(const nctl::FlatHashSet<int, HashFunc> &hashset1, const nctl::FlatHashSet<int, HashFunc> &hashset2)
+{
+	typename nctl::FlatHashSet<int, HashFunc>::ConstIterator hashset1It = hashset1.begin();
+	typename nctl::FlatHashSet<int, HashFunc>::ConstIterator hashset2It = hashset2.begin();
+	while (hashset1It != hashset1.end())
+	{
+		ASSERT_EQ(hashset1It.key(), hashset2It.key());
+
+		hashset1It++;
+		hashset2It++;
+	}
+}
+
+}
+
+#endif
@@ -0,0 +1,125 @@
+#include "gtest_flathashset.h"
+
+namespace {
+
+class FlatHashSetIteratorTest : public ::testing::Test
+{
+  public:
+	FlatHashSetIteratorTest()
+	    : hashset_(Capacity) {}
+
+  protected:
+	void SetUp() override { initFlatHashSet(hashset_); }
+
+	FlatHashSetTestType hashset_;
+};
+
+TEST_F(FlatHashSetIteratorTest, ForLoopIteration)
+{
+	int n = 0;
+
+	printf("Iterating through elements with for loop:\n");
+	for (FlatHashSetTestType::ConstIterator i = hashset_.begin(); i != hashset_.end(); ++i)
+	{
+		printf(" [%d] hash: %u, key: %d\n", n, i.hash(), i.key());
+		ASSERT_EQ(i.key(), n);
+		n++;
+	}
+	printf("\n");
+}
+
+TEST_F(FlatHashSetIteratorTest, ForLoopEmptyIteration)
+{
+	FlatHashSetTestType newHashset(Capacity);
+
+	printf("Iterating over an empty hashset with for loop:\n");
+	for (FlatHashSetTestType::ConstIterator i = newHashset.begin(); i != newHashset.end(); ++i)
+		ASSERT_TRUE(false); // should never reach this point
+	printf("\n");
+}
+
+TEST_F(FlatHashSetIteratorTest, ReverseForLoopIteration)
+{
+	int n = Size - 1;
+
+	printf("Reverse iterating through elements with for loop:\n");
+	for (FlatHashSetTestType::ConstReverseIterator r = hashset_.rBegin(); r != hashset_.rEnd(); ++r)
+	{
+		printf(" [%d] hash: %u, key: %d\n", n, r.base().hash(), r.base().key());
+		ASSERT_EQ(r.base().key(), n);
+		n--;
+	}
+	printf("\n");
+}
+
+TEST_F(FlatHashSetIteratorTest, ReverseForLoopEmptyIteration)
+{
+	FlatHashSetTestType newHashset(Capacity);
+
+	printf("Reverse iterating over an empty hashset with for loop:\n");
+	for (FlatHashSetTestType::ConstReverseIterator r = newHashset.rBegin(); r != newHashset.rEnd(); ++r)
+		ASSERT_TRUE(false); // should never reach this point
+	printf("\n");
+}
+
+TEST_F(FlatHashSetIteratorTest, WhileLoopIteration)
+{
+	int n = 0;
+
+	printf("Iterating through elements with while loop:\n");
+	FlatHashSetTestType::ConstIterator i = hashset_.begin();
+	while (i != hashset_.end())
+	{
+		printf(" [%d] hash: %u, key: %d\n", n, i.hash(), i.key());
+		ASSERT_EQ(i.key(), n);
+		++i;
+		++n;
+	}
+	printf("\n");
+}
+
+TEST_F(FlatHashSetIteratorTest, WhileLoopEmptyIteration)
+{
+	FlatHashSetTestType newHashset(Capacity);
+
+	printf("Iterating over an empty hashset with while loop:\n");
+	FlatHashSetTestType::ConstIterator i = newHashset.begin();
+	while (i != newHashset.end())
+	{
+		ASSERT_TRUE(false); // should never reach this point
+		++i;
+	}
+	printf("\n");
+}
+
+TEST_F(FlatHashSetIteratorTest, ReverseWhileLoopIteration)
+{
+	int n = Size - 1;
+
+	printf("Reverse iterating through elements with while loop:\n");
+	FlatHashSetTestType::ConstReverseIterator r = hashset_.rBegin();
+	while (r != hashset_.rEnd())
+	{
+		printf(" [%d] hash: %u, key: %d\n", n, r.base().hash(), r.base().key());
+		ASSERT_EQ(r.base().key(), n);
+		++r;
+		--n;
+	}
+	printf("\n");
+}
+
+TEST_F(FlatHashSetIteratorTest, ReverseWhileLoopEmptyIteration)
+{
+	FlatHashSetTestType newHashset(Capacity);
+
+	printf("Reverse iterating over an empty hashset with while loop:\n");
+	FlatHashSetTestType::ConstReverseIterator r = newHashset.rBegin();
+	while (r != newHashset.rEnd())
+	{
+		ASSERT_TRUE(false); // should never reach this point
+		++r;
+	}
+	printf("\n");
+}
+
+}
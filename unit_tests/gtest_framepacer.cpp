@@ -0,0 +1,253 @@
+#include <cmath> // for fabsf()
+#include <ctime> // for clock()
+#include <ncine/FramePacer.h>
+#include <ncine/TimeStamp.h>
+#include "gtest/gtest.h"
+
+namespace nc = ncine;
+
+namespace {
+
+const unsigned int NumHistogramBuckets = 5;
+const float BucketLimits[NumHistogramBuckets - 1] = { 0.1f, 0.5f, 1.0f, 2.0f }; // in milliseconds
+
+/// A time source that only advances when the pacer sleeps or when frame work is simulated
+class FakeTimeSource : public nc::FramePacer::TimeSource
+{
+  public:
+	static const uint32_t Frequency = 1000000; // one tick per microsecond
+	/// Ticks that pass when the thread is only yielded
+	static const uint64_t YieldTicks = 10;
+
+	FakeTimeSource()
+	    : counter_(Frequency), overSleepTicks_(0), numSleeps_(0) {}
+
+	uint64_t counter() const override { return counter_; }
+	uint32_t frequency() const override { return Frequency; }
+	void sleep(float seconds) override
+	{
+		const uint64_t ticks = static_cast<uint64_t>(seconds * Frequency);
+		counter_ += (ticks > 0) ? ticks + overSleepTicks_ : YieldTicks;
+		numSleeps_++;
+	}
+
+	inline unsigned int numSleeps() const { return numSleeps_; }
+	inline void setOverSleep(uint64_t ticks) { overSleepTicks_ = ticks; }
+	inline void advance(uint64_t ticks) { counter_ += ticks; }
+
+  private:
+	uint64_t counter_;
+	uint64_t overSleepTicks_;
+	unsigned int numSleeps_;
+};
+
+const unsigned int FrameRate = 100;
+const uint64_t PeriodTicks = FakeTimeSource::Frequency / FrameRate;
+
+/// Simulates frames that take the specified number of ticks and returns the slip divisor at the end
+unsigned int simulateWork(nc::FramePacer &pacer, FakeTimeSource &timeSource, unsigned int numFrames, uint64_t workTicks)
+{
+	for (unsigned int i = 0; i < numFrames; i++)
+	{
+		timeSource.advance(workTicks);
+		pacer.wait();
+	}
+	return pacer.slipDivisor();
+}
+
+/// Paces frames with the system clock for the specified time, then prints the average rate, the CPU time and a jitter histogram
+/*! \note Wall-clock results depend on the load of the machine, they are reported but not checked */
+void reportFrameRate(unsigned int frameRate, float seconds)
+{
+	nc::FramePacer pacer(frameRate);
+	const unsigned int numFrames = static_cast<unsigned int>(frameRate * seconds);
+	const float period = 1.0f / static_cast<float>(frameRate);
+	unsigned int histogram[NumHistogramBuckets] = {};
+
+	pacer.wait(); // the first frame is not paced
+	const std::clock_t cpuStart = std::clock();
+	const nc::TimeStamp start = nc::TimeStamp::now();
+	nc::TimeStamp frameStart = start;
+
+	for (unsigned int i = 0; i < numFrames; i++)
+	{
+		pacer.wait();
+		const float interval = frameStart.secondsSince();
+		frameStart = nc::TimeStamp::now();
+
+		const float jitter = fabsf(interval - period) * 1000.0f;
+		unsigned int bucket = 0;
+		while (bucket < NumHistogramBuckets - 1 && jitter >= BucketLimits[bucket])
+			bucket++;
+		histogram[bucket]++;
+	}
+
+	const float elapsed = start.secondsSince();
+	const float cpuTime = static_cast<float>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+	const float averageRate = numFrames / elapsed;
+
+	printf("%u frames at %u Hz: %.3f FPS on average, %.3f s of CPU time in %.3f s (%.1f%%), spin interval %.3f ms\n",
+	       numFrames, frameRate, averageRate, cpuTime, elapsed, (cpuTime / elapsed) * 100.0f, pacer.spinInterval() * 1000.0f);
+	printf("Jitter histogram: <0.1 ms: %u, <0.5 ms: %u, <1 ms: %u, <2 ms: %u, >=2 ms: %u\n",
+	       histogram[0], histogram[1], histogram[2], histogram[3], histogram[4]);
+}
+
+TEST(FramePacerTest, Disabled)
+{
+	FakeTimeSource timeSource;
+	nc::FramePacer pacer(0, timeSource);
+	printf("Waiting with a disabled pacer\n");
+
+	ASSERT_EQ(pacer.frameRate(), 0u);
+	ASSERT_EQ(pacer.wait(), 0.0f);
+	ASSERT_EQ(timeSource.numSleeps(), 0u);
+}
+
+TEST(FramePacerTest, FirstFrameNotPaced)
+{
+	FakeTimeSource timeSource;
+	nc::FramePacer pacer(FrameRate, timeSource);
+	printf("The first frame after a reset is not paced\n");
+
+	ASSERT_EQ(pacer.wait(), 0.0f);
+	ASSERT_EQ(timeSource.numSleeps(), 0u);
+
+	timeSource.advance(PeriodTicks / 2);
+	pacer.reset();
+	ASSERT_EQ(pacer.wait(), 0.0f);
+	ASSERT_EQ(timeSource.numSleeps(), 0u);
+}
+
+TEST(FramePacerTest, WaitUntilDeadline)
+{
+	FakeTimeSource timeSource;
+	nc::FramePacer pacer(FrameRate, timeSource);
+	const uint64_t firstDeadline = timeSource.counter() + PeriodTicks;
+	pacer.wait();
+	printf("Waking up at the deadline of every frame of %lu ticks\n", static_cast<unsigned long>(PeriodTicks));
+
+	const unsigned int numFrames = 10;
+	for (unsigned int i = 0; i < numFrames; i++)
+	{
+		timeSource.advance(PeriodTicks / 4);
+		const uint64_t deadline = firstDeadline + i * PeriodTicks;
+		const uint64_t expectedWait = deadline - timeSource.counter();
+		const float waited = pacer.wait();
+
+		// Yielding can overshoot the deadline by a fraction of the yield time
+		ASSERT_GE(timeSource.counter(), deadline);
+		ASSERT_LT(timeSource.counter(), deadline + FakeTimeSource::YieldTicks);
+		ASSERT_GE(waited, static_cast<float>(expectedWait) / FakeTimeSource::Frequency);
+	}
+	ASSERT_EQ(pacer.numMissedFrames(), 0u);
+}
+
+TEST(FramePacerTest, CompensateLateFrame)
+{
+	FakeTimeSource timeSource;
+	nc::FramePacer pacer(FrameRate, timeSource);
+	const uint64_t firstDeadline = timeSource.counter() + PeriodTicks;
+	pacer.wait();
+	printf("A late frame is compensated by a shorter wait in the next one\n");
+
+	timeSource.advance(PeriodTicks + PeriodTicks / 2);
+	ASSERT_EQ(pacer.wait(), 0.0f);
+	ASSERT_EQ(pacer.numMissedFrames(), 1u);
+
+	// The deadline is advanced by a fixed period from the missed one, not from the late wake up
+	timeSource.advance(PeriodTicks / 4);
+	pacer.wait();
+	ASSERT_GE(timeSource.counter(), firstDeadline + PeriodTicks);
+	ASSERT_LT(timeSource.counter(), firstDeadline + PeriodTicks + FakeTimeSource::YieldTicks);
+}
+
+TEST(FramePacerTest, RestartWhenTooLate)
+{
+	FakeTimeSource timeSource;
+	nc::FramePacer pacer(FrameRate, timeSource);
+	pacer.wait();
+	printf("A frame late by more than a period restarts pacing instead of rushing the next frames\n");
+
+	timeSource.advance(PeriodTicks * 3);
+	const uint64_t lateWakeUp = timeSource.counter();
+	ASSERT_EQ(pacer.wait(), 0.0f);
+
+	timeSource.advance(PeriodTicks / 4);
+	pacer.wait();
+	ASSERT_GE(timeSource.counter(), lateWakeUp + PeriodTicks);
+	ASSERT_LT(timeSource.counter(), lateWakeUp + PeriodTicks + FakeTimeSource::YieldTicks);
+}
+
+TEST(FramePacerTest, AdaptSpinInterval)
+{
+	FakeTimeSource timeSource;
+	nc::FramePacer pacer(FrameRate, timeSource);
+	const float initialSpinInterval = pacer.spinInterval();
+	pacer.wait();
+	printf("The spin interval grows to absorb the oversleep of the system\n");
+
+	// Oversleeping by 1.5 ms doubles it to 3 ms
+	timeSource.setOverSleep(1500);
+	simulateWork(pacer, timeSource, 1, PeriodTicks / 4);
+	ASSERT_GT(pacer.spinInterval(), initialSpinInterval);
+	ASSERT_FLOAT_EQ(pacer.spinInterval(), 0.003f);
+
+	timeSource.setOverSleep(0);
+	simulateWork(pacer, timeSource, 100, PeriodTicks / 4);
+	ASSERT_LT(pacer.spinInterval(), 0.003f);
+}
+
+TEST(FramePacerTest, NoSlipByDefault)
+{
+	FakeTimeSource timeSource;
+	nc::FramePacer pacer(FrameRate, timeSource);
+	pacer.wait();
+	printf("Overloading a pacer at %u Hz without slipping\n", FrameRate);
+
+	const unsigned int divisor = simulateWork(pacer, timeSource, nc::FramePacer::SlipFrames + 1, PeriodTicks + PeriodTicks / 2);
+	ASSERT_EQ(divisor, 1u);
+	ASSERT_GE(pacer.numMissedFrames(), nc::FramePacer::SlipFrames);
+}
+
+TEST(FramePacerTest, SlipAndRecover)
+{
+	FakeTimeSource timeSource;
+	nc::FramePacer pacer(FrameRate, timeSource);
+	pacer.setCanSlip(true);
+	pacer.wait();
+	printf("Overloading a pacer at %u Hz that can slip\n", FrameRate);
+
+	// Every frame misses its deadline by half a period
+	ASSERT_EQ(simulateWork(pacer, timeSource, nc::FramePacer::SlipFrames - 1, PeriodTicks + PeriodTicks / 2), 1u);
+	const unsigned int slipDivisor = simulateWork(pacer, timeSource, 1, PeriodTicks + PeriodTicks / 2);
+	printf("Paced frame rate after overload: %.2f FPS\n", pacer.pacedFrameRate());
+	ASSERT_EQ(slipDivisor, 2u);
+	ASSERT_FLOAT_EQ(pacer.pacedFrameRate(), FrameRate / 2.0f);
+
+	// A single frame without work is not enough to recover
+	ASSERT_EQ(simulateWork(pacer, timeSource, 1, 0), 2u);
+	// The frames fit in the slipped period but not in the shorter one with its safety margin
+	ASSERT_EQ(simulateWork(pacer, timeSource, nc::FramePacer::SlipFrames, PeriodTicks - PeriodTicks / 20), 2u);
+
+	ASSERT_EQ(simulateWork(pacer, timeSource, nc::FramePacer::SlipFrames - 1, PeriodTicks / 2), 2u);
+	const unsigned int recoveredDivisor = simulateWork(pacer, timeSource, 1, PeriodTicks / 2);
+	printf("Paced frame rate after recovery: %.2f FPS\n", pacer.pacedFrameRate());
+	ASSERT_EQ(recoveredDivisor, 1u);
+}
+
+TEST(FramePacerTest, ReportPace30Hz)
+{
+	reportFrameRate(30, 1.0f);
+}
+
+TEST(FramePacerTest, ReportPace60Hz)
+{
+	reportFrameRate(60, 1.0f);
+}
+
+TEST(FramePacerTest, ReportPace144Hz)
+{
+	reportFrameRate(144, 1.0f);
+}
+
+}
@@ -0,0 +1,153 @@
+#include <ncine/FrameStatistics.h>
+#include "gtest/gtest.h"
+
+namespace nc = ncine;
+
+namespace {
+
+const unsigned int Capacity = 100;
+
+/// Adds frames whose stages last one millisecond times their index, plus the frame index for the whole frame
+void addFrames(nc::FrameStatistics &stats, unsigned int numFrames, unsigned int firstFrame)
+{
+	float stageTimes[nc::FrameStatistics::Stages::COUNT];
+	for (unsigned int i = 0; i < numFrames; i++)
+	{
+		stageTimes[nc::FrameStatistics::Stages::FRAME] = (firstFrame + i + 1) * 0.001f;
+		for (unsigned int stage = 1; stage < nc::FrameStatistics::Stages::COUNT; stage++)
+			stageTimes[stage] = stage * 0.001f;
+		stats.addFrame(stageTimes);
+	}
+}
+
+TEST(FrameStatisticsTest, Empty)
+{
+	nc::FrameStatistics stats(Capacity);
+	printf("Computing the statistics without frames\n");
+
+	nc::FrameStatistics::Summary summary;
+	stats.computeSummary(summary);
+	ASSERT_EQ(stats.numFrames(), 0u);
+	ASSERT_EQ(summary.numFrames, 0u);
+	ASSERT_EQ(summary.numHitches, 0u);
+	ASSERT_EQ(summary.stages[nc::FrameStatistics::Stages::FRAME].max, 0.0f);
+}
+
+TEST(FrameStatisticsTest, Disabled)
+{
+	nc::FrameStatistics stats(0);
+	printf("Adding frames to disabled statistics\n");
+	addFrames(stats, 10, 0);
+
+	nc::FrameStatistics::Summary summary;
+	stats.computeSummary(summary);
+	ASSERT_EQ(stats.numRecordedFrames(), 0u);
+	ASSERT_EQ(summary.numFrames, 0u);
+}
+
+TEST(FrameStatisticsTest, Percentiles)
+{
+	nc::FrameStatistics stats(Capacity);
+	addFrames(stats, Capacity - 1, 0);
+
+	nc::FrameStatistics::Summary summary;
+	stats.computeSummary(summary);
+	const nc::FrameStatistics::StageSummary &frame = summary.stages[nc::FrameStatistics::Stages::FRAME];
+	printf("Frame: mean %.3f ms, p50 %.3f ms, p95 %.3f ms, p99 %.3f ms, max %.3f ms\n",
+	       frame.mean * 1000.0f, frame.p50 * 1000.0f, frame.p95 * 1000.0f, frame.p99 * 1000.0f, frame.max * 1000.0f);
+
+	ASSERT_EQ(summary.numFrames, Capacity - 1);
+	ASSERT_NEAR(frame.mean, 0.050f, 0.0001f);
+	ASSERT_NEAR(frame.p50, 0.050f, 0.0001f);
+	ASSERT_NEAR(frame.p95, 0.095f, 0.0001f);
+	ASSERT_NEAR(frame.p99, 0.099f, 0.0001f);
+	ASSERT_NEAR(frame.max, 0.099f, 0.0001f);
+
+	for (unsigned int stage = 1; stage < nc::FrameStatistics::Stages::COUNT; stage++)
+	{
+		ASSERT_NEAR(summary.stages[stage].p50, stage * 0.001f, 0.0001f);
+		ASSERT_NEAR(summary.stages[stage].max, stage * 0.001f, 0.0001f);
+	}
+}
+
+TEST(FrameStatisticsTest, NearestRankPercentiles)
+{
+	nc::FrameStatistics stats(Capacity);
+	printf("Nearest-rank percentiles of a single frame\n");
+	addFrames(stats, 1, 0);
+
+	nc::FrameStatistics::Summary summary;
+	stats.computeSummary(summary);
+	const nc::FrameStatistics::StageSummary &single = summary.stages[nc::FrameStatistics::Stages::FRAME];
+	ASSERT_FLOAT_EQ(single.p50, 0.001f);
+	ASSERT_FLOAT_EQ(single.p99, 0.001f);
+
+	printf("Nearest-rank percentiles of ten frames\n");
+	stats.reset();
+	addFrames(stats, 10, 0);
+	stats.computeSummary(summary);
+	const nc::FrameStatistics::StageSummary &frame = summary.stages[nc::FrameStatistics::Stages::FRAME];
+	ASSERT_FLOAT_EQ(frame.p50, 0.005f);
+	ASSERT_FLOAT_EQ(frame.p95, 0.010f);
+	ASSERT_FLOAT_EQ(frame.p99, 0.010f);
+}
+
+TEST(FrameStatisticsTest, RingKeepsMostRecentFrames)
+{
+	nc::FrameStatistics stats(Capacity);
+	printf("Adding %u frames to a ring of %u\n", Capacity * 3, Capacity);
+	addFrames(stats, Capacity * 3, 0);
+
+	nc::FrameStatistics::Summary summary;
+	stats.computeSummary(summary);
+	ASSERT_EQ(stats.numFrames(), Capacity * 3);
+	ASSERT_EQ(stats.numRecordedFrames(), Capacity);
+	ASSERT_GE(summary.numFrames, Capacity - 1);
+	ASSERT_NEAR(summary.stages[nc::FrameStatistics::Stages::FRAME].max, Capacity * 3 * 0.001f, 0.0001f);
+	ASSERT_GT(summary.stages[nc::FrameStatistics::Stages::FRAME].p50, Capacity * 2 * 0.001f);
+}
+
+TEST(FrameStatisticsTest, Hitches)
+{
+	nc::FrameStatistics stats(Capacity);
+	float stageTimes[nc::FrameStatistics::Stages::COUNT] = {};
+
+	stageTimes[nc::FrameStatistics::Stages::FRAME] = 0.016f;
+	for (unsigned int i = 0; i < 50; i++)
+		stats.addFrame(stageTimes);
+	stageTimes[nc::FrameStatistics::Stages::FRAME] = 0.1f;
+	for (unsigned int i = 0; i < 3; i++)
+		stats.addFrame(stageTimes);
+
+	nc::FrameStatistics::Summary summary;
+	stats.computeSummary(summary);
+	printf("Hitches with a factor of %.1f: %u\n", stats.hitchFactor(), summary.numHitches);
+	ASSERT_EQ(summary.numHitches, 3u);
+
+	stats.setHitchFactor(10.0f);
+	stats.computeSummary(summary);
+	ASSERT_EQ(summary.numHitches, 0u);
+}
+
+TEST(FrameStatisticsTest, Reset)
+{
+	nc::FrameStatistics stats(Capacity);
+	addFrames(stats, 10, 0);
+	printf("Resetting the statistics\n");
+	stats.reset();
+
+	nc::FrameStatistics::Summary summary;
+	stats.computeSummary(summary);
+	ASSERT_EQ(stats.numFrames(), 0u);
+	ASSERT_EQ(summary.numFrames, 0u);
+}
+
+TEST(FrameStatisticsTest, FormatFromExtension)
+{
+	printf("Choosing the file format from the extension\n");
+	ASSERT_EQ(nc::FrameStatistics::formatFromExtension("stats.json"), nc::FrameStatistics::Format::JSON);
+	ASSERT_EQ(nc::FrameStatistics::formatFromExtension("stats.csv"), nc::FrameStatistics::Format::CSV);
+	ASSERT_STREQ(nc::FrameStatistics::stageName(nc::FrameStatistics::Stages::UPDATE), "update");
+}
+
+}
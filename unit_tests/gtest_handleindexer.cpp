@@ -0,0 +1,128 @@
+#include <ncine/HandleIndexer.h>
+#include <ncine/Object.h>
+#include <ncine/ServiceLocator.h>
+#include <nctl/UniquePtr.h>
+#include "gtest/gtest.h"
+
+namespace nc = ncine;
+
+namespace {
+
+const unsigned int NumObjects = 32;
+
+class HandleIndexerTest : public ::testing::Test
+{
+  public:
+	HandleIndexerTest()
+	    : indexer_(nullptr) {}
+
+  protected:
+	void SetUp() override
+	{
+		nctl::UniquePtr<nc::HandleIndexer> indexer = nctl::makeUnique<nc::HandleIndexer>();
+		indexer_ = indexer.get();
+		nc::theServiceLocator().registerIndexer(nctl::move(indexer));
+	}
+
+	void TearDown() override { nc::theServiceLocator().unregisterIndexer(); }
+
+	nc::HandleIndexer *indexer_;
+};
+
+TEST_F(HandleIndexerTest, EmptyIndexer)
+{
+	ASSERT_TRUE(indexer_->isEmpty());
+	ASSERT_EQ(indexer_->size(), 0);
+	ASSERT_EQ(indexer_->object(0), nullptr);
+}
+
+TEST_F(HandleIndexerTest, AddObjects)
+{
+	printf("Creating %u objects\n", NumObjects);
+	nc::Object *objects[NumObjects];
+	for (unsigned int i = 0; i < NumObjects; i++)
+		objects[i] = new nc::Object(nc::Object::ObjectType::BASE);
+
+	ASSERT_EQ(indexer_->size(), NumObjects);
+	for (unsigned int i = 0; i < NumObjects; i++)
+	{
+		ASSERT_NE(objects[i]->id(), 0);
+		ASSERT_EQ(indexer_->object(objects[i]->id()), objects[i]);
+	}
+
+	for (unsigned int i = 0; i < NumObjects; i++)
+		delete objects[i];
+	ASSERT_TRUE(indexer_->isEmpty());
+}
+
+TEST_F(HandleIndexerTest, StaleIdIsRejected)
+{
+	nc::Object *object = new nc::Object(nc::Object::ObjectType::BASE);
+	const unsigned int staleId = object->id();
+	delete object;
+
+	printf("Creating an object that reuses the slot of a destroyed one\n");
+	nc::Object newObject(nc::Object::ObjectType::BASE);
+	ASSERT_EQ(nc::HandleIndexer::index(newObject.id()), nc::HandleIndexer::index(staleId));
+	ASSERT_NE(newObject.id(), staleId);
+	ASSERT_EQ(indexer_->object(staleId), nullptr);
+	ASSERT_FALSE(indexer_->removeObject(staleId));
+	ASSERT_FALSE(indexer_->setObject(staleId, &newObject));
+	ASSERT_EQ(indexer_->object(newObject.id()), &newObject);
+}
+
+TEST_F(HandleIndexerTest, SlotsAreReused)
+{
+	printf("Creating and destroying objects %u times\n", NumObjects * 100);
+	for (unsigned int i = 0; i < NumObjects * 100; i++)
+	{
+		nc::Object *objects[4];
+		for (unsigned int j = 0; j < 4; j++)
+			objects[j] = new nc::Object(nc::Object::ObjectType::BASE);
+		for (unsigned int j = 0; j < 4; j++)
+			delete objects[j];
+	}
+
+	ASSERT_TRUE(indexer_->isEmpty());
+	ASSERT_LE(indexer_->numSlots(), 5);
+	ASSERT_EQ(indexer_->numFreeSlots(), indexer_->numSlots() - 1);
+}
+
+TEST_F(HandleIndexerTest, MoveConstructor)
+{
+	nc::Object object(nc::Object::ObjectType::BASE);
+	const unsigned int id = object.id();
+
+	nc::Object movedObject(nctl::move(object));
+	ASSERT_EQ(object.id(), 0);
+	ASSERT_EQ(movedObject.id(), id);
+	ASSERT_EQ(indexer_->object(id), &movedObject);
+}
+
+TEST_F(HandleIndexerTest, MoveAssignment)
+{
+	nc::Object object(nc::Object::ObjectType::BASE);
+	nc::Object otherObject(nc::Object::ObjectType::BASE);
+	const unsigned int id = object.id();
+	const unsigned int otherId = otherObject.id();
+
+	otherObject = nctl::move(object);
+	ASSERT_EQ(object.id(), 0);
+	ASSERT_EQ(otherObject.id(), id);
+	ASSERT_EQ(indexer_->object(id), &otherObject);
+	ASSERT_EQ(indexer_->object(otherId), nullptr);
+	ASSERT_EQ(indexer_->size(), 1);
+}
+
+TEST_F(HandleIndexerTest, DestroyRemainingObjects)
+{
+	for (unsigned int i = 0; i < NumObjects; i++)
+		new nc::Object(nc::Object::ObjectType::BASE);
+
+	printf("Unregistering the indexer with %u objects left\n", NumObjects);
+	nc::theServiceLocator().unregisterIndexer();
+	SetUp();
+	ASSERT_TRUE(indexer_->isEmpty());
+}
+
+}
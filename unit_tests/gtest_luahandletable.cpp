@@ -0,0 +1,124 @@
+#include <ncine/LuaHandleTable.h>
+#include "gtest/gtest.h"
+
+namespace nc = ncine;
+
+namespace {
+
+const unsigned int NumObjects = 32;
+
+class LuaHandleTableTest : public ::testing::Test
+{
+  public:
+	LuaHandleTableTest()
+	    : handles_(4), objects_() {}
+
+  protected:
+	nc::LuaHandleTable handles_;
+	int objects_[NumObjects];
+};
+
+TEST_F(LuaHandleTableTest, EmptyTable)
+{
+	nc::LuaTypes::UserDataType type = nc::LuaTypes::SPRITE;
+	ASSERT_EQ(handles_.size(), 0u);
+	ASSERT_EQ(handles_.numTracked(), 0u);
+	ASSERT_EQ(handles_.object(nc::LuaHandleTable::InvalidHandle, type), nullptr);
+	ASSERT_EQ(type, nc::LuaTypes::UNKNOWN);
+}
+
+TEST_F(LuaHandleTableTest, AddObjects)
+{
+	printf("Adding %u objects\n", NumObjects);
+	nc::LuaHandleTable::Handle handles[NumObjects];
+	for (unsigned int i = 0; i < NumObjects; i++)
+		handles[i] = handles_.add(&objects_[i], nc::LuaTypes::SPRITE, nc::LuaHandleTable::Tracking::TRACKED);
+
+	ASSERT_EQ(handles_.size(), NumObjects);
+	for (unsigned int i = 0; i < NumObjects; i++)
+	{
+		nc::LuaTypes::UserDataType type = nc::LuaTypes::UNKNOWN;
+		ASSERT_NE(handles[i], nc::LuaHandleTable::InvalidHandle);
+		ASSERT_EQ(handles_.object(handles[i], type), &objects_[i]);
+		ASSERT_EQ(type, nc::LuaTypes::SPRITE);
+	}
+}
+
+TEST_F(LuaHandleTableTest, SameObjectSameHandle)
+{
+	const nc::LuaHandleTable::Handle tracked = handles_.add(&objects_[0], nc::LuaTypes::SPRITE, nc::LuaHandleTable::Tracking::TRACKED);
+	const nc::LuaHandleTable::Handle untracked = handles_.add(&objects_[0], nc::LuaTypes::SCENENODE, nc::LuaHandleTable::Tracking::UNTRACKED);
+	printf("Handle of the tracked object: 0x%x, handle when pushed again: 0x%x\n", tracked, untracked);
+
+	ASSERT_EQ(tracked, untracked);
+	ASSERT_TRUE(handles_.isTracked(untracked));
+	ASSERT_EQ(handles_.size(), 1u);
+}
+
+TEST_F(LuaHandleTableTest, StaleHandleIsRejected)
+{
+	const nc::LuaHandleTable::Handle handle = handles_.add(&objects_[0], nc::LuaTypes::TEXTURE, nc::LuaHandleTable::Tracking::TRACKED);
+	ASSERT_TRUE(handles_.remove(handle));
+	ASSERT_FALSE(handles_.remove(handle));
+
+	const nc::LuaHandleTable::Handle newHandle = handles_.add(&objects_[1], nc::LuaTypes::TEXTURE, nc::LuaHandleTable::Tracking::TRACKED);
+	printf("Stale handle: 0x%x, new handle in the same slot: 0x%x\n", handle, newHandle);
+	ASSERT_EQ(nc::LuaHandleTable::index(handle), nc::LuaHandleTable::index(newHandle));
+	ASSERT_NE(handle, newHandle);
+
+	nc::LuaTypes::UserDataType type = nc::LuaTypes::UNKNOWN;
+	ASSERT_EQ(handles_.object(handle, type), nullptr);
+	ASSERT_EQ(handles_.object(newHandle, type), &objects_[1]);
+}
+
+TEST_F(LuaHandleTableTest, TrackedCounters)
+{
+	nc::LuaHandleTable::Handle handles[NumObjects];
+	for (unsigned int i = 0; i < NumObjects; i++)
+	{
+		const nc::LuaTypes::UserDataType type = (i % 2 == 0) ? nc::LuaTypes::SPRITE : nc::LuaTypes::TEXTNODE;
+		const nc::LuaHandleTable::Tracking tracking = (i % 4 == 3) ? nc::LuaHandleTable::Tracking::UNTRACKED : nc::LuaHandleTable::Tracking::TRACKED;
+		handles[i] = handles_.add(&objects_[i], type, tracking);
+	}
+
+	printf("Tracked objects: %u sprites and %u text nodes\n", handles_.numTracked(nc::LuaTypes::SPRITE), handles_.numTracked(nc::LuaTypes::TEXTNODE));
+	ASSERT_EQ(handles_.numTracked(), NumObjects / 4 * 3);
+	ASSERT_EQ(handles_.numTracked(nc::LuaTypes::SPRITE), NumObjects / 2);
+	ASSERT_EQ(handles_.numTracked(nc::LuaTypes::TEXTNODE), NumObjects / 4);
+
+	handles_.remove(handles[0]);
+	handles_.remove(handles[1]);
+	ASSERT_EQ(handles_.numTracked(nc::LuaTypes::SPRITE), NumObjects / 2 - 1);
+	ASSERT_EQ(handles_.numTracked(nc::LuaTypes::TEXTNODE), NumObjects / 4 - 1);
+}
+
+TEST_F(LuaHandleTableTest, RemoveUntracked)
+{
+	const nc::LuaHandleTable::Handle tracked = handles_.add(&objects_[0], nc::LuaTypes::SPRITE, nc::LuaHandleTable::Tracking::TRACKED);
+	const nc::LuaHandleTable::Handle untracked = handles_.add(&objects_[1], nc::LuaTypes::SCENENODE, nc::LuaHandleTable::Tracking::UNTRACKED);
+
+	printf("Removing untracked objects\n");
+	handles_.removeUntracked();
+	ASSERT_TRUE(handles_.isValid(tracked));
+	ASSERT_FALSE(handles_.isValid(untracked));
+	ASSERT_EQ(handles_.size(), 1u);
+}
+
+TEST_F(LuaHandleTableTest, TrackedReplacesStaleUntracked)
+{
+	const nc::LuaHandleTable::Handle untracked = handles_.add(&objects_[0], nc::LuaTypes::SCENENODE, nc::LuaHandleTable::Tracking::UNTRACKED);
+	const nc::LuaHandleTable::Handle tracked = handles_.add(&objects_[0], nc::LuaTypes::SPRITE, nc::LuaHandleTable::Tracking::TRACKED);
+
+	ASSERT_FALSE(handles_.isValid(untracked));
+	ASSERT_TRUE(handles_.isTracked(tracked));
+	ASSERT_EQ(handles_.numTracked(nc::LuaTypes::SPRITE), 1u);
+}
+
+TEST_F(LuaHandleTableTest, UserDataConversion)
+{
+	const nc::LuaHandleTable::Handle handle = handles_.add(&objects_[0], nc::LuaTypes::FONT, nc::LuaHandleTable::Tracking::TRACKED);
+	ASSERT_EQ(nc::LuaHandleTable::toHandle(nc::LuaHandleTable::toUserData(handle)), handle);
+	ASSERT_EQ(nc::LuaHandleTable::toHandle(nullptr), nc::LuaHandleTable::InvalidHandle);
+}
+
+}
@@ -0,0 +1,92 @@
+#include <ncine/Profiler.h>
+#include "gtest/gtest.h"
+
+namespace nc = ncine;
+
+namespace {
+
+void recordZones(unsigned int numZones)
+{
+	for (unsigned int i = 0; i < numZones; i++)
+	{
+		nc::Profiler::Zone zone("TestZone");
+	}
+}
+
+class ProfilerTest : public ::testing::Test
+{
+  public:
+	void SetUp() override
+	{
+		nc::Profiler::setEnabled(true);
+		nc::Profiler::clear();
+	}
+	void TearDown() override { nc::Profiler::setEnabled(false); }
+};
+
+TEST_F(ProfilerTest, DisabledByDefault)
+{
+	nc::Profiler::setEnabled(false);
+	printf("Recording zones with the profiler disabled\n");
+	recordZones(10);
+
+	ASSERT_FALSE(nc::Profiler::isEnabled());
+	ASSERT_EQ(nc::Profiler::numZones(), 0u);
+}
+
+TEST_F(ProfilerTest, RecordZones)
+{
+	printf("Recording 10 zones\n");
+	recordZones(10);
+
+	ASSERT_TRUE(nc::Profiler::isEnabled());
+	ASSERT_EQ(nc::Profiler::numZones(), 10u);
+	ASSERT_GE(nc::Profiler::numThreads(), 1u);
+}
+
+TEST_F(ProfilerTest, NestedZones)
+{
+	printf("Recording nested zones\n");
+	{
+		nc::Profiler::Zone outer("Outer");
+		{
+			nc::Profiler::Zone inner("Inner");
+		}
+	}
+
+	ASSERT_EQ(nc::Profiler::numZones(), 2u);
+}
+
+TEST_F(ProfilerTest, DisableDuringZone)
+{
+	printf("Disabling the profiler while a zone is open\n");
+	{
+		nc::Profiler::Zone zone("Zone");
+		nc::Profiler::setEnabled(false);
+	}
+
+	// A zone started while the profiler was enabled is always recorded
+	ASSERT_EQ(nc::Profiler::numZones(), 1u);
+}
+
+TEST_F(ProfilerTest, RingKeepsMostRecentZones)
+{
+	const unsigned int NumZones = nc::Profiler::ZonesPerThread + 100;
+	printf("Recording %u zones in a buffer of %u\n", NumZones, nc::Profiler::ZonesPerThread);
+	recordZones(NumZones);
+
+	ASSERT_EQ(nc::Profiler::numZones(), static_cast<unsigned long int>(nc::Profiler::ZonesPerThread));
+}
+
+TEST_F(ProfilerTest, Clear)
+{
+	recordZones(10);
+	printf("Clearing the recorded zones\n");
+	nc::Profiler::clear();
+	ASSERT_EQ(nc::Profiler::numZones(), 0u);
+
+	recordZones(5);
+	ASSERT_EQ(nc::Profiler::numZones(), 5u);
+}
+
+}
@@ -0,0 +1,160 @@
+#include <ncine/ShaderProgramStatus.h>
+#include "gtest/gtest.h"
+
+namespace nc = ncine;
+
+namespace {
+
+using Status = nc::ShaderProgramStatus::Status;
+
+TEST(ShaderProgramStatusTest, InitialStatus)
+{
+	const nc::ShaderProgramStatus status;
+	printf("A new program is not linked\n");
+
+	ASSERT_EQ(status.value(), Status::NOT_LINKED);
+	ASSERT_FALSE(status.isLinked());
+	ASSERT_FALSE(status.hasDeferredQueries());
+}
+
+TEST(ShaderProgramStatusTest, ImmediateLink)
+{
+	nc::ShaderProgramStatus status;
+	printf("Linking with immediate queries and introspection\n");
+
+	ASSERT_TRUE(status.checkLink(true));
+	ASSERT_EQ(status.value(), Status::LINKED);
+	ASSERT_TRUE(status.isLinked());
+	ASSERT_FALSE(status.hasDeferredQueries());
+
+	ASSERT_TRUE(status.completeIntrospection());
+	ASSERT_EQ(status.value(), Status::LINKED_WITH_INTROSPECTION);
+	ASSERT_TRUE(status.isLinked());
+}
+
+TEST(ShaderProgramStatusTest, ImmediateLinkFailure)
+{
+	nc::ShaderProgramStatus status;
+	printf("A failed link with immediate queries\n");
+
+	ASSERT_TRUE(status.checkLink(false));
+	ASSERT_EQ(status.value(), Status::LINKING_FAILED);
+	ASSERT_FALSE(status.isLinked());
+	ASSERT_FALSE(status.completeIntrospection());
+	ASSERT_EQ(status.value(), Status::LINKING_FAILED);
+}
+
+TEST(ShaderProgramStatusTest, ParallelLink)
+{
+	nc::ShaderProgramStatus status;
+	printf("Deferred link polled until completion: NOT_LINKED, LINKING, LINKED_WITH_DEFERRED_QUERIES, LINKED_WITH_INTROSPECTION\n");
+
+	ASSERT_TRUE(status.deferLink(true));
+	ASSERT_EQ(status.value(), Status::LINKING);
+	ASSERT_TRUE(status.isLinked());
+	ASSERT_TRUE(status.hasDeferredQueries());
+
+	ASSERT_TRUE(status.completeLink());
+	ASSERT_EQ(status.value(), Status::LINKED_WITH_DEFERRED_QUERIES);
+	ASSERT_TRUE(status.isLinked());
+	ASSERT_TRUE(status.hasDeferredQueries());
+
+	ASSERT_TRUE(status.checkLink(true));
+	ASSERT_EQ(status.value(), Status::LINKED);
+	ASSERT_FALSE(status.hasDeferredQueries());
+
+	ASSERT_TRUE(status.completeIntrospection());
+	ASSERT_EQ(status.value(), Status::LINKED_WITH_INTROSPECTION);
+}
+
+TEST(ShaderProgramStatusTest, DeferredLinkWithoutPolling)
+{
+	nc::ShaderProgramStatus status;
+	printf("Deferred link when the driver cannot be polled skips the LINKING status\n");
+
+	ASSERT_TRUE(status.deferLink(false));
+	ASSERT_EQ(status.value(), Status::LINKED_WITH_DEFERRED_QUERIES);
+	ASSERT_FALSE(status.completeLink());
+	ASSERT_EQ(status.value(), Status::LINKED_WITH_DEFERRED_QUERIES);
+
+	ASSERT_TRUE(status.checkLink(true));
+	ASSERT_EQ(status.value(), Status::LINKED);
+}
+
+TEST(ShaderProgramStatusTest, CheckLinkWhileLinking)
+{
+	nc::ShaderProgramStatus status;
+	printf("Checking deferred queries of a program used before its link has been polled\n");
+
+	ASSERT_TRUE(status.deferLink(true));
+	ASSERT_TRUE(status.checkLink(true));
+	ASSERT_EQ(status.value(), Status::LINKED);
+	ASSERT_FALSE(status.completeLink());
+	ASSERT_EQ(status.value(), Status::LINKED);
+}
+
+TEST(ShaderProgramStatusTest, DeferredCompilationFailure)
+{
+	nc::ShaderProgramStatus status;
+	printf("A shader failing to compile is found when checking deferred queries\n");
+
+	ASSERT_TRUE(status.deferLink(true));
+	ASSERT_TRUE(status.completeLink());
+	ASSERT_TRUE(status.failCompilation());
+	ASSERT_EQ(status.value(), Status::COMPILATION_FAILED);
+	ASSERT_FALSE(status.isLinked());
+	ASSERT_FALSE(status.hasDeferredQueries());
+}
+
+TEST(ShaderProgramStatusTest, DeferredLinkFailure)
+{
+	nc::ShaderProgramStatus status;
+	printf("A failed link is found when checking deferred queries\n");
+
+	ASSERT_TRUE(status.deferLink(false));
+	ASSERT_TRUE(status.checkLink(false));
+	ASSERT_EQ(status.value(), Status::LINKING_FAILED);
+	ASSERT_FALSE(status.isLinked());
+}
+
+TEST(ShaderProgramStatusTest, NoLinkAfterCompilationFailure)
+{
+	nc::ShaderProgramStatus status;
+	printf("A program whose shader has failed to compile cannot be linked\n");
+
+	ASSERT_TRUE(status.failCompilation());
+	ASSERT_FALSE(status.deferLink(true));
+	ASSERT_FALSE(status.checkLink(true));
+	ASSERT_EQ(status.value(), Status::COMPILATION_FAILED);
+}
+
+TEST(ShaderProgramStatusTest, NoTransitionsAfterIntrospection)
+{
+	nc::ShaderProgramStatus status;
+	printf("A linked program with introspection only changes status when reset\n");
+
+	ASSERT_TRUE(status.checkLink(true));
+	ASSERT_TRUE(status.completeIntrospection());
+
+	ASSERT_FALSE(status.failCompilation());
+	ASSERT_FALSE(status.deferLink(true));
+	ASSERT_FALSE(status.completeLink());
+	ASSERT_FALSE(status.checkLink(false));
+	ASSERT_FALSE(status.completeIntrospection());
+	ASSERT_EQ(status.value(), Status::LINKED_WITH_INTROSPECTION);
+}
+
+TEST(ShaderProgramStatusTest, Reset)
+{
+	nc::ShaderProgramStatus status;
+	printf("Resetting a program allows linking it again\n");
+
+	ASSERT_TRUE(status.deferLink(true));
+	status.reset();
+	ASSERT_EQ(status.value(), Status::NOT_LINKED);
+
+	ASSERT_TRUE(status.checkLink(true));
+	ASSERT_EQ(status.value(), Status::LINKED);
+}
+
+}
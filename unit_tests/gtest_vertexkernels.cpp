@@ -0,0 +1,162 @@
+#include <cstring> // for memcmp()
+#include <ncine/VertexKernels.h>
+#include "gtest/gtest.h"
+
+namespace nc = ncine;
+
+namespace {
+
+const unsigned int NumVertices = 37; // not a multiple of the vector width, to exercise the tails
+const unsigned int MaxNumFloats = 6;
+const unsigned int NumIndices = 53;
+const unsigned int NumQuads = 5;
+const int MeshIndex = 42;
+const unsigned short Offset = 1000;
+
+void fillVertices(float *vertices, unsigned int numFloats)
+{
+	for (unsigned int i = 0; i < numFloats; i++)
+		vertices[i] = static_cast<float>(i) * 0.5f - 3.0f;
+}
+
+void testCopyWithIndex(unsigned int numFloats)
+{
+	float src[NumVertices * MaxNumFloats];
+	float dest[NumVertices * (MaxNumFloats + 1)];
+	float scalarDest[NumVertices * (MaxNumFloats + 1)];
+	fillVertices(src, NumVertices * numFloats);
+
+	printf("Copying %u vertices of %u floats with the %s kernel\n", NumVertices, numFloats, nc::VertexKernels::instructionSet());
+	nc::VertexKernels::copyWithIndex(dest, src, NumVertices, numFloats, MeshIndex);
+	nc::VertexKernels::copyWithIndexScalar(scalarDest, src, NumVertices, numFloats, MeshIndex);
+
+	ASSERT_EQ(memcmp(dest, scalarDest, NumVertices * (numFloats + 1) * sizeof(float)), 0);
+	for (unsigned int i = 0; i < NumVertices; i++)
+	{
+		int index = 0;
+		memcpy(&index, &dest[i * (numFloats + 1) + numFloats], sizeof(int));
+		ASSERT_EQ(index, MeshIndex);
+		ASSERT_FLOAT_EQ(dest[i * (numFloats + 1)], src[i * numFloats]);
+	}
+}
+
+TEST(VertexKernelsTest, CopyWithIndexTwoFloats)
+{
+	testCopyWithIndex(2);
+}
+
+TEST(VertexKernelsTest, CopyWithIndexFourFloats)
+{
+	testCopyWithIndex(4);
+}
+
+TEST(VertexKernelsTest, CopyWithIndexSixFloats)
+{
+	testCopyWithIndex(6);
+}
+
+TEST(VertexKernelsTest, CopyWithIndexZeroVertices)
+{
+	float src[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
+	float dest[5] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+
+	printf("Copying zero vertices\n");
+	nc::VertexKernels::copyWithIndex(dest, src, 0, 4, MeshIndex);
+	for (unsigned int i = 0; i < 5; i++)
+		ASSERT_EQ(dest[i], 0.0f);
+}
+
+TEST(VertexKernelsTest, AddOffset)
+{
+	unsigned short src[NumIndices];
+	unsigned short dest[NumIndices];
+	unsigned short scalarDest[NumIndices];
+	for (unsigned int i = 0; i < NumIndices; i++)
+		src[i] = static_cast<unsigned short>((i * 7) % NumIndices);
+
+	printf("Adding %u to %u indices with the %s kernel\n", Offset, NumIndices, nc::VertexKernels::instructionSet());
+	nc::VertexKernels::addOffset(dest, src, NumIndices, Offset);
+	nc::VertexKernels::addOffsetScalar(scalarDest, src, NumIndices, Offset);
+
+	for (unsigned int i = 0; i < NumIndices; i++)
+	{
+		ASSERT_EQ(dest[i], scalarDest[i]);
+		ASSERT_EQ(dest[i], src[i] + Offset);
+	}
+}
+
+TEST(VertexKernelsTest, AddOffsetWrapsAround)
+{
+	unsigned short src[NumIndices];
+	unsigned short dest[NumIndices];
+	for (unsigned int i = 0; i < NumIndices; i++)
+		src[i] = static_cast<unsigned short>(65535 - i);
+
+	printf("Adding %u to indices close to the maximum value\n", Offset);
+	nc::VertexKernels::addOffset(dest, src, NumIndices, Offset);
+	for (unsigned int i = 0; i < NumIndices; i++)
+		ASSERT_EQ(dest[i], static_cast<unsigned short>(src[i] + Offset));
+}
+
+TEST(VertexKernelsTest, AddOffsetInPlace)
+{
+	unsigned short indices[NumIndices];
+	for (unsigned int i = 0; i < NumIndices; i++)
+		indices[i] = static_cast<unsigned short>(i);
+
+	printf("Adding %u to %u indices in place\n", Offset, NumIndices);
+	nc::VertexKernels::addOffset(indices, indices, NumIndices, Offset);
+	for (unsigned int i = 0; i < NumIndices; i++)
+		ASSERT_EQ(indices[i], i + Offset);
+}
+
+TEST(VertexKernelsTest, QuadsToStrip)
+{
+	nc::VertexKernels::Quad quads[NumQuads];
+	for (unsigned int i = 0; i < NumQuads; i++)
+	{
+		const float base = static_cast<float>(i) * 10.0f;
+		quads[i].positions[0] = base;
+		quads[i].positions[1] = base + 1.0f;
+		quads[i].positions[2] = base + 2.0f;
+		quads[i].positions[3] = base + 3.0f;
+		quads[i].texCoords[0] = 0.1f * i;
+		quads[i].texCoords[1] = 0.1f * i + 0.01f;
+		quads[i].texCoords[2] = 0.1f * i + 0.02f;
+		quads[i].texCoords[3] = 0.1f * i + 0.03f;
+	}
+
+	float dest[NumQuads * 16];
+	float scalarDest[NumQuads * 16];
+	printf("Expanding %u quads with the %s kernel\n", NumQuads, nc::VertexKernels::instructionSet());
+	nc::VertexKernels::quadsToStrip(dest, quads, NumQuads);
+	nc::VertexKernels::quadsToStripScalar(scalarDest, quads, NumQuads);
+
+	ASSERT_EQ(memcmp(dest, scalarDest, sizeof(dest)), 0);
+	for (unsigned int i = 0; i < NumQuads; i++)
+	{
+		const float *vertices = &dest[i * 16];
+		// Bottom left
+		ASSERT_FLOAT_EQ(vertices[0], quads[i].positions[0]);
+		ASSERT_FLOAT_EQ(vertices[1], quads[i].positions[1]);
+		ASSERT_FLOAT_EQ(vertices[2], quads[i].texCoords[0]);
+		ASSERT_FLOAT_EQ(vertices[3], quads[i].texCoords[1]);
+		// Top left
+		ASSERT_FLOAT_EQ(vertices[4], quads[i].positions[0]);
+		ASSERT_FLOAT_EQ(vertices[5], quads[i].positions[3]);
+		ASSERT_FLOAT_EQ(vertices[6], quads[i].texCoords[0]);
+		ASSERT_FLOAT_EQ(vertices[7], quads[i].texCoords[3]);
+		// Bottom right
+		ASSERT_FLOAT_EQ(vertices[8], quads[i].positions[2]);
+		ASSERT_FLOAT_EQ(vertices[9], quads[i].positions[1]);
+		ASSERT_FLOAT_EQ(vertices[10], quads[i].texCoords[2]);
+		ASSERT_FLOAT_EQ(vertices[11], quads[i].texCoords[1]);
+		// Top right
+		ASSERT_FLOAT_EQ(vertices[12], quads[i].positions[2]);
+		ASSERT_FLOAT_EQ(vertices[13], quads[i].positions[3]);
+		ASSERT_FLOAT_EQ(vertices[14], quads[i].texCoords[2]);
+		ASSERT_FLOAT_EQ(vertices[15], quads[i].texCoords[3]);
+	}
+}
+
+}